@@ -0,0 +1,203 @@
+#!/usr/bin/env python3
+
+#~ Copyright 2026 agent.
+#~ Distributed under the Boost Software License, Version 1.0.
+#~ (See accompanying file LICENSE_1_0.txt or http://www.boost.org/LICENSE_1_0.txt)
+
+"""
+Runs the benchmarks that are listed in the JSON file generated by benchmarks/CMakeLists.txt a number of times,
+and writes the wall time, peak memory usage, rewrite counts and term pool statistics of every benchmark to a JSON
+file. When a baseline, i.e., the output of an earlier run, is given the results are compared with it and the
+script fails when a benchmark became slower or uses more memory than the threshold allows.
+
+The timed runs are not instrumented. The rewrite counts and term pool statistics are obtained from one additional
+run, with the rewriter profile enabled for the tools that rewrite.
+"""
+
+import argparse
+import json
+import os
+import re
+import statistics
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+
+class Measurement:
+    def __init__(self, wall_time, peak_rss_kb, exit_code, timed_out):
+        self.wall_time = wall_time
+        self.peak_rss_kb = peak_rss_kb
+        self.exit_code = exit_code
+        self.timed_out = timed_out
+
+def run(command, timeout, env = None):
+    """Runs the command and measures its wall time and its peak resident set size, which is given in kilobytes."""
+    with open(os.devnull, 'w') as devnull:
+        start = time.perf_counter()
+        process = subprocess.Popen(command, stdout = devnull, stderr = devnull, env = env)
+        timed_out = threading.Event()
+
+        def kill():
+            timed_out.set()
+            process.kill()
+
+        timer = threading.Timer(timeout, kill) if timeout else None
+        if timer:
+            timer.start()
+        # Unlike wait(), wait4() provides the resource usage of this child only.
+        _, status, usage = os.wait4(process.pid, 0)
+        wall_time = time.perf_counter() - start
+        if timer:
+            timer.cancel()
+        process.returncode = os.waitstatus_to_exitcode(status)
+
+        # On Linux ru_maxrss is in kilobytes, but on macOS it is in bytes.
+        peak_rss_kb = usage.ru_maxrss // 1024 if sys.platform == 'darwin' else usage.ru_maxrss
+        return Measurement(wall_time, peak_rss_kb, process.returncode, timed_out.is_set())
+
+def parse_rewriter_profile(filename):
+    """Returns the number of rule applications and rewrite calls that are reported in a rewriter profile."""
+    applications = 0
+    calls = 0
+    section = None
+    with open(filename, 'r', encoding = 'utf-8') as file:
+        for line in file:
+            if line.startswith('Rewrite rules'):
+                section = 'rules'
+            elif line.startswith('Function symbols'):
+                section = 'symbols'
+            else:
+                # Rule lines are "time % attempts applications rule" and symbol lines are "calls time symbol".
+                fields = line.split()
+                if section == 'rules' and len(fields) >= 5 and re.fullmatch(r'\d+', fields[3]):
+                    applications += int(fields[3])
+                elif section == 'symbols' and len(fields) >= 3 and re.fullmatch(r'\d+', fields[0]):
+                    calls += int(fields[0])
+    return applications, calls
+
+def instrumented_run(benchmark, timeout):
+    """Runs the benchmark once with the term pool statistics and, if applicable, the rewriter profile enabled."""
+    result = {}
+    with tempfile.TemporaryDirectory() as directory:
+        aterm_statistics = os.path.join(directory, 'aterm_statistics.json')
+        profile = os.path.join(directory, 'rewriter_profile.txt')
+
+        env = dict(os.environ)
+        env['MCRL2_ATERM_STATS'] = aterm_statistics
+        command = list(benchmark['command'])
+        if benchmark.get('rewriter', False):
+            # All function symbols are reported, as their calls are added up.
+            command[1:1] = ['--rewriter-profile=' + profile, '--rewriter-profile-symbols=' + str(2**31)]
+
+        measurement = run(command, timeout, env)
+        if measurement.exit_code != 0:
+            return result
+
+        if os.path.exists(aterm_statistics):
+            try:
+                with open(aterm_statistics, 'r', encoding = 'utf-8') as file:
+                    result['aterm_statistics'] = json.load(file)
+            except ValueError as e:
+                print('Could not read the term pool statistics of {}: {}'.format(benchmark['name'], e))
+
+        if os.path.exists(profile):
+            applications, calls = parse_rewriter_profile(profile)
+            result['rewrite_rule_applications'] = applications
+            result['rewrite_calls'] = calls
+    return result
+
+def run_benchmark(benchmark, repetitions, timeout):
+    measurements = []
+    for _ in range(repetitions):
+        measurement = run(benchmark['command'], timeout)
+        measurements.append(measurement)
+        if measurement.exit_code != 0:
+            break
+
+    result = {
+        'command': benchmark['command'],
+        'wall_time': [m.wall_time for m in measurements],
+        'peak_rss_kb': [m.peak_rss_kb for m in measurements],
+    }
+
+    failed = [m for m in measurements if m.exit_code != 0]
+    if failed:
+        result['failed'] = 'timeout' if failed[0].timed_out else 'exit code {}'.format(failed[0].exit_code)
+        return result
+
+    result['median_wall_time'] = statistics.median(result['wall_time'])
+    result['max_peak_rss_kb'] = max(result['peak_rss_kb'])
+    result.update(instrumented_run(benchmark, timeout))
+    return result
+
+def compare(results, baseline, threshold, minimum_time):
+    """Prints the benchmarks of which the time or memory exceeds the baseline by more than threshold percent.
+       Benchmarks of which the baseline time is below minimum_time seconds are not compared on time, as their
+       timings are dominated by noise. Returns the number of regressions."""
+    regressions = 0
+    factor = 1.0 + threshold / 100.0
+    for name, result in sorted(results.items()):
+        if name not in baseline:
+            continue
+        old = baseline[name]
+        if 'failed' in result:
+            if 'failed' not in old:
+                print('REGRESSION {}: failed ({})'.format(name, result['failed']))
+                regressions += 1
+            continue
+        if 'failed' in old:
+            continue
+
+        metrics = [('max_peak_rss_kb', 'peak RSS', '{:.0f}kB')]
+        if old['median_wall_time'] >= minimum_time:
+            metrics.insert(0, ('median_wall_time', 'wall time', '{:.3f}s'))
+        for key, description, unit in metrics:
+            if result[key] > old[key] * factor:
+                print('REGRESSION {}: {} {} -> {} (+{:.1f}%)'.format(
+                    name, description, unit.format(old[key]), unit.format(result[key]), 100.0 * (result[key] / old[key] - 1.0)))
+                regressions += 1
+    return regressions
+
+def main():
+    cmdline_parser = argparse.ArgumentParser()
+    cmdline_parser.add_argument('benchmarks', metavar='FILE', help='the JSON file with the benchmarks to run')
+    cmdline_parser.add_argument('-o', '--output', metavar='FILE', default='benchmark_results.json', help='the JSON file to which the results are written')
+    cmdline_parser.add_argument('-b', '--baseline', metavar='FILE', help='the results of an earlier run to compare with')
+    cmdline_parser.add_argument('-r', '--repetitions', metavar='N', type=int, default=3, help='the number of timed runs of every benchmark')
+    cmdline_parser.add_argument('-t', '--threshold', metavar='PERCENT', type=float, default=10.0, help='the increase in time or memory that is reported as a regression')
+    cmdline_parser.add_argument('--minimum-time', metavar='SEC', type=float, default=0.1, help='benchmarks that took less time in the baseline are not compared on time')
+    cmdline_parser.add_argument('--timeout', metavar='SEC', type=float, default=None, help='the maximum time of a single run')
+    cmdline_parser.add_argument('-p', '--pattern', metavar='REGEX', default='.*', help='only run the benchmarks of which the name matches REGEX')
+    args = cmdline_parser.parse_args()
+
+    with open(args.benchmarks, 'r', encoding = 'utf-8') as file:
+        benchmarks = json.load(file)
+
+    results = {}
+    for benchmark in benchmarks:
+        if not re.search(args.pattern, benchmark['name']):
+            continue
+        print('Running {}'.format(benchmark['name']), flush = True)
+        results[benchmark['name']] = run_benchmark(benchmark, args.repetitions, args.timeout)
+        if 'failed' in results[benchmark['name']]:
+            print('  failed ({})'.format(results[benchmark['name']]['failed']))
+        else:
+            print('  {:.3f}s, {} kB'.format(results[benchmark['name']]['median_wall_time'], results[benchmark['name']]['max_peak_rss_kb']))
+
+    with open(args.output, 'w', encoding = 'utf-8') as file:
+        json.dump({'repetitions': args.repetitions, 'benchmarks': results}, file, indent = 2)
+    print('Results are written to {}'.format(args.output))
+
+    if args.baseline:
+        with open(args.baseline, 'r', encoding = 'utf-8') as file:
+            baseline = json.load(file)['benchmarks']
+        regressions = compare(results, baseline, args.threshold, args.minimum_time)
+        if regressions > 0:
+            print('{} regressions with respect to {}'.format(regressions, args.baseline))
+            sys.exit(1)
+        print('No regressions with respect to {}'.format(args.baseline))
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,32 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef MCRL2_ATERMPP_ATERM_GARBAGE_COLLECTION_H
+#define MCRL2_ATERMPP_ATERM_GARBAGE_COLLECTION_H
+
+#include <cstddef>
+
+namespace atermpp
+{
+
+/// \brief Sweeps the unreachable terms incrementally between term creations when passing true, and sweeps
+///        all of them during garbage collection otherwise.
+/// \details Incremental sweeping is enabled initially when the environment variable
+///          MCRL2_ATERM_INCREMENTAL_SWEEP is set to a value other than 0.
+void enable_incremental_sweep(bool enable);
+
+/// \brief Sets the number of threads that perform garbage collection.
+/// \details The value 0 uses as many threads as there are threads that use terms, but not more than the
+///          hardware supports. The initial value is that of the environment variable
+///          MCRL2_ATERM_COLLECTION_THREADS when it is set, and 0 otherwise.
+void set_number_of_collection_threads(std::size_t number_of_threads);
+
+} // namespace atermpp
+
+#endif // MCRL2_ATERMPP_ATERM_GARBAGE_COLLECTION_H
@@ -0,0 +1,177 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef MCRL2_ATERMPP_ATERM_IO_CHUNKED_H
+#define MCRL2_ATERMPP_ATERM_IO_CHUNKED_H
+
+#include "mcrl2/atermpp/aterm_io_binary.h"
+
+#include <mutex>
+#include <sstream>
+
+namespace atermpp
+{
+
+/// \brief The compression that is applied to the data of a chunk.
+/// \details Only uncompressed chunks can be written and read for now. The value is stored for every chunk
+///          in the index, such that compressed chunks can be added without changing the format.
+enum class chunk_compression : std::uint8_t
+{
+  none = 0
+};
+
+/// \brief The entry of a chunk in the index of a chunked aterm stream.
+struct chunk_information
+{
+  std::uint64_t offset = 0;           ///< The position of the chunk data relative to the start of the stream.
+  std::uint64_t size = 0;             ///< The number of bytes of the chunk data.
+  std::uint64_t number_of_terms = 0;  ///< The number of terms that were written to the chunk.
+  chunk_compression compression = chunk_compression::none;
+};
+
+/// \brief Writes terms in the chunked binary aterm format to an output stream.
+/// \details The chunked aterm format:
+///
+///          The terms are divided over chunks. Every chunk is a complete stream in the binary aterm format
+///          (see binary_aterm_ostream), such that it can be decoded independently of the other chunks.
+///          Subterms are only shared within a chunk. A chunk is finished once its data exceeds the chunk
+///          size, or explicitly by flush_chunk(), which can be used to put for instance a header in a chunk
+///          of its own. A term is never divided over two chunks.
+///
+///          The stream starts with a header of eight bytes: a zero, the magic value and the version. Every
+///          chunk is preceded by its size as 64 bits integer, and the chunks are followed by the value
+///          2^64-1. Then the index follows, which contains the offset, size, number of terms and
+///          compression of every chunk. The stream ends with a footer of 24 bytes that consists of the
+///          offset of the index, the number of chunks and the magic value again. All integers are
+///          stored in little endian byte order.
+///
+///          The chunks can therefore be read sequentially from a stream that cannot be repositioned,
+///          and in any order by means of the index when the stream supports seeking.
+class chunked_aterm_ostream final : public aterm_ostream
+{
+public:
+  /// \brief The default size in bytes after which a chunk is finished.
+  static constexpr std::size_t default_chunk_size = 1 << 20;
+
+  /// \brief Provide the output stream to which the terms are written.
+  chunked_aterm_ostream(std::ostream& os, std::size_t chunk_size = default_chunk_size);
+
+  /// \brief Finishes the last chunk and writes the index.
+  ~chunked_aterm_ostream() override;
+
+  /// \brief Writes the term to the current chunk, and starts a new chunk when this one is full.
+  void put(const aterm& term) override;
+
+  /// \brief Finishes the current chunk, unless it is empty. The next term starts a new chunk.
+  void flush_chunk();
+
+private:
+  void write_integer(std::uint64_t value);
+
+  std::ostream& m_stream;
+  std::size_t m_chunk_size;
+
+  std::uint64_t m_position = 0; ///< The number of bytes written to m_stream.
+  std::vector<chunk_information> m_index;
+
+  std::ostringstream m_chunk_data;
+  std::unique_ptr<binary_aterm_ostream> m_chunk; ///< Writes the current chunk into m_chunk_data.
+  std::uint64_t m_chunk_terms = 0;
+};
+
+/// \brief Reads terms from a stream in the chunked binary aterm format.
+/// \details The terms can be read sequentially by get(), which does not require the stream to
+///          support seeking. Alternatively, index() yields the chunks in the stream, which can then
+///          be read in any order by read_chunk(). Reading chunks is thread safe, and decoding them
+///          happens in the calling thread such that chunks can be decoded in parallel.
+class chunked_aterm_istream final : public aterm_istream
+{
+public:
+  /// \brief Provide the input stream from which terms are read.
+  chunked_aterm_istream(std::istream& is);
+
+  void get(aterm& t) override;
+
+  /// \returns The index of the chunks in the stream.
+  /// \details The index is read from the end of the stream on the first call, which requires that the
+  ///          stream supports seeking. The position of sequential reading is not affected.
+  const std::vector<chunk_information>& index();
+
+  /// \brief Reads the terms of the given chunk, and stores them in result.
+  /// \details The terms are constructed by the calling thread, and should only be used by that thread.
+  void read_chunk(std::size_t chunk, std::vector<aterm>& result);
+
+  /// \returns The undecoded data of the given chunk.
+  std::string read_chunk_data(std::size_t chunk);
+
+  /// \brief The number of bytes at the start of a stream that identify the chunked aterm format.
+  static constexpr std::size_t identification_size = 3;
+
+  /// \returns True if the given stream starts with the header of the chunked aterm format.
+  /// \details The stream must support seeking, as its position is restored afterwards. For
+  ///          other streams false is returned, see peeked_istream for these streams.
+  static bool is_chunked(std::istream& is);
+
+  /// \returns True if the given first bytes of a stream identify the chunked aterm format.
+  static bool is_chunked(const std::string& first_bytes);
+
+  /// \brief Decodes the terms in the data of a single chunk and stores them in result.
+  static void decode_chunk(const std::string& data, std::vector<aterm>& result, aterm_transformer* transformer = identity);
+
+private:
+  std::uint64_t read_integer();
+
+  std::istream& m_stream;
+  std::mutex m_mutex; ///< Guards the repositioning of m_stream by read_chunk_data.
+
+  std::vector<chunk_information> m_index;
+  bool m_index_read = false;
+
+  bool m_end_of_chunks = false;
+  std::istringstream m_chunk_data;
+  std::unique_ptr<binary_aterm_istream> m_chunk; ///< Reads the current chunk from m_chunk_data.
+};
+
+/// \brief An input stream that reads the first bytes of another stream in advance.
+/// \details This determines the format of a stream that cannot be repositioned, such as standard input,
+///          without losing the inspected bytes. Reading from this stream yields these bytes followed by
+///          the remainder of the other stream, which should no longer be read directly.
+class peeked_istream final : public std::istream
+{
+public:
+  /// \brief Reads the given number of bytes of is in advance, or less when is ends before.
+  peeked_istream(std::istream& is, std::size_t size);
+
+  /// \returns The bytes that were read in advance.
+  const std::string& peeked() const
+  {
+    return m_peeked;
+  }
+
+private:
+  class buffer final : public std::streambuf
+  {
+  public:
+    buffer(std::streambuf* source, const std::string& peeked);
+
+  protected:
+    int_type underflow() override;
+
+  private:
+    std::streambuf* m_source;
+    std::vector<char> m_data;
+  };
+
+  std::string m_peeked;
+  std::unique_ptr<buffer> m_buffer;
+};
+
+} // namespace atermpp
+
+#endif // MCRL2_ATERMPP_ATERM_IO_CHUNKED_H
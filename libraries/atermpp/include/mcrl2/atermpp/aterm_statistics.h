@@ -0,0 +1,39 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef MCRL2_ATERMPP_ATERM_STATISTICS_H
+#define MCRL2_ATERMPP_ATERM_STATISTICS_H
+
+#include <iosfwd>
+#include <string>
+
+namespace atermpp
+{
+
+/// \brief Enables or disables the statistics of the term pool.
+/// \details The counters of the term pool are always maintained. Enabling the statistics additionally prints
+///          the garbage collection metrics to the log. The statistics are enabled initially when the environment
+///          variable MCRL2_ATERM_STATS is set, see print_aterm_statistics_at_exit.
+void enable_aterm_statistics(bool enable);
+
+/// \returns True iff the statistics of the term pool are enabled.
+bool aterm_statistics_enabled();
+
+/// \brief Writes the statistics of the term pool to the given stream as a JSON object.
+/// \details Blocks all other threads that use terms while the statistics are gathered.
+void print_aterm_statistics(std::ostream& os);
+
+/// \brief Enables the statistics of the term pool and writes them when the program exits.
+/// \param filename The file to which the statistics are written, or the standard error stream when it is
+///        empty or "-". This is the value of MCRL2_ATERM_STATS when that environment variable is set.
+void print_aterm_statistics_at_exit(const std::string& filename);
+
+} // namespace atermpp
+
+#endif // MCRL2_ATERMPP_ATERM_STATISTICS_H
@@ -21,9 +21,6 @@ constexpr static bool EnableGarbageCollection = true;
 /// \brief Enable the block allocator for terms.
 constexpr static bool EnableBlockAllocator = true;
 
-/// \brief Enable to print garbage collection statistics.
-constexpr static bool EnableGarbageCollectionMetrics = false;
-
 /// Performs garbage collection intensively for testing purposes.
 constexpr static bool EnableAggressiveGarbageCollection = false;
 
@@ -32,14 +29,7 @@ constexpr static bool EnableAggressiveGarbageCollection = false;
 ///          the thread safety of the term pool under concurrent GC pressure.
 constexpr static bool EnableGCStressThread = false;
 
-/// \brief Enable to print hashtable collision, size and number of buckets.
-constexpr static bool EnableHashtableMetrics = false;
-
-/// \brief Enable to obtain the percentage of terms found compared to allocated.
-constexpr static bool EnableCreationMetrics = false;
-
-/// \brief Keep track of the number of variables registered.
-constexpr static bool EnableVariableRegistrationMetrics = false;
+// The metrics of the term pool are enabled at run time, see atermpp::enable_aterm_statistics.
 
 } // namespace atermpp::detail
 
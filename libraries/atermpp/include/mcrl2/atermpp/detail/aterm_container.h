@@ -24,8 +24,6 @@
 namespace atermpp
 {
 
-using term_mark_stack = std::stack<std::reference_wrapper<detail::_aterm>>;
-
 inline void mark_term(const aterm_core& t, term_mark_stack& todo)
 {
   if (t.defined())
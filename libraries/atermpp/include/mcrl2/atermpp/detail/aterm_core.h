@@ -50,7 +50,10 @@ public:
   /// \brief Create a term from a function symbol.
   _aterm(const function_symbol& symbol) :
     m_function_symbol(symbol)
-  {}
+  {
+    // The symbol can be copied from a marked term during an incremental sweep, but a new term is not marked.
+    unmark();
+  }
 
   const function_symbol& function() const noexcept
   {
@@ -63,6 +66,13 @@ public:
     m_function_symbol.m_function_symbol.tag();
   }
 
+  /// \brief Mark this term unless it was marked already.
+  /// \returns True iff this call marked the term, which is decided atomically when threads are enabled.
+  bool try_mark() const
+  {
+    return m_function_symbol.m_function_symbol.try_tag();
+  }
+
   /// \brief Remove the mark from a term.
   void unmark() const
   {
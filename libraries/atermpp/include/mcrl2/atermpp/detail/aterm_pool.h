@@ -10,12 +10,16 @@
 #ifndef ATERMPP_DETAIL_ATERM_POOL_H
 #define ATERMPP_DETAIL_ATERM_POOL_H
 
+#include "mcrl2/atermpp/aterm_statistics.h"
+#include "mcrl2/atermpp/detail/aterm_pool_statistics.h"
 #include "mcrl2/atermpp/detail/aterm_pool_storage.h"
+#include "mcrl2/atermpp/detail/collection_threads.h"
 #include "mcrl2/atermpp/detail/function_symbol_pool.h"
 
 #include "mcrl2/utilities/shared_mutex.h"
 
 #include <atomic>
+#include <memory>
 
 
 namespace atermpp::detail
@@ -40,13 +44,18 @@ class aterm_pool;
 class thread_aterm_pool_interface final
 {
 public:
-  thread_aterm_pool_interface(aterm_pool& pool, std::function<void()> mark_function, std::function<void()> print_function, std::function<std::size_t()> protection_set_size_function);
+  thread_aterm_pool_interface(aterm_pool& pool,
+    std::function<void(term_mark_stack&, std::size_t, std::size_t)> mark_function,
+    std::function<void()> print_function,
+    std::function<std::size_t()> protection_set_size_function);
   ~thread_aterm_pool_interface();
 
   /// \brief Mark the terms created by this thread to prevent them being garbage collected.
-  void mark()
+  /// \details The roots are divided into the given number of parts, and only the roots in the given part
+  ///          are marked. Different parts can be marked concurrently using deferred stacks.
+  void mark(term_mark_stack& todo, std::size_t part = 0, std::size_t number_of_parts = 1)
   {
-    m_mark_function();
+    m_mark_function(todo, part, number_of_parts);
   }
 
   /// \brief Print performance statistics for data stored for this thread.
@@ -64,9 +73,14 @@ public:
   // Prematurely unregister the thread_aterm_pool_interface.
   void unregister();
 
+  /// \returns The counters of this thread, which should only be changed by this thread.
+  thread_statistics& statistics() { return m_statistics; }
+  const thread_statistics& statistics() const { return m_statistics; }
+
 private:
   aterm_pool& m_pool;
-  std::function<void()> m_mark_function;
+  thread_statistics m_statistics;
+  std::function<void(term_mark_stack&, std::size_t, std::size_t)> m_mark_function;
   std::function<void()> m_print_function;
   std::function<std::size_t()> m_protection_set_size_function;
   bool m_registered = true;
@@ -114,6 +128,10 @@ public:
   /// \brief Prints various performance statistics for the term pool.
   inline void print_performance_statistics() const;
 
+  /// \brief Writes the statistics of the term pool as a JSON object, see atermpp::print_aterm_statistics.
+  /// \details The caller must ensure that no other thread uses the pool, for instance by the exclusive lock.
+  inline void print_statistics(std::ostream& os) const;
+
   /// \returns A global term that indicates the empty list.
   aterm& empty_list() noexcept { return reinterpret_cast<aterm&>(m_empty_list); }  // TODO remove this reinterpret cast by letting m_empty_list become an aterm.
 
@@ -137,6 +155,17 @@ public:
 
   inline function_symbol_pool& get_symbol_pool() { return m_function_symbol_pool; }
 
+  /// \brief Sets the number of threads that perform garbage collection.
+  /// \details The default value 0 uses as many threads as there are threads that registered a
+  ///          thread_aterm_pool, but not more than the hardware supports.
+  inline void set_number_of_collection_threads(std::size_t number_of_threads) { m_number_of_collection_threads = number_of_threads; }
+
+  /// \brief Sweep incrementally when passing true, and sweep all terms during garbage collection otherwise.
+  /// \details With incremental sweeping the threads are only blocked to mark the reachable terms and to destroy
+  ///          the unreachable terms with a deletion hook. The other unreachable terms are destroyed in small
+  ///          steps that are interleaved with the creation of terms.
+  inline void enable_incremental_sweep(bool enable) { m_enable_incremental_sweep = enable; }
+
   // These functions of the aterm pool should be called through a thread_aterm_pool.
 private:
   /// \brief Force garbage collection on all storages.
@@ -153,6 +182,47 @@ private:
   /// \details threadsafe
   inline void collect_impl(mcrl2::utilities::shared_mutex& mutex);
 
+  /// \returns The number of threads that perform the next garbage collection.
+  inline std::size_t number_of_collection_threads() const;
+
+  /// \brief Marks the terms reachable from all thread pools with the given number of threads.
+  /// \details Every thread marks a part of the roots of every thread pool. The arguments of marked terms
+  ///          are pushed on the stack of the thread, and threads that run out of work take terms that
+  ///          were shared by the other threads.
+  inline void mark_parallel(std::size_t number_of_threads);
+
+  /// \brief Marks the arguments of the terms on the stack of the worker until the stack is empty.
+  inline void mark_pending(collection_worker& worker);
+
+  /// \brief Moves the terms shared by some worker to the stack of the worker with the given index.
+  /// \returns False iff all workers have run out of work, which ends the marking.
+  inline bool take_shared(std::size_t index, std::size_t number_of_threads);
+
+  /// \brief Destroys the terms that are not marked with the given number of threads.
+  /// \details The buckets of every storage are divided into ranges that are swept independently.
+  inline void sweep_parallel(std::size_t number_of_threads);
+
+  /// \brief Calls the deletion hooks of the unmarked terms and destroys these terms, such that the other
+  ///        unmarked terms can be swept incrementally.
+  inline void destroy_terms_with_deletion_hook(std::size_t number_of_threads);
+
+  /// \brief Collects the unmarked terms of the storage that have a deletion hook, with the given number of
+  ///        threads, and calls their hooks on this thread. The terms are not destroyed.
+  /// \returns The terms of which the hooks were called, in one part per thread.
+  template<typename Storage>
+  std::vector<std::vector<const _aterm*>> call_deletion_hooks(Storage& storage, std::size_t number_of_threads);
+
+  /// \brief Sweeps the next buckets of the incremental sweep, if there is one.
+  /// \details threadsafe
+  inline void sweep_increment(mcrl2::utilities::shared_mutex& mutex);
+
+  /// \brief Finishes the incremental sweep, if there is one. Requires the exclusive lock.
+  inline void finish_sweep();
+
+  /// \brief Applies f to every storage, in the order in which they are swept.
+  template<typename F>
+  void for_each_storage(F f);
+
   /// \brief Creates a integral term with the given value.
   inline bool create_int(aterm& term, std::size_t val);
 
@@ -222,10 +292,33 @@ private:
   /// Track the number of terms destroyed and reduce the freelist.
   std::atomic<long> m_count_until_collection = 0;
 
+  /// The statistics of the garbage collections, and the counters of the thread pools that were removed.
+  collection_statistics m_statistics;
+  thread_statistics m_removed_thread_statistics;
+  std::chrono::steady_clock::time_point m_creation_time = std::chrono::steady_clock::now();
+
+  /// A reusable todo stack for marking with a single thread.
+  term_mark_stack m_todo;
+
+  /// The threads and their state for parallel garbage collection.
+  collection_threads m_collection_threads;
+  std::vector<std::unique_ptr<collection_worker>> m_collection_workers;
+
+  /// The number of workers that are marking, and the number of workers that wait for shared terms.
+  std::atomic<std::size_t> m_busy_workers = 0;
+  std::atomic<std::size_t> m_idle_workers = 0;
+
+  std::atomic<std::size_t> m_number_of_collection_threads = 0; /// Zero means one thread per thread pool.
+
   std::atomic<bool> m_enable_garbage_collection = EnableGarbageCollection; /// Garbage collection is enabled.
 
   std::atomic<bool> m_enable_resize = true; /// Automatic hash table resizing is enabled.
 
+  std::atomic<bool> m_enable_incremental_sweep = false; /// Unreachable terms are destroyed incrementally.
+
+  std::atomic<bool> m_sweeping = false; /// An incremental sweep has not finished yet.
+  std::size_t m_sweep_increment = 0; /// The number of buckets that are swept per step of an incremental sweep.
+
   /// All the shared mutexes.
   mcrl2::utilities::shared_mutex m_shared_mutex;
 
@@ -234,7 +327,10 @@ private:
 };
 
 inline
-thread_aterm_pool_interface::thread_aterm_pool_interface(aterm_pool& pool, std::function<void()> mark_function, std::function<void()> print_function, std::function<std::size_t()> protection_set_size_function)
+thread_aterm_pool_interface::thread_aterm_pool_interface(aterm_pool& pool,
+  std::function<void(term_mark_stack&, std::size_t, std::size_t)> mark_function,
+  std::function<void()> print_function,
+  std::function<std::size_t()> protection_set_size_function)
   : m_pool(pool), m_mark_function(mark_function), m_print_function(print_function), m_protection_set_size_function(protection_set_size_function)
 {
   m_pool.register_thread_aterm_pool(*this);
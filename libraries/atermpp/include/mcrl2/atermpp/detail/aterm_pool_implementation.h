@@ -11,6 +11,8 @@
 #define MCRL2_ATERMPP_DETAIL_ATERM_POOL_IMPLEMENTATION_H
 
 #include <chrono>
+#include <cstdlib>
+#include <string>
 #include <thread>
 #include "aterm_pool.h"
 #include "aterm_pool_storage_implementation.h"   // For store_in_argument_array. 
@@ -39,6 +41,17 @@ aterm_pool::aterm_pool() :
     m_count_until_collection = 1;
   }
 
+  // The garbage collection can be configured by environment variables, see aterm_garbage_collection.h.
+  if (const char* value = std::getenv("MCRL2_ATERM_INCREMENTAL_SWEEP"))
+  {
+    m_enable_incremental_sweep = std::string(value) != "0";
+  }
+
+  if (const char* value = std::getenv("MCRL2_ATERM_COLLECTION_THREADS"))
+  {
+    m_number_of_collection_threads = std::strtoul(value, nullptr, 10);
+  }
+
   // Initialize the empty list.
   create_appl(reinterpret_cast<aterm&>(m_empty_list), m_function_symbol_pool.as_empty_list());
 }
@@ -106,6 +119,8 @@ void aterm_pool::remove_thread_aterm_pool(thread_aterm_pool_interface& pool)
   auto it = std::find(m_thread_pools.begin(), m_thread_pools.end(), &pool);
   if (it != m_thread_pools.end())
   {
+    m_removed_thread_statistics.add(pool.statistics());
+
     m_thread_pools.erase(it);  // This only removes the pointer, not the underlying data
                                // structure, which only disappears when the thread is removed. 
   }
@@ -132,6 +147,76 @@ void aterm_pool::print_performance_statistics() const
   }
 }
 
+void aterm_pool::print_statistics(std::ostream& os) const
+{
+  // Writes the counters of a thread as the members of a JSON object.
+  auto print_thread_statistics = [&os](const thread_statistics& statistics)
+  {
+    os << "\"created_terms\": " << statistics.created_terms.value()
+       << ", \"found_terms\": " << statistics.found_terms.value()
+       << ", \"function_symbols\": " << statistics.function_symbols.value()
+       << ", \"variable_insertions\": " << statistics.variable_insertions.value()
+       << ", \"container_insertions\": " << statistics.container_insertions.value();
+  };
+
+  thread_statistics total;
+  total.add(m_removed_thread_statistics);
+  for (const thread_aterm_pool_interface* pool : m_thread_pools)
+  {
+    total.add(pool->statistics());
+  }
+
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_creation_time).count();
+  os << "{\n  \"seconds\": " << seconds << ",\n";
+
+  os << "  \"terms\": {\"size\": " << size() << ", \"capacity\": " << capacity() << ", ";
+  print_thread_statistics(total);
+  os << ", \"created_terms_per_second\": " << (seconds > 0 ? static_cast<double>(total.created_terms.value()) / seconds : 0.0) << "},\n";
+
+  os << "  \"function_symbols\": {\"size\": " << m_function_symbol_pool.size() << ", \"capacity\": " << m_function_symbol_pool.capacity() << "},\n";
+
+  os << "  \"garbage_collection\": {\"collected_terms\": " << m_statistics.collected_terms
+     << ", \"resizes\": " << m_statistics.resizes << ",\n    \"pauses\": ";
+  m_statistics.pauses.print_json(os);
+  os << ",\n    \"mark_phases\": ";
+  m_statistics.mark_phases.print_json(os);
+  os << ",\n    \"sweep_steps\": ";
+  m_statistics.sweep_steps.print_json(os);
+  os << "},\n";
+
+  // The storages are listed by the arity of the terms that they contain.
+  os << "  \"storages\": [\n";
+  auto print_storage = [&os](const char* arity, const hashtable_statistics& statistics, bool last)
+  {
+    os << "    {\"arity\": \"" << arity << "\", ";
+    statistics.print_json_members(os);
+    os << (last ? "}\n" : "},\n");
+  };
+  print_storage("integer", m_int_storage.statistics(), false);
+  print_storage("0", std::get<0>(m_appl_storage).statistics(), false);
+  print_storage("1", std::get<1>(m_appl_storage).statistics(), false);
+  print_storage("2", std::get<2>(m_appl_storage).statistics(), false);
+  print_storage("3", std::get<3>(m_appl_storage).statistics(), false);
+  print_storage("4", std::get<4>(m_appl_storage).statistics(), false);
+  print_storage("5", std::get<5>(m_appl_storage).statistics(), false);
+  print_storage("6", std::get<6>(m_appl_storage).statistics(), false);
+  print_storage("7", std::get<7>(m_appl_storage).statistics(), false);
+  print_storage("8+", m_appl_dynamic_storage.statistics(), true);
+  os << "  ],\n";
+
+  // The threads that are still registered, followed by the threads that have been removed together.
+  os << "  \"threads\": [\n";
+  for (const thread_aterm_pool_interface* pool : m_thread_pools)
+  {
+    os << "    {\"protection_set_size\": " << pool->protection_set_size() << ", ";
+    print_thread_statistics(pool->statistics());
+    os << "},\n";
+  }
+  os << "    {\"removed_threads\": true, ";
+  print_thread_statistics(m_removed_thread_statistics);
+  os << "}\n  ]\n}\n";
+}
+
 std::size_t aterm_pool::capacity() const noexcept
 {
   // Determine the total number of terms in any storage.
@@ -179,6 +264,10 @@ void aterm_pool::created_term(mcrl2::utilities::shared_mutex& shared_mutex, long
         {
           collect_impl(shared_mutex);
         }
+        else if (m_sweeping)
+        {
+          sweep_increment(shared_mutex);
+        }
 
         if (m_enable_resize && resize_is_needed(shared_mutex))
         {
@@ -209,13 +298,26 @@ void aterm_pool::collect_impl(mcrl2::utilities::shared_mutex& shared_mutex)
       return;
     } 
 
+    const auto pause_start = std::chrono::steady_clock::now();
+
+    // The unreachable terms of the previous garbage collection must be destroyed before marking again.
+    finish_sweep();
+
     auto timestamp = std::chrono::system_clock::now();
     std::size_t old_size = size();
+    const std::size_t number_of_threads = number_of_collection_threads();
 
     // Mark the terms referenced by all thread pools.
-    for (const auto& pool : m_thread_pools)
+    if (number_of_threads > 1)
     {
-      pool->mark();
+      mark_parallel(number_of_threads);
+    }
+    else
+    {
+      for (const auto& pool : m_thread_pools)
+      {
+        pool->mark(m_todo);
+      }
     }
 
     assert(std::get<0>(m_appl_storage).verify_mark());
@@ -228,42 +330,79 @@ void aterm_pool::collect_impl(mcrl2::utilities::shared_mutex& shared_mutex)
     assert(std::get<7>(m_appl_storage).verify_mark());
     assert(m_appl_dynamic_storage.verify_mark());
 
+    m_statistics.mark_phases.add(std::chrono::steady_clock::now() - pause_start);
+
     // Keep track of the duration for marking and reset for sweep.
     auto mark_duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - timestamp).count();
     timestamp = std::chrono::system_clock::now();
     // Collect all terms that are not marked.
-    m_appl_dynamic_storage.sweep();
-    std::get<7>(m_appl_storage).sweep();
-    std::get<6>(m_appl_storage).sweep();
-    std::get<5>(m_appl_storage).sweep();
-    std::get<4>(m_appl_storage).sweep();
-    std::get<3>(m_appl_storage).sweep();
-    std::get<2>(m_appl_storage).sweep();
-    std::get<1>(m_appl_storage).sweep();
-    std::get<0>(m_appl_storage).sweep();
-    m_int_storage.sweep();
+    if (m_enable_incremental_sweep)
+    {
+      // The minimum number of buckets that are swept per step.
+      constexpr std::size_t minimum_sweep_increment = 1 << 14;
+
+      destroy_terms_with_deletion_hook(number_of_threads);
+
+      std::size_t buckets = 0;
+      for_each_storage([&buckets](auto& storage)
+        {
+          storage.start_incremental_sweep();
+          buckets += storage.bucket_count();
+        });
+
+      // Sweep all buckets in about 64 steps.
+      m_sweep_increment = std::max(minimum_sweep_increment, buckets / 64);
+      m_sweeping = true;
+    }
+    else if (number_of_threads > 1)
+    {
+      sweep_parallel(number_of_threads);
+    }
+    else
+    {
+      for_each_storage([](auto& storage) { storage.sweep(); });
+    }
 
     // Check that after sweeping the terms are consistent.
-    assert(m_int_storage.verify_sweep());
-    assert(std::get<0>(m_appl_storage).verify_sweep());
-    assert(std::get<1>(m_appl_storage).verify_sweep());
-    assert(std::get<2>(m_appl_storage).verify_sweep());
-    assert(std::get<3>(m_appl_storage).verify_sweep());
-    assert(std::get<4>(m_appl_storage).verify_sweep());
-    assert(std::get<5>(m_appl_storage).verify_sweep());
-    assert(std::get<6>(m_appl_storage).verify_sweep());
-    assert(std::get<7>(m_appl_storage).verify_sweep());
-    assert(m_appl_dynamic_storage.verify_sweep());
+    assert(m_sweeping || m_int_storage.verify_sweep());
+    assert(m_sweeping || std::get<0>(m_appl_storage).verify_sweep());
+    assert(m_sweeping || std::get<1>(m_appl_storage).verify_sweep());
+    assert(m_sweeping || std::get<2>(m_appl_storage).verify_sweep());
+    assert(m_sweeping || std::get<3>(m_appl_storage).verify_sweep());
+    assert(m_sweeping || std::get<4>(m_appl_storage).verify_sweep());
+    assert(m_sweeping || std::get<5>(m_appl_storage).verify_sweep());
+    assert(m_sweeping || std::get<6>(m_appl_storage).verify_sweep());
+    assert(m_sweeping || std::get<7>(m_appl_storage).verify_sweep());
+    assert(m_sweeping || m_appl_dynamic_storage.verify_sweep());
+
+    m_statistics.collected_terms += old_size - size();
 
     // Print some statistics.
-    if (EnableGarbageCollectionMetrics)
+    if (aterm_statistics_enabled())
     {
       // Update the times
       auto sweep_duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - timestamp).count();
 
       // Print the relevant information.
       mCRL2log(mcrl2::log::info) << "g_term_pool(): Garbage collected " << old_size - size() << " terms, " << size() << " terms remaining in "
-        << mark_duration + sweep_duration << " ms (marking " << mark_duration << " ms + sweep " << sweep_duration << " ms).\n";
+        << mark_duration + sweep_duration << " ms (marking " << mark_duration << " ms + sweep " << sweep_duration << " ms) using "
+        << number_of_threads << " thread(s).\n";
+
+      if (m_sweeping)
+      {
+        mCRL2log(mcrl2::log::info) << "g_term_pool(): The other unreachable terms are swept incrementally in steps of "
+          << m_sweep_increment << " buckets.\n";
+      }
+      else if (number_of_threads > 1)
+      {
+        for (std::size_t i = 0; i < number_of_threads; ++i)
+        {
+          const collection_worker& worker = *m_collection_workers[i];
+          mCRL2log(mcrl2::log::info) << "g_term_pool(): Thread " << i << " marked " << worker.marked << " terms in "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(worker.mark_duration).count() << " ms and swept "
+            << worker.swept << " terms in " << std::chrono::duration_cast<std::chrono::milliseconds>(worker.sweep_duration).count() << " ms.\n";
+        }
+      }
     }
 
     // Garbage collect function symbols.
@@ -278,7 +417,340 @@ void aterm_pool::collect_impl(mcrl2::utilities::shared_mutex& shared_mutex)
     {
       m_count_until_collection = 1;
     }
+
+    m_statistics.pauses.add(std::chrono::steady_clock::now() - pause_start);
+  }
+}
+
+std::size_t aterm_pool::number_of_collection_threads() const
+{
+  if constexpr (mcrl2::utilities::detail::GlobalThreadSafe)
+  {
+    if (m_number_of_collection_threads > 0)
+    {
+      return m_number_of_collection_threads;
+    }
+
+    // The registered threads are blocked during garbage collection, so use as many threads instead.
+    return std::max<std::size_t>(1, std::min<std::size_t>(m_thread_pools.size(), std::thread::hardware_concurrency()));
+  }
+  else
+  {
+    return 1;
+  }
+}
+
+void aterm_pool::mark_parallel(std::size_t number_of_threads)
+{
+  // The number of pending terms after which the roots are interrupted to mark their subterms.
+  constexpr std::size_t pending_terms_limit = 1 << 16;
+
+  while (m_collection_workers.size() < number_of_threads)
+  {
+    m_collection_workers.push_back(std::make_unique<collection_worker>());
+    collection_worker& worker = *m_collection_workers.back();
+    worker.todo = term_mark_stack([this, &worker](term_mark_stack&) { mark_pending(worker); }, pending_terms_limit);
+  }
+
+  m_busy_workers = number_of_threads;
+  m_idle_workers = 0;
+
+  m_collection_threads.run(number_of_threads, [this, number_of_threads](std::size_t index)
+    {
+      collection_worker& worker = *m_collection_workers[index];
+      auto timestamp = std::chrono::steady_clock::now();
+      worker.marked = 0;
+
+      // Push the roots in the part of every thread pool that belongs to this thread.
+      for (const auto& pool : m_thread_pools)
+      {
+        pool->mark(worker.todo, index, number_of_threads);
+      }
+
+      do
+      {
+        mark_pending(worker);
+      }
+      while (take_shared(index, number_of_threads));
+
+      worker.mark_duration = std::chrono::steady_clock::now() - timestamp;
+    });
+}
+
+void aterm_pool::mark_pending(collection_worker& worker)
+{
+  while (!worker.todo.empty())
+  {
+    _aterm& term = worker.todo.top();
+    worker.todo.pop();
+    ++worker.marked;
+
+    const std::size_t arity = term.function().arity();
+    _term_appl& term_appl = static_cast<_term_appl&>(term);
+
+    for (std::size_t i = 0; i < arity; ++i)
+    {
+      // Only the thread that actually marks an argument pushes it.
+      _aterm& argument = *detail::address(term_appl.arg(i));
+      if (!argument.is_marked() && argument.try_mark())
+      {
+        worker.todo.emplace(argument);
+      }
+    }
+
+    // Share the oldest half of the pending terms, which are closest to the roots, when other workers are idle.
+    if (m_idle_workers.load(std::memory_order_relaxed) > 0
+        && worker.todo.size() > 1
+        && !worker.has_shared.load(std::memory_order_relaxed))
+    {
+      std::lock_guard<std::mutex> guard(worker.mutex);
+      for (std::size_t i = worker.todo.size() / 2; i > 0; --i)
+      {
+        worker.shared.push_back(&worker.todo.pop_bottom());
+      }
+      worker.has_shared = true;
+    }
+  }
+}
+
+bool aterm_pool::take_shared(std::size_t index, std::size_t number_of_threads)
+{
+  collection_worker& worker = *m_collection_workers[index];
+
+  // Moves the shared terms of the other worker to the stack of this worker, if there are any.
+  auto take = [&worker](collection_worker& other)
+  {
+    std::lock_guard<std::mutex> guard(other.mutex);
+    for (_aterm* term : other.shared)
+    {
+      worker.todo.emplace(*term);
+    }
+
+    bool result = !other.shared.empty();
+    other.shared.clear();
+    other.has_shared = false;
+    return result;
+  };
+
+  // The terms shared by this worker cannot be taken by another worker after it becomes idle, since
+  // only busy workers share terms. So all work is done when no worker is busy anymore.
+  if (take(worker))
+  {
+    return true;
+  }
+
+  --m_busy_workers;
+  ++m_idle_workers;
+
+  while (true)
+  {
+    for (std::size_t i = 1; i < number_of_threads; ++i)
+    {
+      collection_worker& other = *m_collection_workers[(index + i) % number_of_threads];
+      if (other.has_shared.load(std::memory_order_relaxed))
+      {
+        // Become busy before taking the terms, such that the other workers cannot terminate in between.
+        ++m_busy_workers;
+        if (take(other))
+        {
+          --m_idle_workers;
+          return true;
+        }
+        --m_busy_workers;
+      }
+    }
+
+    if (m_busy_workers == 0)
+    {
+      --m_idle_workers;
+      return false;
+    }
+
+    std::this_thread::yield();
+  }
+}
+
+void aterm_pool::sweep_parallel(std::size_t number_of_threads)
+{
+  // The minimum number of buckets that are swept at once.
+  constexpr std::size_t minimum_range_size = 1 << 12;
+
+  for (std::size_t i = 0; i < number_of_threads; ++i)
+  {
+    m_collection_workers[i]->swept = 0;
+    m_collection_workers[i]->sweep_duration = {};
+  }
+
+  // Executes the tasks with the given number of threads, where every thread takes the next task when it is done.
+  auto run_tasks = [&](const auto& tasks)
+  {
+    std::atomic<std::size_t> next_task = 0;
+    m_collection_threads.run(number_of_threads, [&](std::size_t index)
+      {
+        collection_worker& worker = *m_collection_workers[index];
+        auto timestamp = std::chrono::steady_clock::now();
+
+        for (std::size_t i = next_task++; i < tasks.size(); i = next_task++)
+        {
+          worker.swept += tasks[i]();
+        }
+
+        worker.sweep_duration += std::chrono::steady_clock::now() - timestamp;
+      });
+  };
+
+  // Call the deletion hooks while all terms, including the arguments of the unreachable terms, still exist.
+  for_each_storage([&](auto& storage)
+    {
+      if (storage.has_deletion_hooks())
+      {
+        call_deletion_hooks(storage, number_of_threads);
+      }
+    });
+
+  // Divide the buckets of all storages into ranges, with several ranges per thread for load balancing.
+  std::vector<std::function<std::size_t()>> sweep_tasks;
+  for_each_storage([&](auto& storage)
+    {
+      const std::size_t buckets = storage.bucket_count();
+      const std::size_t range_size = std::max(minimum_range_size, buckets / (8 * number_of_threads));
+      for (std::size_t first = 0; first < buckets; first += range_size)
+      {
+        sweep_tasks.emplace_back([&storage, first, last = std::min(first + range_size, buckets)]() { return storage.sweep(first, last); });
+      }
+    });
+  run_tasks(sweep_tasks);
+
+  // The allocator of each storage can only be consolidated when all its buckets have been swept.
+  std::vector<std::function<std::size_t()>> consolidate_tasks;
+  for_each_storage([&](auto& storage)
+    {
+      consolidate_tasks.emplace_back([&storage]() { storage.consolidate(); return std::size_t(0); });
+    });
+  run_tasks(consolidate_tasks);
+}
+
+template<typename Storage>
+std::vector<std::vector<const _aterm*>> aterm_pool::call_deletion_hooks(Storage& storage, std::size_t number_of_threads)
+{
+  std::vector<std::vector<const _aterm*>> terms(number_of_threads);
+  const std::size_t buckets = storage.bucket_count();
+  if (number_of_threads > 1)
+  {
+    m_collection_threads.run(number_of_threads, [&](std::size_t index)
+      {
+        storage.unmarked_terms_with_deletion_hook(buckets * index / number_of_threads, buckets * (index + 1) / number_of_threads, terms[index]);
+      });
   }
+  else
+  {
+    storage.unmarked_terms_with_deletion_hook(0, buckets, terms[0]);
+  }
+
+  // The hooks of all terms are called before any term is destroyed, as the terms can be arguments of each other.
+  for (const std::vector<const _aterm*>& part : terms)
+  {
+    storage.call_deletion_hooks(part);
+  }
+  return terms;
+}
+
+void aterm_pool::destroy_terms_with_deletion_hook(std::size_t number_of_threads)
+{
+  for_each_storage([&](auto& storage)
+    {
+      if (storage.has_deletion_hooks())
+      {
+        for (const std::vector<const _aterm*>& part : call_deletion_hooks(storage, number_of_threads))
+        {
+          storage.destroy(part);
+        }
+      }
+    });
+}
+
+void aterm_pool::sweep_increment(mcrl2::utilities::shared_mutex& shared_mutex)
+{
+  mcrl2::utilities::lock_guard guard(shared_mutex, std::try_to_lock);
+  if (!guard.owns_lock())
+  {
+    // Another process owns the exclusive lock. Block until it is done by acquiring (and immediately
+    // releasing) a shared lock.
+    mcrl2::utilities::shared_guard shared(shared_mutex);
+    return;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  const std::size_t old_size = size();
+
+  std::size_t remaining = m_sweep_increment;
+  bool finished = true;
+  for_each_storage([&](auto& storage)
+    {
+      remaining -= storage.sweep_increment(remaining);
+      finished = finished && !storage.is_sweeping();
+    });
+
+  m_statistics.collected_terms += old_size - size();
+  m_statistics.sweep_steps.add(std::chrono::steady_clock::now() - start);
+
+  if (finished)
+  {
+    finish_sweep();
+  }
+}
+
+void aterm_pool::finish_sweep()
+{
+  if (!m_sweeping)
+  {
+    return;
+  }
+
+  const std::size_t old_size = size();
+  for_each_storage([](auto& storage) { storage.sweep_increment(storage.bucket_count()); });
+  m_sweeping = false;
+  m_statistics.collected_terms += old_size - size();
+
+  assert(m_int_storage.verify_sweep());
+  assert(std::get<0>(m_appl_storage).verify_sweep());
+  assert(std::get<1>(m_appl_storage).verify_sweep());
+  assert(std::get<2>(m_appl_storage).verify_sweep());
+  assert(std::get<3>(m_appl_storage).verify_sweep());
+  assert(std::get<4>(m_appl_storage).verify_sweep());
+  assert(std::get<5>(m_appl_storage).verify_sweep());
+  assert(std::get<6>(m_appl_storage).verify_sweep());
+  assert(std::get<7>(m_appl_storage).verify_sweep());
+  assert(m_appl_dynamic_storage.verify_sweep());
+
+  if (aterm_statistics_enabled())
+  {
+    mCRL2log(mcrl2::log::info) << "g_term_pool(): Finished the incremental sweep, " << size() << " terms remaining.\n";
+  }
+
+  // The function symbols of the destroyed terms can now be collected.
+  m_function_symbol_pool.sweep();
+
+  // The heuristic of collect_impl, which can now take the destroyed terms into account.
+  if constexpr (!EnableAggressiveGarbageCollection)
+  {
+    m_count_until_collection = static_cast<long>(size() + protection_set_size());
+  }
+}
+
+template<typename F>
+void aterm_pool::for_each_storage(F f)
+{
+  f(m_appl_dynamic_storage);
+  f(std::get<7>(m_appl_storage));
+  f(std::get<6>(m_appl_storage));
+  f(std::get<5>(m_appl_storage));
+  f(std::get<4>(m_appl_storage));
+  f(std::get<3>(m_appl_storage));
+  f(std::get<2>(m_appl_storage));
+  f(std::get<1>(m_appl_storage));
+  f(std::get<0>(m_appl_storage));
+  f(m_int_storage);
 }
 
 function_symbol aterm_pool::create_function_symbol(const std::string& name, const std::size_t arity, const bool check_for_registered_functions)
@@ -405,6 +877,9 @@ void aterm_pool::resize_if_needed(mcrl2::utilities::shared_mutex& mutex)
     return;
   } 
 
+  // The incremental sweep relies on the positions of the terms in the hash tables.
+  finish_sweep();
+
   const std::chrono::time_point<std::chrono::system_clock> timestamp = std::chrono::system_clock::now();
   std::size_t old_capacity = capacity();
   std::size_t old_symbols_capacity = m_function_symbol_pool.capacity();
@@ -426,7 +901,12 @@ void aterm_pool::resize_if_needed(mcrl2::utilities::shared_mutex& mutex)
   // Attempt to resize ever so often.
   // m_count_until_check_resize = 10000;
 
-  if (EnableGarbageCollectionMetrics && (old_capacity != capacity() || old_symbols_capacity != m_function_symbol_pool.capacity()))
+  if (old_capacity != capacity() || old_symbols_capacity != m_function_symbol_pool.capacity())
+  {
+    ++m_statistics.resizes;
+  }
+
+  if (aterm_statistics_enabled() && (old_capacity != capacity() || old_symbols_capacity != m_function_symbol_pool.capacity()))
   {
     // Only print if a resize actually took place.
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - timestamp).count();
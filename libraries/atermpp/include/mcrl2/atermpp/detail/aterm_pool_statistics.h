@@ -0,0 +1,159 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef MCRL2_ATERMPP_DETAIL_ATERM_POOL_STATISTICS_H
+#define MCRL2_ATERMPP_DETAIL_ATERM_POOL_STATISTICS_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+
+namespace atermpp::detail
+{
+
+/// \brief A counter that is only incremented by a single thread, but can be read by any thread.
+/// \details The increment is a relaxed load and store instead of an atomic read-modify-write, such that
+///          it is as cheap as incrementing an ordinary integer.
+class thread_counter
+{
+public:
+  void increment() noexcept { m_value.store(m_value.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+
+  void add(std::size_t value) noexcept { m_value.store(m_value.load(std::memory_order_relaxed) + value, std::memory_order_relaxed); }
+
+  std::size_t value() const noexcept { return m_value.load(std::memory_order_relaxed); }
+
+private:
+  std::atomic<std::size_t> m_value = 0;
+};
+
+/// \brief The counters of a single thread_aterm_pool.
+struct thread_statistics
+{
+  thread_counter created_terms;        ///< The number of terms that were added to the pool.
+  thread_counter found_terms;          ///< The number of terms that were already in the pool.
+  thread_counter function_symbols;     ///< The number of function symbols that were created or found.
+  thread_counter variable_insertions;  ///< The number of variables that were added to the root set.
+  thread_counter container_insertions; ///< The number of containers that were added to the root set.
+
+  /// \brief Adds the counters of other to these counters, which are only changed by the calling thread.
+  void add(const thread_statistics& other)
+  {
+    created_terms.add(other.created_terms.value());
+    found_terms.add(other.found_terms.value());
+    function_symbols.add(other.function_symbols.value());
+    variable_insertions.add(other.variable_insertions.value());
+    container_insertions.add(other.container_insertions.value());
+  }
+};
+
+/// \brief A histogram of durations, where bucket i counts the durations below 2^i microseconds that are
+///        not counted by bucket i - 1.
+class duration_histogram
+{
+public:
+  using duration = std::chrono::steady_clock::duration;
+
+  void add(duration d)
+  {
+    const auto microseconds = static_cast<std::size_t>(std::chrono::duration_cast<std::chrono::microseconds>(d).count());
+    std::size_t bucket = 0;
+    while (bucket + 1 < m_counts.size() && (std::size_t(1) << bucket) <= microseconds)
+    {
+      ++bucket;
+    }
+
+    ++m_counts[bucket];
+    ++m_count;
+    m_total += d;
+    m_maximum = std::max(m_maximum, d);
+  }
+
+  std::size_t count() const { return m_count; }
+
+  duration total() const { return m_total; }
+
+  /// \brief Writes the histogram as a JSON object, which only lists the buckets that are not empty.
+  void print_json(std::ostream& os) const
+  {
+    os << "{\"count\": " << m_count
+       << ", \"total_ms\": " << std::chrono::duration<double, std::milli>(m_total).count()
+       << ", \"maximum_ms\": " << std::chrono::duration<double, std::milli>(m_maximum).count()
+       << ", \"buckets\": [";
+
+    bool first = true;
+    for (std::size_t i = 0; i < m_counts.size(); ++i)
+    {
+      if (m_counts[i] > 0)
+      {
+        os << (first ? "" : ", ") << "{\"below_us\": " << (std::size_t(1) << i) << ", \"count\": " << m_counts[i] << "}";
+        first = false;
+      }
+    }
+    os << "]}";
+  }
+
+private:
+  std::array<std::size_t, 40> m_counts{};
+  std::size_t m_count = 0;
+  duration m_total{};
+  duration m_maximum{};
+};
+
+/// \brief The statistics of the garbage collections, which are only changed under the exclusive lock.
+struct collection_statistics
+{
+  std::size_t collected_terms = 0;  ///< The number of terms destroyed during the pauses.
+  std::size_t resizes = 0;          ///< The number of times that the hash tables were resized.
+  duration_histogram pauses;        ///< The durations for which the other threads were blocked by a collection.
+  duration_histogram mark_phases;   ///< The durations of the marking phases.
+  duration_histogram sweep_steps;   ///< The durations of the steps of incremental sweeps.
+};
+
+/// \brief The distribution of the elements of a hash table over its buckets.
+struct hashtable_statistics
+{
+  std::size_t size = 0;
+  std::size_t buckets = 0;
+  std::size_t used_buckets = 0;   ///< The number of buckets that contain at least one element.
+  std::size_t longest_bucket = 0;
+  std::size_t probes = 0;         ///< The sum over all elements of their position in their bucket, starting at one.
+
+  template<typename UnorderedSet>
+  explicit hashtable_statistics(const UnorderedSet& set)
+    : size(set.size()),
+      buckets(set.bucket_count())
+  {
+    for (std::size_t i = 0; i < buckets; ++i)
+    {
+      const std::size_t length = set.bucket_size(i);
+      used_buckets += length > 0 ? 1 : 0;
+      longest_bucket = std::max(longest_bucket, length);
+      probes += length * (length + 1) / 2;
+    }
+  }
+
+  /// \brief Writes the statistics as the members of a JSON object, without the enclosing braces.
+  void print_json_members(std::ostream& os) const
+  {
+    os << "\"size\": " << size
+       << ", \"buckets\": " << buckets
+       << ", \"load_factor\": " << (buckets == 0 ? 0.0 : static_cast<double>(size) / static_cast<double>(buckets))
+       << ", \"used_buckets\": " << used_buckets
+       << ", \"longest_bucket\": " << longest_bucket
+       << ", \"average_probe_length\": " << (size == 0 ? 0.0 : static_cast<double>(probes) / static_cast<double>(size));
+  }
+};
+
+} // namespace atermpp::detail
+
+#endif // MCRL2_ATERMPP_DETAIL_ATERM_POOL_STATISTICS_H
@@ -11,11 +11,13 @@
 #define ATERMPP_DETAIL_ATERM_POOL_STORAGE_H
 
 #include "mcrl2/atermpp/detail/aterm_hash.h"
-#include "mcrl2/utilities/cache_metric.h"
+#include "mcrl2/atermpp/detail/aterm_pool_statistics.h"
 #include "mcrl2/utilities/unordered_set.h"
 
+#include <functional>
 #include <stack>
 #include <utility>
+#include <vector>
 
 namespace atermpp
 {
@@ -24,6 +26,50 @@ using term_callback = void (*)(const aterm&);
 
 extern void add_deletion_hook(const function_symbol&, term_callback);
 
+/// \brief The stack of terms of which the arguments still have to be marked during garbage collection.
+/// \details The parallel garbage collector constructs a stack with a process function. For such a stack
+///          mark_term only marks the given root and pushes it, and the process function is called to mark
+///          the subterms whenever more than the given limit of terms is pending. This allows the subterms
+///          of the roots to be divided over several threads.
+class term_mark_stack : public std::stack<std::reference_wrapper<detail::_aterm>>
+{
+public:
+  term_mark_stack() = default;
+
+  term_mark_stack(std::function<void(term_mark_stack&)> process, std::size_t limit)
+    : m_process(std::move(process)),
+      m_limit(limit)
+  {}
+
+  /// \returns True iff mark_term only marks and pushes the roots on this stack.
+  bool is_deferred() const
+  {
+    return m_process != nullptr;
+  }
+
+  /// \brief Pushes a root that has just been marked, and processes the stack when it has become too large.
+  void push_root(detail::_aterm& term)
+  {
+    emplace(term);
+    if (size() > m_limit)
+    {
+      m_process(*this);
+    }
+  }
+
+  /// \brief Removes the term at the bottom of the stack, which is the term that was pushed first.
+  detail::_aterm& pop_bottom()
+  {
+    detail::_aterm& term = c.front();
+    c.pop_front();
+    return term;
+  }
+
+private:
+  std::function<void(term_mark_stack&)> m_process;
+  std::size_t m_limit = 0;
+};
+
 namespace detail
 {
 
@@ -31,7 +77,8 @@ namespace detail
 class aterm_pool;
 
 /// \brief Marks a term and recursively all arguments that are not reachable.
-inline void mark_term(const _aterm& root, std::stack<std::reference_wrapper<_aterm>>& todo);
+/// \details For a deferred stack only the term itself is marked and pushed, see term_mark_stack.
+inline void mark_term(const _aterm& root, term_mark_stack& todo);
 
 /// \brief This class provides for all types of term storage. It also
 ///       provides garbage collection via its mark and sweep functions.
@@ -145,6 +192,43 @@ public:
   ///        mark() was called first.
   void sweep();
 
+  /// \returns The number of buckets of the hash table, which sweep(first, last) divides into ranges.
+  std::size_t bucket_count() const { return m_term_set.bucket_count(); }
+
+  /// \returns True iff a deletion hook was added to this storage.
+  bool has_deletion_hooks() const { return !m_deletion_hooks.empty(); }
+
+  /// \brief Adds the terms in the buckets [first, last) that are not marked and have a deletion hook to result.
+  /// \details Disjoint ranges can be processed concurrently.
+  void unmarked_terms_with_deletion_hook(std::size_t first, std::size_t last, std::vector<const _aterm*>& result) const;
+
+  /// \brief Calls the deletion hooks of the given terms, which are not destroyed yet.
+  void call_deletion_hooks(const std::vector<const _aterm*>& terms);
+
+  /// \brief Destroys the terms in the buckets [first, last) that are not marked, and removes the mark of the others.
+  /// \details The deletion hooks of the destroyed terms must have been called before. Disjoint ranges can be
+  ///          swept concurrently.
+  /// \returns The number of destroyed terms.
+  std::size_t sweep(std::size_t first, std::size_t last);
+
+  /// \brief Frees the blocks of the allocator that no longer contain terms, which is done after sweeping.
+  void consolidate();
+
+  /// \brief Starts to sweep the buckets in steps of sweep_increment(), in between which terms can be created.
+  /// \details The unmarked terms with a deletion hook must have been destroyed already, see destroy().
+  ///          Terms that are found or created in the buckets that have not been swept yet are marked.
+  void start_incremental_sweep();
+
+  /// \brief Sweeps at most the given number of buckets of the incremental sweep.
+  /// \returns The number of buckets that were swept, which is zero once the sweep has finished.
+  std::size_t sweep_increment(std::size_t number_of_buckets);
+
+  /// \returns True iff an incremental sweep has been started and has not finished yet.
+  bool is_sweeping() const { return m_sweeping; }
+
+  /// \brief Destroys the given terms, which must not be marked.
+  void destroy(const std::vector<const _aterm*>& terms);
+
   /// \brief Check whether resizing the hash table is needed. 
   bool resize_is_needed() const;
 
@@ -154,6 +238,9 @@ public:
   /// \returns The number of terms stored in this storage.
   std::size_t size() const { return m_term_set.size(); }
 
+  /// \returns The distribution of the terms over the buckets of the hash table.
+  hashtable_statistics statistics() const { return hashtable_statistics(m_term_set); }
+
   /// \brief A fake copy constructor to fix the issues with GCC 4 and 5.
   aterm_pool_storage(const aterm_pool_storage& other) :
     m_pool(other.m_pool),
@@ -173,9 +260,6 @@ private:
   /// \threadsafe
   void call_deletion_hook(unprotected_aterm_core term);
 
-  /// \brief Removes an element from the unordered set and deallocates it.
-  iterator destroy(iterator it);
-
   /// \brief Inserts a term constructed by the given arguments, checks for existing term.
   template<typename ...Args>
   bool emplace(aterm_core& term, Args&&... args);
@@ -203,8 +287,11 @@ private:
 
   // Various performance statistics.
 
-  mcrl2::utilities::cache_metric m_term_metric; ///< Count the number of times a term has been found in or is added to the set.
   std::size_t m_erasedBlocks = 0; /// The number of blocks that have been erased in the block allocator.
+
+  // The state of an incremental sweep, which only changes while all other threads are blocked.
+  bool m_sweeping = false;
+  std::size_t m_sweep_position = 0; ///< The buckets before this position have been swept.
 };
 
 } // namespace detail
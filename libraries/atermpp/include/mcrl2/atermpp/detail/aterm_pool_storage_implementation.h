@@ -70,9 +70,17 @@ construct_arguments(InputIterator it, [[maybe_unused]] InputIterator end, TermCo
   return arguments;
 }
 
-void mark_term(const _aterm& root, std::stack<std::reference_wrapper<_aterm>>& todo)
+void mark_term(const _aterm& root, term_mark_stack& todo)
 {
-  if (!root.is_marked())
+  if (todo.is_deferred())
+  {
+    // Another thread can mark the same root concurrently, and only one of them pushes it.
+    if (!root.is_marked() && root.try_mark())
+    {
+      todo.push_root(const_cast<_aterm&>(root));
+    }
+  }
+  else if (!root.is_marked())
   {
     // Mark root before pushing. If root also appears as a subterm of another root processed
     // later in the same marking pass, the is_marked() check below will prevent it from being
@@ -288,44 +296,91 @@ bool ATERM_POOL_STORAGE::create_appl_dynamic(aterm& term,
 ATERM_POOL_STORAGE_TEMPLATES
 void ATERM_POOL_STORAGE::print_performance_stats(const char* identifier) const
 {
-  if (EnableHashtableMetrics)
+  if (!aterm_statistics_enabled())
   {
-    mCRL2log(mcrl2::log::info) << "g_term_pool(" << identifier << ") hashtable:\n";
-    print_performance_statistics(m_term_set);
+    return;
   }
 
-  if (EnableGarbageCollectionMetrics && m_erasedBlocks > 0)
+  if (mcrl2::log::mCRL2logEnabled(mcrl2::log::debug))
   {
-    mCRL2log(mcrl2::log::info) << "g_term_pool(" << identifier << "): Consolidate removed " << m_erasedBlocks << " blocks.\n";
+    // Only determine the bucket lengths when they are printed, as this visits the whole table.
+    mCRL2log(mcrl2::log::debug) << "g_term_pool(" << identifier << ") hashtable:\n";
+    print_performance_statistics(m_term_set);
   }
 
-  if (EnableCreationMetrics)
+  if (m_erasedBlocks > 0)
   {
-    mCRL2log(mcrl2::log::info) << "g_term_pool(" << identifier << "): emplace() " << m_term_metric.message() << ".\n";
+    mCRL2log(mcrl2::log::info) << "g_term_pool(" << identifier << "): Consolidate removed " << m_erasedBlocks << " blocks.\n";
   }
 }
 
 ATERM_POOL_STORAGE_TEMPLATES
 void ATERM_POOL_STORAGE::sweep()
 {
-  // Iterate over all terms and remove the ones that are not marked (unreachable).
-  for (auto it = m_term_set.begin(); it != m_term_set.end(); )
+  // Call the deletion hooks while all terms, including the arguments of unreachable terms, still exist.
+  if (has_deletion_hooks())
   {
-    const Element& term = *it;
+    std::vector<const _aterm*> terms;
+    unmarked_terms_with_deletion_hook(0, bucket_count(), terms);
+    call_deletion_hooks(terms);
+  }
 
-    if (!term.is_marked())
-    {
-      // For constants, i.e., arity zero and integer terms we do not mark, but use their reachability directly. 
-      it = destroy(it);
-    }
-    else
+  sweep(0, bucket_count());
+  consolidate();
+}
+
+ATERM_POOL_STORAGE_TEMPLATES
+void ATERM_POOL_STORAGE::unmarked_terms_with_deletion_hook(std::size_t first, std::size_t last, std::vector<const _aterm*>& result) const
+{
+  for (std::size_t i = first; i < last; ++i)
+  {
+    for (auto it = m_term_set.begin(i); it != m_term_set.end(i); ++it)
     {
-      // Reset terms that have been marked.
-      term.unmark();
-      ++it;
+      const Element& term = *it;
+      if (!term.is_marked())
+      {
+        for (const auto& hook : m_deletion_hooks)
+        {
+          if (hook.first == term.function())
+          {
+            result.push_back(&term);
+            break;
+          }
+        }
+      }
     }
   }
+}
+
+ATERM_POOL_STORAGE_TEMPLATES
+void ATERM_POOL_STORAGE::call_deletion_hooks(const std::vector<const _aterm*>& terms)
+{
+  for (const _aterm* term : terms)
+  {
+    call_deletion_hook(term);
+  }
+}
+
+ATERM_POOL_STORAGE_TEMPLATES
+std::size_t ATERM_POOL_STORAGE::sweep(std::size_t first, std::size_t last)
+{
+  // Remove the terms that are not marked (unreachable) in the given buckets.
+  return m_term_set.erase_if(first, last, [](const Element& term)
+    {
+      if (term.is_marked())
+      {
+        // Reset terms that have been marked.
+        term.unmark();
+        return false;
+      }
 
+      return true;
+    });
+}
+
+ATERM_POOL_STORAGE_TEMPLATES
+void ATERM_POOL_STORAGE::consolidate()
+{
   if constexpr (EnableBlockAllocator)
   {
     // Clean up unnecessary blocks.
@@ -333,6 +388,45 @@ void ATERM_POOL_STORAGE::sweep()
   }
 }
 
+ATERM_POOL_STORAGE_TEMPLATES
+void ATERM_POOL_STORAGE::start_incremental_sweep()
+{
+  m_sweeping = true;
+  m_sweep_position = 0;
+}
+
+ATERM_POOL_STORAGE_TEMPLATES
+std::size_t ATERM_POOL_STORAGE::sweep_increment(std::size_t number_of_buckets)
+{
+  if (!m_sweeping)
+  {
+    return 0;
+  }
+
+  const std::size_t first = m_sweep_position;
+  const std::size_t last = std::min(first + number_of_buckets, bucket_count());
+  sweep(first, last);
+  m_sweep_position = last;
+
+  if (last == bucket_count())
+  {
+    m_sweeping = false;
+    consolidate();
+  }
+  return last - first;
+}
+
+ATERM_POOL_STORAGE_TEMPLATES
+void ATERM_POOL_STORAGE::destroy(const std::vector<const _aterm*>& terms)
+{
+  for (const _aterm* term : terms)
+  {
+    assert(!term->is_marked());
+    const std::size_t bucket = m_term_set.bucket(static_cast<const Element&>(*term));
+    m_term_set.erase_if(bucket, bucket + 1, [term](const Element& element) { return &element == term; });
+  }
+}
+
 ATERM_POOL_STORAGE_TEMPLATES
 bool ATERM_POOL_STORAGE::resize_is_needed() const
 {
@@ -393,19 +487,6 @@ bool ATERM_POOL_STORAGE::verify_sweep()
 
 /// Private definitions
 
-ATERM_POOL_STORAGE_TEMPLATES
-typename ATERM_POOL_STORAGE::iterator ATERM_POOL_STORAGE::destroy(iterator it)
-{
-  // Store the term temporarily to be able to deallocate it after removing it from the set.
-  const Element& term = *it;
-
-  // Trigger the deletion hook before the term is actually destroyed.
-  call_deletion_hook(&term);
-
-  // Remove them from the hash table, will also destroy terms with fixed arity.
-  return m_term_set.erase(it);
-}
-
 ATERM_POOL_STORAGE_TEMPLATES
 template<typename ...Args>
 bool ATERM_POOL_STORAGE::emplace(aterm_core& term, Args&&... args)
@@ -413,14 +494,11 @@ bool ATERM_POOL_STORAGE::emplace(aterm_core& term, Args&&... args)
   auto [it, added] = m_term_set.emplace(std::forward<Args>(args)...);
   new (&term) atermpp::unprotected_aterm_core(&*it); 
 
-  if (added)
-  {
-    if (EnableCreationMetrics) { m_term_metric.miss(); }
-  }
-  else if (EnableCreationMetrics)
+  if (m_sweeping && m_term_set.bucket(*it) >= m_sweep_position)
   {
-    // A term was already found in the set.
-    m_term_metric.hit();
+    // The incremental sweep has not reached this term yet, so it is marked to survive. An unreachable term
+    // that is found again is revived this way, which is safe as its arguments are held by the caller.
+    it->mark();
   }
 
   return added;
@@ -0,0 +1,82 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef MCRL2_ATERMPP_DETAIL_COLLECTION_THREADS_H
+#define MCRL2_ATERMPP_DETAIL_COLLECTION_THREADS_H
+
+#include "mcrl2/atermpp/detail/aterm_pool_storage.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace atermpp::detail
+{
+
+/// \brief The state of a thread that takes part in a parallel garbage collection.
+/// \details The terms on the todo stack are private to the thread. When other threads run out of work,
+///          part of them is moved to the shared terms, which can be taken by any thread.
+struct alignas(64) collection_worker
+{
+  term_mark_stack todo;
+
+  std::mutex mutex;                    ///< Guards the shared terms.
+  std::vector<_aterm*> shared;         ///< Marked terms of which the arguments still have to be marked.
+  std::atomic<bool> has_shared{false}; ///< Equal to !shared.empty(), but can be read without the mutex.
+
+  // Statistics of the last garbage collection.
+  std::size_t marked = 0;
+  std::size_t swept = 0;
+  std::chrono::steady_clock::duration mark_duration{};
+  std::chrono::steady_clock::duration sweep_duration{};
+};
+
+/// \brief A fixed set of threads that perform the garbage collection together with the collecting thread.
+/// \details The threads are started on the first call of run() and wait for the next collection in
+///          between. They never create or protect terms, and therefore do not have a thread_aterm_pool,
+///          which means that they are not blocked by the collecting thread.
+class collection_threads
+{
+public:
+  collection_threads() = default;
+  collection_threads(const collection_threads&) = delete;
+  collection_threads& operator=(const collection_threads&) = delete;
+
+  /// \brief Stops and joins the threads.
+  ~collection_threads();
+
+  /// \brief Calls f(i) for every i in [0, n) concurrently, and returns when all of these calls have finished.
+  /// \details The call f(0) is made by the calling thread itself.
+  void run(std::size_t n, const std::function<void(std::size_t)>& f);
+
+private:
+  /// \brief The function executed by the thread with the given index, which waits for the tasks
+  ///        after the given generation.
+  void loop(std::size_t index, std::size_t generation);
+
+  std::vector<std::thread> m_threads;
+
+  std::mutex m_mutex;
+  std::condition_variable m_start;    ///< Signalled when a new task is available.
+  std::condition_variable m_finished; ///< Signalled when the last thread finished the task.
+
+  const std::function<void(std::size_t)>* m_task = nullptr;
+  std::size_t m_number_of_participants = 0; ///< The threads with index below this value execute the task.
+  std::size_t m_generation = 0;             ///< Incremented for every task.
+  std::size_t m_pending = 0;                ///< The number of threads that did not finish the task yet.
+  bool m_stop = false;
+};
+
+} // namespace atermpp::detail
+
+#endif // MCRL2_ATERMPP_DETAIL_COLLECTION_THREADS_H
@@ -11,7 +11,6 @@
 #define DETAIL_FUNCTION_SYMBOL_POOL_H
 
 #include "mcrl2/atermpp/detail/function_symbol_hash.h"
-#include "mcrl2/utilities/cache_metric.h"
 #include "mcrl2/utilities/unordered_set.h"
 #include "mcrl2/utilities/mutex.h"
 
@@ -99,9 +98,6 @@ private:
   function_symbol m_as_list;
   function_symbol m_as_empty_list;
 
-  // Various performance metrics.
-  mcrl2::utilities::cache_metric m_function_symbol_metrics; ///< Track the number of function symbols found in or added to the set.
-
   // Create helper function. 
   void create_helper(const std::string& name);
 };
@@ -41,7 +41,7 @@ public:
         m_containers(new mcrl2::utilities::hashtable<detail::aterm_container*>()),
         m_thread_interface(
             global_pool,
-            [this] { mark(); },
+            [this](term_mark_stack& todo, std::size_t part, std::size_t number_of_parts) { mark(todo, part, number_of_parts); },
             [this] { print_local_performance_statistics(); },
             [this] { return protection_set_size(); })
   {
@@ -145,7 +145,7 @@ public:
       mcrl2::utilities::hashtable<aterm_container*>& containers);
 
   // Implementation of thread_aterm_pool_interface
-  inline void mark();
+  inline void mark(term_mark_stack& todo, std::size_t part, std::size_t number_of_parts);
   inline void print_local_performance_statistics() const;
   inline std::size_t protection_set_size() const;
 
@@ -168,6 +168,9 @@ public:
   inline void resize() { m_pool.resize_if_needed(m_shared_mutex); }
 
 private:
+  /// \brief Updates the counters of this thread, and triggers garbage collection and resizing when a term was added.
+  inline void created_term(bool added);
+
   aterm_pool& m_pool;
 
   /// Keeps track of pointers to all existing aterm variables and containers.
@@ -175,9 +178,6 @@ private:
   mcrl2::utilities::hashtable<aterm_core*>* m_variables;
   mcrl2::utilities::hashtable<detail::aterm_container*>* m_containers;
 
-  std::size_t m_variable_insertions = 0;
-  std::size_t m_container_insertions = 0;
-  std::stack<std::reference_wrapper<_aterm>> m_todo; ///< A reusable todo stack.
 
   long m_count_until_check; // Counter used to check whether the data structures need a resize or recollect
                             // to avoid checking too often, and incrementing global counters too frequently.
@@ -22,6 +22,7 @@ namespace atermpp::detail
 
 function_symbol thread_aterm_pool::create_function_symbol(std::string&& name, const std::size_t arity, const bool check_for_registered_functions)
 {
+  m_thread_interface.statistics().function_symbols.increment();
   mcrl2::utilities::shared_guard guard(m_shared_mutex);
   function_symbol symbol = m_pool.create_function_symbol(std::move(name), arity, check_for_registered_functions);
   return symbol;
@@ -33,13 +34,26 @@ function_symbol thread_aterm_pool::create_function_symbol(const std::string& nam
   return create_function_symbol(std::move(name_copy), arity, check_for_registered_functions);
 }
 
+void thread_aterm_pool::created_term(bool added)
+{
+  if (added)
+  {
+    m_thread_interface.statistics().created_terms.increment();
+    m_pool.created_term(m_shared_mutex, m_count_until_check);
+  }
+  else
+  {
+    m_thread_interface.statistics().found_terms.increment();
+  }
+}
+
 void thread_aterm_pool::create_int(aterm& term, size_t val)
 {
   mcrl2::utilities::shared_guard guard(m_shared_mutex);
   bool added = m_pool.create_int(term, val);
   guard.unlock();
    
-  if (added) { m_pool.created_term(m_shared_mutex, m_count_until_check); }
+  created_term(added);
 }
 
 void thread_aterm_pool::create_term(aterm& term, const atermpp::function_symbol& sym)
@@ -48,7 +62,7 @@ void thread_aterm_pool::create_term(aterm& term, const atermpp::function_symbol&
   bool added = m_pool.create_term(term, sym);
   guard.unlock();
 
-  if (added) { m_pool.created_term(m_shared_mutex, m_count_until_check); }
+  created_term(added);
 }
 
 template<class ...Terms>
@@ -58,7 +72,7 @@ void thread_aterm_pool::create_appl(aterm& term, const function_symbol& sym, con
   bool added = m_pool.create_appl(term, sym, arguments...);
   guard.unlock();
 
-  if (added) { m_pool.created_term(m_shared_mutex, m_count_until_check); }
+  created_term(added);
 }
 
 template<class Term, class INDEX_TYPE, class ...Terms>
@@ -94,7 +108,7 @@ void thread_aterm_pool::create_appl_index(aterm& term, const function_symbol& sy
   }
   guard.unlock();
 
-  if (added) { m_pool.created_term(m_shared_mutex, m_count_until_check); }
+  created_term(added);
 }
 
 template<typename InputIterator>
@@ -107,7 +121,7 @@ void thread_aterm_pool::create_appl_dynamic(aterm& term,
   bool added = m_pool.create_appl_dynamic(term, sym, begin, end);
   guard.unlock();
     
-  if (added) { m_pool.created_term(m_shared_mutex, m_count_until_check); }
+  created_term(added);
 }
 
 template<typename InputIterator, typename ATermConverter>
@@ -121,12 +135,12 @@ void thread_aterm_pool::create_appl_dynamic(aterm& term,
   bool added = m_pool.create_appl_dynamic(term, sym, convert_to_aterm, begin, end);
   guard.unlock();
 
-  if (added) { m_pool.created_term(m_shared_mutex, m_count_until_check); }
+  created_term(added);
 }
 
 void thread_aterm_pool::register_variable(aterm_core* variable)
 {
-  if constexpr (EnableVariableRegistrationMetrics) { ++m_variable_insertions; }
+  m_thread_interface.statistics().variable_insertions.increment();
 
   mcrl2::utilities::shared_guard guard(m_shared_mutex);
       
@@ -151,7 +165,7 @@ void thread_aterm_pool::deregister_variable(aterm_core* variable)
 
 void thread_aterm_pool::register_container(aterm_container* container)
 {
-  if constexpr (EnableVariableRegistrationMetrics) { ++m_container_insertions; }
+  m_thread_interface.statistics().container_insertions.increment();
 
   mcrl2::utilities::shared_guard guard(m_shared_mutex);
   if (m_containers->must_resize())
@@ -202,10 +216,15 @@ void thread_aterm_pool::absorb(mcrl2::utilities::hashtable<aterm_core*>& variabl
   }
 }
 
-void thread_aterm_pool::mark()
+void thread_aterm_pool::mark(term_mark_stack& todo, std::size_t part, std::size_t number_of_parts)
 {
-  for (const aterm_core* variable : *m_variables) 
+  // Only consider the given part of the hash tables, such that the parts can be marked concurrently.
+  auto first = [=](auto& table) { return table.begin() + (table.end() - table.begin()) * part / number_of_parts; };
+  auto last = [=](auto& table) { return table.begin() + (table.end() - table.begin()) * (part + 1) / number_of_parts; };
+
+  for (auto it = first(*m_variables); it != last(*m_variables); ++it)
   {
+    const aterm_core* variable = *it;
     if (variable != nullptr)
     {
       // Mark all terms (and their subterms) that are reachable, i.e the root set.
@@ -213,27 +232,29 @@ void thread_aterm_pool::mark()
       if (term != nullptr && !term->is_marked()) 
       {
         // This variable is not a default term and that term has not been marked.
-        mark_term(*term, m_todo);
+        mark_term(*term, todo);
       }
     }
   }
 
-  for (const aterm_container* container : *m_containers)
+  for (auto it = first(*m_containers); it != last(*m_containers); ++it)
   {
+    const aterm_container* container = *it;
     if (container != nullptr)
     {
       // The container marks the contained terms itself.
-      container->mark(m_todo);
+      container->mark(todo);
     }
   }
 }
 
 void thread_aterm_pool::print_local_performance_statistics() const
 {
-  if constexpr (EnableVariableRegistrationMetrics)
+  if (aterm_statistics_enabled())
   {
-    mCRL2log(mcrl2::log::info) << "thread_aterm_pool: " << m_variables->size() << " variables in root set (" << m_variable_insertions << " total insertions)"
-                               << " and " << m_containers->size() << " containers in root set (" << m_container_insertions << " total insertions).\n";
+    const thread_statistics& statistics = m_thread_interface.statistics();
+    mCRL2log(mcrl2::log::info) << "thread_aterm_pool: " << m_variables->size() << " variables in root set (" << statistics.variable_insertions.value() << " total insertions)"
+                               << " and " << m_containers->size() << " containers in root set (" << statistics.container_insertions.value() << " total insertions).\n";
   }
 }
 
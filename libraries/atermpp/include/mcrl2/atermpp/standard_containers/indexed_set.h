@@ -77,6 +77,20 @@ public:
     m_set.clear(thread_index);
   }
 
+  /// \brief Allocates the indexed set for at most capacity elements, after which it never grows.
+  /// \details Inserting and looking up keys is lock free afterwards, see mcrl2::utilities::indexed_set.
+  void set_fixed_capacity(std::size_t capacity, std::size_t thread_index = 0)
+  {
+    mcrl2::utilities::shared_guard guard = detail::g_thread_term_pool().lock_shared();
+    m_set.set_fixed_capacity(capacity, thread_index);
+  }
+
+  /// \returns The maximal number of elements of the set, or zero if the set can grow arbitrarily.
+  [[nodiscard]] std::size_t fixed_capacity() const
+  {
+    return m_set.fixed_capacity();
+  }
+
   /// \brief Insert a key in the indexed set and return its index.
   /// \returns The index of the key and whether the element was newly inserted.
   [[nodiscard]] std::pair<size_type, bool> insert(const Key& key, std::size_t thread_index=0)
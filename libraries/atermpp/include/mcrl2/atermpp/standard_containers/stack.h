@@ -154,7 +154,7 @@ public:
     using std::swap; swap(m_container, other.m_container);
   }
 
-  void mark(std::stack<std::reference_wrapper<detail::_aterm>>& todo) const
+  void mark(term_mark_stack& todo) const
   {
     m_container.mark(todo);
   }
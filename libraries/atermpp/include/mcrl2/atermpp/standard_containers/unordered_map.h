@@ -427,6 +427,13 @@ class unordered_map
       return m_container.size();
     }
 
+    /// \brief Number of elements that can be stored before rehash.
+    /// \details Nonstandard.
+    size_type capacity()
+    {
+      return m_container.capacity();
+    }
+
     /// \returns An iterator over all keys.
     iterator begin();
     iterator end();
@@ -0,0 +1,21 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "mcrl2/atermpp/aterm_garbage_collection.h"
+#include "mcrl2/atermpp/detail/global_aterm_pool.h"
+
+void atermpp::enable_incremental_sweep(bool enable)
+{
+  detail::g_term_pool().enable_incremental_sweep(enable);
+}
+
+void atermpp::set_number_of_collection_threads(std::size_t number_of_threads)
+{
+  detail::g_term_pool().set_number_of_collection_threads(number_of_threads);
+}
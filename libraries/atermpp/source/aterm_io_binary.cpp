@@ -86,7 +86,7 @@ struct write_todo
    : term(term)
   {}
 
-  void mark(std::stack<std::reference_wrapper<detail::_aterm>>& todo) const
+  void mark(term_mark_stack& todo) const
   {
     term.mark(todo);
   }
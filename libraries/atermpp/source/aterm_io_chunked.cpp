@@ -0,0 +1,344 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "mcrl2/atermpp/aterm_io_chunked.h"
+#include "mcrl2/utilities/logger.h"
+
+#include <limits>
+
+namespace atermpp
+{
+
+/// \brief The magic value for a chunked binary aterm format stream.
+/// \details It differs from the magic value of the binary aterm format, such that reading a chunked stream
+///          as a binary aterm stream (and vice versa) results in a clear error.
+static constexpr std::uint16_t CHUNKED_MAGIC = 0x8bac;
+
+/// \brief The version of the chunked binary aterm format. The version of the binary aterm format of the
+///        chunks themselves is checked when a chunk is decoded.
+///
+/// \details History:
+///
+/// 17 October 2026   : version 0x0001 (introduction of the chunked aterm format)
+static constexpr std::uint16_t CHUNKED_VERSION = 0x0001;
+
+/// \brief The value that is written instead of a chunk size after the last chunk.
+static constexpr std::uint64_t end_of_chunks = std::numeric_limits<std::uint64_t>::max();
+
+/// \brief The number of bytes of the header and the footer.
+static constexpr std::size_t header_size = 8;
+static constexpr std::size_t footer_size = 24;
+
+chunked_aterm_ostream::chunked_aterm_ostream(std::ostream& os, std::size_t chunk_size)
+  : m_stream(os),
+    m_chunk_size(chunk_size)
+{
+  // Write the header, the first byte is zero as for the binary aterm format.
+  const std::uint8_t header[header_size] = { 0, CHUNKED_MAGIC >> 8, CHUNKED_MAGIC & 0xff, CHUNKED_VERSION >> 8, CHUNKED_VERSION & 0xff, 0, 0, 0 };
+  m_stream.write(reinterpret_cast<const char*>(header), header_size);
+  m_position = header_size;
+}
+
+chunked_aterm_ostream::~chunked_aterm_ostream()
+{
+  flush_chunk();
+  write_integer(end_of_chunks);
+
+  // Write the index followed by the footer.
+  std::uint64_t index_offset = m_position;
+  for (const chunk_information& chunk: m_index)
+  {
+    write_integer(chunk.offset);
+    write_integer(chunk.size);
+    write_integer(chunk.number_of_terms);
+    write_integer(static_cast<std::uint64_t>(chunk.compression));
+  }
+
+  write_integer(index_offset);
+  write_integer(m_index.size());
+  write_integer(CHUNKED_MAGIC);
+
+  m_stream.flush();
+  if (m_stream.fail())
+  {
+    mCRL2log(mcrl2::log::error) << "Failed to write the index of the chunked aterm format to the output file/stream.\n";
+  }
+}
+
+void chunked_aterm_ostream::put(const aterm& term)
+{
+  if (m_chunk == nullptr)
+  {
+    m_chunk = std::make_unique<binary_aterm_ostream>(m_chunk_data);
+  }
+
+  m_chunk->set_transformer(m_transformer);
+  m_chunk->put(term);
+  ++m_chunk_terms;
+
+  // The bit stream buffers a few bytes, so the chunk can be slightly larger than the chunk size.
+  if (static_cast<std::size_t>(m_chunk_data.tellp()) >= m_chunk_size)
+  {
+    flush_chunk();
+  }
+}
+
+void chunked_aterm_ostream::flush_chunk()
+{
+  if (m_chunk == nullptr)
+  {
+    return;
+  }
+
+  // Destroying the binary stream writes its end of stream marker and flushes the remaining bits.
+  m_chunk.reset();
+  std::string data = m_chunk_data.str();
+  m_chunk_data.str(std::string());
+
+  write_integer(data.size());
+  m_index.push_back(chunk_information{m_position, data.size(), m_chunk_terms, chunk_compression::none});
+  m_chunk_terms = 0;
+
+  m_stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+  m_position += data.size();
+}
+
+void chunked_aterm_ostream::write_integer(std::uint64_t value)
+{
+  char buffer[sizeof(std::uint64_t)]; // NOLINT(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+  for (char& byte: buffer)
+  {
+    byte = static_cast<char>(value & 0xff);
+    value >>= 8;
+  }
+
+  m_stream.write(buffer, sizeof(std::uint64_t));
+  m_position += sizeof(std::uint64_t);
+}
+
+chunked_aterm_istream::chunked_aterm_istream(std::istream& is)
+  : m_stream(is)
+{
+  std::uint8_t header[header_size]; // NOLINT(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+  m_stream.read(reinterpret_cast<char*>(header), header_size);
+  if (!m_stream || header[0] != 0 || ((header[1] << 8) | header[2]) != CHUNKED_MAGIC)
+  {
+    throw mcrl2::runtime_error("Error while reading: missing the control sequence of the chunked aterm format.");
+  }
+
+  std::size_t version = (header[3] << 8) | header[4];
+  if (version != CHUNKED_VERSION)
+  {
+    throw mcrl2::runtime_error("The chunked aterm format version (" + std::to_string(version) + ") of the input file is incompatible with the version (" +
+                               std::to_string(CHUNKED_VERSION) + ") of this tool. The input file must be regenerated. ");
+  }
+}
+
+bool chunked_aterm_istream::is_chunked(std::istream& is)
+{
+  std::istream::pos_type position = is.tellg();
+  if (position == std::istream::pos_type(-1))
+  {
+    return false;
+  }
+
+  std::string first_bytes(identification_size, '\0');
+  is.read(first_bytes.data(), identification_size);
+  first_bytes.resize(is.gcount());
+  bool result = is_chunked(first_bytes);
+
+  is.clear();
+  is.seekg(position);
+  return result;
+}
+
+bool chunked_aterm_istream::is_chunked(const std::string& first_bytes)
+{
+  return first_bytes.size() >= identification_size
+      && static_cast<std::uint8_t>(first_bytes[0]) == 0
+      && ((static_cast<std::uint8_t>(first_bytes[1]) << 8) | static_cast<std::uint8_t>(first_bytes[2])) == CHUNKED_MAGIC;
+}
+
+void chunked_aterm_istream::get(aterm& t)
+{
+  while (true)
+  {
+    if (m_chunk != nullptr)
+    {
+      m_chunk->set_transformer(m_transformer);
+      m_chunk->get(t);
+      if (t.defined())
+      {
+        return;
+      }
+
+      // The end of this chunk has been reached, continue with the next one.
+      m_chunk.reset();
+    }
+
+    if (m_end_of_chunks)
+    {
+      t = aterm();
+      return;
+    }
+
+    std::uint64_t size = read_integer();
+    if (size == end_of_chunks)
+    {
+      m_end_of_chunks = true;
+      continue;
+    }
+
+    std::string data(size, '\0');
+    m_stream.read(data.data(), static_cast<std::streamsize>(size));
+    if (!m_stream)
+    {
+      throw mcrl2::runtime_error("Error while reading: the chunked aterm stream ended within a chunk.");
+    }
+
+    m_chunk_data.str(std::move(data));
+    m_chunk_data.clear();
+    m_chunk = std::make_unique<binary_aterm_istream>(m_chunk_data);
+  }
+}
+
+const std::vector<chunk_information>& chunked_aterm_istream::index()
+{
+  std::lock_guard<std::mutex> guard(m_mutex);
+  if (m_index_read)
+  {
+    return m_index;
+  }
+
+  std::istream::pos_type position = m_stream.tellg();
+  m_stream.seekg(-static_cast<std::istream::off_type>(footer_size), std::ios_base::end);
+  if (!m_stream)
+  {
+    throw mcrl2::runtime_error("Error while reading: the index of a chunked aterm stream can only be read from a seekable stream.");
+  }
+
+  std::uint64_t index_offset = read_integer();
+  std::uint64_t number_of_chunks = read_integer();
+  if (read_integer() != CHUNKED_MAGIC)
+  {
+    throw mcrl2::runtime_error("Error while reading: the chunked aterm stream does not end with an index.");
+  }
+
+  m_stream.seekg(static_cast<std::istream::off_type>(index_offset));
+  m_index.resize(number_of_chunks);
+  for (chunk_information& chunk: m_index)
+  {
+    chunk.offset = read_integer();
+    chunk.size = read_integer();
+    chunk.number_of_terms = read_integer();
+
+    std::uint64_t compression = read_integer();
+    if (compression != static_cast<std::uint64_t>(chunk_compression::none))
+    {
+      throw mcrl2::runtime_error("Error while reading: chunk compression " + std::to_string(compression) + " is not supported by this tool.");
+    }
+    chunk.compression = static_cast<chunk_compression>(compression);
+  }
+
+  m_stream.seekg(position);
+  m_index_read = true;
+  return m_index;
+}
+
+std::string chunked_aterm_istream::read_chunk_data(std::size_t chunk)
+{
+  const chunk_information& information = index().at(chunk);
+  std::string data(information.size, '\0');
+
+  std::lock_guard<std::mutex> guard(m_mutex);
+  std::istream::pos_type position = m_stream.tellg();
+  m_stream.seekg(static_cast<std::istream::off_type>(information.offset));
+  m_stream.read(data.data(), static_cast<std::streamsize>(information.size));
+  if (!m_stream)
+  {
+    throw mcrl2::runtime_error("Error while reading: chunk " + std::to_string(chunk) + " of the chunked aterm stream is incomplete.");
+  }
+  m_stream.seekg(position);
+
+  return data;
+}
+
+void chunked_aterm_istream::read_chunk(std::size_t chunk, std::vector<aterm>& result)
+{
+  decode_chunk(read_chunk_data(chunk), result, m_transformer);
+}
+
+void chunked_aterm_istream::decode_chunk(const std::string& data, std::vector<aterm>& result, aterm_transformer* transformer)
+{
+  std::istringstream stream(data);
+  binary_aterm_istream input(stream);
+  input.set_transformer(transformer);
+
+  result.clear();
+  aterm t;
+  for (input.get(t); t.defined(); input.get(t))
+  {
+    result.push_back(t);
+  }
+}
+
+std::uint64_t chunked_aterm_istream::read_integer()
+{
+  std::uint8_t buffer[sizeof(std::uint64_t)]; // NOLINT(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+  m_stream.read(reinterpret_cast<char*>(buffer), sizeof(std::uint64_t));
+  if (!m_stream)
+  {
+    throw mcrl2::runtime_error("Error while reading: unexpected end of the chunked aterm stream.");
+  }
+
+  std::uint64_t value = 0;
+  for (std::size_t i = sizeof(std::uint64_t); i > 0; --i)
+  {
+    value = (value << 8) | buffer[i - 1];
+  }
+  return value;
+}
+
+peeked_istream::peeked_istream(std::istream& is, std::size_t size)
+  : std::istream(nullptr),
+    m_peeked(size, '\0')
+{
+  is.read(m_peeked.data(), static_cast<std::streamsize>(size));
+  m_peeked.resize(is.gcount());
+  m_buffer = std::make_unique<buffer>(is.rdbuf(), m_peeked);
+  rdbuf(m_buffer.get());
+}
+
+peeked_istream::buffer::buffer(std::streambuf* source, const std::string& peeked)
+  : m_source(source),
+    m_data(peeked.begin(), peeked.end())
+{
+  setg(m_data.data(), m_data.data(), m_data.data() + m_data.size());
+}
+
+peeked_istream::buffer::int_type peeked_istream::buffer::underflow()
+{
+  if (gptr() < egptr())
+  {
+    return traits_type::to_int_type(*gptr());
+  }
+
+  // The bytes read in advance have been consumed, continue with the source in blocks of 64 KiB.
+  m_data.resize(1 << 16);
+  std::streamsize count = m_source->sgetn(m_data.data(), static_cast<std::streamsize>(m_data.size()));
+  if (count <= 0)
+  {
+    return traits_type::eof();
+  }
+
+  setg(m_data.data(), m_data.data(), m_data.data() + count);
+  return traits_type::to_int_type(*gptr());
+}
+
+} // namespace atermpp
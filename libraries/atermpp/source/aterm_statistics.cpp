@@ -0,0 +1,93 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "mcrl2/atermpp/aterm_statistics.h"
+#include "mcrl2/atermpp/detail/global_aterm_pool.h"
+#include "mcrl2/atermpp/detail/thread_aterm_pool.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+using namespace atermpp;
+
+/// \brief The environment variable that enables the statistics, of which the value is the output file.
+static constexpr const char* statistics_variable = "MCRL2_ATERM_STATS";
+
+static std::atomic<bool>& statistics_enabled()
+{
+  static std::atomic<bool> enabled(std::getenv(statistics_variable) != nullptr);
+  return enabled;
+}
+
+static std::string& statistics_filename()
+{
+  static std::string filename;
+  return filename;
+}
+
+static void print_statistics_at_exit()
+{
+  // The global term pool is never destroyed, and the thread pool of the main thread has already been
+  // removed and its counters added to the pool. So the pool is accessed without a thread pool.
+  const std::string& filename = statistics_filename();
+  if (filename.empty() || filename == "-")
+  {
+    detail::g_term_pool<true>().print_statistics(std::cerr);
+    return;
+  }
+
+  std::ofstream file(filename);
+  if (!file)
+  {
+    std::cerr << "Could not open file " << filename << " to write the term pool statistics.\n";
+    return;
+  }
+  detail::g_term_pool<true>().print_statistics(file);
+}
+
+/// \brief Registers the printing of the statistics when the environment variable is set.
+static const bool statistics_variable_registered = []()
+{
+  if (const char* filename = std::getenv(statistics_variable))
+  {
+    print_aterm_statistics_at_exit(filename);
+  }
+  return true;
+}();
+
+void atermpp::enable_aterm_statistics(bool enable)
+{
+  statistics_enabled() = enable;
+}
+
+bool atermpp::aterm_statistics_enabled()
+{
+  return statistics_enabled().load(std::memory_order_relaxed);
+}
+
+void atermpp::print_aterm_statistics(std::ostream& os)
+{
+  mcrl2::utilities::lock_guard guard = detail::g_thread_term_pool().lock();
+  detail::g_term_pool().print_statistics(os);
+}
+
+void atermpp::print_aterm_statistics_at_exit(const std::string& filename)
+{
+  static bool registered = false;
+
+  enable_aterm_statistics(true);
+  statistics_filename() = filename;
+  if (!registered)
+  {
+    registered = true;
+    std::atexit(print_statistics_at_exit);
+  }
+}
@@ -0,0 +1,88 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "mcrl2/atermpp/detail/collection_threads.h"
+
+namespace atermpp::detail
+{
+
+collection_threads::~collection_threads()
+{
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_stop = true;
+  }
+  m_start.notify_all();
+
+  for (std::thread& thread : m_threads)
+  {
+    thread.join();
+  }
+}
+
+void collection_threads::run(std::size_t n, const std::function<void(std::size_t)>& f)
+{
+  if (n <= 1)
+  {
+    f(0);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+
+    // Start the missing threads, which take part from the current generation onwards.
+    while (m_threads.size() + 1 < n)
+    {
+      const std::size_t index = m_threads.size() + 1;
+      m_threads.emplace_back([this, index, generation = m_generation] { loop(index, generation); });
+    }
+
+    m_task = &f;
+    m_number_of_participants = n;
+    m_pending = n - 1;
+    ++m_generation;
+  }
+  m_start.notify_all();
+
+  f(0);
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_finished.wait(lock, [this] { return m_pending == 0; });
+  m_task = nullptr;
+}
+
+void collection_threads::loop(std::size_t index, std::size_t generation)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true)
+  {
+    m_start.wait(lock, [&] { return m_stop || m_generation != generation; });
+    if (m_stop)
+    {
+      return;
+    }
+
+    generation = m_generation;
+    if (index < m_number_of_participants)
+    {
+      const std::function<void(std::size_t)>& task = *m_task;
+      lock.unlock();
+      task(index);
+      lock.lock();
+
+      if (--m_pending == 0)
+      {
+        m_finished.notify_one();
+      }
+    }
+  }
+}
+
+} // namespace atermpp::detail
@@ -8,6 +8,7 @@
 //
 
 #include "mcrl2/atermpp/detail/function_symbol_pool.h"
+#include "mcrl2/atermpp/aterm_statistics.h"
 
 #include <chrono>
 
@@ -63,15 +64,11 @@ function_symbol function_symbol_pool::create(std::string&& name, const std::size
   auto it = m_symbol_set.find(name, arity);
   if (it != m_symbol_set.end())
   {
-    if constexpr (EnableCreationMetrics) { m_function_symbol_metrics.hit(); }
-
     // The element already exists so return it.
     return function_symbol(_function_symbol::ref(&(*it)));
   }
   else
   {
-    if constexpr (EnableCreationMetrics) { m_function_symbol_metrics.miss(); }
-
     const _function_symbol& symbol = *m_symbol_set.emplace(std::move(name), arity).first;
     if (check_for_registered_functions)
     {
@@ -87,15 +84,11 @@ function_symbol function_symbol_pool::create(const std::string& name, const std:
   auto it = m_symbol_set.find(name, arity);
   if (it != m_symbol_set.end())
   {
-    if constexpr (EnableCreationMetrics) { m_function_symbol_metrics.hit(); }
-
     // The element already exists so return it.
     return function_symbol(_function_symbol::ref(&(*it)));
   }
   else
   {
-    if constexpr (EnableCreationMetrics) { m_function_symbol_metrics.miss(); }
-
     const _function_symbol& symbol = *m_symbol_set.emplace(name, arity).first;
     if (check_for_registered_functions)
     {
@@ -191,7 +184,7 @@ void function_symbol_pool::sweep()
 
   std::size_t erased_blocks = 0; //m_symbol_set.get_allocator().consolidate();
 
-  if constexpr (EnableGarbageCollectionMetrics)
+  if (aterm_statistics_enabled())
   {
     auto sweep_duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - timestamp).count();
 
@@ -202,16 +195,11 @@ void function_symbol_pool::sweep()
     mCRL2log(mcrl2::log::info) << "function_symbol_pool: Consolidate removed " << erased_blocks << " blocks.\n";
   }
 
-  if constexpr (EnableHashtableMetrics)
+  if (aterm_statistics_enabled() && mcrl2::log::mCRL2logEnabled(mcrl2::log::debug))
   {
     print_performance_statistics(m_symbol_set);
   }
 
-  if constexpr (EnableCreationMetrics)
-  {
-    mCRL2log(mcrl2::log::info) << "g_function_symbol_pool: Stores " << size() << " function symbols. create() " << m_function_symbol_metrics.message() << ".\n";
-  }
-
   if constexpr (EnableReferenceCountMetrics)
   {
     mCRL2log(mcrl2::log::info) << "g_function_symbol_pool: all reference counts changed " << _function_symbol::reference_count_changes() << " times.\n";
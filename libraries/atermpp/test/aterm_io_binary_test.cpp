@@ -7,7 +7,7 @@
 // http://www.boost.org/LICENSE_1_0.txt)
 //
 
-#include "mcrl2/atermpp/aterm_io_binary.h"
+#include "mcrl2/atermpp/aterm_io_chunked.h"
 
 #define BOOST_AUTO_TEST_MAIN
 #include <boost/test/included/unit_test.hpp>
@@ -104,3 +104,133 @@ BOOST_AUTO_TEST_CASE(transitions_test)
     BOOST_CHECK_EQUAL(t, term);
   }
 }
+
+BOOST_AUTO_TEST_CASE(chunked_test)
+{
+  std::vector<aterm> sequence;
+
+  function_symbol transition("transition", 3);
+  for (std::size_t index = 0; index < 1000; ++index)
+  {
+    sequence.emplace_back(transition, aterm_int(index), aterm(function_symbol("a", 0)), aterm_int(index + 1));
+  }
+  sequence.push_back(aterm_int(42));
+
+  std::stringstream stream;
+  {
+    // A small chunk size results in many chunks.
+    chunked_aterm_ostream output(stream, 256);
+    output << sequence.front();
+    output.flush_chunk();
+
+    for (std::size_t index = 1; index < sequence.size(); ++index)
+    {
+      output << sequence[index];
+    }
+  }
+
+  // Read the terms sequentially.
+  BOOST_CHECK(chunked_aterm_istream::is_chunked(stream));
+  {
+    chunked_aterm_istream input(stream);
+    for (const atermpp::aterm& term : sequence)
+    {
+      aterm t;
+      input.get(t);
+      BOOST_CHECK_EQUAL(t, term);
+    }
+
+    aterm t;
+    input.get(t);
+    BOOST_CHECK(!t.defined());
+  }
+
+  // Read the chunks in reverse order by means of the index.
+  stream.clear();
+  stream.seekg(0);
+  chunked_aterm_istream input(stream);
+  const std::vector<chunk_information>& index = input.index();
+  BOOST_CHECK_GT(index.size(), 2u);
+  BOOST_CHECK_EQUAL(index.front().number_of_terms, 1u);
+
+  std::size_t end = sequence.size();
+  for (std::size_t chunk = index.size(); chunk > 0; --chunk)
+  {
+    std::vector<aterm> terms;
+    input.read_chunk(chunk - 1, terms);
+    BOOST_CHECK_EQUAL(terms.size(), index[chunk - 1].number_of_terms);
+    BOOST_CHECK(std::equal(terms.begin(), terms.end(), sequence.begin() + (end - terms.size())));
+    end -= terms.size();
+  }
+  BOOST_CHECK_EQUAL(end, 0u);
+
+  // Reading the index does not disturb sequential reading.
+  aterm t;
+  input.get(t);
+  BOOST_CHECK_EQUAL(t, sequence.front());
+}
+
+BOOST_AUTO_TEST_CASE(chunked_mismatch_test)
+{
+  std::stringstream stream;
+  {
+    binary_aterm_ostream output(stream);
+    output << aterm_int(50);
+  }
+
+  BOOST_CHECK(!chunked_aterm_istream::is_chunked(stream));
+  BOOST_CHECK_THROW(chunked_aterm_istream input(stream), mcrl2::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(chunked_peeked_test)
+{
+  std::vector<aterm> sequence;
+  function_symbol f("f", 2);
+  for (std::size_t index = 0; index < 1000; ++index)
+  {
+    sequence.emplace_back(f, aterm_int(index), aterm_int(index % 7));
+  }
+
+  for (bool chunked : {false, true})
+  {
+    std::stringstream stream;
+    if (chunked)
+    {
+      chunked_aterm_ostream output(stream, 256);
+      for (const aterm& term : sequence)
+      {
+        output << term;
+      }
+    }
+    else
+    {
+      binary_aterm_ostream output(stream);
+      for (const aterm& term : sequence)
+      {
+        output << term;
+      }
+    }
+
+    // The format is determined without repositioning the stream, and the peeked bytes are read again.
+    peeked_istream peeked(stream, chunked_aterm_istream::identification_size);
+    BOOST_CHECK_EQUAL(chunked_aterm_istream::is_chunked(peeked.peeked()), chunked);
+    BOOST_CHECK(!chunked_aterm_istream::is_chunked(peeked));
+
+    std::unique_ptr<aterm_istream> input;
+    if (chunked)
+    {
+      input = std::make_unique<chunked_aterm_istream>(peeked);
+    }
+    else
+    {
+      input = std::make_unique<binary_aterm_istream>(peeked);
+    }
+
+    for (const aterm& term : sequence)
+    {
+      aterm t;
+      input->get(t);
+      BOOST_CHECK_EQUAL(t, term);
+    }
+  }
+}
@@ -13,8 +13,11 @@
 #include <boost/test/included/unit_test.hpp>
 
 #include "mcrl2/atermpp/aterm_io.h"
+#include "mcrl2/atermpp/aterm_statistics.h"
 #include "mcrl2/atermpp/aterm_string.h"
 
+#include <sstream>
+
 using namespace atermpp;
 
 BOOST_AUTO_TEST_CASE(test_aterm)
@@ -78,3 +81,31 @@ BOOST_AUTO_TEST_CASE(test_several_aterm_io)
   test_aterm_io("[a,b,[]]");
   test_aterm_io("f([a,f(x),[]],2,[g,g(34566)])"); 
 }
+
+BOOST_AUTO_TEST_CASE(test_aterm_statistics)
+{
+  std::ostringstream before;
+  print_aterm_statistics(before);
+
+  // Creating a new term and finding it again are both counted.
+  const function_symbol f("__test_aterm_statistics__", 1);
+  aterm t1(f, aterm_int(4242));
+  aterm t2(f, aterm_int(4242));
+  BOOST_CHECK(t1 == t2);
+
+  std::ostringstream after;
+  print_aterm_statistics(after);
+
+  // Reads the first number after the given key.
+  auto value = [](const std::string& s, const std::string& key)
+  {
+    std::size_t position = s.find("\"" + key + "\": ");
+    BOOST_REQUIRE(position != std::string::npos);
+    return std::stoul(s.substr(position + key.size() + 4));
+  };
+
+  BOOST_CHECK_GE(value(after.str(), "created_terms"), value(before.str(), "created_terms") + 1);
+  BOOST_CHECK_GE(value(after.str(), "found_terms"), value(before.str(), "found_terms") + 2);
+  BOOST_CHECK(after.str().find("\"arity\": \"8+\"") != std::string::npos);
+  BOOST_CHECK(after.str().find("\"pauses\"") != std::string::npos);
+}
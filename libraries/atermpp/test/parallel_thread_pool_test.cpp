@@ -11,7 +11,11 @@
 #include <boost/test/included/unit_test.hpp>
 
 #include "mcrl2/atermpp/aterm.h"
+#include "mcrl2/atermpp/aterm_garbage_collection.h"
+#include "mcrl2/atermpp/aterm_int.h"
 #include "mcrl2/atermpp/aterm_io.h"
+#include "mcrl2/atermpp/aterm_list.h"
+#include "mcrl2/atermpp/standard_containers/vector.h"
 #include "mcrl2/atermpp/detail/global_aterm_pool.h"
 #include "mcrl2/utilities/configuration.h"
 
@@ -164,3 +168,158 @@ BOOST_AUTO_TEST_CASE(test_concurrent_worker_teardown_does_not_corrupt_main_pool)
 
   BOOST_CHECK(true);
 }
+
+// Builds a balanced tree of the given depth whose leaves are leaf(i) for consecutive numbers i.
+static aterm make_tree(const function_symbol& node, const function_symbol& leaf, std::size_t depth, std::size_t& number)
+{
+  if (depth == 0)
+  {
+    return aterm(leaf, aterm_int(number++));
+  }
+  aterm left = make_tree(node, leaf, depth - 1, number);
+  aterm right = make_tree(node, leaf, depth - 1, number);
+  return aterm(node, left, right);
+}
+
+static std::size_t count_leaves(const aterm& t, const function_symbol& leaf)
+{
+  if (t.function() == leaf)
+  {
+    return 1;
+  }
+  return count_leaves(t[0], leaf) + count_leaves(t[1], leaf);
+}
+
+// Garbage collection with several threads must keep the terms reachable from variables and
+// containers, and destroy the other terms after calling their deletion hooks.
+BOOST_AUTO_TEST_CASE(test_parallel_garbage_collection)
+{
+  if constexpr (!mcrl2::utilities::detail::GlobalThreadSafe)
+  {
+    return;
+  }
+
+  const function_symbol node("__test_parallel_gc_node__", 2);
+  const function_symbol leaf("__test_parallel_gc_leaf__", 1);
+
+  static std::atomic<std::size_t> number_of_deleted_leaves{ 0 };
+  atermpp::add_deletion_hook(leaf, [](const atermpp::aterm&) { ++number_of_deleted_leaves; });
+
+  atermpp::set_number_of_collection_threads(4);
+
+  // A long list that is reachable from a variable, and trees that are reachable from a container.
+  aterm_list list;
+  for (std::size_t i = 0; i < 100000; ++i)
+  {
+    list.push_front(aterm_int(i));
+  }
+
+  std::size_t number = 0;
+  atermpp::vector<aterm> trees;
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    trees.push_back(make_tree(node, leaf, 12, number));
+  }
+
+  // Leaves that become unreachable immediately.
+  for (std::size_t i = 0; i < 1000; ++i)
+  {
+    aterm garbage(leaf, aterm_int(number + i));
+  }
+
+  atermpp::detail::g_thread_term_pool().collect();
+  BOOST_CHECK_EQUAL(number_of_deleted_leaves.load(), 1000u);
+
+  std::size_t sum = 0;
+  for (const aterm& t : list)
+  {
+    sum += down_cast<aterm_int>(t).value();
+  }
+  BOOST_CHECK_EQUAL(list.size(), 100000u);
+  BOOST_CHECK_EQUAL(sum, std::size_t(100000) * 99999 / 2);
+
+  for (const aterm& tree : trees)
+  {
+    BOOST_CHECK_EQUAL(count_leaves(tree, leaf), 1u << 12);
+  }
+
+  // The marks are removed by the sweep, so nothing reachable is destroyed by the next collection.
+  atermpp::detail::g_thread_term_pool().collect();
+  BOOST_CHECK_EQUAL(number_of_deleted_leaves.load(), 1000u);
+
+  trees.clear();
+  atermpp::detail::g_thread_term_pool().collect();
+  BOOST_CHECK_EQUAL(number_of_deleted_leaves.load(), 1000u + 4 * (1u << 12));
+
+  atermpp::set_number_of_collection_threads(0);
+}
+
+// With incremental sweeping the unreachable terms are destroyed while threads create terms, which can
+// also find and thereby revive unreachable terms that were not destroyed yet.
+BOOST_AUTO_TEST_CASE(test_incremental_sweep)
+{
+  const function_symbol pair("__test_incremental_sweep_pair__", 2);
+  const function_symbol leaf("__test_incremental_sweep_leaf__", 1);
+
+  static std::atomic<std::size_t> number_of_deleted_leaves{ 0 };
+  atermpp::add_deletion_hook(leaf, [](const atermpp::aterm&) { ++number_of_deleted_leaves; });
+
+  atermpp::enable_incremental_sweep(true);
+
+  aterm_list list;
+  for (std::size_t i = 0; i < 100000; ++i)
+  {
+    list.push_front(aterm_int(i));
+  }
+
+  for (std::size_t i = 0; i < 1000; ++i)
+  {
+    aterm garbage(leaf, aterm_int(i));
+  }
+
+  {
+    aterm garbage(pair, aterm_int(123456789), aterm_int(987654321));
+  }
+
+  // The terms with a deletion hook are destroyed immediately.
+  atermpp::detail::g_thread_term_pool().collect();
+  BOOST_CHECK_EQUAL(number_of_deleted_leaves.load(), 1000u);
+
+  aterm revived(pair, aterm_int(123456789), aterm_int(987654321));
+
+  // Create terms on several threads, which sweep the remaining buckets in steps.
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < 4; ++t)
+  {
+    threads.emplace_back([t, &pair]()
+      {
+        for (std::size_t i = 0; i < 200000; ++i)
+        {
+          aterm garbage(pair, aterm_int(t), aterm_int(1000000 + i));
+        }
+      });
+  }
+
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  std::size_t sum = 0;
+  for (const aterm& t : list)
+  {
+    sum += down_cast<aterm_int>(t).value();
+  }
+  BOOST_CHECK_EQUAL(list.size(), 100000u);
+  BOOST_CHECK_EQUAL(sum, std::size_t(100000) * 99999 / 2);
+
+  // Collecting again finishes the previous sweep first.
+  atermpp::detail::g_thread_term_pool().collect();
+  atermpp::enable_incremental_sweep(false);
+  atermpp::detail::g_thread_term_pool().collect();
+
+  BOOST_CHECK(revived == aterm(pair, aterm_int(123456789), aterm_int(987654321)));
+  BOOST_CHECK_EQUAL(down_cast<aterm_int>(revived[0]).value(), 123456789u);
+  BOOST_CHECK_EQUAL(down_cast<aterm_int>(revived[1]).value(), 987654321u);
+  BOOST_CHECK_EQUAL(number_of_deleted_leaves.load(), 1000u);
+}
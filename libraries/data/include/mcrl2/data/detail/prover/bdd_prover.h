@@ -487,6 +487,7 @@ class BDD_Prover: protected rewriter
 #ifdef MCRL2_ENABLE_JITTYC
         case(jitty_compiling):
 #endif
+        case(jitty_interpreting):
         {
           /* These provers are ok */
           break;
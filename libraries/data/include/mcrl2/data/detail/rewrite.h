@@ -92,6 +92,21 @@ class Rewriter
      **/
     virtual void rewrite(data_expression& result, const data_expression& term, substitution_type& sigma) = 0;
 
+    /**
+     * \brief Rewrite a sequence of mCRL2 data terms under the same substitution.
+     * \details The result is the same as when the terms are rewritten one by one, but a rewriter can
+     *          prepare the rewriting of all terms only once. This is used for the next state vectors of summands.
+     * \param result The normal forms of the terms, in the same order. It is resized to the number of terms.
+     **/
+    virtual void rewrite(std::vector<data_expression>& result, const std::vector<data_expression>& terms, substitution_type& sigma)
+    {
+      result.resize(terms.size());
+      for (std::size_t i = 0; i < terms.size(); ++i)
+      {
+        rewrite(result[i], terms[i], sigma);
+      }
+    }
+
     /**
      * \brief Provide the rewriter with a () operator, such that it can also
      *        rewrite terms using this operator.
@@ -11,6 +11,8 @@
 #define MCRL2_DATA_DETAIL_REWRITE_JITTY_H
 
 #include "mcrl2/data/detail/rewrite.h"
+#include "mcrl2/data/detail/rewrite/normal_form_memo.h"
+#include "mcrl2/data/detail/rewrite/rewrite_profile.h"
 #include "mcrl2/data/detail/rewrite/rewrite_stack.h"
 #include "mcrl2/data/detail/rewrite/strategy_rule.h"
 
@@ -66,6 +68,8 @@ class RewriterJitty: public Rewriter
 
     void rewrite(data_expression& result, const data_expression& term, substitution_type& sigma) override;
 
+    void rewrite(std::vector<data_expression>& result, const std::vector<data_expression>& terms, substitution_type& sigma) override;
+
     std::shared_ptr<detail::Rewriter> clone() override { return std::shared_ptr<Rewriter>(new RewriterJitty(*this)); }
 
     const function_symbol& this_term_is_in_normal_form() 
@@ -73,6 +77,11 @@ class RewriterJitty: public Rewriter
       return this_term_is_in_normal_form_symbol;
     }
 
+    const normal_form_memo& memo() const
+    {
+      return m_memo;
+    }
+
   protected:
 
     // A dedicated function symbol that indicates that a term is in normal form. It has name "Rewritten@@term".
@@ -80,10 +89,12 @@ class RewriterJitty: public Rewriter
     // Terms with this auxiliary function symbol cannot be printed using the pretty printer for data expressions.
     function_symbol this_term_is_in_normal_form_symbol;
     bool rewriting_in_progress = false;
+    bool m_profile = rewrite_profile_enabled(); // Record the rules and function symbols that are used.
 
     class rewrite_stack m_rewrite_stack;     // Stack for intermediate rewrite results.
 
     std::vector<data_expression> rhs_for_constants_cache; // Cache that contains normal forms for constants. 
+    normal_form_memo m_memo{get_rewriter_memo_size()}; // Normal forms of applications, independent of the substitution.
     std::map< function_symbol, data_equation_list > jitty_eqns;
     std::vector<strategy> jitty_strat;
 
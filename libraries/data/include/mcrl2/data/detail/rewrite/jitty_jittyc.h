@@ -100,6 +100,30 @@ inline const data_expression* get_argument_of_higher_order_term_helper(const app
   return nullptr;
 }
 
+///
+/// \brief arity_is_allowed yields true if the function indicated by the function index can
+///        legitemately be used with a arguments. A function f:D1x...xDn->D can be used with 0 and
+///        n arguments. A function f:(D1x...xDn)->(E1x...Em)->F can be used with 0, n, and n+m
+///        arguments.
+/// \param s A function sort
+/// \param a The desired number of arguments
+/// \return A boolean indicating whether a term of sort s applied to a arguments is a valid term.
+///
+inline bool arity_is_allowed(const sort_expression& s, const std::size_t a)
+{
+  if (a == 0)
+  {
+    return true;
+  }
+  if (is_function_sort(s))
+  {
+    const function_sort& fs = atermpp::down_cast<function_sort>(s);
+    std::size_t n = fs.domain().size();
+    return n <= a && arity_is_allowed(fs.codomain(), a - n);
+  }
+  return false;
+}
+
 // This function returns the i-th argument t_i. NOTE: The first argument has index 1.
 // t is an applicatoin of the shape application(application(...application(f,t1,...tn),tn+1....),tm...).
 // i must be a valid index of an argument. 
@@ -14,7 +14,6 @@
 #include <utility>
 #include <string>
 
-#include "mcrl2/utilities/uncompiledlibrary.h"
 #include "mcrl2/utilities/toolset_version.h"
 #include "mcrl2/atermpp/standard_containers/vector.h"
 #include "mcrl2/data/detail/rewrite/jitty.h"
@@ -23,72 +22,118 @@
 #include "mcrl2/data/substitutions/mutable_map_substitution.h"
 
 #ifdef MCRL2_ENABLE_JITTYC
+#include "mcrl2/utilities/uncompiledlibrary.h"
+#endif
 
 namespace mcrl2::data::detail
 {
 
 using sort_list_vector = std::vector<sort_expression_list>;
 
+#ifdef MCRL2_ENABLE_JITTYC
+
 ///
-/// \brief The normal_form_cache class stores normal forms of data_expressions that
-///        are inserted in it. By keeping the cache on the stack, the normal forms
-///        in it will not be freed by the ATerm library, and can therefore be used
-///        in the generated jittyc code.
+/// \brief The generated_term_table class stores the terms, such as normal forms and function
+///        symbols, that are used by the generated jittyc code. By keeping the table alive, the
+///        terms in it will not be freed by the ATerm library. The generated code refers to a term
+///        by its position in the table, such that the compiled rewriter does not depend on the
+///        addresses of terms in the current process, and can be reused by other processes.
 ///
-class normal_form_cache
+class generated_term_table
 {
   private:
-    std::set<data_expression> m_lookup;
+    std::vector<data_expression> m_terms;
+    std::map<data_expression, std::size_t> m_indices;
   public:
-    normal_form_cache() = default;
-
-    // Caches cannot be copied or moved. The addresses in the cache must remain available the lifetime of
-    // all rewriters using this cache. 
-    normal_form_cache(const normal_form_cache& ) = delete;
-    normal_form_cache(normal_form_cache&& ) = delete;
-    normal_form_cache& operator=(const normal_form_cache& ) = delete;
-    normal_form_cache& operator=(normal_form_cache&& ) = delete;
-  
-  /// \brief insert stores the normal form of t in the cache, and returns a string
-  ///        that is a C++ representation of the stored normal form. This string can
-  ///        be used by the generated rewriter as long as the cache object is alive,
-  ///        and its clear() method has not been called.
-  /// \param t The term to normalize.
-  /// \return A C++ string that evaluates to the cached normal form of t.
-  ///
-  std::string insert(const data_expression& t)
-  {
-    std::stringstream ss;
-    const data_expression* cached_term = &*(m_lookup.insert(t).first);
-    ss << "*reinterpret_cast<const data_expression*>(" << (void*)(cached_term) << ")";
-    return ss.str();
-  }
+    generated_term_table() = default;
+
+    // Tables cannot be copied or moved. The terms in the table must remain available the lifetime of
+    // all rewriters using this table.
+    generated_term_table(const generated_term_table& ) = delete;
+    generated_term_table(generated_term_table&& ) = delete;
+    generated_term_table& operator=(const generated_term_table& ) = delete;
+    generated_term_table& operator=(generated_term_table&& ) = delete;
+
+    /// \brief Stores t in the table if it is not present yet.
+    /// \return The position of t in the table.
+    std::size_t index(const data_expression& t)
+    {
+      auto [it, inserted] = m_indices.try_emplace(t, m_terms.size());
+      if (inserted)
+      {
+        m_terms.push_back(t);
+      }
+      return it->second;
+    }
 
-  /// \brief Checks whether the cache is empty.
-  /// \return A boolean indicating whether the cache is empty. 
-  bool empty() const
-  {
-    return m_lookup.empty();
-  }
+    /// \brief insert stores t in the table, and returns a string that is a C++ representation
+    ///        of the stored term in the generated code.
+    /// \param t The term to store, which is generally a normal form.
+    /// \return A C++ string that evaluates to t.
+    ///
+    std::string insert(const data_expression& t)
+    {
+      return "reinterpret_cast<const data_expression&>(generated_terms[" + std::to_string(index(t)) + "])";
+    }
+
+    /// \brief Stores t in the table, and returns a C++ string that evaluates to the address of t
+    ///        as an uintptr_t in the generated code.
+    std::string address(const data_expression& t)
+    {
+      return "reinterpret_cast<uintptr_t>(generated_terms[" + std::to_string(index(t)) + "])";
+    }
+
+    /// \brief Replaces the contents of the table by the given terms, in this order.
+    void assign(const std::vector<data_expression>& terms)
+    {
+      m_terms = terms;
+      m_indices.clear();
+      for (std::size_t i = 0; i < m_terms.size(); ++i)
+      {
+        m_indices.emplace(m_terms[i], i);
+      }
+    }
+
+    const std::vector<data_expression>& terms() const
+    {
+      return m_terms;
+    }
+
+    /// \brief Checks whether the table is empty.
+    /// \return A boolean indicating whether the table is empty.
+    bool empty() const
+    {
+      return m_terms.empty();
+    }
 
-  ~normal_form_cache() = default;
+    ~generated_term_table() = default;
 };
 
+#endif // MCRL2_ENABLE_JITTYC
+
+/// \brief The jitty rewriter that generates and compiles C++ code for the match trees of the rewrite rules.
+/// \details The construction of the strategies and match trees is also available without MCRL2_ENABLE_JITTYC,
+///          for rewriters that use them in another way. Only the generation and compilation of code requires it.
 class RewriterCompilingJitty: public Rewriter
 {
   public:
     using substitution_type = Rewriter::substitution_type;
     using rewriter_function = void (*)(data_expression&, const application&, RewriterCompilingJitty*);
 
-    RewriterCompilingJitty(const data_specification& DataSpec, const used_data_equation_selector&);
     ~RewriterCompilingJitty() override;
 
+#ifdef MCRL2_ENABLE_JITTYC
+    RewriterCompilingJitty(const data_specification& DataSpec, const used_data_equation_selector&);
+
     rewrite_strategy getStrategy() override;
 
     data_expression rewrite(const data_expression& term, substitution_type& sigma) override;
 
     void rewrite(data_expression& result, const data_expression& term, substitution_type& sigma) override;
 
+    void rewrite(std::vector<data_expression>& result, const std::vector<data_expression>& terms, substitution_type& sigma) override;
+#endif
+
     // The variable global_sigma is a temporary store to maintain the substitution 
     // sigma during rewriting a single term. It is not a variable for public use.
     substitution_type* global_sigma = nullptr;
@@ -228,17 +273,28 @@ class RewriterCompilingJitty: public Rewriter
     // The following vector is to store normal forms of constants, indexed by the sequence number in a constant. 
     std::vector<data_expression> normal_forms_for_constants;
 
+#ifdef MCRL2_ENABLE_JITTYC
+    // Restores the terms that are used by the generated code from their textual representation, which is
+    // stored in the compiled rewriter, and prepares the tables above for the given arity bound.
+    // Returns the terms, in the order in which the generated code refers to them.
+    const std::vector<data_expression>& initialise_generated_terms(const std::string& text, std::size_t arity_bound);
+#endif
+
     // Standard assignment operator.
     RewriterCompilingJitty& operator=(const RewriterCompilingJitty& other)=delete;
 
+#ifdef MCRL2_ENABLE_JITTYC
     std::shared_ptr<detail::Rewriter> clone() override
     {
       return std::shared_ptr<Rewriter>(new RewriterCompilingJitty(*this));
     }
+#endif
 
   protected:
+#ifdef MCRL2_ENABLE_JITTYC
     class ImplementTree;
     friend class ImplementTree;
+#endif
     
     RewriterJitty jitty_rewriter;
     std::set < data_equation > rewrite_rules;
@@ -247,8 +303,11 @@ class RewriterCompilingJitty: public Rewriter
     std::map<function_symbol, data_equation_list> jittyc_eqns;
     std::set<function_symbol> m_extra_symbols;
 
+#ifdef MCRL2_ENABLE_JITTYC
     std::shared_ptr<uncompiled_library> rewriter_so;
-    std::shared_ptr<normal_form_cache> m_nf_cache;
+    std::shared_ptr<generated_term_table> m_generated_terms;
+#endif
+    bool m_profile = rewrite_profile_enabled(); // The generated code records the function symbols that are used.
 
     // The rewriter maintains a copy of busy and forbidden flag,
     // to allow for faster access to them. These flags are used extensively and
@@ -262,6 +321,11 @@ class RewriterCompilingJitty: public Rewriter
     // Copy construction. Not (yet) for public use.
     RewriterCompilingJitty(RewriterCompilingJitty& other) = default;
 
+    // Construction that, if compile is false, only collects the rewrite rules per function symbol, without
+    // generating and compiling the rewriter, for rewriters that use the match trees in another way.
+    // Compiling requires MCRL2_ENABLE_JITTYC.
+    RewriterCompilingJitty(const data_specification& DataSpec, const used_data_equation_selector&, bool compile);
+
     void (*so_rewr_cleanup)();
     void (*so_rewr)(data_expression& result, const data_expression&, RewriterCompilingJitty*);
 
@@ -270,10 +334,15 @@ class RewriterCompilingJitty: public Rewriter
     bool opid_is_nf(const function_symbol& opid, std::size_t num_args);
     void calc_nfs_list(nfs_array& a, const application& args, variable_or_number_list nnfvars);
     bool calc_nfs(const data_expression& t, variable_or_number_list nnfvars);
+#ifdef MCRL2_ENABLE_JITTYC
     void CleanupRewriteSystem();
     void BuildRewriteSystem();
+    void load_rewriter();
+    std::string cache_filename(const std::string& compile_script) const;
+    std::string generated_terms_text() const;
     void generate_code(const std::string& filename);
     void generate_rewr_functions(std::ostream& s, const data::function_symbol& func, const data_equation_list& eqs);
+#endif
     bool lift_rewrite_rule_to_right_arity(data_equation& e, std::size_t requested_arity);
     sort_list_vector
     get_residual_sorts(const sort_expression& s, std::size_t actual_arity, std::size_t requested_arity);
@@ -295,6 +364,7 @@ class RewriterCompilingJitty: public Rewriter
   }
 };
 
+#ifdef MCRL2_ENABLE_JITTYC
 struct rewriter_interface
 {
   std::string caller_toolset_version;
@@ -303,9 +373,8 @@ struct rewriter_interface
   void (*rewrite_external)(data_expression& result, const data_expression& t, RewriterCompilingJitty*);
   void (*rewrite_cleanup)();
 };
+#endif // MCRL2_ENABLE_JITTYC
 
 }
 
-#endif // MCRL2_ENABLE_JITTYC
-
 #endif // MCRL2_DATA_DETAIL_REWR_JITTYC_H
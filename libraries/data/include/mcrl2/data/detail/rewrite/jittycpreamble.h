@@ -183,6 +183,31 @@ std::size_t get_index(const function_symbol& func)
   return atermpp::detail::index_traits<function_symbol, function_symbol_key_type, 2>::index(func);
 }
 
+// Stores the rewrite functions for f applied to arity arguments in the lookup tables.
+static inline
+void set_precompiled_rewrite_functions(const data_expression& f,
+                                       const std::size_t arity,
+                                       rewriter_function when_arguments_are_not_in_normal_form,
+                                       rewriter_function when_arguments_are_in_normal_form,
+                                       RewriterCompilingJitty* this_rewriter)
+{
+  const std::size_t index = get_index(down_cast<function_symbol>(f));
+  assert(index < this_rewriter->index_bound && arity < this_rewriter->arity_bound);
+  this_rewriter->functions_when_arguments_are_not_in_normal_form[this_rewriter->arity_bound * index + arity] = when_arguments_are_not_in_normal_form;
+  this_rewriter->functions_when_arguments_are_in_normal_form[this_rewriter->arity_bound * index + arity] = when_arguments_are_in_normal_form;
+}
+
+static inline
+void set_normal_form_for_constant(const data_expression& f, const data_expression& normal_form, RewriterCompilingJitty* this_rewriter)
+{
+  const std::size_t index = get_index(down_cast<function_symbol>(f));
+  if (index >= this_rewriter->normal_forms_for_constants.size())
+  {
+    this_rewriter->normal_forms_for_constants.resize(index + 1);
+  }
+  this_rewriter->normal_forms_for_constants[index] = normal_form;
+}
+
 static inline
 RewriterCompilingJitty::substitution_type& sigma(RewriterCompilingJitty* this_rewriter)
 {
@@ -0,0 +1,161 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/data/detail/rewrite/jittyi.h
+/// \brief A rewriter that interprets the match trees of the compiling jitty rewriter.
+
+#ifndef MCRL2_DATA_DETAIL_REWRITE_JITTYI_H
+#define MCRL2_DATA_DETAIL_REWRITE_JITTYI_H
+
+#include "mcrl2/data/detail/rewrite/jittyc.h"
+
+namespace mcrl2::data::detail
+{
+
+/// \brief A register of the interpreter, which contains a term that is not necessarily in normal form.
+struct interpreter_register
+{
+  data_expression term;
+  bool normal_form = false;
+};
+
+/// \brief A node of a right hand side or a condition of a rewrite rule.
+/// \details The arguments of a function node that are rewritten before the function symbol is applied
+///          are calculated in normal form. The other arguments are passed on as terms that are not
+///          rewritten yet.
+struct interpreter_node
+{
+  enum kind_type
+  {
+    normal_form,    ///< A term without variables, which is in normal form.
+    bound_variable, ///< A variable, which is stored in the register with the given index.
+    function,       ///< A function symbol applied to the arguments, that are given as nodes.
+    other           ///< Any other term, such as a binder or a where clause, which is rewritten as a whole.
+  };
+
+  kind_type kind;
+  data_expression term;                                       ///< The normal form, the function symbol or the other term.
+  std::size_t index = 0;                                      ///< The register of a variable.
+  std::vector<std::size_t> arguments;                         ///< The nodes of the arguments of a function.
+  std::vector<bool> arguments_in_normal_form;                 ///< The arguments of a function that are rewritten first.
+  std::vector<std::pair<variable, std::size_t>> variables;    ///< The variables of an other term, and their registers.
+};
+
+/// \brief An instruction of an interpreter program.
+/// \details A term that is inspected by an instruction is the term in the source register if the position is 0,
+///          and otherwise the argument at the given position of that term, where the head has position 0.
+struct interpreter_instruction
+{
+  enum opcode
+  {
+    rewrite_argument,  ///< Rewrite the argument in the source register to normal form.
+    bind,              ///< Store the term in the target register, which holds a variable of the rule.
+    match_bound,       ///< Jump if the term differs from the value of the variable in the target register.
+    match_term,        ///< Jump if the term differs from the given function symbol or machine number.
+    match_head,        ///< Jump if the term is not the given function symbol applied to arguments.
+    condition,         ///< Jump if the node with the target index does not rewrite to true.
+    result,            ///< The node with the target index is the result.
+    jump,              ///< Jump to the next part of the strategy, as no rule applies.
+    finish             ///< No rule applies, and the result is the function symbol applied to the rewritten arguments.
+  };
+
+  opcode op;
+  std::size_t source = 0;
+  std::size_t position = 0;
+  std::size_t target = 0;     ///< The register in which a matched term is stored, or the index of a node.
+  std::size_t on_failure = 0; ///< The instruction at which the program continues if the term does not match.
+  data_expression term;
+};
+
+/// \brief The program that rewrites a function symbol applied to a fixed number of arguments.
+/// \details The arguments are in the first registers. The program is a translation of the strategy of the
+///          compiling rewriter, of which the match trees are the code and the right hand sides are the nodes.
+struct interpreter_program
+{
+  std::size_t number_of_registers = 0;
+  std::vector<interpreter_instruction> instructions;
+  std::vector<interpreter_node> nodes;
+  data_expression normal_form;  ///< The normal form of a constant.
+  std::function<void(data_expression&, const data_expression&)> cpp_function;  ///< The C++ implementation, if any.
+};
+
+/// \brief The jitty rewriter with the strategies and match trees of the compiling rewriter, which are translated
+///        into programs that are interpreted. This avoids the generation and compilation of C++ code.
+class RewriterInterpretingJitty: public RewriterCompilingJitty
+{
+  public:
+    using substitution_type = Rewriter::substitution_type;
+
+    RewriterInterpretingJitty(const data_specification& data_spec, const used_data_equation_selector& equation_selector);
+
+    // The copy constructor. The programs are shared with the copy.
+    RewriterInterpretingJitty(RewriterInterpretingJitty& other) = default;
+
+    RewriterInterpretingJitty& operator=(const RewriterInterpretingJitty& other) = delete;
+
+    ~RewriterInterpretingJitty() override = default;
+
+    rewrite_strategy getStrategy() override;
+
+    data_expression rewrite(const data_expression& term, substitution_type& sigma) override;
+
+    void rewrite(data_expression& result, const data_expression& term, substitution_type& sigma) override;
+
+    void rewrite(std::vector<data_expression>& result, const std::vector<data_expression>& terms, substitution_type& sigma) override;
+
+    std::shared_ptr<detail::Rewriter> clone() override
+    {
+      return std::shared_ptr<Rewriter>(new RewriterInterpretingJitty(*this));
+    }
+
+  protected:
+    // The arguments that the strategy of a function symbol applied to a number of arguments rewrites first.
+    using rewritten_arguments_map = std::map<std::pair<function_symbol, std::size_t>, std::vector<bool>>;
+
+    // The programs are indexed by the index of the function symbol times m_arity_bound plus the number of arguments.
+    // A function symbol without a program is rewritten by rewriting its arguments.
+    std::shared_ptr<const std::vector<interpreter_program>> m_programs;
+    std::size_t m_arity_bound = 1;
+
+    // The registers of all programs that are being executed. The registers of a program start at its frame.
+    std::vector<interpreter_register> m_registers;
+
+    // The arguments of the terms that are being constructed. This is a stack, as the arguments of a term
+    // are rewritten or constructed recursively, and the arguments of a term are on top of it.
+    std::vector<data_expression> m_arguments;
+
+    const interpreter_program* program(const function_symbol& f, std::size_t arity) const;
+
+    void translate_tree(interpreter_program& program,
+                        const match_tree& tree,
+                        std::size_t cur_arg,
+                        std::size_t parent,
+                        std::size_t level,
+                        std::vector<std::pair<std::size_t, std::size_t>>& stack,
+                        const std::map<variable, std::size_t>& variables,
+                        std::vector<std::size_t>& failures,
+                        const rewritten_arguments_map& rewritten_arguments);
+    std::size_t translate_term(interpreter_program& program,
+                               const data_expression& t,
+                               const std::map<variable, std::size_t>& variables,
+                               const rewritten_arguments_map& rewritten_arguments);
+
+    void rewrite_aux(data_expression& result, const data_expression& term, substitution_type& sigma);
+    void rewrite_with_arguments_in_normal_form(data_expression& result, const application& t, substitution_type& sigma);
+    void apply_function(data_expression& result, const function_symbol& f, std::size_t arity, std::size_t frame, substitution_type& sigma);
+    void execute(data_expression& result, const interpreter_program& program, const function_symbol& f, std::size_t arity,
+                 std::size_t frame, substitution_type& sigma);
+    void finish(data_expression& result, const function_symbol& f, std::size_t arity, std::size_t frame, substitution_type& sigma);
+    void normalise(std::size_t index, substitution_type& sigma);
+    void evaluate(data_expression& result, const interpreter_program& program, std::size_t node, std::size_t frame, substitution_type& sigma);
+    data_expression delay(const interpreter_program& program, std::size_t node, std::size_t frame);
+};
+
+} // namespace mcrl2::data::detail
+
+#endif // MCRL2_DATA_DETAIL_REWRITE_JITTYI_H
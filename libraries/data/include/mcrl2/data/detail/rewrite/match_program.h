@@ -0,0 +1,150 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/data/detail/rewrite/match_program.h
+/// \brief The left hand side of a rewrite rule as a sequence of instructions to match a term.
+
+#ifndef MCRL2_DATA_DETAIL_REWRITE_MATCH_PROGRAM_H
+#define MCRL2_DATA_DETAIL_REWRITE_MATCH_PROGRAM_H
+
+#include <algorithm>
+#include <vector>
+
+#include "mcrl2/data/detail/rewrite/jitty_jittyc.h"
+
+namespace mcrl2::data::detail
+{
+
+/// \brief An instruction of a match program.
+/// \details The instructions that refer to an argument act on the arguments of the term that is matched. The
+///          other instructions act on the top of a stack of subterms, which is popped. A variable is identified
+///          by the position in which it is bound, as the instructions always bind the variables in the same order.
+struct match_instruction
+{
+  enum opcode
+  {
+    bind_argument,         ///< Bind the variable to the argument.
+    match_bound_argument,  ///< The argument must be equal to the value of the variable with the given position.
+    match_argument,        ///< The argument must be equal to the function symbol or machine number.
+    push_argument,         ///< Push the argument, which must be an application that is matched by the next instructions.
+    bind,                  ///< Bind the variable to the subterm.
+    match_bound,           ///< The subterm must be equal to the value of the variable with the given position.
+    match,                 ///< The subterm must be equal to the function symbol or machine number.
+    match_application      ///< The subterm must be an application with the given number of arguments, of
+                           ///< which the head and the arguments are pushed such that the head is on top.
+  };
+
+  opcode op;
+  std::size_t index;        ///< The argument, or the number of arguments of an application.
+  std::size_t position;     ///< The position of a bound variable.
+  data_expression term;     ///< The variable, function symbol or machine number.
+};
+
+/// \brief The left hand side of a rewrite rule, translated to instructions that match a term.
+/// \details Matching with the program avoids the traversal of the left hand side, and the search for
+///          variables that occur more than once, which are both needed when the left hand side is matched directly.
+class match_program
+{
+  public:
+    match_program() = default;
+
+    /// \brief Translates the arguments of the left hand side lhs of a rewrite rule.
+    explicit match_program(const data_expression& lhs)
+      : m_arity(is_function_symbol(lhs) ? 0 : recursive_number_of_args(lhs))
+    {
+      std::vector<variable> bound;
+      for (std::size_t i = 0; i < m_arity; ++i)
+      {
+        const data_expression& p = get_argument_of_higher_order_term(atermpp::down_cast<application>(lhs), i);
+        if (is_variable(p))
+        {
+          const auto it = std::find(bound.begin(), bound.end(), p);
+          if (it == bound.end())
+          {
+            m_instructions.push_back({match_instruction::bind_argument, i, 0, p});
+            bound.push_back(atermpp::down_cast<variable>(p));
+          }
+          else
+          {
+            m_instructions.push_back({match_instruction::match_bound_argument, i, static_cast<std::size_t>(it - bound.begin()), data_expression()});
+          }
+        }
+        else if (is_function_symbol(p) || is_machine_number(p))
+        {
+          m_instructions.push_back({match_instruction::match_argument, i, 0, p});
+        }
+        else
+        {
+          m_instructions.push_back({match_instruction::push_argument, i, 0, data_expression()});
+          translate(p, bound, 1);
+        }
+      }
+    }
+
+    /// \brief The number of arguments of the left hand side.
+    std::size_t arity() const
+    {
+      return m_arity;
+    }
+
+    /// \brief The maximal number of subterms on the stack while the program is executed.
+    std::size_t stack_size() const
+    {
+      return m_stack_size;
+    }
+
+    const std::vector<match_instruction>& instructions() const
+    {
+      return m_instructions;
+    }
+
+  protected:
+    std::size_t m_arity = 0;
+    std::size_t m_stack_size = 0;
+    std::vector<match_instruction> m_instructions;
+
+    // Translate the pattern p, which is the top of a stack of the given size.
+    void translate(const data_expression& p, std::vector<variable>& bound, std::size_t stack_size)
+    {
+      m_stack_size = std::max(m_stack_size, stack_size);
+      if (is_variable(p))
+      {
+        const auto it = std::find(bound.begin(), bound.end(), p);
+        if (it == bound.end())
+        {
+          m_instructions.push_back({match_instruction::bind, 0, 0, p});
+          bound.push_back(atermpp::down_cast<variable>(p));
+        }
+        else
+        {
+          m_instructions.push_back({match_instruction::match_bound, 0, static_cast<std::size_t>(it - bound.begin()), data_expression()});
+        }
+      }
+      else if (is_function_symbol(p) || is_machine_number(p))
+      {
+        m_instructions.push_back({match_instruction::match, 0, 0, p});
+      }
+      else
+      {
+        const application& pa = atermpp::down_cast<application>(p);
+        m_instructions.push_back({match_instruction::match_application, pa.size(), 0, data_expression()});
+
+        // The head is on top, and below it the arguments from left to right.
+        std::size_t size = stack_size - 1 + pa.size() + 1;
+        translate(pa.head(), bound, size--);
+        for (const data_expression& argument: pa)
+        {
+          translate(argument, bound, size--);
+        }
+      }
+    }
+};
+
+} // namespace mcrl2::data::detail
+
+#endif // MCRL2_DATA_DETAIL_REWRITE_MATCH_PROGRAM_H
@@ -0,0 +1,173 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/data/detail/rewrite/normal_form_memo.h
+/// \brief A bounded table that maps terms to their normal forms.
+
+#ifndef MCRL2_DATA_DETAIL_REWRITE_NORMAL_FORM_MEMO_H
+#define MCRL2_DATA_DETAIL_REWRITE_NORMAL_FORM_MEMO_H
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+#include "mcrl2/atermpp/detail/aterm_container.h"
+#include "mcrl2/atermpp/detail/thread_aterm_pool.h"
+#include "mcrl2/data/data_expression.h"
+
+namespace mcrl2::data::detail
+{
+
+// Stores the number of entries of the normal form memo of newly created rewriters. Zero disables the memo.
+template <class T> // note, T is only a dummy
+struct rewriter_memo_size
+{
+  static std::size_t memo_size;
+};
+
+// Initialization
+template <class T>
+std::size_t rewriter_memo_size<T>::memo_size = 0;
+
+inline
+void set_rewriter_memo_size(std::size_t size)
+{
+  rewriter_memo_size<std::size_t>::memo_size = size;
+}
+
+inline
+std::size_t get_rewriter_memo_size()
+{
+  return rewriter_memo_size<std::size_t>::memo_size;
+}
+
+/// \brief A table from terms to their normal forms, of which the size is bounded.
+/// \details The table is direct mapped on the address of a term, which identifies it due to maximal sharing.
+///          An entry that maps to an occupied position replaces the old entry. The terms in the table are
+///          protected by the table. At every garbage collection the entries that have not been used since
+///          the previous garbage collection are removed, such that their terms can be collected.
+///          The table is used by a single thread. A copy of the table is an empty table of the same size.
+class normal_form_memo
+{
+  public:
+    /// \brief Constructor.
+    /// \param size The maximal number of entries, which is rounded up to a power of two. Zero disables the table.
+    explicit normal_form_memo(std::size_t size)
+     : m_entries(size == 0 ? 0 : capacity(size)),
+       m_shift(64 - std::countr_zero(m_entries.size())),
+       m_container([this](atermpp::term_mark_stack& todo) { mark(todo); },
+                   [this]() { return size_in_terms(); })
+    {}
+
+    normal_form_memo(const normal_form_memo& other)
+     : normal_form_memo(other.m_entries.size())
+    {}
+
+    normal_form_memo& operator=(const normal_form_memo& other) = delete;
+
+    bool enabled() const
+    {
+      return !m_entries.empty();
+    }
+
+    /// \brief Assigns the normal form of t to result when it is stored in the table.
+    /// \returns True iff the normal form of t was found.
+    bool find(data_expression& result, const data_expression& t, atermpp::detail::thread_aterm_pool& pool)
+    {
+      mcrl2::utilities::shared_guard guard = pool.lock_shared();
+      entry& e = m_entries[position(t)];
+      if (e.term != atermpp::detail::address(t))
+      {
+        m_misses++;
+        return false;
+      }
+
+      m_hits++;
+      e.used = true;
+      result.assign(reinterpret_cast<const data_expression&>(e.normal_form), pool);
+      return true;
+    }
+
+    /// \brief Stores that normal_form is the normal form of t.
+    void insert(const data_expression& t, const data_expression& normal_form, atermpp::detail::thread_aterm_pool& pool)
+    {
+      mcrl2::utilities::shared_guard guard = pool.lock_shared();
+      entry& e = m_entries[position(t)];
+      e.term = atermpp::detail::address(t);
+      e.normal_form = atermpp::detail::address(normal_form);
+      e.used = true;
+    }
+
+    std::size_t hits() const
+    {
+      return m_hits;
+    }
+
+    std::size_t misses() const
+    {
+      return m_misses;
+    }
+
+  private:
+    struct entry
+    {
+      const atermpp::detail::_aterm* term = nullptr;
+      const atermpp::detail::_aterm* normal_form = nullptr;
+      bool used = false;
+    };
+
+    static std::size_t capacity(std::size_t size)
+    {
+      return std::bit_ceil(std::max<std::size_t>(size, 2));
+    }
+
+    std::size_t position(const data_expression& t) const
+    {
+      // Fibonacci hashing of the address, as the lower bits of an address are mostly equal.
+      return (reinterpret_cast<std::uintptr_t>(atermpp::detail::address(t)) * 11400714819323198485ull) >> m_shift;
+    }
+
+    // Called by the garbage collector, while no thread can change the table.
+    void mark(atermpp::term_mark_stack& todo)
+    {
+      for (entry& e: m_entries)
+      {
+        if (e.used)
+        {
+          e.used = false;
+          atermpp::detail::mark_term(*e.term, todo);
+          atermpp::detail::mark_term(*e.normal_form, todo);
+        }
+        else
+        {
+          e = entry();
+        }
+      }
+    }
+
+    std::size_t size_in_terms() const
+    {
+      std::size_t result = 0;
+      for (const entry& e: m_entries)
+      {
+        result += (e.term == nullptr ? 0 : 2);
+      }
+      return result;
+    }
+
+    std::vector<entry> m_entries;
+    std::size_t m_shift;
+    std::size_t m_hits = 0;
+    std::size_t m_misses = 0;
+    atermpp::detail::aterm_container m_container;
+};
+
+} // namespace mcrl2::data::detail
+
+#endif // MCRL2_DATA_DETAIL_REWRITE_NORMAL_FORM_MEMO_H
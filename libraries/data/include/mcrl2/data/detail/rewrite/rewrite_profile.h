@@ -0,0 +1,214 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/data/detail/rewrite/rewrite_profile.h
+/// \brief Counters that record how often and how long rewrite rules and function symbols are used.
+
+#ifndef MCRL2_DATA_DETAIL_REWRITE_REWRITE_PROFILE_H
+#define MCRL2_DATA_DETAIL_REWRITE_REWRITE_PROFILE_H
+
+#include <chrono>
+#include <iosfwd>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "mcrl2/data/data_equation.h"
+
+namespace mcrl2::data::detail
+{
+
+using rewrite_profile_clock = std::chrono::steady_clock;
+
+/// \brief The counters of a single rewrite rule.
+struct rewrite_rule_counters
+{
+  std::string rule;                           ///< The printed rule, such that it can be reported at exit.
+  std::size_t attempts = 0;                   ///< The number of times the left hand side was matched.
+  std::size_t applications = 0;               ///< The number of times the rule was applied.
+  rewrite_profile_clock::duration time{};     ///< The time spent on this rule, excluding nested rules.
+};
+
+/// \brief The counters of a single function symbol.
+struct function_symbol_counters
+{
+  std::string symbol;                         ///< The printed symbol and its sort.
+  std::size_t calls = 0;                      ///< The number of terms with this head symbol that were rewritten.
+  rewrite_profile_clock::duration time{};     ///< The time spent on these terms, excluding nested symbols.
+};
+
+/// \brief The counters of the rewriters of one thread.
+/// \details The counters are kept per thread, such that they can be updated without synchronisation. The
+///          counters of all threads are added up when the profile is printed. The rules and symbols are
+///          identified by the address of their term, which is kept alive by the profile such that it is not reused.
+class rewrite_profile
+{
+  public:
+    /// \returns The counters of the given rule, which are created when the rule is used for the first time.
+    rewrite_rule_counters& rule(const data_equation& equation)
+    {
+      auto it = m_rules.find(atermpp::detail::address(equation));
+      return it == m_rules.end() ? add_rule(equation) : it->second;
+    }
+
+    /// \returns The counters of the given symbol, which are created when the symbol is used for the first time.
+    function_symbol_counters& symbol(const function_symbol& f)
+    {
+      auto it = m_symbols.find(atermpp::detail::address(f));
+      return it == m_symbols.end() ? add_symbol(f) : it->second;
+    }
+
+    /// \brief The time of the rules that are applied within the rule that is currently timed.
+    rewrite_profile_clock::duration& nested_rule_time()
+    {
+      return m_nested_rule_time;
+    }
+
+    /// \brief The time of the symbols that are rewritten within the symbol that is currently timed.
+    rewrite_profile_clock::duration& nested_symbol_time()
+    {
+      return m_nested_symbol_time;
+    }
+
+    using rule_map = std::unordered_map<const atermpp::detail::_aterm*, rewrite_rule_counters>;
+    using symbol_map = std::unordered_map<const atermpp::detail::_aterm*, function_symbol_counters>;
+
+    const rule_map& rules() const
+    {
+      return m_rules;
+    }
+
+    const symbol_map& symbols() const
+    {
+      return m_symbols;
+    }
+
+  private:
+    rewrite_rule_counters& add_rule(const data_equation& equation);
+    function_symbol_counters& add_symbol(const function_symbol& f);
+
+    rule_map m_rules;
+    symbol_map m_symbols;
+    std::vector<atermpp::aterm> m_terms;
+    rewrite_profile_clock::duration m_nested_rule_time{};
+    rewrite_profile_clock::duration m_nested_symbol_time{};
+};
+
+/// \brief Enables or disables profiling for the rewriters that are created from now on.
+/// \details A rewriter decides when it is created whether it records a profile, such that rewriters that do not
+///          record a profile do not pay for it. The compiling rewriter only records the function symbols.
+void enable_rewrite_profile(bool enable);
+
+/// \returns True iff newly created rewriters must record a profile.
+bool rewrite_profile_enabled();
+
+/// \returns The profile of the current thread.
+rewrite_profile& local_rewrite_profile();
+
+/// \brief Writes the profile of all threads to the given stream.
+/// \details The rules are sorted on the time spent on them, and the function symbols on the number of calls, of
+///          which only the first number_of_symbols are printed. Must only be called when no other thread rewrites.
+void print_rewrite_profile(std::ostream& os, std::size_t number_of_symbols);
+
+/// \brief Enables profiling and writes the profile when the program exits.
+/// \param filename The file to which the profile is written, or the standard error stream when it is "-".
+/// \param number_of_symbols The number of function symbols with the most calls that are reported.
+void print_rewrite_profile_at_exit(const std::string& filename, std::size_t number_of_symbols);
+
+/// \brief Adds the time between its construction and destruction to a counter.
+/// \details The time of timers that run in between with the same nested time is subtracted, such that the
+///          time of a rule is not counted again for the rules that are applied to rewrite its right hand side.
+class rewrite_profile_timer
+{
+  public:
+    rewrite_profile_timer(rewrite_profile_clock::duration& time, rewrite_profile_clock::duration& nested_time)
+     : m_time(time),
+       m_nested_time(nested_time),
+       m_outer_nested_time(nested_time),
+       m_start(rewrite_profile_clock::now())
+    {
+      m_nested_time = rewrite_profile_clock::duration::zero();
+    }
+
+    rewrite_profile_timer(const rewrite_profile_timer&) = delete;
+    rewrite_profile_timer& operator=(const rewrite_profile_timer&) = delete;
+
+    ~rewrite_profile_timer()
+    {
+      const rewrite_profile_clock::duration elapsed = rewrite_profile_clock::now() - m_start;
+      m_time += elapsed - m_nested_time;
+      m_nested_time = m_outer_nested_time + elapsed;
+    }
+
+  private:
+    rewrite_profile_clock::duration& m_time;
+    rewrite_profile_clock::duration& m_nested_time;
+    rewrite_profile_clock::duration m_outer_nested_time;
+    rewrite_profile_clock::time_point m_start;
+};
+
+/// \brief Records an attempt to apply a rewrite rule, which lasts until the profiler is destroyed.
+/// \details Does nothing when profiling is not enabled for the rewriter.
+class rewrite_rule_profiler
+{
+  public:
+    rewrite_rule_profiler(bool enabled, const data_equation& equation)
+    {
+      if (enabled)
+      {
+        rewrite_profile& profile = local_rewrite_profile();
+        m_counters = &profile.rule(equation);
+        m_counters->attempts++;
+        m_timer.emplace(m_counters->time, profile.nested_rule_time());
+      }
+    }
+
+    rewrite_rule_profiler(const rewrite_rule_profiler&) = delete;
+    rewrite_rule_profiler& operator=(const rewrite_rule_profiler&) = delete;
+
+    /// \brief Records that the rule is applied.
+    void applied()
+    {
+      if (m_counters != nullptr)
+      {
+        m_counters->applications++;
+      }
+    }
+
+  private:
+    rewrite_rule_counters* m_counters = nullptr;
+    std::optional<rewrite_profile_timer> m_timer;
+};
+
+/// \brief Records the rewriting of a term with the given head symbol, which lasts until the profiler is destroyed.
+/// \details Does nothing when profiling is not enabled for the rewriter.
+class function_symbol_profiler
+{
+  public:
+    function_symbol_profiler(bool enabled, const function_symbol& f)
+    {
+      if (enabled)
+      {
+        rewrite_profile& profile = local_rewrite_profile();
+        function_symbol_counters& counters = profile.symbol(f);
+        counters.calls++;
+        m_timer.emplace(counters.time, profile.nested_symbol_time());
+      }
+    }
+
+    function_symbol_profiler(const function_symbol_profiler&) = delete;
+    function_symbol_profiler& operator=(const function_symbol_profiler&) = delete;
+
+  private:
+    std::optional<rewrite_profile_timer> m_timer;
+};
+
+} // namespace mcrl2::data::detail
+
+#endif // MCRL2_DATA_DETAIL_REWRITE_REWRITE_PROFILE_H
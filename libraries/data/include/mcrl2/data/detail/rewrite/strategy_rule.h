@@ -12,6 +12,7 @@
 #define MCRL2_DATA_DETAIL_REWRITE_STRATEGY_RULE_H
 
 #include "mcrl2/data/data_equation.h"
+#include "mcrl2/data/detail/rewrite/match_program.h"
 
 
 
@@ -27,6 +28,7 @@ class strategy_rule
     // this using for instance a union type. 
     enum { data_equation_type, rewrite_index_type, cpp_function_type } m_strategy_element_type;
     data_equation m_rewrite_rule;
+    detail::match_program m_match_program;
     size_t m_rewrite_index = 0UL;
     std::function<void(data_expression&, const data_expression&)> m_cpp_function;
 
@@ -43,7 +45,8 @@ class strategy_rule
 
     strategy_rule(const data_equation& eq)
       : m_strategy_element_type(data_equation_type),
-        m_rewrite_rule(eq)
+        m_rewrite_rule(eq),
+        m_match_program(eq.lhs())
     {}
 
     bool is_rewrite_index() const
@@ -69,6 +72,13 @@ class strategy_rule
       return m_rewrite_rule;
     }
 
+    /// \brief The instructions to match the left hand side of the equation.
+    const detail::match_program& match_program() const
+    {
+      assert(is_equation());
+      return m_match_program;
+    }
+
     std::size_t rewrite_index() const
     {
       assert(is_rewrite_index());
@@ -87,6 +97,7 @@ class strategy
 {
   protected:
     std::size_t m_number_of_variables;
+    std::size_t m_match_stack_size = 0;
     std::vector<strategy_rule> m_rules;
 
   public:
@@ -94,7 +105,15 @@ class strategy
     strategy(size_t n, const std::vector<strategy_rule>& r)
      : m_number_of_variables(n),
        m_rules(r)
-    {}
+    {
+      for (const strategy_rule& rule: m_rules)
+      {
+        if (rule.is_equation())
+        {
+          m_match_stack_size = std::max(m_match_stack_size, rule.match_program().stack_size());
+        }
+      }
+    }
    
     /// \brief Default constructor. 
     strategy()
@@ -107,6 +126,12 @@ class strategy
       return m_number_of_variables; 
     }
 
+    /// \brief Provides the maximal stack size of the match programs of the rewrite rules in this strategy.
+    std::size_t match_stack_size() const
+    {
+      return m_match_stack_size;
+    }
+
     /// \brief Yield the rules of the strategy. 
     const std::vector<strategy_rule>& rules() const 
     { 
@@ -50,6 +50,8 @@ class RewriterProver: public Rewriter
       }
     }
 
+    using Rewriter::rewrite;
+
     void rewrite(data_expression& result, const data_expression& t, substitution_type& sigma) override
     {
       // The prover rewriter should also work on terms with other types than Bool. 
@@ -31,6 +31,8 @@ std::vector<data::rewrite_strategy> initialise_test_rewrite_strategies(const boo
   {
     result.push_back(data::jitty_prover);
   }
+  // The interpreted match trees of the compiling rewriter do not require a compiler.
+  result.push_back(data::jitty_interpreting);
 #ifdef MCRL2_TEST_JITTYC
 #ifdef MCRL2_ENABLE_JITTYC
   result.push_back(data::jitty_compiling);
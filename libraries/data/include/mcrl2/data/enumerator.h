@@ -427,7 +427,7 @@ class enumerator_list_element_with_substitution: public enumerator_list_element<
     ///        when elements of this class are used in an atermpp standard container.
     ///        When garbage collection of aterms is taking place this function is
     ///        called for all elements of this class in the atermpp container. 
-    void mark(std::stack<std::reference_wrapper<atermpp::detail::_aterm>>& todo) const
+    void mark(atermpp::term_mark_stack& todo) const
     {
       mark_term(*atermpp::detail::address(m_variables), todo);
       mark_term(*atermpp::detail::address(m_expressions), todo);
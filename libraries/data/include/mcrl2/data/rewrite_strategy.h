@@ -14,10 +14,11 @@ enum rewrite_strategy
 #ifdef MCRL2_ENABLE_JITTYC
   jitty_compiling,            /** \brief Compiling JITty */
   jitty_prover,               /** \brief JITty + Prover */
-  jitty_compiling_prover      /** \brief Compiling JITty + Prover*/
+  jitty_compiling_prover,     /** \brief Compiling JITty + Prover*/
 #else
-  jitty_prover                /** \brief JITty + Prover */
+  jitty_prover,               /** \brief JITty + Prover */
 #endif
+  jitty_interpreting          /** \brief JITty with the interpreted match trees of compiling JITty */
 };
 
 /// \brief standard conversion from string to rewrite strategy
@@ -32,6 +33,10 @@ rewrite_strategy parse_rewrite_strategy(const std::string& s)
   {
     return jitty_prover;
   }
+  else if (s == "jittyi")
+  {
+    return jitty_interpreting;
+  }
 
 #ifdef MCRL2_ENABLE_JITTYC
   if (s == "jittyc")
@@ -78,6 +83,7 @@ inline std::string pp(const rewrite_strategy s)
 #ifdef MCRL2_ENABLE_JITTYC
     case jitty_compiling_prover: return "jittycp";
 #endif
+    case jitty_interpreting: return "jittyi";
     default: throw mcrl2::runtime_error("unknown rewrite_strategy");
   }
 }
@@ -102,6 +108,7 @@ inline std::string description(const rewrite_strategy s)
 #ifdef MCRL2_ENABLE_JITTYC
     case jitty_compiling_prover: return "compiled jitty rewriting with prover";
 #endif
+    case jitty_interpreting: return "interpreted compiling jitty rewriting, without a C++ compiler";
     default: throw mcrl2::runtime_error("unknown rewrite_strategy");
   }
 }
@@ -236,6 +236,20 @@ class rewriter: public basic_rewriter<data_expression>
 #endif
     }
 
+    /// \brief Rewrites the data expressions in terms under the same substitution.
+    /// \details This is more efficient than rewriting the expressions one by one, e.g., for the
+    ///          next state vector of a summand, as the rewriter is set up once for all expressions.
+    /// \param[out] result The normal forms of the expressions in terms, in the same order.
+    /// \param[in] terms The data expressions to be rewritten.
+    /// \param[in] sigma A substitution function.
+    void operator()(std::vector<data_expression>& result, const std::vector<data_expression>& terms, substitution_type& sigma) const
+    {
+#ifdef MCRL2_COUNT_DATA_REWRITE_CALLS
+      rewrite_calls += terms.size();
+#endif
+      m_rewriter->rewrite(result, terms, sigma);
+    }
+
     ~rewriter()
     {
 #ifdef MCRL2_COUNT_DATA_REWRITE_CALLS
@@ -12,8 +12,13 @@
 #ifndef MCRL2_DATA_REWRITER_TOOL_H
 #define MCRL2_DATA_REWRITER_TOOL_H
 
+#include "mcrl2/atermpp/aterm_garbage_collection.h"
+#include "mcrl2/atermpp/aterm_statistics.h"
 #include "mcrl2/data/detail/enumerator_iteration_limit.h"
+#include "mcrl2/data/detail/rewrite/normal_form_memo.h"
+#include "mcrl2/data/detail/rewrite/rewrite_profile.h"
 #include "mcrl2/data/rewriter.h"
+#include "mcrl2/utilities/block_memory.h"
 #include "mcrl2/utilities/command_line_interface.h"
 
 namespace mcrl2::data::tools
@@ -42,6 +47,7 @@ class rewriter_tool: public Tool
 #ifdef MCRL2_ENABLE_JITTYC
       rewriter_option.add_value(data::jitty_compiling);
 #endif
+      rewriter_option.add_value(data::jitty_interpreting);
       if (!suppress_jittyp)
       {
         rewriter_option.add_value(data::jitty_prover);
@@ -60,7 +66,51 @@ class rewriter_tool: public Tool
         "limit enumeration of universal and existential quantifiers in data expressions to NUM iterations (default NUM=10, NUM=0 for unlimited).",
         'Q'
       );
-
+      desc.add_hidden_option(
+        "rewriter-memo",
+        utilities::make_optional_argument("NUM", "65536"),
+        "remember the normal forms of at most NUM terms of which the arguments are normal forms, such that recurring "
+        "terms, such as operations on large data structures in the state, are not rewritten again (default NUM=65536). "
+        "Normal forms that are not used between two garbage collections are forgotten. Only applies to the jitty rewriter."
+      );
+      desc.add_hidden_option(
+        "aterm-stats",
+        utilities::make_optional_argument("FILE", "-"),
+        "write statistics of the term pool in JSON format to FILE when the tool exits, or to standard error "
+        "if FILE is '-' (default). Setting the environment variable MCRL2_ATERM_STATS to FILE has the same effect."
+      );
+      desc.add_hidden_option(
+        "aterm-incremental-sweep",
+        "destroy the unreachable terms after a garbage collection in small steps between the creation of terms, "
+        "instead of during the garbage collection. Setting the environment variable MCRL2_ATERM_INCREMENTAL_SWEEP "
+        "to 1 has the same effect."
+      );
+      desc.add_hidden_option(
+        "aterm-collection-threads",
+        utilities::make_mandatory_argument("NUM"),
+        "perform garbage collection with NUM threads, where 0 (default) uses one thread for every thread that uses "
+        "terms. Setting the environment variable MCRL2_ATERM_COLLECTION_THREADS to NUM has the same effect."
+      );
+      desc.add_hidden_option(
+        "aterm-huge-pages",
+        utilities::make_optional_argument("MODE", "transparent"),
+        "allocate the terms from regions backed by huge pages, where MODE is 'transparent' (default) for transparent "
+        "huge pages, 'explicit' for huge pages reserved by the system administrator or 'standard' to disable huge pages. "
+        "Every thread allocates from its own regions, which keeps its terms on its NUMA node."
+      );
+      desc.add_hidden_option(
+        "rewriter-profile",
+        utilities::make_optional_argument("FILE", "-"),
+        "record for every rewrite rule how often it is tried and applied and how much time is spent on it, and for "
+        "every function symbol how often a term with that head symbol is rewritten. The rules sorted on time and "
+        "the function symbols sorted on calls are written to FILE when the tool exits, or to standard error if FILE "
+        "is '-' (default). The compiling rewriter only records the function symbols."
+      );
+      desc.add_hidden_option(
+        "rewriter-profile-symbols",
+        utilities::make_mandatory_argument("NUM"),
+        "report the NUM function symbols with the most rewrite calls in the rewriter profile (default NUM=25)."
+      );
     }
 
     /// \brief Add options to an interface description. Also includes
@@ -82,6 +132,39 @@ class rewriter_tool: public Tool
         m_qlimit = (qlimit == 0 ? std::numeric_limits<std::size_t>::max() : qlimit);
       }
       data::detail::set_enumerator_iteration_limit(m_qlimit);
+
+      if (parser.has_option("rewriter-memo"))
+      {
+        data::detail::set_rewriter_memo_size(parser.option_argument_as<std::size_t>("rewriter-memo"));
+      }
+
+      if (parser.has_option("aterm-stats"))
+      {
+        atermpp::print_aterm_statistics_at_exit(parser.option_argument("aterm-stats"));
+      }
+
+      if (parser.has_option("aterm-incremental-sweep"))
+      {
+        atermpp::enable_incremental_sweep(true);
+      }
+
+      if (parser.has_option("aterm-collection-threads"))
+      {
+        atermpp::set_number_of_collection_threads(parser.option_argument_as<std::size_t>("aterm-collection-threads"));
+      }
+
+      if (parser.has_option("aterm-huge-pages"))
+      {
+        utilities::set_block_memory_mode(utilities::parse_block_memory_mode(parser.option_argument("aterm-huge-pages")));
+      }
+
+      if (parser.has_option("rewriter-profile"))
+      {
+        const std::size_t number_of_symbols = parser.has_option("rewriter-profile-symbols")
+                                                ? parser.option_argument_as<std::size_t>("rewriter-profile-symbols")
+                                                : 25;
+        data::detail::print_rewrite_profile_at_exit(parser.option_argument("rewriter-profile"), number_of_symbols);
+      }
     }
 
   public:
@@ -13,6 +13,7 @@
 #include "mcrl2/data/detail/rewrite/jitty_jittyc.h"
 
 #include <boost/config.hpp>
+#include <optional>
 
 #include "mcrl2/data/substitutions/mutable_map_substitution.h"
 #include "mcrl2/data/replace.h"
@@ -205,7 +206,14 @@ RewriterJitty::RewriterJitty(
   rebuild_strategy(data_spec, equation_selector);
 }
 
-RewriterJitty::~RewriterJitty() = default;
+RewriterJitty::~RewriterJitty()
+{
+  if (m_memo.enabled())
+  {
+    mCRL2log(log::verbose) << "The normal form memo of the jitty rewriter was used " << m_memo.hits() << " times and missed " 
+                           << m_memo.misses() << " times.\n";
+  }
+}
 
 // Find the variables that occur in the lhs and the rhs of the assignments;
 //
@@ -342,75 +350,104 @@ void RewriterJitty::subst_values(
   }
 }
 
-// Match term t with the lhs p of an equation.
+// Match the arguments of a term with the left hand side of an equation, given as a match program. The
+// function argument(i) yields the i-th argument of the term, which is a normal form if rewritten_defined[i] holds.
+// The stack must be large enough for the stack size of the program.
+template <class ArgumentFunction>
 static bool match_jitty(
-                    const data_expression& t,
-                    const data_expression& p,
-                    jitty_assignments_for_a_rewrite_rule& assignments,
-                    const bool term_context_guarantees_normal_form)
+                    const match_program& program,
+                    ArgumentFunction argument,
+                    const bool* rewritten_defined,
+                    const data_expression** stack,
+                    jitty_assignments_for_a_rewrite_rule& assignments)
 {
-  if (is_machine_number(p))
+  std::size_t top=0;
+  for (const match_instruction& instruction: program.instructions())
   {
-    return p==t;
-  }
-  else if (is_function_symbol(p))
-  {
-    return p==t;
-  }
-  else if (is_variable(p))
-  {
-
-    for (std::size_t i=0; i<assignments.size; i++)
+    switch (instruction.op)
     {
-      if (p==assignments.assignment[i].var)
+      case match_instruction::bind_argument:
       {
-        return t==assignments.assignment[i].term;
+        new (&assignments.assignment[assignments.size])
+                  jitty_variable_assignment_for_a_rewrite_rule(
+                                    atermpp::down_cast<variable>(instruction.term),
+                                    argument(instruction.index),
+                                    rewritten_defined[instruction.index]);
+        assignments.size++;
+        break;
       }
-    }
-
-    new (&assignments.assignment[assignments.size])
-              jitty_variable_assignment_for_a_rewrite_rule(
-                                atermpp::down_cast<variable>(p),
-                                t,
-                                term_context_guarantees_normal_form);
-    assignments.size++;
-    return true;
-  }
-  else
-  {
-    if (is_machine_number(t) || is_function_symbol(t) || is_variable(t) || is_abstraction(t) || is_where_clause(t))
-    {
-      return false;
-    }
-    // p and t must be applications.
-    assert(term_context_guarantees_normal_form); // If the argument must match an expression it must be a normal form.
-
-    const application& pa=atermpp::down_cast<application>(p);
-    const application& ta=atermpp::down_cast<application>(t);
-    if (pa.size()!=ta.size()) // are p and t applications of the same arity?
-    {
-      return false;
-    }
-
-    if (!match_jitty(ta.head(),
-                     pa.head(),assignments,true))
-    {
-      return false;
-    }
-
-    for (std::size_t i=0; i<pa.size(); i++)
-    {
-      if (!match_jitty(ta[i], pa[i],assignments,true))
+      case match_instruction::match_bound_argument:
+      {
+        if (argument(instruction.index)!=assignments.assignment[instruction.position].term)
+        {
+          return false;
+        }
+        break;
+      }
+      case match_instruction::match_argument:
+      {
+        if (argument(instruction.index)!=instruction.term)
+        {
+          return false;
+        }
+        break;
+      }
+      case match_instruction::push_argument:
+      {
+        stack[top++]=&argument(instruction.index);
+        break;
+      }
+      case match_instruction::bind:
+      {
+        new (&assignments.assignment[assignments.size])
+                  jitty_variable_assignment_for_a_rewrite_rule(
+                                    atermpp::down_cast<variable>(instruction.term),
+                                    *stack[--top],
+                                    true);
+        assignments.size++;
+        break;
+      }
+      case match_instruction::match_bound:
+      {
+        if (*stack[--top]!=assignments.assignment[instruction.position].term)
+        {
+          return false;
+        }
+        break;
+      }
+      case match_instruction::match:
+      {
+        if (*stack[--top]!=instruction.term)
+        {
+          return false;
+        }
+        break;
+      }
+      case match_instruction::match_application:
       {
-        return false;
+        const data_expression& t=*stack[--top];
+        if (!is_application(t))
+        {
+          return false;
+        }
+        const application& ta=atermpp::down_cast<application>(t);
+        if (ta.size()!=instruction.index) // are the pattern and t applications of the same arity?
+        {
+          return false;
+        }
+        for (std::size_t i=ta.size(); i>0; --i)
+        {
+          stack[top++]=&ta[i-1];
+        }
+        stack[top++]=&ta.head();
+        break;
       }
     }
-
-    return true;
   }
+  assert(top==0);
+  return true;
 }
 
-
 // This function applies the rewrite_cpp_code on a higher order term t with op as head symbol for
 // which the code in rewrite_cpp_code must be applied. 
 template <class ITERATOR>
@@ -591,6 +628,7 @@ void RewriterJitty::rewrite_aux_function_symbol(
 
   const std::size_t arity=detail::recursive_number_of_args(term);
   assert(arity>0);
+  function_symbol_profiler symbol_profiler(m_profile, op);
   m_rewrite_stack.increase(arity+1); 
   bool* rewritten_defined = MCRL2_SPECIFIC_STACK_ALLOCATOR(bool, arity);
 
@@ -603,10 +641,18 @@ void RewriterJitty::rewrite_aux_function_symbol(
   make_jitty_strat_sufficiently_larger(op_value);
   const strategy& strat=jitty_strat[op_value];
 
+  // The normal form memo is consulted as soon as the strategy has rewritten all arguments. The key is op applied
+  // to the normal forms of the arguments, which does not depend on sigma. The normal form found by applying a
+  // rule is stored under this key. 
+  const bool use_memo = m_memo.enabled() && term.head()==op;
+  std::size_t number_of_rewritten_arguments = 0;
+  std::optional<data_expression> memo_key;
+
   if (!strat.rules().empty())
   {
     jitty_assignments_for_a_rewrite_rule assignments(
              MCRL2_SPECIFIC_STACK_ALLOCATOR(jitty_variable_assignment_for_a_rewrite_rule, strat.number_of_variables()));
+    const data_expression** match_stack = MCRL2_SPECIFIC_STACK_ALLOCATOR(const data_expression*, strat.match_stack_size());
 
     for (const strategy_rule& rule : strat.rules())
     {
@@ -627,6 +673,18 @@ void RewriterJitty::rewrite_aux_function_symbol(
               rewrite_aux(m_rewrite_stack.element(i,arity+1),detail::get_argument_of_higher_order_term(term,i),sigma);
             }
             rewritten_defined[i]=true;
+            number_of_rewritten_arguments++;
+            if (use_memo && number_of_rewritten_arguments==arity)
+            {
+              memo_key.emplace();
+              make_application(*memo_key,op,m_rewrite_stack.stack_iterator(0,arity+1), 
+                                            m_rewrite_stack.stack_iterator(arity,arity+1));
+              if (m_memo.find(result, *memo_key, *m_thread_aterm_pool))
+              {
+                m_rewrite_stack.decrease(arity+1);
+                return;
+              }
+            }
           }
           assert(m_rewrite_stack.element(i,arity+1).defined());
         }
@@ -646,6 +704,10 @@ void RewriterJitty::rewrite_aux_function_symbol(
           application rewriteable_term(op, m_rewrite_stack.stack_iterator(0,arity+1),
                                            m_rewrite_stack.stack_iterator(arity,arity+1)); /* TODO Optimize */
           rule.rewrite_cpp_code()(result, rewriteable_term);
+          if (memo_key)
+          {
+            m_memo.insert(*memo_key, result, *m_thread_aterm_pool);
+          }
           m_rewrite_stack.decrease(arity+1);
           return;
         }
@@ -674,31 +736,26 @@ void RewriterJitty::rewrite_aux_function_symbol(
       else
       {
         const data_equation& rule1=rule.equation();
-        const data_expression& lhs=rule1.lhs();
-        std::size_t rule_arity = (is_function_symbol(lhs)?0:detail::recursive_number_of_args(lhs));
+        const match_program& program=rule.match_program();
+        const std::size_t rule_arity = program.arity();
 
         if (rule_arity > arity)
         {
           break;
         }
 
+        rewrite_rule_profiler rule_profiler(m_profile, rule1);
         assert(assignments.size==0);
 
-        bool matches = true;
-        for (std::size_t i=0; i<rule_arity; i++)
-        {
-          assert(i<arity);
-          if (!match_jitty(rewritten_defined[i]?
-                                 m_rewrite_stack.get_element(i,arity+1):
-                                 detail::get_argument_of_higher_order_term(term,i),
-                           detail::get_argument_of_higher_order_term(atermpp::down_cast<application>(lhs),i),
-                           assignments,rewritten_defined[i]))
-          {
-            matches = false;
-            break;
-          }
-        }
-        if (matches)
+        if (match_jitty(program,
+                        [&](std::size_t i) -> const data_expression&
+                        {
+                          assert(i<arity);
+                          return rewritten_defined[i]?
+                                   m_rewrite_stack.get_element(i,arity+1):
+                                   detail::get_argument_of_higher_order_term(term,i);
+                        },
+                        rewritten_defined, match_stack, assignments))
         {
           bool condition_of_this_rule=false;
           if (rule1.condition()==sort_bool::true_())
@@ -713,12 +770,17 @@ void RewriterJitty::rewrite_aux_function_symbol(
           }
           if (condition_of_this_rule)
           {
+            rule_profiler.applied();
             const data_expression& rhs=rule1.rhs();
 
             if (arity == rule_arity)
             {
               subst_values(m_rewrite_stack.top(),assignments,rhs,m_generator);
               rewrite_aux(result, m_rewrite_stack.top(),sigma);
+              if (memo_key)
+              {
+                m_memo.insert(*memo_key, result, *m_thread_aterm_pool);
+              }
               m_rewrite_stack.decrease(arity+1);
               return;
             }
@@ -796,6 +858,11 @@ void RewriterJitty::rewrite_aux_function_symbol(
     sort = &fsort.codomain();
   }
 
+  if (memo_key)
+  {
+    // Record that no rule applies, such that the rules are not matched again.
+    m_memo.insert(*memo_key, result, *m_thread_aterm_pool);
+  }
   m_rewrite_stack.decrease(arity+1);
   return; 
 }
@@ -810,6 +877,7 @@ void RewriterJitty::rewrite_aux_const_function_symbol(
 
   const std::size_t op_value=atermpp::detail::index_traits<data::function_symbol,function_symbol_key_type, 2>::index(op);
   make_jitty_strat_sufficiently_larger(op_value);
+  function_symbol_profiler symbol_profiler(m_profile, op);
 
   // Cache the rhs's as they are rewritten very often. 
   if (rhs_for_constants_cache.size()<=op_value)
@@ -854,8 +922,10 @@ void RewriterJitty::rewrite_aux_const_function_symbol(
         break;
       }
 
+      rewrite_rule_profiler rule_profiler(m_profile, rule1);
       if (rule1.condition()==sort_bool::true_())
       { 
+        rule_profiler.applied();
         rewrite_aux(result,rule1.rhs(),sigma);
         rhs_for_constants_cache[op_value]=result;
         return;
@@ -863,6 +933,7 @@ void RewriterJitty::rewrite_aux_const_function_symbol(
       rewrite_aux(result,rule1.condition(),sigma);
       if (result==sort_bool::true_())
       {
+        rule_profiler.applied();
         rewrite_aux(result,rule1.rhs(),sigma);
         rhs_for_constants_cache[op_value]=result;
         return;
@@ -912,6 +983,50 @@ void RewriterJitty::rewrite(
   return;
 }
 
+void RewriterJitty::rewrite(
+     std::vector<data_expression>& result,
+     const std::vector<data_expression>& terms,
+     substitution_type& sigma)
+{
+  // The terms are rewritten within one rewriting session, such that the set up and the restart
+  // after a stack overflow are done once for all terms, instead of once per term.
+  result.resize(terms.size());
+  if (rewriting_in_progress)
+  {
+    for (std::size_t i=0; i<terms.size(); ++i)
+    {
+#ifdef MCRL2_DISPLAY_REWRITE_STATISTICS
+      data::detail::increment_rewrite_count();
+#endif
+      rewrite_aux(result[i], terms[i], sigma);
+    }
+    return;
+  }
+
+  assert(m_rewrite_stack.stack_size()==0);
+  rewriting_in_progress=true;
+  try
+  {
+    for (std::size_t i=0; i<terms.size(); ++i)
+    {
+#ifdef MCRL2_DISPLAY_REWRITE_STATISTICS
+      data::detail::increment_rewrite_count();
+#endif
+      rewrite_aux(result[i], terms[i], sigma);
+      assert(remove_normal_form_function(result[i])==result[i]);
+    }
+  }
+  catch (recalculate_term_as_stack_is_too_small&)
+  {
+    rewriting_in_progress=false; // Restart rewriting all terms, due to a stack overflow.
+    m_rewrite_stack.reserve_more_space();
+    rewrite(result,terms,sigma);
+    return;
+  }
+  rewriting_in_progress=false;
+  assert(m_rewrite_stack.stack_size()==0);
+}
+
 data_expression RewriterJitty::rewrite(
      const data_expression& term,
      substitution_type& sigma)
@@ -13,17 +13,21 @@
 #include "mcrl2/data/sort_expression.h"
 
 #ifdef MCRL2_ENABLE_JITTYC
-
 #include <unistd.h>
 #include <sys/stat.h>
+#endif
 
 #include "mcrl2/atermpp/algorithm.h"
+#include "mcrl2/atermpp/aterm_io.h"
 #include "mcrl2/atermpp/detail/aterm_list_implementation.h"
+#include "mcrl2/data/detail/io.h"
 #include "mcrl2/data/detail/rewrite/jitty_jittyc.h"
 #include "mcrl2/data/detail/rewrite/jittyc.h"
 #include "mcrl2/data/replace.h"
 #include "mcrl2/utilities/basename.h"
 #include "mcrl2/utilities/stopwatch.h"
+#include <filesystem>
+#include <iomanip>
 #include <memory>
 
 #ifdef MCRL2_DISPLAY_REWRITE_STATISTICS
@@ -40,6 +44,8 @@ using namespace mcrl2::log;
 namespace mcrl2::data::detail
 {
 
+#ifdef MCRL2_ENABLE_JITTYC
+
 // Some compilers can only deal with a limited number of nested curly brackets. 
 // This limit can be increased by using -fbracket-depth=C where C is a new constant
 // value. By default this value C often appears to be 256. But not all compilers 
@@ -58,6 +64,8 @@ class bracket_level_data
     std::stack< std::string > current_data_arguments;
 };
 
+#endif // MCRL2_ENABLE_JITTYC
+
 /// This function returns the variables that occur in a complex subexpression within f.
 /// For instance in f(n+1,m) it returns {n}. In m+f(n1+1,n2) it returns {n1}. 
 /// The effect is that such variables n, and n1, must be in normalform, before evaluation.
@@ -185,6 +193,7 @@ static std::vector<bool> dep_vars(const data_equation& eqn)
   return result;
 }
 
+#ifdef MCRL2_ENABLE_JITTYC
 static std::size_t calc_max_arity(const function_symbol_vector& symbols)
 {
   std::size_t max_arity = 0;
@@ -196,32 +205,9 @@ static std::size_t calc_max_arity(const function_symbol_vector& symbols)
 
   return max_arity;
 }
+#endif // MCRL2_ENABLE_JITTYC
 
 
-///
-/// \brief arity_is_allowed yields true if the function indicated by the function index can
-///        legitemately be used with a arguments. A function f:D1x...xDn->D can be used with 0 and
-///        n arguments. A function f:(D1x...xDn)->(E1x...Em)->F can be used with 0, n, and n+m
-///        arguments.
-/// \param s A function sort
-/// \param a The desired number of arguments
-/// \return A boolean indicating whether a term of sort s applied to a arguments is a valid term.
-///
-static bool arity_is_allowed(const sort_expression& s, const std::size_t a)
-{
-  if (a == 0)
-  {
-    return true;
-  }
-  if (is_function_sort(s))
-  {
-    const function_sort& fs = atermpp::down_cast<function_sort>(s);
-    std::size_t n = fs.domain().size();
-    return n <= a && arity_is_allowed(fs.codomain(), a - n);
-  }
-  return false;
-}
-
 void RewriterCompilingJitty::term2seq(const data_expression& t, match_tree_list& s, std::size_t *var_cnt, const bool omit_head)
 {
   if (is_machine_number(t))
@@ -951,6 +937,8 @@ void RewriterCompilingJitty::extend_nfs(nfs_array& nfs, const function_symbol& o
   }
 }
 
+#ifdef MCRL2_ENABLE_JITTYC
+
 class rewr_function_spec
 {
   protected:
@@ -1584,14 +1572,14 @@ class RewriterCompilingJitty::ImplementTree
       if (target_for_output.empty())
       { 
         RewriterCompilingJitty::substitution_type sigma;
-        s << m_rewriter.m_nf_cache->insert(m_rewriter.jitty_rewriter(t,sigma));
+        s << m_rewriter.m_generated_terms->insert(m_rewriter.jitty_rewriter(t,sigma));
       }
       else
       {
         RewriterCompilingJitty::substitution_type sigma;
         s << m_padding << target_for_output 
           << ".unprotected_assign<false>("
-          << m_rewriter.m_nf_cache->insert(m_rewriter.jitty_rewriter(t,sigma)) 
+          << m_rewriter.m_generated_terms->insert(m_rewriter.jitty_rewriter(t,sigma)) 
           << ");\n";
       }
       result_type << "data_expression";
@@ -1905,7 +1893,7 @@ class RewriterCompilingJitty::ImplementTree
              std::map<variable,std::string>& type_of_code_variables)
   {
     bool reset_current_data_parameters=false;
-    const void* func = (void*)(atermpp::detail::address(tree.function()));
+    const std::string func = m_rewriter.m_generated_terms->address(tree.function());
     m_stream << m_padding;
     brackets.bracket_nesting_level++;
     if (level == 0)
@@ -1986,7 +1974,7 @@ class RewriterCompilingJitty::ImplementTree
              std::map<variable,std::string>& type_of_code_variables)
   {
     bool reset_current_data_parameters=false;
-    const void* number = (void*)(atermpp::detail::address(tree.number()));
+    const std::string number = m_rewriter.m_generated_terms->address(tree.number());
     m_stream << m_padding;
     brackets.bracket_nesting_level++;
     if (level == 0)
@@ -2588,15 +2576,12 @@ public:
     {
       m_stream << m_padding << "result.unprotected_assign<false>(";
       RewriterCompilingJitty::substitution_type sigma;
-      m_stream << m_rewriter.m_nf_cache->insert(m_rewriter.jitty_rewriter(opid,sigma)) << ");\n";
+      m_stream << m_rewriter.m_generated_terms->insert(m_rewriter.jitty_rewriter(opid,sigma)) << ");\n";
     }
     else
     {
-      std::stringstream ss;
-      ss << "this_rewriter->normal_forms_for_constants[" 
-         << atermpp::detail::index_traits<data::function_symbol, function_symbol_key_type, 2>::index(opid) 
-         << "]";
-      rewr_function_finish_term(m_stream, arity, ss.str(), down_cast<function_sort>(opid.sort()));
+      RewriterCompilingJitty::substitution_type sigma;
+      rewr_function_finish_term(m_stream, arity, m_rewriter.m_generated_terms->insert(m_rewriter.jitty_rewriter(opid,sigma)), down_cast<function_sort>(opid.sort()));
     } 
   }
 
@@ -2648,6 +2633,11 @@ public:
     rewr_function_signature(m_stream, index, arity, brackets);
     m_stream << m_padding << "{\n";
     m_padding.indent();
+    if (m_rewriter.m_profile)
+    {
+      m_stream << m_padding << "function_symbol_profiler symbol_profiler(true, down_cast<function_symbol>("
+               << m_rewriter.m_generated_terms->insert(func) << "));\n";
+    }
     implement_strategy(m_stream, strategy, arity, func, brackets, auxiliary_code_fragments,data_spec);
     m_stream << m_padding << "return;\n";
     m_padding.unindent();
@@ -2863,16 +2853,10 @@ void RewriterCompilingJitty::generate_code(const std::string& filename)
   // jittycpreamble.h.
   ImplementTree code_generator(*this, function_symbols);
 
-  index_bound = atermpp::detail::index_traits<data::function_symbol, function_symbol_key_type, 2>::max_index() + 1;
-
-  functions_when_arguments_are_not_in_normal_form = std::vector<rewriter_function>(arity_bound * index_bound);
-  functions_when_arguments_are_in_normal_form = std::vector<rewriter_function>(arity_bound * index_bound);
-
-  cpp_file << "#define INDEX_BOUND__ " << index_bound << "// These values are not used anymore.\n"
-              "#define ARITY_BOUND__ " << arity_bound << "// These values are not used anymore.\n";
-  cpp_file << "#include \"mcrl2/data/detail/rewrite/jittycpreamble.h\"\n";
-
-  cpp_file << "namespace {\n"
+  // The generated code is first stored in a separate buffer, because the table of terms that it
+  // uses must be declared before it, and is only complete when all code has been generated.
+  std::stringstream code;
+  code << "namespace {\n"
                "// Anonymous namespace so the compiler uses internal linkage for the generated\n"
                "// rewrite code.\n"
                "\n"
@@ -2913,115 +2897,295 @@ void RewriterCompilingJitty::generate_code(const std::string& filename)
   rewr_code << "};\n"
                "} // namespace\n";
 
-  code_generator.generate_delayed_application_functions(cpp_file);
+  code_generator.generate_delayed_application_functions(code);
 
-  cpp_file << rewr_code.str();
+  code << rewr_code.str();
 
-  cpp_file << "void set_the_precompiled_rewrite_functions_in_a_lookup_table(RewriterCompilingJitty* this_rewriter)\n"
-              "{\n";
-  cpp_file << "  assert(&this_rewriter->functions_when_arguments_are_not_in_normal_form == (void *)" << &functions_when_arguments_are_not_in_normal_form << ");  // Check that this table matches the one rewriter is actually using.\n";
-  cpp_file << "  assert(&this_rewriter->functions_when_arguments_are_in_normal_form == (void *)" << &functions_when_arguments_are_in_normal_form << ");  // Check that this table matches the one rewriter is actually using.\n";
-  cpp_file << "  for(rewriter_function& f: this_rewriter->functions_when_arguments_are_not_in_normal_form)\n"
-           << "  {\n"
-           << "    f = nullptr;\n"
-           << "  }\n";
-  cpp_file << "  for(rewriter_function& f: this_rewriter->functions_when_arguments_are_in_normal_form)\n"
-           << "  {\n"
-           << "    f = nullptr;\n"
-           << "  }\n";
-
-  // Fill tables with the rewrite functions
+  // The tables are filled when the rewriter is loaded, using the indices of the function symbols in
+  // the loading process.
+  code << "void set_the_precompiled_rewrite_functions_in_a_lookup_table(RewriterCompilingJitty* this_rewriter)\n"
+          "{\n";
+  std::stringstream fill_tables;
   RewriterCompilingJitty::substitution_type sigma;
-  normal_forms_for_constants.clear();
   for (const rewr_function_spec& f: code_generator.implemented_rewrs())
   {
     if (!f.delayed())
     {
-      std::size_t index = atermpp::detail::index_traits<data::function_symbol, function_symbol_key_type, 2>::index(f.fs());
       if (f.arity()>0)
       {
-        cpp_file << "  this_rewriter->functions_when_arguments_are_not_in_normal_form[this_rewriter->arity_bound * "
-                 << index
-                 << " + " << f.arity() << "] = rewr_functions::"
-                 << f.name() << "_term;\n";
-        cpp_file << "  this_rewriter->functions_when_arguments_are_in_normal_form[this_rewriter->arity_bound * "
-                 << index
-                 << " + " << f.arity() << "] = rewr_functions::"
-                 << f.name() << "_term_arg_in_normal_form;\n";
+        fill_tables << "  set_precompiled_rewrite_functions(" << m_generated_terms->insert(f.fs()) << ", " << f.arity() 
+                    << ", rewr_functions::" << f.name() << "_term"
+                    << ", rewr_functions::" << f.name() << "_term_arg_in_normal_form, this_rewriter);\n";
       }
       else
       { 
-        if (index>=normal_forms_for_constants.size())
-        {
-          normal_forms_for_constants.resize(index+1);
-        }
-        normal_forms_for_constants[index]=jitty_rewriter(f.fs(),sigma);
+        fill_tables << "  set_normal_form_for_constant(" << m_generated_terms->insert(f.fs()) << ", "
+                    << m_generated_terms->insert(jitty_rewriter(f.fs(),sigma)) << ", this_rewriter);\n";
       }
     }
   }
 
+  code << "  const std::vector<data_expression>& terms = this_rewriter->initialise_generated_terms(generated_terms_text, " << arity_bound << ");\n"
+          "  for (std::size_t i = 0; i < terms.size(); ++i)\n"
+          "  {\n"
+          "    generated_terms[i] = atermpp::detail::address(terms[i]);\n"
+          "  }\n";
+  code << fill_tables.str();
+  code << "}\n";
 
-  cpp_file << "}\n";
+  cpp_file << "#include \"mcrl2/data/detail/rewrite/jittycpreamble.h\"\n";
+  cpp_file << "\n"
+              "// The terms used by the generated code, which are restored from their textual representation when the\n"
+              "// rewriter is loaded. The generated code does not contain any address of the process that generated it.\n";
+  cpp_file << "static const atermpp::detail::_aterm* generated_terms[" << std::max<std::size_t>(1, m_generated_terms->terms().size()) << "];\n";
+  cpp_file << "static const char* const generated_terms_text = R\"jittyc_terms(" << generated_terms_text() << ")jittyc_terms\";\n\n";
+  cpp_file << code.str();
   cpp_file.close();
 }
 
-void RewriterCompilingJitty::BuildRewriteSystem()
+const std::vector<data_expression>& RewriterCompilingJitty::initialise_generated_terms(const std::string& text, std::size_t arity_bound)
 {
-  CleanupRewriteSystem();
+  const aterm_list tables = down_cast<aterm_list>(data::detail::add_index(read_term_from_string(text)));
+  assert(tables.size() == 3);
+  auto it = tables.begin();
 
-  // Try to find out from environment which compile script to use.
-  // If not set, choose one of the following two:
-  // * if "mcrl2compilerewriter" is in the same directory as the executable,
-  //   this is the version we favour. This is especially needed for single
-  //   bundle applications on MacOSX. Furthermore, it is the more foolproof
-  //   approach on other platforms.
-  // * by default, fall back to the system provided mcrl2compilerewriter script.
-  //   in this case, we rely on the script being available in the user's
-  //   $PATH environment variable.
-  std::string compile_script;
-  const char* env_compile_script = std::getenv("MCRL2_COMPILEREWRITER");
-  if (env_compile_script != nullptr)
+  std::vector<data_expression> terms;
+  for (const aterm& t: down_cast<aterm_list>(*it++))
   {
-    compile_script = env_compile_script;
+    terms.push_back(down_cast<data_expression>(t));
   }
-  else if(mcrl2::utilities::file_exists(mcrl2::utilities::get_executable_basename() + "/mcrl2compilerewriter"))
+  m_generated_terms->assign(terms);
+
+  rewriter_bound_variables.clear();
+  for (const aterm& v: down_cast<aterm_list>(*it++))
   {
-    compile_script = mcrl2::utilities::get_executable_basename() + "/mcrl2compilerewriter";
+    rewriter_bound_variables.push_back(down_cast<variable>(v));
   }
-  else
+
+  rewriter_binding_variable_lists.clear();
+  for (const aterm& vl: down_cast<aterm_list>(*it++))
   {
-    compile_script = "mcrl2compilerewriter";
+    rewriter_binding_variable_lists.push_back(down_cast<variable_list>(vl));
   }
 
-  rewriter_so = std::make_shared<uncompiled_library>(compile_script);
+  // All function symbols used by the rewriter exist now, so their indices are below the index bound.
+  this->arity_bound = arity_bound;
+  index_bound = atermpp::detail::index_traits<data::function_symbol, function_symbol_key_type, 2>::max_index() + 1;
+  functions_when_arguments_are_not_in_normal_form.assign(arity_bound * index_bound, nullptr);
+  functions_when_arguments_are_in_normal_form.assign(arity_bound * index_bound, nullptr);
+  normal_forms_for_constants.clear();
 
-  mCRL2log(verbose) << "using '" << compile_script << "' to compile rewriter." << std::endl;
-  stopwatch time;
+  return m_generated_terms->terms();
+}
 
-  jittyc_eqns.clear();
-  for (const data_equation& rewrite_rule: rewrite_rules)
+std::string RewriterCompilingJitty::generated_terms_text() const
+{
+  const aterm_list tables({
+    aterm_list(m_generated_terms->terms().begin(), m_generated_terms->terms().end()),
+    aterm_list(rewriter_bound_variables.begin(), rewriter_bound_variables.end()),
+    aterm_list(rewriter_binding_variable_lists.begin(), rewriter_binding_variable_lists.end())});
+
+  // The indices of function symbols and variables are specific for this process, and are restored when reading.
+  std::ostringstream text;
+  write_term_to_text_stream(data::detail::remove_index(tables), text);
+  return text.str();
+}
+
+
+
+/// \brief Returns the directory in which compiled rewriters are cached, or an empty string if the
+///        cache is disabled. The cache is only used when the environment variable MCRL2_JITTYC_CACHE
+///        is set to the directory, as every cached rewriter takes several megabytes.
+static std::string jittyc_cache_directory()
+{
+  const char* env_cache = std::getenv("MCRL2_JITTYC_CACHE");
+  if (env_cache == nullptr || *env_cache == '\0')
   {
-    jittyc_eqns[down_cast<function_symbol>(get_nested_head(rewrite_rule.lhs()))].push_front(rewrite_rule);
+    return std::string();
   }
+  const std::filesystem::path directory(env_cache);
 
-  std::string cpp_file = generate_cpp_filename(reinterpret_cast<std::size_t>(this));
-  generate_code(cpp_file);
+  std::error_code error;
+  std::filesystem::create_directories(directory, error);
+  if (error)
+  {
+    mCRL2log(verbose) << "cannot use '" << directory.string() << "' to cache compiled rewriters: " << error.message() << "." << std::endl;
+    return std::string();
+  }
+  return directory.string();
+}
 
-  mCRL2log(verbose) << "generated " << cpp_file << " in " << time.time() << "ms, compiling..." << std::endl;
-  time.reset();
+/// \brief Returns the path and the version of the compiler that the default compile script selects.
+static std::string compiler_version()
+{
+  FILE* stream = popen("CXX=\"${CXX:-$(command -v c++ || command -v clang++ || command -v g++ || echo c++)}\"; "
+                       "echo \"$CXX\"; \"$CXX\" --version 2>/dev/null", "r");
+  if (stream == nullptr)
+  {
+    return std::string();
+  }
 
-  try
+  std::string result;
+  std::array<char, 1024> buffer;
+  while (fgets(buffer.data(), buffer.size(), stream) != nullptr)
   {
-    rewriter_so->compile(cpp_file);
+    result += buffer.data();
   }
-  catch(std::runtime_error& e)
+  pclose(stream);
+  return result;
+}
+
+/// \brief The 64-bit FNV-1a hash of the given text, continuing from the given hash.
+static std::uint64_t fnv1a_hash(const std::string& text, std::uint64_t hash = 14695981039346656037ULL)
+{
+  for (const char c: text)
   {
-    rewriter_so->leave_files();
-    throw mcrl2::runtime_error(std::string("Could not compile rewriter: ") + e.what());
+    hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
   }
+  return hash;
+}
 
-  mCRL2log(verbose) << "compiled in " << time.time() << "ms, loading rewriter..." << std::endl;
+/// \brief Returns a hash of the contents of all files in the directories that the compile script passes
+///        with -I to the compiler. These contain jittycpreamble.h and all headers that it includes, which
+///        are compiled into the rewriter together with the generated code.
+static std::uint64_t include_directories_hash(const std::string& script)
+{
+  std::vector<std::string> directories;
+  for (std::size_t position = script.find("-I"); position != std::string::npos; position = script.find("-I", position + 2))
+  {
+    std::size_t begin = position + 2;
+    std::size_t end;
+    if (begin < script.size() && script[begin] == '"')
+    {
+      ++begin;
+      end = script.find('"', begin);
+    }
+    else
+    {
+      end = script.find_first_of(" \t\n", begin);
+    }
+    directories.push_back(script.substr(begin, end == std::string::npos ? std::string::npos : end - begin));
+  }
+
+  std::vector<std::filesystem::path> files;
+  for (const std::string& directory: directories)
+  {
+    std::error_code error;
+    for (std::filesystem::recursive_directory_iterator it(directory, error), end; !error && it != end; it.increment(error))
+    {
+      if (it->is_regular_file(error))
+      {
+        files.push_back(it->path());
+      }
+    }
+  }
+  std::sort(files.begin(), files.end());
+
+  std::uint64_t hash = fnv1a_hash(std::string());
+  for (const std::filesystem::path& file: files)
+  {
+    std::ifstream stream(file, std::ios::binary);
+    std::ostringstream contents;
+    contents << stream.rdbuf();
+    hash = fnv1a_hash(file.string(), hash);
+    hash = fnv1a_hash(contents.str(), hash);
+  }
+  return hash;
+}
+
+/// \brief Appends the textual representation of t, without the indices that are specific for this process.
+static void write_key_part(std::vector<std::string>& parts, const char* kind, const atermpp::aterm& t)
+{
+  std::ostringstream text;
+  text << kind << " ";
+  write_term_to_text_stream(data::detail::remove_index(t), text);
+  parts.push_back(text.str());
+}
+
+std::string RewriterCompilingJitty::cache_filename(const std::string& compile_script) const
+{
+  const std::string directory = jittyc_cache_directory();
+  if (directory.empty())
+  {
+    return std::string();
+  }
+
+  // The key consists of everything that determines the compiled rewriter: the version and build of the
+  // toolset, the compile script with its compiler flags, the compiler, the headers that are included by the
+  // generated code, and the rewrite rules and function symbols that are used.
+  std::ostringstream script_text;
+  std::ifstream script(compile_script);
+  if (script)
+  {
+    script_text << script.rdbuf();
+  }
+
+  std::ostringstream key;
+  key << mcrl2::utilities::get_toolset_version() << "\n"
+      << sizeof(RewriterCompilingJitty) << "\n"
+      << compile_script << "\n"
+      << "profile " << m_profile << "\n"
+      << script_text.str() << "\n"
+      << compiler_version() << "\n"
+      << "headers " << include_directories_hash(script_text.str()) << "\n";
+
+  // The rules and symbols are sorted, as their order in the sets depends on the addresses of the terms.
+  std::vector<std::string> parts;
+  for (const data_equation& rule: rewrite_rules)
+  {
+    write_key_part(parts, "equation", rule);
+  }
+  for (const function_symbol& f: m_data_specification_for_enumeration.constructors())
+  {
+    if (data_equation_selector(f))
+    {
+      write_key_part(parts, "constructor", f);
+    }
+  }
+  for (const function_symbol& f: m_data_specification_for_enumeration.mappings())
+  {
+    if (data_equation_selector(f))
+    {
+      write_key_part(parts, "mapping", f);
+    }
+  }
+  std::sort(parts.begin(), parts.end());
+  for (const std::string& part: parts)
+  {
+    key << part << "\n";
+  }
+
+  std::ostringstream filename;
+  filename << "jittyc_" << std::hex << std::setfill('0') << std::setw(16) << fnv1a_hash(key.str())
+           << std::setw(16) << std::hash<std::string>()(key.str()) << ".so";
+  return (std::filesystem::path(directory) / filename.str()).string();
+}
+
+/// \brief Copies the compiled library to the cache. The copy is renamed when it is complete, such that
+///        other processes never load a partially written library.
+static void store_in_cache(const std::string& library, const std::string& cache_file)
+{
+  const std::string temporary_file = cache_file + "." + std::to_string(getpid()) + ".tmp";
+  std::error_code error;
+  std::filesystem::copy_file(library, temporary_file, std::filesystem::copy_options::overwrite_existing, error);
+  if (!error)
+  {
+    std::filesystem::rename(temporary_file, cache_file, error);
+  }
 
+  if (error)
+  {
+    mCRL2log(verbose) << "could not store the compiled rewriter in the cache: " << error.message() << "." << std::endl;
+    std::filesystem::remove(temporary_file, error);
+  }
+  else
+  {
+    mCRL2log(verbose) << "stored the compiled rewriter as '" << cache_file << "'." << std::endl;
+  }
+}
+
+void RewriterCompilingJitty::load_rewriter()
+{
   bool (*init)(rewriter_interface*, RewriterCompilingJitty* this_rewriter);
   rewriter_interface interface = {.caller_toolset_version = mcrl2::utilities::get_toolset_version(),
       .status = "Unknown error when loading rewriter.",
@@ -3067,15 +3231,107 @@ void RewriterCompilingJitty::BuildRewriteSystem()
   mCRL2log(verbose) << interface.status << std::endl;
 }
 
+void RewriterCompilingJitty::BuildRewriteSystem()
+{
+  CleanupRewriteSystem();
+
+  // Try to find out from environment which compile script to use.
+  // If not set, choose one of the following two:
+  // * if "mcrl2compilerewriter" is in the same directory as the executable,
+  //   this is the version we favour. This is especially needed for single
+  //   bundle applications on MacOSX. Furthermore, it is the more foolproof
+  //   approach on other platforms.
+  // * by default, fall back to the system provided mcrl2compilerewriter script.
+  //   in this case, we rely on the script being available in the user's
+  //   $PATH environment variable.
+  std::string compile_script;
+  const char* env_compile_script = std::getenv("MCRL2_COMPILEREWRITER");
+  if (env_compile_script != nullptr)
+  {
+    compile_script = env_compile_script;
+  }
+  else if(mcrl2::utilities::file_exists(mcrl2::utilities::get_executable_basename() + "/mcrl2compilerewriter"))
+  {
+    compile_script = mcrl2::utilities::get_executable_basename() + "/mcrl2compilerewriter";
+  }
+  else
+  {
+    compile_script = "mcrl2compilerewriter";
+  }
+
+  // Use the rewriter that was compiled for the same rewrite rules by an earlier run, if it is cached.
+  const std::string cache_file = cache_filename(compile_script);
+  if (!cache_file.empty() && mcrl2::utilities::file_exists(cache_file))
+  {
+    rewriter_so = std::make_shared<uncompiled_library>(compile_script);
+    rewriter_so->use_compiled(cache_file);
+    try
+    {
+      load_rewriter();
+      mCRL2log(verbose) << "loaded the compiled rewriter '" << cache_file << "' from the cache (hit)." << std::endl;
+      return;
+    }
+    catch (std::runtime_error& e)
+    {
+      mCRL2log(verbose) << "could not load the cached rewriter '" << cache_file << "', compiling it again: " << e.what() << std::endl;
+    }
+  }
+  else if (!cache_file.empty())
+  {
+    mCRL2log(verbose) << "the compiled rewriter is not in the cache (miss)." << std::endl;
+  }
+
+  rewriter_so = std::make_shared<uncompiled_library>(compile_script);
+
+  mCRL2log(verbose) << "using '" << compile_script << "' to compile rewriter." << std::endl;
+  stopwatch time;
+
+  std::string cpp_file = generate_cpp_filename(reinterpret_cast<std::size_t>(this));
+  generate_code(cpp_file);
+
+  mCRL2log(verbose) << "generated " << cpp_file << " in " << time.time() << "ms, compiling..." << std::endl;
+  time.reset();
+
+  try
+  {
+    rewriter_so->compile(cpp_file);
+  }
+  catch(std::runtime_error& e)
+  {
+    rewriter_so->leave_files();
+    throw mcrl2::runtime_error(std::string("Could not compile rewriter: ") + e.what());
+  }
+
+  mCRL2log(verbose) << "compiled in " << time.time() << "ms, loading rewriter..." << std::endl;
+
+  if (!cache_file.empty())
+  {
+    store_in_cache(rewriter_so->library_filename(), cache_file);
+  }
+
+  load_rewriter();
+}
+
 RewriterCompilingJitty::RewriterCompilingJitty(
                           const data_specification& data_spec,
                           const used_data_equation_selector& equation_selector)
+  : RewriterCompilingJitty(data_spec, equation_selector, true)
+{
+}
+
+#endif // MCRL2_ENABLE_JITTYC
+
+RewriterCompilingJitty::RewriterCompilingJitty(
+                          const data_specification& data_spec,
+                          const used_data_equation_selector& equation_selector,
+                          [[maybe_unused]] const bool compile)
   : Rewriter(data_spec,equation_selector),
-    jitty_rewriter(data_spec,equation_selector),
-    m_nf_cache(new normal_form_cache())
+    jitty_rewriter(data_spec,equation_selector)
+#ifdef MCRL2_ENABLE_JITTYC
+    , m_generated_terms(new generated_term_table())
+#endif
 {
   thread_initialise();
-  assert(m_nf_cache->empty());
   so_rewr_cleanup = nullptr;
   so_rewr = nullptr;
   rewriting_in_progress = false;
@@ -3104,14 +3360,30 @@ RewriterCompilingJitty::RewriterCompilingJitty(
     }
   }
 
-  BuildRewriteSystem();
+  for (const data_equation& rewrite_rule: rewrite_rules)
+  {
+    jittyc_eqns[down_cast<function_symbol>(get_nested_head(rewrite_rule.lhs()))].push_front(rewrite_rule);
+  }
+
+#ifdef MCRL2_ENABLE_JITTYC
+  if (compile)
+  {
+    BuildRewriteSystem();
+  }
+#else
+  assert(!compile);
+#endif
 }
 
 RewriterCompilingJitty::~RewriterCompilingJitty()
 {
+#ifdef MCRL2_ENABLE_JITTYC
   CleanupRewriteSystem();
+#endif
 }
 
+#ifdef MCRL2_ENABLE_JITTYC
+
 void RewriterCompilingJitty::rewrite(
      data_expression& result,
      const data_expression& term,
@@ -3153,6 +3425,54 @@ void RewriterCompilingJitty::rewrite(
   return;
 }
 
+void RewriterCompilingJitty::rewrite(
+     std::vector<data_expression>& result,
+     const std::vector<data_expression>& terms,
+     substitution_type& sigma)
+{
+  // The substitution is installed once for all terms, and the terms are rewritten within one
+  // rewriting session, such that a stack overflow restarts the rewriting of all terms.
+  result.resize(terms.size());
+  substitution_type *saved_sigma=global_sigma;
+  global_sigma=&sigma;
+  if (rewriting_in_progress)
+  {
+    for (std::size_t i=0; i<terms.size(); ++i)
+    {
+#ifdef MCRL2_DISPLAY_REWRITE_STATISTICS
+      data::detail::increment_rewrite_count();
+#endif
+      so_rewr(result[i], terms[i], this);
+    }
+  }
+  else
+  {
+    rewriting_in_progress=true;
+    try
+    {
+      for (std::size_t i=0; i<terms.size(); ++i)
+      {
+#ifdef MCRL2_DISPLAY_REWRITE_STATISTICS
+        data::detail::increment_rewrite_count();
+#endif
+        so_rewr(result[i], terms[i], this);
+      }
+    }
+    catch (recalculate_term_as_stack_is_too_small&)
+    {
+      rewriting_in_progress=false; // Restart rewriting all terms, due to a stack overflow.
+      m_rewrite_stack.reserve_more_space();
+      global_sigma=saved_sigma;
+      rewrite(result,terms,sigma);
+      return;
+    }
+    rewriting_in_progress=false;
+    assert(m_rewrite_stack.stack_size()==0);
+  }
+
+  global_sigma=saved_sigma;
+}
+
 data_expression RewriterCompilingJitty::rewrite(
      const data_expression& term,
      substitution_type& sigma)
@@ -3167,8 +3487,6 @@ rewrite_strategy RewriterCompilingJitty::getStrategy()
   return jitty_compiling;
 }
 
-}
-
-
+#endif // MCRL2_ENABLE_JITTYC
 
-#endif
+}
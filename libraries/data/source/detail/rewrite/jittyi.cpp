@@ -0,0 +1,769 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file jittyi.cpp
+
+#include "mcrl2/atermpp/algorithm.h"
+#include "mcrl2/data/detail/rewrite/jitty_jittyc.h"
+#include "mcrl2/data/detail/rewrite/jittyi.h"
+#include "mcrl2/data/replace_capture_avoiding.h"
+#include "mcrl2/utilities/stopwatch.h"
+
+#ifdef MCRL2_DISPLAY_REWRITE_STATISTICS
+#include "mcrl2/data/detail/rewrite_statistics.h"
+#endif
+
+using namespace mcrl2::log;
+
+namespace mcrl2::data::detail
+{
+
+static std::size_t get_index(const function_symbol& f)
+{
+  return atermpp::detail::index_traits<function_symbol, function_symbol_key_type, 2>::index(f);
+}
+
+// Applies head to the arguments in [begin, end), using as many applications as the sort of head requires.
+template <class ITERATOR>
+static data_expression apply_to_arguments(const data_expression& head, ITERATOR begin, const ITERATOR end)
+{
+  data_expression result = head;
+  sort_expression s = head.sort();
+  while (begin != end)
+  {
+    const function_sort& fs = atermpp::down_cast<function_sort>(s);
+    const ITERATOR next = begin + fs.domain().size();
+    result = application(result, begin, next);
+    s = fs.codomain();
+    begin = next;
+  }
+  return result;
+}
+
+RewriterInterpretingJitty::RewriterInterpretingJitty(
+                          const data_specification& data_spec,
+                          const used_data_equation_selector& equation_selector)
+  : RewriterCompilingJitty(data_spec, equation_selector, false)
+{
+  stopwatch time;
+
+  // First determine the strategies of all function symbols with rewrite rules, for all numbers of arguments
+  // to which they can be applied, as the right hand sides refer to the strategies of other function symbols.
+  std::map<std::pair<function_symbol, std::size_t>, match_tree_list> strategies;
+  rewritten_arguments_map rewritten_arguments;
+  std::size_t index_bound = 0;
+  for (const auto& [f, equations]: jittyc_eqns)
+  {
+    const std::size_t max_arity = getArity(f);
+    for (std::size_t arity = 0; arity <= max_arity; ++arity)
+    {
+      if (arity_is_allowed(f.sort(), arity))
+      {
+        const match_tree_list strategy = create_strategy(equations, arity);
+        std::vector<bool> rewritten(arity, false);
+        for (const match_tree& tree: strategy)
+        {
+          if (!tree.isA())
+          {
+            break;
+          }
+          rewritten[atermpp::down_cast<match_tree_A>(tree).variable_index()] = true;
+        }
+        strategies.emplace(std::make_pair(f, arity), strategy);
+        rewritten_arguments.emplace(std::make_pair(f, arity), rewritten);
+      }
+    }
+    m_arity_bound = std::max(m_arity_bound, max_arity + 1);
+    index_bound = std::max(index_bound, get_index(f) + 1);
+  }
+  for (const auto& [f, implementation]: data_spec.cpp_implemented_functions())
+  {
+    m_arity_bound = std::max(m_arity_bound, getArity(f) + 1);
+    index_bound = std::max(index_bound, get_index(f) + 1);
+  }
+
+  std::vector<interpreter_program> programs(index_bound * m_arity_bound);
+  for (const auto& [key, strategy]: strategies)
+  {
+    const auto& [f, arity] = key;
+    interpreter_program& program = programs[get_index(f) * m_arity_bound + arity];
+    program.number_of_registers = arity;
+    for (const match_tree& tree: strategy)
+    {
+      if (tree.isA())
+      {
+        program.instructions.push_back({interpreter_instruction::rewrite_argument, atermpp::down_cast<match_tree_A>(tree).variable_index()});
+      }
+      else
+      {
+        std::vector<std::pair<std::size_t, std::size_t>> stack;
+        std::vector<std::size_t> failures;
+        translate_tree(program, tree, 0, 0, 0, stack, std::map<variable, std::size_t>(), failures, rewritten_arguments);
+        for (const std::size_t i: failures)
+        {
+          program.instructions[i].on_failure = program.instructions.size();
+        }
+      }
+    }
+    program.instructions.push_back({interpreter_instruction::finish});
+    if (arity == 0)
+    {
+      substitution_type sigma;
+      program.normal_form = jitty_rewriter(f, sigma);
+    }
+  }
+  for (const auto& [f, implementation]: data_spec.cpp_implemented_functions())
+  {
+    for (std::size_t arity = get_direct_arity(f); arity <= getArity(f); ++arity)
+    {
+      if (arity_is_allowed(f.sort(), arity))
+      {
+        programs[get_index(f) * m_arity_bound + arity].cpp_function = implementation.first;
+      }
+    }
+  }
+  m_programs = std::make_shared<const std::vector<interpreter_program>>(std::move(programs));
+
+  mCRL2log(verbose) << "translated the rewrite rules into " << strategies.size() << " programs in " << time.time() << "ms." << std::endl;
+}
+
+void RewriterInterpretingJitty::translate_tree(
+                   interpreter_program& program,
+                   const match_tree& tree,
+                   const std::size_t cur_arg,
+                   const std::size_t parent,
+                   const std::size_t level,
+                   std::vector<std::pair<std::size_t, std::size_t>>& stack,
+                   const std::map<variable, std::size_t>& variables,
+                   std::vector<std::size_t>& failures,
+                   const rewritten_arguments_map& rewritten_arguments)
+{
+  // As in the code generated by the compiling rewriter, the current term is argument cur_arg at level 0,
+  // and otherwise the argument at position cur_arg of the term in register parent.
+  const std::size_t source = level == 0 ? cur_arg : parent;
+  const std::size_t position = level == 0 ? 0 : cur_arg;
+  const std::size_t instruction = program.instructions.size();
+
+  if (tree.isS())
+  {
+    const match_tree_S& tree_S = atermpp::down_cast<match_tree_S>(tree);
+    if (atermpp::find_if(tree_S.subtree(), [&](const atermpp::aterm& t) { return t == tree_S.target_variable(); }) == atermpp::aterm())
+    {
+      translate_tree(program, tree_S.subtree(), cur_arg, parent, level, stack, variables, failures, rewritten_arguments);
+      return;
+    }
+    std::map<variable, std::size_t> extended_variables = variables;
+    extended_variables[tree_S.target_variable()] = program.number_of_registers;
+    program.instructions.push_back({interpreter_instruction::bind, source, position, program.number_of_registers++});
+    translate_tree(program, tree_S.subtree(), cur_arg, parent, level, stack, extended_variables, failures, rewritten_arguments);
+  }
+  else if (tree.isM())
+  {
+    const match_tree_M& tree_M = atermpp::down_cast<match_tree_M>(tree);
+    program.instructions.push_back({interpreter_instruction::match_bound, source, position, variables.at(tree_M.match_variable())});
+    translate_tree(program, tree_M.true_tree(), cur_arg, parent, level, stack, variables, failures, rewritten_arguments);
+    program.instructions[instruction].on_failure = program.instructions.size();
+    translate_tree(program, tree_M.false_tree(), cur_arg, parent, level, stack, variables, failures, rewritten_arguments);
+  }
+  else if (tree.isF() || tree.isMachineNumber())
+  {
+    // The arguments of a matched argument are inspected in its own register, and those of a matched subterm
+    // in a new register.
+    const bool is_F = tree.isF();
+    const data_expression& term = is_F ? static_cast<const data_expression&>(atermpp::down_cast<match_tree_F>(tree).function())
+                                       : static_cast<const data_expression&>(atermpp::down_cast<match_tree_MachineNumber>(tree).number());
+    const match_tree& true_tree = is_F ? atermpp::down_cast<match_tree_F>(tree).true_tree() : atermpp::down_cast<match_tree_MachineNumber>(tree).true_tree();
+    const match_tree& false_tree = is_F ? atermpp::down_cast<match_tree_F>(tree).false_tree() : atermpp::down_cast<match_tree_MachineNumber>(tree).false_tree();
+    const std::size_t target = level == 0 ? cur_arg : program.number_of_registers++;
+    program.instructions.push_back({is_F && is_function_sort(term.sort()) ? interpreter_instruction::match_head : interpreter_instruction::match_term,
+                                    source, position, target, 0, term});
+    stack.emplace_back(cur_arg, parent);
+    translate_tree(program, true_tree, 1, target, level + 1, stack, variables, failures, rewritten_arguments);
+    stack.pop_back();
+    program.instructions[instruction].on_failure = program.instructions.size();
+    translate_tree(program, false_tree, cur_arg, parent, level, stack, variables, failures, rewritten_arguments);
+  }
+  else if (tree.isD())
+  {
+    const std::pair<std::size_t, std::size_t> up = stack.back();
+    stack.pop_back();
+    translate_tree(program, atermpp::down_cast<match_tree_D>(tree).subtree(), up.first, up.second, level - 1, stack, variables, failures, rewritten_arguments);
+    stack.push_back(up);
+  }
+  else if (tree.isN())
+  {
+    translate_tree(program, atermpp::down_cast<match_tree_N>(tree).subtree(), cur_arg + 1, parent, level, stack, variables, failures, rewritten_arguments);
+  }
+  else if (tree.isC())
+  {
+    const match_tree_C& tree_C = atermpp::down_cast<match_tree_C>(tree);
+    const std::size_t condition = translate_term(program, tree_C.condition(), variables, rewritten_arguments);
+    program.instructions.push_back({interpreter_instruction::condition, 0, 0, condition});
+    translate_tree(program, tree_C.true_tree(), cur_arg, parent, level, stack, variables, failures, rewritten_arguments);
+    program.instructions[instruction].on_failure = program.instructions.size();
+    translate_tree(program, tree_C.false_tree(), cur_arg, parent, level, stack, variables, failures, rewritten_arguments);
+  }
+  else if (tree.isR())
+  {
+    const std::size_t result = translate_term(program, atermpp::down_cast<match_tree_R>(tree).result(), variables, rewritten_arguments);
+    program.instructions.push_back({interpreter_instruction::result, 0, 0, result});
+  }
+  else
+  {
+    // No rule applies, and the jump to the next part of the strategy is set when its position is known.
+    assert(tree.isX());
+    failures.push_back(instruction);
+    program.instructions.push_back({interpreter_instruction::jump});
+  }
+}
+
+std::size_t RewriterInterpretingJitty::translate_term(
+                   interpreter_program& program,
+                   const data_expression& t,
+                   const std::map<variable, std::size_t>& variables,
+                   const rewritten_arguments_map& rewritten_arguments)
+{
+  interpreter_node node;
+  const std::set<variable> free_variables = find_free_variables(t);
+  if (free_variables.empty())
+  {
+    // As in the compiling rewriter, terms without variables are rewritten beforehand.
+    substitution_type sigma;
+    node.kind = interpreter_node::normal_form;
+    node.term = jitty_rewriter(t, sigma);
+  }
+  else if (is_variable(t))
+  {
+    node.kind = interpreter_node::bound_variable;
+    node.index = variables.at(atermpp::down_cast<variable>(t));
+  }
+  else if (is_application(t) && is_function_symbol(get_nested_head(t)))
+  {
+    const function_symbol& f = atermpp::down_cast<function_symbol>(get_nested_head(t));
+    const std::size_t arity = recursive_number_of_args(t);
+    node.kind = interpreter_node::function;
+    node.term = f;
+    for (std::size_t i = 0; i < arity; ++i)
+    {
+      node.arguments.push_back(translate_term(program, get_argument_of_higher_order_term(atermpp::down_cast<application>(t), i),
+                                              variables, rewritten_arguments));
+    }
+    // The arguments of function symbols without rewrite rules are all rewritten.
+    const auto i = rewritten_arguments.find(std::make_pair(f, arity));
+    node.arguments_in_normal_form = i == rewritten_arguments.end() ? std::vector<bool>(arity, true) : i->second;
+  }
+  else
+  {
+    node.kind = interpreter_node::other;
+    node.term = t;
+    for (const variable& v: free_variables)
+    {
+      node.variables.emplace_back(v, variables.at(v));
+    }
+  }
+  program.nodes.push_back(node);
+  return program.nodes.size() - 1;
+}
+
+const interpreter_program* RewriterInterpretingJitty::program(const function_symbol& f, const std::size_t arity) const
+{
+  const std::size_t index = get_index(f) * m_arity_bound + arity;
+  if (arity >= m_arity_bound || index >= m_programs->size())
+  {
+    return nullptr;
+  }
+  const interpreter_program& result = (*m_programs)[index];
+  if (result.instructions.empty() && !result.cpp_function)
+  {
+    return nullptr;
+  }
+  return &result;
+}
+
+void RewriterInterpretingJitty::normalise(const std::size_t index, substitution_type& sigma)
+{
+  if (!m_registers[index].normal_form)
+  {
+    // The registers can be moved while the term is rewritten.
+    const data_expression t = std::move(m_registers[index].term);
+    data_expression result;
+    rewrite_aux(result, t, sigma);
+    m_registers[index] = {result, true};
+  }
+}
+
+void RewriterInterpretingJitty::finish(
+                   data_expression& result,
+                   const function_symbol& f,
+                   const std::size_t arity,
+                   const std::size_t frame,
+                   substitution_type& sigma)
+{
+  const std::size_t base = m_arguments.size();
+  for (std::size_t i = 0; i < arity; ++i)
+  {
+    normalise(frame + i, sigma);
+    m_arguments.push_back(m_registers[frame + i].term);
+  }
+  result = apply_to_arguments(f, m_arguments.begin() + base, m_arguments.end());
+  m_arguments.resize(base);
+}
+
+void RewriterInterpretingJitty::apply_function(
+                   data_expression& result,
+                   const function_symbol& f,
+                   const std::size_t arity,
+                   const std::size_t frame,
+                   substitution_type& sigma)
+{
+  const interpreter_program* p = program(f, arity);
+  if (p == nullptr)
+  {
+    finish(result, f, arity, frame, sigma);
+  }
+  else if (p->cpp_function)
+  {
+    // The C++ function is applied to its direct arguments, and the result to the remaining arguments.
+    const std::size_t base = m_arguments.size();
+    for (std::size_t i = 0; i < arity; ++i)
+    {
+      normalise(frame + i, sigma);
+      m_arguments.push_back(m_registers[frame + i].term);
+    }
+    const std::size_t direct_arity = get_direct_arity(f);
+    p->cpp_function(result, application(f, m_arguments.begin() + base, m_arguments.begin() + base + direct_arity));
+    if (arity > direct_arity)
+    {
+      const data_expression t = apply_to_arguments(result, m_arguments.begin() + base + direct_arity, m_arguments.end());
+      m_arguments.resize(base);
+      rewrite_with_arguments_in_normal_form(result, atermpp::down_cast<application>(t), sigma);
+    }
+    else
+    {
+      m_arguments.resize(base);
+    }
+  }
+  else
+  {
+    execute(result, *p, f, arity, frame, sigma);
+  }
+  m_registers.resize(frame);
+}
+
+void RewriterInterpretingJitty::execute(
+                   data_expression& result,
+                   const interpreter_program& program,
+                   const function_symbol& f,
+                   const std::size_t arity,
+                   const std::size_t frame,
+                   substitution_type& sigma)
+{
+  m_registers.resize(frame + program.number_of_registers);
+
+  // The term that is inspected by an instruction.
+  auto inspected = [&](const interpreter_instruction& instruction) -> const data_expression&
+  {
+    const data_expression& t = m_registers[frame + instruction.source].term;
+    return instruction.position == 0 ? t : atermpp::down_cast<data_expression>(t[instruction.position]);
+  };
+
+  std::size_t pc = 0;
+  while (true)
+  {
+    const interpreter_instruction& instruction = program.instructions[pc];
+    switch (instruction.op)
+    {
+      case interpreter_instruction::rewrite_argument:
+      {
+        normalise(frame + instruction.source, sigma);
+        ++pc;
+        break;
+      }
+      case interpreter_instruction::bind:
+      {
+        interpreter_register& target = m_registers[frame + instruction.target];
+        const interpreter_register& source = m_registers[frame + instruction.source];
+        if (instruction.position != 0)
+        {
+          target = {atermpp::down_cast<data_expression>(source.term[instruction.position]), true};
+        }
+        else if (!source.normal_form && is_application(source.term)
+                 && atermpp::down_cast<application>(source.term).head() == jitty_rewriter.this_term_is_in_normal_form())
+        {
+          target = {atermpp::down_cast<application>(source.term)[0], true};
+        }
+        else
+        {
+          target = source;
+        }
+        ++pc;
+        break;
+      }
+      case interpreter_instruction::match_bound:
+      {
+        pc = inspected(instruction) == m_registers[frame + instruction.target].term ? pc + 1 : instruction.on_failure;
+        break;
+      }
+      case interpreter_instruction::match_term:
+      case interpreter_instruction::match_head:
+      {
+        const data_expression& t = inspected(instruction);
+        bool matches = false;
+        if (instruction.op == interpreter_instruction::match_term)
+        {
+          matches = t == instruction.term;
+        }
+        else
+        {
+          // Only an argument can be matched by the function symbol itself, as in the compiling rewriter.
+          matches = (is_application(t) && atermpp::down_cast<application>(t).head() == instruction.term)
+                    || (instruction.position == 0 && t == instruction.term);
+        }
+        if (!matches)
+        {
+          pc = instruction.on_failure;
+          break;
+        }
+        if (instruction.position != 0)
+        {
+          m_registers[frame + instruction.target] = {t, true};
+        }
+        ++pc;
+        break;
+      }
+      case interpreter_instruction::condition:
+      {
+        data_expression condition;
+        evaluate(condition, program, instruction.target, frame, sigma);
+        pc = condition == sort_bool::true_() ? pc + 1 : instruction.on_failure;
+        break;
+      }
+      case interpreter_instruction::result:
+      {
+        evaluate(result, program, instruction.target, frame, sigma);
+        return;
+      }
+      case interpreter_instruction::jump:
+      {
+        pc = instruction.on_failure;
+        break;
+      }
+      case interpreter_instruction::finish:
+      {
+        finish(result, f, arity, frame, sigma);
+        return;
+      }
+    }
+  }
+}
+
+void RewriterInterpretingJitty::evaluate(
+                   data_expression& result,
+                   const interpreter_program& program,
+                   const std::size_t node,
+                   const std::size_t frame,
+                   substitution_type& sigma)
+{
+  const interpreter_node& n = program.nodes[node];
+  switch (n.kind)
+  {
+    case interpreter_node::normal_form:
+    {
+      result = n.term;
+      return;
+    }
+    case interpreter_node::bound_variable:
+    {
+      normalise(frame + n.index, sigma);
+      result = m_registers[frame + n.index].term;
+      return;
+    }
+    case interpreter_node::function:
+    {
+      // The arguments are stored in the registers of the function that is applied.
+      const std::size_t arguments_frame = m_registers.size();
+      m_registers.resize(arguments_frame + n.arguments.size());
+      for (std::size_t i = 0; i < n.arguments.size(); ++i)
+      {
+        const interpreter_node& argument = program.nodes[n.arguments[i]];
+        if (argument.kind == interpreter_node::bound_variable && !n.arguments_in_normal_form[i])
+        {
+          m_registers[arguments_frame + i] = m_registers[frame + argument.index];
+        }
+        else if (argument.kind == interpreter_node::normal_form || n.arguments_in_normal_form[i])
+        {
+          data_expression value;
+          evaluate(value, program, n.arguments[i], frame, sigma);
+          m_registers[arguments_frame + i] = {value, true};
+        }
+        else
+        {
+          m_registers[arguments_frame + i] = {delay(program, n.arguments[i], frame), false};
+        }
+      }
+      apply_function(result, atermpp::down_cast<function_symbol>(n.term), n.arguments.size(), arguments_frame, sigma);
+      return;
+    }
+    case interpreter_node::other:
+    {
+      // The variables are rewritten to normal form, as in the compiling rewriter.
+      substitution_type variables;
+      for (const auto& [v, index]: n.variables)
+      {
+        normalise(frame + index, sigma);
+        variables[v] = m_registers[frame + index].term;
+      }
+      rewrite_aux(result, n.term, variables);
+      return;
+    }
+  }
+}
+
+data_expression RewriterInterpretingJitty::delay(const interpreter_program& program, const std::size_t node, const std::size_t frame)
+{
+  // A value in normal form is marked, such that it is not rewritten again.
+  auto value = [&](const std::size_t index) -> data_expression
+  {
+    const interpreter_register& r = m_registers[frame + index];
+    if (r.normal_form && !is_function_symbol(r.term) && !is_machine_number(r.term))
+    {
+      return application(jitty_rewriter.this_term_is_in_normal_form(), r.term);
+    }
+    return r.term;
+  };
+
+  const interpreter_node& n = program.nodes[node];
+  switch (n.kind)
+  {
+    case interpreter_node::normal_form:
+    {
+      return n.term;
+    }
+    case interpreter_node::bound_variable:
+    {
+      return value(n.index);
+    }
+    case interpreter_node::function:
+    {
+      const std::size_t base = m_arguments.size();
+      for (const std::size_t argument: n.arguments)
+      {
+        m_arguments.push_back(delay(program, argument, frame));
+      }
+      data_expression result = apply_to_arguments(n.term, m_arguments.begin() + base, m_arguments.end());
+      m_arguments.resize(base);
+      return result;
+    }
+    case interpreter_node::other:
+    {
+      mutable_map_substitution<> variables;
+      for (const auto& [v, index]: n.variables)
+      {
+        variables[v] = value(index);
+      }
+      return replace_variables_capture_avoiding(n.term, variables);
+    }
+  }
+  return data_expression();
+}
+
+void RewriterInterpretingJitty::rewrite_with_arguments_in_normal_form(
+                   data_expression& result,
+                   const application& t,
+                   substitution_type& sigma)
+{
+  const data_expression& head = get_nested_head(t);
+  if (is_function_symbol(head))
+  {
+    const std::size_t arity = recursive_number_of_args(t);
+    const std::size_t frame = m_registers.size();
+    for (std::size_t i = 0; i < arity; ++i)
+    {
+      m_registers.push_back({get_argument_of_higher_order_term(t, i), true});
+    }
+    apply_function(result, atermpp::down_cast<function_symbol>(head), arity, frame, sigma);
+    return;
+  }
+  if (is_variable(head))
+  {
+    result = t;
+    return;
+  }
+  assert(is_lambda(head));
+  rewrite_lambda_application(result, t, sigma, true);
+}
+
+// The head of t below all applications, where a term that is marked to be in normal form counts as a head.
+static const data_expression& get_nested_head(const data_expression& t, const function_symbol& normal_form_marker)
+{
+  if (is_application(t) && atermpp::down_cast<application>(t).head() != normal_form_marker)
+  {
+    return get_nested_head(atermpp::down_cast<application>(t).head(), normal_form_marker);
+  }
+  return t;
+}
+
+// Rewrites the arguments of t, also those of nested applications, and replaces the nested head by head.
+static data_expression rewrite_arguments(const data_expression& t,
+                                         const data_expression& head,
+                                         const function_symbol& normal_form_marker,
+                                         const std::function<data_expression(const data_expression&)>& rewrite)
+{
+  if (!is_application(t) || atermpp::down_cast<application>(t).head() == normal_form_marker)
+  {
+    return head;
+  }
+  const application& ta = atermpp::down_cast<application>(t);
+  return application(rewrite_arguments(ta.head(), head, normal_form_marker, rewrite), ta.begin(), ta.end(), rewrite);
+}
+
+void RewriterInterpretingJitty::rewrite_aux(
+                   data_expression& result,
+                   const data_expression& term,
+                   substitution_type& sigma)
+{
+  if (is_machine_number(term))
+  {
+    result = term;
+    return;
+  }
+  if (is_function_symbol(term))
+  {
+    const interpreter_program* p = program(atermpp::down_cast<function_symbol>(term), 0);
+    result = p == nullptr || !p->normal_form.defined() ? term : p->normal_form;
+    return;
+  }
+  if (is_variable(term))
+  {
+    sigma.apply(atermpp::down_cast<variable>(term), result, *m_thread_aterm_pool);
+    return;
+  }
+  if (is_application(term))
+  {
+    const application& t = atermpp::down_cast<application>(term);
+    if (t.head() == jitty_rewriter.this_term_is_in_normal_form())
+    {
+      result = t[0];
+      return;
+    }
+    const function_symbol& normal_form_marker = jitty_rewriter.this_term_is_in_normal_form();
+    const data_expression& head = get_nested_head(t);
+    if (is_function_symbol(head) && head != normal_form_marker)
+    {
+      const std::size_t arity = recursive_number_of_args(t);
+      const std::size_t frame = m_registers.size();
+      for (std::size_t i = 0; i < arity; ++i)
+      {
+        m_registers.push_back({get_argument_of_higher_order_term(t, i), false});
+      }
+      apply_function(result, atermpp::down_cast<function_symbol>(head), arity, frame, sigma);
+      return;
+    }
+    if (is_abstraction(head))
+    {
+      const abstraction& a = atermpp::down_cast<abstraction>(head);
+      if (is_lambda_binder(a.binding_operator()))
+      {
+        rewrite_lambda_application(result, t, sigma);
+      }
+      else if (is_exists_binder(a.binding_operator()))
+      {
+        existential_quantifier_enumeration(result, a, sigma);
+      }
+      else
+      {
+        universal_quantifier_enumeration(result, a, sigma);
+      }
+      return;
+    }
+    // The head is a variable, a where clause or a term in normal form, which is rewritten before the arguments are.
+    data_expression rewritten_head;
+    rewrite_aux(rewritten_head, get_nested_head(t, normal_form_marker), sigma);
+    const data_expression t1 = rewrite_arguments(t, rewritten_head, normal_form_marker, [&](const data_expression& u)
+                                                 {
+                                                   data_expression r;
+                                                   rewrite_aux(r, u, sigma);
+                                                   return r;
+                                                 });
+    if (is_application(t1))
+    {
+      rewrite_with_arguments_in_normal_form(result, atermpp::down_cast<application>(t1), sigma);
+    }
+    else
+    {
+      result = t1;
+    }
+    return;
+  }
+  if (is_abstraction(term))
+  {
+    const abstraction& a = atermpp::down_cast<abstraction>(term);
+    if (is_exists_binder(a.binding_operator()))
+    {
+      existential_quantifier_enumeration(result, a, sigma);
+      return;
+    }
+    if (is_forall_binder(a.binding_operator()))
+    {
+      universal_quantifier_enumeration(result, a, sigma);
+      return;
+    }
+    assert(is_lambda_binder(a.binding_operator()));
+    rewrite_single_lambda(result, a.variables(), a.body(), sigma, false);
+    return;
+  }
+  assert(is_where_clause(term));
+  rewrite_where(result, atermpp::down_cast<where_clause>(term), sigma);
+}
+
+void RewriterInterpretingJitty::rewrite(
+     data_expression& result,
+     const data_expression& term,
+     substitution_type& sigma)
+{
+#ifdef MCRL2_DISPLAY_REWRITE_STATISTICS
+  data::detail::increment_rewrite_count();
+#endif
+  // The registers and arguments of programs that are interrupted by an exception are removed.
+  const std::size_t frame = m_registers.size();
+  const std::size_t base = m_arguments.size();
+  try
+  {
+    rewrite_aux(result, term, sigma);
+  }
+  catch (...)
+  {
+    m_registers.resize(frame);
+    m_arguments.resize(base);
+    throw;
+  }
+}
+
+void RewriterInterpretingJitty::rewrite(
+     std::vector<data_expression>& result,
+     const std::vector<data_expression>& terms,
+     substitution_type& sigma)
+{
+  Rewriter::rewrite(result, terms, sigma);
+}
+
+data_expression RewriterInterpretingJitty::rewrite(
+     const data_expression& term,
+     substitution_type& sigma)
+{
+  data_expression result;
+  rewrite(result, term, sigma);
+  return result;
+}
+
+rewrite_strategy RewriterInterpretingJitty::getStrategy()
+{
+  return jitty_interpreting;
+}
+
+} // namespace mcrl2::data::detail
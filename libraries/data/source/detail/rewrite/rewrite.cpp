@@ -12,9 +12,7 @@
 #include "mcrl2/data/detail/rewrite/jitty_jittyc.h"
 #include "mcrl2/data/detail/enumerator_iteration_limit.h"
 
-#ifdef MCRL2_ENABLE_JITTYC
-#include "mcrl2/data/detail/rewrite/jittyc.h"
-#endif
+#include "mcrl2/data/detail/rewrite/jittyi.h"
 
 #include "mcrl2/data/detail/rewrite/with_prover.h"
 
@@ -514,6 +512,8 @@ std::shared_ptr<Rewriter> createRewriter(
     case jitty_compiling_prover:
       return std::shared_ptr<Rewriter>(new RewriterProver(data_spec,jitty_compiling,equations_selector));
 #endif
+    case jitty_interpreting:
+      return std::shared_ptr<Rewriter>(new RewriterInterpretingJitty(data_spec,equations_selector));
     default: throw mcrl2::runtime_error("Cannot create a rewriter using strategy " + pp(strategy) + ".");
   }
 }
@@ -0,0 +1,197 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "mcrl2/data/detail/rewrite/rewrite_profile.h"
+#include "mcrl2/data/print.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace mcrl2::data::detail
+{
+
+static std::atomic<bool>& profile_enabled()
+{
+  static std::atomic<bool> enabled(false);
+  return enabled;
+}
+
+// The mutex, the profiles of all threads and the output settings are never freed, as the profile is printed
+// at exit, after the static objects may have been destroyed and the threads have terminated.
+static std::mutex& profiles_mutex()
+{
+  static std::mutex* mutex = new std::mutex();
+  return *mutex;
+}
+
+static std::vector<rewrite_profile*>& profiles()
+{
+  static std::vector<rewrite_profile*>* profiles = new std::vector<rewrite_profile*>();
+  return *profiles;
+}
+
+static std::pair<std::string, std::size_t>& profile_output()
+{
+  static std::pair<std::string, std::size_t>* output = new std::pair<std::string, std::size_t>();
+  return *output;
+}
+
+rewrite_rule_counters& rewrite_profile::add_rule(const data_equation& equation)
+{
+  m_terms.push_back(equation);
+  return m_rules.emplace(atermpp::detail::address(equation), rewrite_rule_counters{pp(equation)}).first->second;
+}
+
+function_symbol_counters& rewrite_profile::add_symbol(const function_symbol& f)
+{
+  m_terms.push_back(f);
+  return m_symbols.emplace(atermpp::detail::address(f), function_symbol_counters{pp(f) + ": " + pp(f.sort())}).first->second;
+}
+
+void enable_rewrite_profile(bool enable)
+{
+  profile_enabled() = enable;
+}
+
+bool rewrite_profile_enabled()
+{
+  return profile_enabled().load(std::memory_order_relaxed);
+}
+
+rewrite_profile& local_rewrite_profile()
+{
+  thread_local rewrite_profile* profile = nullptr;
+  if (profile == nullptr)
+  {
+    profile = new rewrite_profile();
+    std::lock_guard<std::mutex> guard(profiles_mutex());
+    profiles().push_back(profile);
+  }
+  return *profile;
+}
+
+static double seconds(rewrite_profile_clock::duration time)
+{
+  return std::chrono::duration<double>(time).count();
+}
+
+// Only the strings and counters in the profiles are used, as no terms can be accessed at exit.
+void print_rewrite_profile(std::ostream& os, std::size_t number_of_symbols)
+{
+  std::lock_guard<std::mutex> guard(profiles_mutex());
+
+  // Add up the counters of all threads.
+  std::map<const atermpp::detail::_aterm*, rewrite_rule_counters> rules;
+  std::map<const atermpp::detail::_aterm*, function_symbol_counters> symbols;
+  for (const rewrite_profile* profile: profiles())
+  {
+    for (const auto& [key, counters]: profile->rules())
+    {
+      auto [it, inserted] = rules.emplace(key, counters);
+      if (!inserted)
+      {
+        it->second.attempts += counters.attempts;
+        it->second.applications += counters.applications;
+        it->second.time += counters.time;
+      }
+    }
+    for (const auto& [key, counters]: profile->symbols())
+    {
+      auto [it, inserted] = symbols.emplace(key, counters);
+      if (!inserted)
+      {
+        it->second.calls += counters.calls;
+        it->second.time += counters.time;
+      }
+    }
+  }
+
+  std::vector<const rewrite_rule_counters*> sorted_rules;
+  rewrite_profile_clock::duration total_rule_time{};
+  for (const auto& [key, counters]: rules)
+  {
+    sorted_rules.push_back(&counters);
+    total_rule_time += counters.time;
+  }
+  std::stable_sort(sorted_rules.begin(), sorted_rules.end(),
+                   [](const rewrite_rule_counters* x, const rewrite_rule_counters* y) { return x->time > y->time; });
+
+  std::vector<const function_symbol_counters*> sorted_symbols;
+  for (const auto& [key, counters]: symbols)
+  {
+    sorted_symbols.push_back(&counters);
+  }
+  std::stable_sort(sorted_symbols.begin(), sorted_symbols.end(),
+                   [](const function_symbol_counters* x, const function_symbol_counters* y) { return x->calls > y->calls; });
+
+  os << "Rewrite rules (" << sorted_rules.size() << " used, " << std::fixed << std::setprecision(3)
+     << seconds(total_rule_time) << "s in total), sorted on time:\n";
+  os << std::setw(12) << "time (s)" << std::setw(8) << "%" << std::setw(14) << "attempts" << std::setw(14)
+     << "applications" << "  rule\n";
+  for (const rewrite_rule_counters* counters: sorted_rules)
+  {
+    const double percentage = total_rule_time.count() == 0 ? 0.0 : 100.0 * seconds(counters->time) / seconds(total_rule_time);
+    os << std::setw(12) << std::setprecision(6) << seconds(counters->time)
+       << std::setw(8) << std::setprecision(2) << percentage
+       << std::setw(14) << counters->attempts
+       << std::setw(14) << counters->applications
+       << "  " << counters->rule << "\n";
+  }
+
+  const std::size_t n = std::min(number_of_symbols, sorted_symbols.size());
+  os << "\nFunction symbols (" << n << " of " << sorted_symbols.size() << "), sorted on the number of rewrite calls:\n";
+  os << std::setw(14) << "calls" << std::setw(12) << "time (s)" << "  symbol\n";
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    os << std::setw(14) << sorted_symbols[i]->calls
+       << std::setw(12) << std::setprecision(6) << seconds(sorted_symbols[i]->time)
+       << "  " << sorted_symbols[i]->symbol << "\n";
+  }
+}
+
+static void print_rewrite_profile_to_file()
+{
+  const auto& [filename, number_of_symbols] = profile_output();
+  if (filename == "-")
+  {
+    print_rewrite_profile(std::cerr, number_of_symbols);
+    return;
+  }
+
+  std::ofstream file(filename);
+  if (!file)
+  {
+    std::cerr << "Could not open file " << filename << " to write the rewriter profile.\n";
+    return;
+  }
+  print_rewrite_profile(file, number_of_symbols);
+}
+
+void print_rewrite_profile_at_exit(const std::string& filename, std::size_t number_of_symbols)
+{
+  static bool registered = false;
+
+  enable_rewrite_profile(true);
+  profile_output() = std::make_pair(filename, number_of_symbols);
+  if (!registered)
+  {
+    registered = true;
+    std::atexit(print_rewrite_profile_to_file);
+  }
+}
+
+} // namespace mcrl2::data::detail
@@ -12,6 +12,9 @@
 #define BOOST_TEST_MODULE rewriter_test
 #include "mcrl2/data/detail/one_point_rule_preprocessor.h"
 #include "mcrl2/data/detail/parse_substitution.h"
+#include "mcrl2/data/detail/rewrite/jitty.h"
+#include "mcrl2/data/detail/rewrite/rewrite_profile.h"
+#include "mcrl2/data/detail/rewrite_strategies.h"
 #include "mcrl2/data/detail/test_rewriters.h"
 #include "mcrl2/data/print.h"
 #include "mcrl2/data/rewriter.h"
@@ -19,6 +22,10 @@
 
 #include <boost/test/included/unit_test.hpp>
 
+#include <chrono>
+#include <filesystem>
+#include <unistd.h>
+
 using namespace mcrl2;
 using namespace mcrl2::core;
 using namespace mcrl2::data;
@@ -244,6 +251,171 @@ void test_enumeration_of_functions()
   test_expressions(R, expr1, expr2, "", data_spec, sigma);
 }
 
+// Check that the profile records the rules that are tried and applied by the jitty rewriter.
+void test_rewrite_profile()
+{
+  std::string DATA_SPEC1 =
+    "map f: Nat -> Nat;\n"
+    "var n: Nat;\n"
+    "eqn f(0) = 0;\n"
+    "    n > 0 -> f(n) = n + f(Int2Nat(n - 1));\n"
+    ;
+
+  data_specification data_spec = parse_data_specification(DATA_SPEC1);
+  data::detail::enable_rewrite_profile(true);
+  data::rewriter R(data_spec, jitty);
+  data::detail::enable_rewrite_profile(false);
+  BOOST_CHECK_EQUAL(data::pp(R(parse_data_expression("f(3)", data_spec))), "6");
+
+  std::size_t attempts = 0;
+  std::size_t applications = 0;
+  for (const auto& [key, counters]: data::detail::local_rewrite_profile().rules())
+  {
+    if (counters.rule.find("f(n)  =") != std::string::npos)
+    {
+      attempts += counters.attempts;
+      applications += counters.applications;
+    }
+  }
+  BOOST_CHECK_EQUAL(attempts, 3u);
+  BOOST_CHECK_EQUAL(applications, 3u);
+
+  std::ostringstream out;
+  data::detail::print_rewrite_profile(out, 10);
+  BOOST_CHECK(out.str().find("f(n)") != std::string::npos);
+}
+
+// Check that the memo of the jitty rewriter gives the same normal forms, also for terms with variables
+// of which the values differ, and after the memo has forgotten terms at garbage collections.
+void test_rewriter_memo()
+{
+  std::string DATA_SPEC1 =
+    "map len: List(Nat) -> Nat;\n"
+    "var n: Nat; l: List(Nat);\n"
+    "eqn len([]) = 0;\n"
+    "    len(n |> l) = 1 + len(l);\n"
+    ;
+
+  data_specification data_spec = parse_data_specification(DATA_SPEC1);
+  data::rewriter R(data_spec, jitty);
+  data::detail::set_rewriter_memo_size(16);
+  data::detail::RewriterJitty R_memo(data_spec, used_data_equation_selector(data_spec));
+  data::detail::set_rewriter_memo_size(0);
+
+  variable l("l", sort_list::list(sort_nat::nat()));
+  data_expression t = parse_data_expression("len(l) + len(tail(l))", variable_list({ l }), data_spec);
+  for (std::size_t i = 0; i < 3; ++i)
+  {
+    for (const std::string& value: { "[1, 2, 3]", "[4, 5]", "[1, 2, 3]", "[]" })
+    {
+      rewriter::substitution_type sigma;
+      sigma[l] = R(parse_data_expression(value, data_spec));
+      BOOST_CHECK_EQUAL(R_memo.rewrite(t, sigma), R(t, sigma));
+    }
+    atermpp::detail::g_thread_term_pool().collect();
+  }
+  BOOST_CHECK(R_memo.memo().hits() > 0);
+}
+
+// Check that rewriting a vector of expressions at once gives the normal forms of the individual expressions.
+void test_rewrite_vector()
+{
+  std::string DATA_SPEC1 =
+    "map f: Nat -> Nat;\n"
+    "var n: Nat;\n"
+    "eqn f(0) = 0;\n"
+    "    n > 0 -> f(n) = n + f(Int2Nat(n - 1));\n"
+    ;
+
+  data_specification data_spec = parse_data_specification(DATA_SPEC1);
+  variable n("n", sort_nat::nat());
+  variable m("m", sort_nat::nat());
+  std::vector<data_expression> terms;
+  for (const std::string& s: { "f(n)", "m", "n + m", "f(3)", "n" })
+  {
+    terms.push_back(parse_data_expression(s, variable_list({ n, m }), data_spec));
+  }
+
+  for (const rewrite_strategy strategy: data::detail::get_test_rewrite_strategies(false))
+  {
+    data::rewriter R(data_spec, strategy);
+    std::vector<data_expression> result(1, sort_nat::c0());
+    for (const std::string& value: { "2", "0" })
+    {
+      rewriter::substitution_type sigma;
+      sigma[n] = R(parse_data_expression(value, data_spec));
+      sigma[m] = R(parse_data_expression("5", data_spec));
+      R(result, terms, sigma);
+      BOOST_CHECK_EQUAL(result.size(), terms.size());
+      for (std::size_t i = 0; i < terms.size(); ++i)
+      {
+        BOOST_CHECK_EQUAL(result[i], R(terms[i], sigma));
+      }
+    }
+  }
+}
+
+// Check the matching of left hand sides with nested patterns and variables that occur more than once.
+void test_nested_and_nonlinear_patterns()
+{
+  std::string DATA_SPEC1 =
+    "map same: Nat # Nat -> Bool;\n"
+    "    h: List(Nat) -> Nat;\n"
+    "var n, m: Nat; l: List(Nat);\n"
+    "eqn same(n, n) = true;\n"
+    "    h(n |> n |> l) = 2 * n;\n"
+    "    h(n |> m |> l) = n + m;\n"
+    "    h([n]) = n;\n"
+    ;
+
+  data_specification data_spec = parse_data_specification(DATA_SPEC1);
+  for (const rewrite_strategy strategy: data::detail::get_test_rewrite_strategies(false))
+  {
+    data::rewriter R(data_spec, strategy);
+    BOOST_CHECK_EQUAL(data::pp(R(parse_data_expression("same(2, 1 + 1)", data_spec))), "true");
+    BOOST_CHECK_EQUAL(data::pp(R(parse_data_expression("same(2, 3)", data_spec))), "same(2, 3)");
+    BOOST_CHECK_EQUAL(data::pp(R(parse_data_expression("h([3, 3, 1])", data_spec))), "6");
+    BOOST_CHECK_EQUAL(data::pp(R(parse_data_expression("h([3, 4])", data_spec))), "7");
+    BOOST_CHECK_EQUAL(data::pp(R(parse_data_expression("h([5])", data_spec))), "5");
+    BOOST_CHECK_EQUAL(data::pp(R(parse_data_expression("h([])", data_spec))), "h([])");
+  }
+}
+
+#ifdef MCRL2_TEST_JITTYC
+// The compiling rewriter stores the rewriter that it compiled in the directory MCRL2_JITTYC_CACHE, and a second
+// rewriter for the same specification loads it from there instead of compiling it again.
+void test_jittyc_cache()
+{
+  const std::filesystem::path directory = std::filesystem::temp_directory_path() / ("mcrl2_jittyc_cache_test_" + std::to_string(getpid()));
+  std::filesystem::remove_all(directory);
+  setenv("MCRL2_JITTYC_CACHE", directory.c_str(), 1);
+
+  const data_specification data_spec = parse_data_specification("map f: Nat -> Nat; var n: Nat; eqn f(n) = n + 1;");
+  const data_expression x = parse_data_expression("f(2)", data_spec);
+  const data_expression normal_form = rewriter(data_spec, jitty)(x);
+  {
+    rewriter r(data_spec, jitty_compiling);
+    BOOST_CHECK_EQUAL(r(x), normal_form);
+  }
+
+  const std::vector<std::filesystem::path> files(std::filesystem::directory_iterator(directory), {});
+  BOOST_REQUIRE_EQUAL(files.size(), 1u);
+
+  // A rewriter that is compiled again replaces the cached file, which changes its modification time.
+  const std::filesystem::file_time_type time = std::filesystem::file_time_type::clock::now() - std::chrono::hours(1);
+  std::filesystem::last_write_time(files.front(), time);
+  {
+    rewriter r(data_spec, jitty_compiling);
+    BOOST_CHECK_EQUAL(r(x), normal_form);
+  }
+  BOOST_CHECK(std::filesystem::last_write_time(files.front()) == time);
+  BOOST_CHECK_EQUAL(std::distance(std::filesystem::directory_iterator(directory), std::filesystem::directory_iterator()), 1);
+
+  unsetenv("MCRL2_JITTYC_CACHE");
+  std::filesystem::remove_all(directory);
+}
+#endif
+
 BOOST_AUTO_TEST_CASE(test_main)
 {
   test1();
@@ -255,4 +427,11 @@ BOOST_AUTO_TEST_CASE(test_main)
   test_lambda_expression();
   test_equality_on_functions();
   test_enumeration_of_functions();
+  test_rewrite_profile();
+  test_rewriter_memo();
+  test_rewrite_vector();
+  test_nested_and_nonlinear_patterns();
+#ifdef MCRL2_TEST_JITTYC
+  test_jittyc_cache();
+#endif
 }
@@ -12,10 +12,12 @@
 #ifndef MCRL2_LPS_EXPLORER_H
 #define MCRL2_LPS_EXPLORER_H
 
+#include <condition_variable>
+#include <exception>
 #include <random>
 #include <thread>
 #include <type_traits>
-#include <condition_variable>
+#include <mutex>
 #include "mcrl2/utilities/detail/io.h"
 #include "mcrl2/utilities/skip.h"
 #include "mcrl2/atermpp/standard_containers/vector.h"
@@ -28,6 +30,7 @@
 #include "mcrl2/data/substitution_utility.h"
 #include "mcrl2/lps/detail/instantiate_global_variables.h"
 #include "mcrl2/lps/explorer_options.h"
+#include "mcrl2/lps/explorer_state_set.h"
 #include "mcrl2/lps/explorer_todo_set.h"
 #include "mcrl2/lps/explorer_utilities.h"
 #include "mcrl2/lps/find_representative.h"
@@ -54,7 +57,7 @@ class explorer: public abortable
     static constexpr bool is_stochastic = Stochastic;
     static constexpr bool is_timed = Timed;
 
-    using indexed_set_for_states_type = atermpp::indexed_set<state, mcrl2::utilities::detail::GlobalThreadSafe>;
+    using indexed_set_for_states_type = explorer_state_set;
 
     struct transition
     {
@@ -77,11 +80,25 @@ class explorer: public abortable
     data::enumerator_identifier_generator m_global_id_generator;
 
     Specification m_global_lpsspec;
-    // Mutexes
-    std::mutex m_exclusive_state_access;
-    // Mutex locked if a process finds the global buffer empty, and unlocked if it is (attempted to be) refilled
-    std::mutex m_global_todo_buffer_mutex;
-    std::condition_variable m_signal_global_todo_buffer_filled;
+
+    // Each thread owns a todo buffer. A thread whose buffer is empty steals states from the buffers
+    // of other threads. The mutex of a buffer is only contended when a state is being stolen from it.
+    std::vector<std::unique_ptr<todo_set>> m_thread_todos;
+    std::vector<std::mutex> m_thread_todo_mutexes;
+
+    // The sizes of the todo buffers. They are written by the thread that holds the mutex of a buffer,
+    // and they are read without locking by threads that look for states to steal.
+    std::vector<std::atomic<std::size_t>> m_thread_todo_sizes;
+
+    // Threads that find no states to steal wait on this condition variable until states become
+    // available in some todo buffer, or until the exploration terminates or is aborted.
+    std::mutex m_idle_mutex;
+    std::condition_variable m_idle_condition;
+    std::atomic<std::size_t> m_idle_threads = 0;
+
+    // The number of states that are stored in a todo buffer or that are being explored. Exploration
+    // has terminated as soon as this counter becomes zero.
+    std::atomic<std::size_t> m_pending_states = 0;
 
     std::vector<data::variable> m_process_parameters;
     std::size_t m_n; // m_n = m_process_parameters.size()
@@ -552,22 +569,15 @@ class explorer: public abortable
       {
         lps::state key;
         project(key, summand.I_r, sigma);
-        utilities::shared_guard g = atermpp::detail::g_thread_term_pool().lock_shared();
-
-        auto it = summand.projection_cache.find(key);
-        if (it == summand.projection_cache.end())
-        {
-          g.unlock();
 
-          std::vector<projected_transition> projected = enumerate_projected_transitions();
-          it = summand.projection_cache.emplace(key, std::move(projected)).first;
-        }
-        else
+        std::vector<projected_transition> projected;
+        if (!summand.projection_cache.find(key, projected, summand.cache_metric))
         {
-          g.unlock();
+          projected = enumerate_projected_transitions();
+          summand.projection_cache.insert(key, projected);
         }
 
-        for (const projected_transition& t : it->second)
+        for (const projected_transition& t : projected)
         {
           consume_projected_transitions(t);
         }
@@ -586,14 +596,10 @@ class explorer: public abortable
       else
       {
         summand_cache_map& cache = summand.cache_strategy == caching::global ? global_cache : summand.local_cache;
-        utilities::shared_guard g = atermpp::detail::g_thread_term_pool().lock_shared();
 
-        auto q = cache.find(detail::cheap_cache_key(sigma, summand.gamma));
-        if (q == cache.end())
+        atermpp::term_list<data::data_expression_list> solutions;
+        if (!cache.find(detail::cheap_cache_key(sigma, summand.gamma), solutions, summand.cache_metric))
         {
-          g.unlock();
-
-          atermpp::term_list<data::data_expression_list> solutions;
           // Enumerate all satisfying valuations for this summand and store them in the cache.
           enumerate_solutions(
             summand, sigma, rewr, condition, enumerator,
@@ -603,14 +609,10 @@ class explorer: public abortable
             }
           );
           summand.compute_key(key, sigma);
-          q = cache.insert({key, solutions}).first;
-        }
-        else
-        {
-          g.unlock();
+          cache.insert(key, solutions);
         }
 
-        for (const auto& e : static_cast<atermpp::term_list<data::data_expression_list>&>(q->second))
+        for (const data::data_expression_list& e : solutions)
         {
           process_transition(e.empty() ? nullptr : &e);
         }
@@ -757,6 +759,109 @@ class explorer: public abortable
       }
     }
 
+    // Returns the position of the todo buffer of the thread with the given index in m_thread_todos.
+    // Threads are numbered from 1 to number_of_threads, and thread 0 is the single threaded variant.
+    static std::size_t todo_position(std::size_t thread_index)
+    {
+      return thread_index == 0 ? 0 : thread_index - 1;
+    }
+
+    // Moves about half of the states of a non empty todo buffer of another thread to the todo buffer
+    // of the current thread. The buffers of other threads are visited round robin, starting
+    // at the buffer following the one of the current thread. Returns false if no state could be stolen.
+    bool steal_states(std::size_t thread_index, std::vector<state>& stolen)
+    {
+      const std::size_t own = todo_position(thread_index);
+      const std::size_t n = m_thread_todos.size();
+      for (std::size_t k = 1; k < n; ++k)
+      {
+        const std::size_t victim = (own + k) % n;
+        if (m_thread_todo_sizes[victim].load(std::memory_order_relaxed) == 0)
+        {
+          continue;
+        }
+        {
+          std::lock_guard<std::mutex> guard(m_thread_todo_mutexes[victim]);
+          todo_set& victim_todo = *m_thread_todos[victim];
+          const std::size_t number_of_states_to_steal = (victim_todo.size() + 1) / 2;
+          for (std::size_t i = 0; i < number_of_states_to_steal; ++i)
+          {
+            stolen.emplace_back();
+            victim_todo.choose_element(stolen.back());
+          }
+          m_thread_todo_sizes[victim] = victim_todo.size();
+        }
+
+        if (!stolen.empty())
+        {
+          std::size_t own_size;
+          {
+            std::lock_guard<std::mutex> guard(m_thread_todo_mutexes[own]);
+            todo_set& own_todo = *m_thread_todos[own];
+            const std::size_t size_before = own_todo.size();
+            for (const state& s: stolen)
+            {
+              own_todo.insert(s);
+            }
+            own_size = own_todo.size();
+            m_thread_todo_sizes[own] = own_size;
+            // A highway todo set may drop states on insertion, and these are no longer pending.
+            m_pending_states -= stolen.size() - (own_size - size_before);
+          }
+          stolen.clear();
+
+          // The stolen states can be stolen in turn by another idle thread.
+          if (own_size > 1)
+          {
+            wake_up_idle_threads(false);
+          }
+          return true;
+        }
+      }
+      return false;
+    }
+
+    // Returns true if an idle thread must stop waiting, because states can be stolen from some todo buffer,
+    // or because the exploration has terminated or is aborted.
+    bool idle_thread_must_wake_up() const
+    {
+      if (m_pending_states.load() == 0 || m_must_abort.load())
+      {
+        return true;
+      }
+      return std::any_of(m_thread_todo_sizes.begin(), m_thread_todo_sizes.end(),
+                         [](const std::atomic<std::size_t>& size) { return size.load() > 0; });
+    }
+
+    // Blocks the calling thread until states can be stolen, or until the exploration terminates or is aborted.
+    // A thread that changes one of the conditions of idle_thread_must_wake_up first updates it, and then calls
+    // wake_up_idle_threads, which takes m_idle_mutex. As the condition is checked while holding this mutex after
+    // m_idle_threads has been incremented, a wake up cannot be missed.
+    void wait_for_states()
+    {
+      std::unique_lock<std::mutex> guard(m_idle_mutex);
+      m_idle_threads++;
+      m_idle_condition.wait(guard, [this]() { return idle_thread_must_wake_up(); });
+      m_idle_threads--;
+    }
+
+    // Wakes up one idle thread, or all of them if all is true.
+    void wake_up_idle_threads(bool all)
+    {
+      if (m_idle_threads.load() > 0)
+      {
+        std::lock_guard<std::mutex> guard(m_idle_mutex);
+        if (all)
+        {
+          m_idle_condition.notify_all();
+        }
+        else
+        {
+          m_idle_condition.notify_one();
+        }
+      }
+    }
+
   private:
     bool is_confluent_tau(const multi_action& a)
     {
@@ -782,6 +887,7 @@ class explorer: public abortable
         m_global_rewr(rewr),
         m_global_enumerator(m_global_rewr, lpsspec.data(), m_global_rewr, m_global_id_generator, false),
         m_global_lpsspec(preprocess(lpsspec)),
+        global_cache(m_options.cache_size),
         m_discovered(m_options.number_of_threads)
     {
 #ifdef MCRL2_USE_CONTROL_FLOW
@@ -803,6 +909,20 @@ class explorer: public abortable
       m_process_parameters = std::vector<data::variable>(params.begin(), params.end());
       m_n = m_process_parameters.size();
       timed_state.resize(m_n + 1);
+
+      if (m_options.tree_compression)
+      {
+        m_discovered.enable_tree_compression(Timed ? m_n + 1 : m_n);
+      }
+      if (m_options.state_capacity > 0)
+      {
+        if (m_options.tree_compression)
+        {
+          throw mcrl2::runtime_error("A state capacity cannot be combined with tree compression.");
+        }
+        // A table with a fixed capacity never has to be resized, so threads can insert states without locking.
+        m_discovered.set_fixed_capacity(m_options.state_capacity);
+      }
       m_initial_state = m_global_lpsspec.initial_process().expressions();
       m_initial_distribution = initial_distribution(m_global_lpsspec);
 
@@ -814,11 +934,11 @@ class explorer: public abortable
         caching cache_strategy = m_options.cached ? (m_options.global_cache ? lps::caching::global : lps::caching::local) : lps::caching::none;
         if (is_confluent_tau(summand.multi_action()))
         {
-          m_confluent_summands.emplace_back(summand, i, m_global_lpsspec.process().process_parameters(), cache_strategy);
+          m_confluent_summands.emplace_back(summand, i, m_global_lpsspec.process().process_parameters(), cache_strategy, m_options.cache_size);
         }
         else
         {
-          m_regular_summands.emplace_back(summand, i, m_global_lpsspec.process().process_parameters(), cache_strategy);
+          m_regular_summands.emplace_back(summand, i, m_global_lpsspec.process().process_parameters(), cache_strategy, m_options.cache_size);
         }
       }
 
@@ -913,9 +1033,8 @@ class explorer: public abortable
       typename StartState = utilities::skip,
       typename FinishState = utilities::skip,
       typename DiscoverInitialState = utilities::skip>
-    void generate_state_space_thread(std::unique_ptr<todo_set>& todo,
+    void generate_state_space_thread(
       std::size_t thread_index,
-      std::atomic<std::size_t>& number_of_active_processes,
       const SummandSequence& regular_summands,
       const SummandSequence& confluent_summands,
       indexed_set_for_states_type& discovered,
@@ -1169,6 +1288,7 @@ class explorer: public abortable
     void abort() override
     {
       m_must_abort = true;
+      wake_up_idle_threads(true);
     }
 
     /// \brief Returns a mapping containing all discovered states.
@@ -1177,6 +1297,21 @@ class explorer: public abortable
       return m_discovered;
     }
 
+    /// \brief Prints the number of hits and misses of the enumeration and projection caches of each summand.
+    void print_cache_statistics() const
+    {
+      for (const std::vector<explorer_summand>* summands: { &m_regular_summands, &m_confluent_summands })
+      {
+        for (const explorer_summand& summand: *summands)
+        {
+          if (summand.cache_metric.hits() + summand.cache_metric.misses() > 0)
+          {
+            mCRL2log(log::verbose) << "Cache of summand " << summand.index << ": " << summand.cache_metric.message() << std::endl;
+          }
+        }
+      }
+    }
+
     const std::vector<explorer_summand>& regular_summands() const
     {
       return m_regular_summands;
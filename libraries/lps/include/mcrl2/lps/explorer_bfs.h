@@ -29,9 +29,7 @@ namespace mcrl2::lps
       typename DiscoverInitialState
     >
     void explorer<Stochastic, Timed, Specification>::generate_state_space_thread(
-      std::unique_ptr<todo_set>& todo,
       const std::size_t thread_index,
-      std::atomic<std::size_t>& number_of_active_processes,
       const SummandSequence& regular_summands,
       const SummandSequence& confluent_summands,
       indexed_set_for_states_type& discovered,
@@ -51,191 +49,169 @@ namespace mcrl2::lps
       state current_state;
       data::data_expression condition;   // The condition is used often, and it is effective not to declare it whenever it is used.
       state_type state_;                 // The same holds for state.
-      std::vector<state> dummy;
-      std::unique_ptr<todo_set> thread_todo=make_todo_set(dummy.begin(),dummy.end()); // The new states for each process are temporarily stored in this vector for each thread. 
+      std::vector<state> new_states;     // The states discovered while exploring current_state. 
+      std::vector<state> stolen;         // Buffer for states that are stolen from other threads.
       atermpp::aterm key;
 
-      if (mcrl2::utilities::detail::GlobalThreadSafe && m_options.number_of_threads > 1)
-      {
-        m_exclusive_state_access.lock();
-      }
-      
+      const bool use_locks = mcrl2::utilities::detail::GlobalThreadSafe && m_options.number_of_threads > 1;
+      todo_set& thread_todo = *m_thread_todos[todo_position(thread_index)];
+      std::mutex& thread_todo_mutex = m_thread_todo_mutexes[todo_position(thread_index)];
+
       while (!m_must_abort.load(std::memory_order_relaxed)) 
       {
-        assert(m_must_abort || thread_todo->empty());
-          
-        if (!todo->empty())
         {
-          todo->choose_element(current_state);
-          thread_todo->insert(current_state);
-          if (mcrl2::utilities::detail::GlobalThreadSafe && m_options.number_of_threads > 1)
+          std::unique_lock<std::mutex> guard(thread_todo_mutex, std::defer_lock);
+          if (use_locks)
+          {
+            guard.lock();
+          }
+
+          if (thread_todo.empty())
+          {
+            if (use_locks)
+            {
+              guard.unlock();
+            }
+
+            // The states that are pending are all owned by other threads. Termination is detected when 
+            // no state is pending anymore, which avoids that idle threads have to synchronise on a mutex.
+            if (m_pending_states.load() == 0)
+            {
+              break;
+            }
+            if (!steal_states(thread_index, stolen))
+            {
+              wait_for_states();
+            }
+            continue;
+          }
+
+          thread_todo.choose_element(current_state);
+          if (use_locks)
           {
-            m_exclusive_state_access.unlock();
+            m_thread_todo_sizes[todo_position(thread_index)] = thread_todo.size();
           }
+        }
 
-          while (!thread_todo->empty() && !m_must_abort.load(std::memory_order_relaxed))
-          { 
-            thread_todo->choose_element(current_state);
-            std::size_t s_index = discovered.index(current_state,thread_index);
-            start_state(thread_index, current_state, s_index);
-            data::add_assignments(thread_sigma, m_process_parameters, current_state);
+        std::size_t s_index = discovered.index(current_state,thread_index);
+        start_state(thread_index, current_state, s_index);
+        data::add_assignments(thread_sigma, m_process_parameters, current_state);
 #ifdef MCRL2_USE_CONTROL_FLOW
-            auto active_cfg_vertices = compute_active_cfg_vertices(thread_sigma, m_process_parameters, m_control_flow_graphs);
+        auto active_cfg_vertices = compute_active_cfg_vertices(thread_sigma, m_process_parameters, m_control_flow_graphs);
 #endif
-            for (const explorer_summand& summand: regular_summands)
-            {   
-              generate_transitions(
-                summand,
-                confluent_summands,
-                thread_sigma,
-                thread_rewr,
-                condition,
-                state_,
-                key,
-                thread_enumerator,
-                thread_id_generator,
+        for (const explorer_summand& summand: regular_summands)
+        {   
+          generate_transitions(
+            summand,
+            confluent_summands,
+            thread_sigma,
+            thread_rewr,
+            condition,
+            state_,
+            key,
+            thread_enumerator,
+            thread_id_generator,
 #ifdef MCRL2_USE_CONTROL_FLOW
-                active_cfg_vertices,
+            active_cfg_vertices,
 #endif
-                [&](const lps::multi_action& a, const state_type& s1)
+            [&](const lps::multi_action& a, const state_type& s1)
+            {
+              if constexpr (Timed)
+              { 
+                const data::data_expression& t = current_state[m_n];
+                if (a.has_time() && less_equal(a.time(), t, thread_sigma, thread_rewr))
                 {
-                  if constexpr (Timed)
-                  { 
-                    const data::data_expression& t = current_state[m_n];
-                    if (a.has_time() && less_equal(a.time(), t, thread_sigma, thread_rewr))
-                    {
-                      return;
-                    }
-                  } 
-                  if constexpr (Stochastic)
-                  { 
-                    std::list<std::size_t> s1_index;
-                    const auto& S1 = s1.states;
-                    // TODO: join duplicate targets
-                    for (const state& s1_: S1)
-                    { 
-                      std::size_t k = discovered.index(s1_,thread_index);
-                      if (k >= discovered.size())
-                      { 
-                        thread_todo->insert(s1_);
-                        k = discovered.insert(s1_, thread_index).first;
-                        discover_state(thread_index, s1_, k);
-                      }
-                      s1_index.push_back(k);
-                    }
-
-                    examine_transition(thread_index, m_options.number_of_threads, current_state, s_index, a, s1, s1_index, summand.index);
-                  } 
-                  else 
+                  return;
+                }
+              } 
+              if constexpr (Stochastic)
+              { 
+                std::list<std::size_t> s1_index;
+                const auto& S1 = s1.states;
+                // TODO: join duplicate targets
+                for (const state& s1_: S1)
+                { 
+                  std::size_t k = discovered.index(s1_,thread_index);
+                  if (k >= discovered.size())
                   { 
-                    std::size_t s1_index; 
-                    if constexpr (Timed)
-                    { 
-                      s1_index = discovered.index(s1,thread_index);
-                      if (s1_index >= discovered.size())
-                      {   
-                        const data::data_expression& t = current_state[m_n];
-                        const data::data_expression& t1 = a.has_time() ? a.time() : t;
-                        make_timed_state(state_, s1, t1);
-                        s1_index = discovered.insert(state_, thread_index).first;
-                        discover_state(thread_index, state_, s1_index);
-                        thread_todo->insert(state_);
-                      } 
-                    }
-                    else
-                    { 
-                      std::pair<std::size_t,bool> p = discovered.insert(s1, thread_index);
-                      s1_index=p.first;
-                      if (p.second)  // Index is newly added. 
-                      {
-                        discover_state(thread_index, s1, s1_index);
-                        thread_todo->insert(s1); 
-                      }
-                    }
-
-                    examine_transition(thread_index, m_options.number_of_threads, current_state, s_index, a, s1, s1_index, summand.index);
+                    new_states.push_back(s1_);
+                    k = discovered.insert(s1_, thread_index).first;
+                    discover_state(thread_index, s1_, k);
                   }
-                }
-              );
-            }
-
-            finish_state(thread_index, m_options.number_of_threads, current_state, s_index, thread_todo->size());
-            thread_todo->finish_state();
-
-            // TODO: The constant 100 below is quite arbitrary, and could be chosen more wisely.
-            // If it is too low, then m_exclusive_state_access.lock(); becomes dominant, whereas 
-            // few states that a local process owns are redistributed, which is not wise. 
-            // It would be nice if we could find an optimal redistribution strategy of the 
-            // states in the todo buffers, minimizing the number of times a mutex has to be 
-            // obtained. 
-            if (number_of_active_processes<m_options.number_of_threads && thread_todo->size()>100)
-            {
-              if (todo->size()==0)
-              {
-                if (mcrl2::utilities::detail::GlobalThreadSafe && m_options.number_of_threads > 1)
-                {
-                  m_exclusive_state_access.lock();
+                  s1_index.push_back(k);
                 }
 
-                // move 25% of the states of this thread to the global todo buffer.
-                std::size_t number_of_states_to_move=std::min(thread_todo->size()-1,1+(thread_todo->size()/4));
-                for(std::size_t i=0; i<number_of_states_to_move; ++i)  
-                {
-                  thread_todo->choose_element(current_state);
-                  todo->insert(current_state);
+                examine_transition(thread_index, m_options.number_of_threads, current_state, s_index, a, s1, s1_index, summand.index);
+              } 
+              else 
+              { 
+                std::size_t s1_index; 
+                if constexpr (Timed)
+                { 
+                  const data::data_expression& t = current_state[m_n];
+                  const data::data_expression& t1 = a.has_time() ? a.time() : t;
+                  make_timed_state(state_, s1, t1);
+                  std::pair<std::size_t,bool> p = discovered.insert(state_, thread_index);
+                  s1_index=p.first;
+                  if (p.second)  // Index is newly added. 
+                  {   
+                    discover_state(thread_index, state_, s1_index);
+                    new_states.push_back(state_);
+                  } 
                 }
-                if (mcrl2::utilities::detail::GlobalThreadSafe && m_options.number_of_threads > 1)
-                {
-                  m_exclusive_state_access.unlock();
+                else
+                { 
+                  std::pair<std::size_t,bool> p = discovered.insert(s1, thread_index);
+                  s1_index=p.first;
+                  if (p.second)  // Index is newly added. 
+                  {
+                    discover_state(thread_index, s1, s1_index);
+                    new_states.push_back(s1); 
+                  }
                 }
-                std::lock_guard<std::mutex> lock(m_global_todo_buffer_mutex);
-                m_signal_global_todo_buffer_filled.notify_all();
-              }
 
+                examine_transition(thread_index, m_options.number_of_threads, current_state, s_index, a, s1, s1_index, summand.index);
+              }
             }
-          }
+          );
         }
-        else
+
+        std::size_t todo_size;
         {
-          if (mcrl2::utilities::detail::GlobalThreadSafe && m_options.number_of_threads > 1)
+          std::unique_lock<std::mutex> guard(thread_todo_mutex, std::defer_lock);
+          if (use_locks)
           {
-            m_exclusive_state_access.unlock();
+            guard.lock();
           }
-        }
-        // Check whether all processes are ready. If so the number_of_active_processes becomes 0. 
-        // Otherwise, this thread becomes active again, and tries to see whether the todo buffer is
-        // not empty, to take up more work. 
-
-        assert(thread_todo->empty() || m_must_abort);
-        if (todo->empty())
-        {
-          std::unique_lock<std::mutex> lock(m_global_todo_buffer_mutex);  
-          // Atomic decrement and compare is essential) 
-          if (1==number_of_active_processes.fetch_sub(1))
+          const std::size_t size_before = thread_todo.size();
+          for (const state& s: new_states)
           {
-            m_must_abort=true;
-            m_signal_global_todo_buffer_filled.notify_all(); 
+            thread_todo.insert(s);
           }
-          else
+          todo_size = thread_todo.size();
+
+          // The new states become pending before the current state is finished, such that
+          // the number of pending states cannot drop to zero while there is work left.
+          m_pending_states += todo_size - size_before;
+          if (use_locks)
           {
-            m_signal_global_todo_buffer_filled.wait(lock); 
-            if (!m_must_abort) 
-            {
-              number_of_active_processes++;   
-            }
+            m_thread_todo_sizes[todo_position(thread_index)] = todo_size;
           }
         }
-        if (mcrl2::utilities::detail::GlobalThreadSafe && m_options.number_of_threads > 1)
+        if (use_locks && !new_states.empty())
+        {
+          wake_up_idle_threads(false);
+        }
+        new_states.clear();
+
+        finish_state(thread_index, m_options.number_of_threads, current_state, s_index, todo_size);
+        thread_todo.finish_state();
+        if (--m_pending_states == 0 && use_locks)
         {
-          m_exclusive_state_access.lock();
+          wake_up_idle_threads(true);
         }
       } 
       mCRL2log(log::debug) << "Stop thread " << thread_index << ".\n";
-      if (mcrl2::utilities::detail::GlobalThreadSafe && m_options.number_of_threads > 1)
-      {
-        m_exclusive_state_access.unlock();
-      }
-
     }  // end generate_state_space_thread.
 
     template <bool Stochastic, bool Timed, typename Specification>
@@ -266,14 +242,20 @@ namespace mcrl2::lps
       assert(number_of_threads>0);
       const std::size_t initialisation_thread_index= (number_of_threads==1?0:1);
       m_recursive = recursive;
-      std::unique_ptr<todo_set> todo;
       discovered.clear(initialisation_thread_index);
 
+      // The initial states are put in the todo buffer of the first thread. The other threads obtain
+      // their work by stealing it. 
+      std::vector<state> dummy;
+      m_thread_todos.clear();
+      m_thread_todo_mutexes = std::vector<std::mutex>(number_of_threads);
+      m_thread_todo_sizes = std::vector<std::atomic<std::size_t>>(number_of_threads);
+
       if constexpr (Stochastic)
       {
         state_type s0_ = make_state(s0);
         const auto& S = s0_.states;
-        todo = make_todo_set(S.begin(), S.end());
+        m_thread_todos.push_back(make_todo_set(S.begin(), S.end()));
         discovered.clear(initialisation_thread_index);
         std::list<std::size_t> s0_index;
         for (const state& s: S)
@@ -291,37 +273,69 @@ namespace mcrl2::lps
       }
       else
       {
-        todo = make_todo_set(s0);
+        m_thread_todos.push_back(make_todo_set(s0));
         std::size_t s0_index = discovered.insert(s0, initialisation_thread_index).first;
         discover_state(initialisation_thread_index, s0, s0_index);
       }
+      m_pending_states = m_thread_todos.front()->size();
+      m_thread_todo_sizes.front() = m_thread_todos.front()->size();
 
-      std::atomic<std::size_t> number_of_active_processes=number_of_threads;
+      for (std::size_t i = 1; i < number_of_threads; ++i)
+      {
+        m_thread_todos.push_back(make_todo_set(dummy.begin(), dummy.end()));
+      }
 
       if (number_of_threads>1)
       {
+        // An exception must not escape from a thread. The first exception that is thrown in a thread, for instance
+        // because the set of discovered states is full, aborts the exploration, and is rethrown after all threads
+        // have stopped.
+        std::exception_ptr thread_exception;
+        std::mutex thread_exception_mutex;
+
         std::vector<std::thread> threads;
         threads.reserve(number_of_threads);
         for(std::size_t i=1; i<=number_of_threads; ++i)  // Threads are numbered from 1 to number_of_threads. Thread number 0 is reserved as 
                                                          // indicator for a sequential implementation. 
         {
           threads.emplace_back([&, i](){ 
-                                    generate_state_space_thread< StateType, SummandSequence,
-                                                         DiscoverState, ExamineTransition,
-                                                         StartState, FinishState,
-                                                         DiscoverInitialState >
-                                       (todo, 
-                                        i, number_of_active_processes, 
-                                        regular_summands,confluent_summands,discovered, discover_state,
-                                        examine_transition, start_state, finish_state, 
-                                        m_global_rewr.clone(), m_global_sigma); } );  // It is essential that the rewriter is cloned as
-                                                                                      // one rewriter cannot be used in parallel.
+                                    try
+                                    {
+                                      generate_state_space_thread< StateType, SummandSequence,
+                                                           DiscoverState, ExamineTransition,
+                                                           StartState, FinishState,
+                                                           DiscoverInitialState >
+                                         (i, 
+                                          regular_summands,confluent_summands,discovered, discover_state,
+                                          examine_transition, start_state, finish_state, 
+                                          m_global_rewr.clone(), m_global_sigma);  // It is essential that the rewriter is cloned as
+                                                                                   // one rewriter cannot be used in parallel.
+                                    }
+                                    catch (...)
+                                    {
+                                      {
+                                        std::lock_guard<std::mutex> guard(thread_exception_mutex);
+                                        if (!thread_exception)
+                                        {
+                                          thread_exception = std::current_exception();
+                                        }
+                                      }
+                                      this->abort();
+                                    }
+                                  } );
         }
 
         for(std::size_t i=1; i<=number_of_threads; ++i)
         {
           threads[i-1].join();
         }
+
+        if (thread_exception)
+        {
+          m_thread_todos.clear();
+          m_must_abort = false;
+          std::rethrow_exception(thread_exception);
+        }
       }
       else
       {
@@ -332,12 +346,13 @@ namespace mcrl2::lps
                                                 DiscoverState, ExamineTransition,
                                                 StartState, FinishState,
                                                 DiscoverInitialState >
-                                  (todo,single_thread_index,number_of_active_processes, 
+                                  (single_thread_index,
                                    regular_summands,confluent_summands,discovered, discover_state,
                                    examine_transition, start_state, finish_state, 
                                    m_global_rewr, m_global_sigma);  
       }
 
+      m_thread_todos.clear();
       m_must_abort = false;
     }
 
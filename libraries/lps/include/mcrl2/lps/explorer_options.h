@@ -45,6 +45,7 @@ struct explorer_options
   bool save_at_end = false;
   bool dfs_recursive = false;
   bool discard_lts_state_labels = false;
+  bool tree_compression = false;  // Store the discovered states using tree compression.
   bool rewrite_actions = true;    // If false, this option prevents rewriting actions.
                                   // Rewriting actions is only needed if they occur in the
                                   // generated lts, or in traces. 
@@ -52,6 +53,8 @@ struct explorer_options
   std::size_t max_traces = 0;
   std::size_t highway_todo_max = std::numeric_limits<std::size_t>::max();
   std::size_t number_of_threads = 1;
+  std::size_t cache_size = 0;     // If not zero, the number of entries of each enumeration cache is bounded by it.
+  std::size_t state_capacity = 0; // If not zero, the table of discovered states is allocated once for this number of states.
   std::string trace_prefix;
   std::set<core::identifier_string> trace_actions;
   std::set<lps::multi_action> trace_multiactions;
@@ -93,6 +96,7 @@ std::ostream& operator<<(std::ostream& out, const explorer_options& options)
   out << "detect-divergence = " << std::boolalpha << options.detect_divergence << std::endl;
   out << "detect-action = " << std::boolalpha << options.detect_action << std::endl;
   out << "discard-lts-state-labels = " << std::boolalpha << options.discard_lts_state_labels << std::endl;
+  out << "tree-compression = " << std::boolalpha << options.tree_compression << std::endl;
   out << "save-error-trace = " << std::boolalpha << options.save_error_trace << std::endl;
   out << "generate-traces = " << std::boolalpha << options.generate_traces << std::endl;
   out << "suppress-progress-messages = " << std::boolalpha << options.suppress_progress_messages << std::endl;
@@ -102,6 +106,8 @@ std::ostream& operator<<(std::ostream& out, const explorer_options& options)
   out << "max-traces = " << options.max_traces << std::endl;
   out << "todo-max = " << options.highway_todo_max << std::endl;
   out << "threads = " << options.number_of_threads << std::endl;
+  out << "cache-size = " << options.cache_size << std::endl;
+  out << "state-capacity = " << options.state_capacity << std::endl;
   out << "trace-prefix = " << options.trace_prefix << std::endl;
   out << "trace-actions = " << core::detail::print_set(options.trace_actions) << std::endl;
   out << "trace-multiactions = " << core::detail::print_set(options.trace_multiactions) << std::endl;
@@ -0,0 +1,252 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/lps/explorer_state_set.h
+/// \brief The set of discovered states of the explorer, optionally stored using tree compression.
+
+#ifndef MCRL2_LPS_EXPLORER_STATE_SET_H
+#define MCRL2_LPS_EXPLORER_STATE_SET_H
+
+#include <cstdint>
+#include <memory>
+#include "mcrl2/atermpp/standard_containers/indexed_set.h"
+#include "mcrl2/lps/state.h"
+#include "mcrl2/utilities/exception.h"
+#include "mcrl2/utilities/hash_utility.h"
+
+namespace mcrl2::lps
+{
+
+/// \brief An indexed set of states.
+/// \details By default the states are stored as terms. When tree compression is enabled, each
+///          parameter value is stored once in a table per parameter, and a state is stored as a
+///          tree of pairs of indices that has the same shape as the balanced tree of the state.
+///          Each inner position of this tree has its own table of pairs, such that subtrees that
+///          are shared between states are stored only once. The index of a state is its index in
+///          the table of the root. This is the tree compression of LTSmin.
+class explorer_state_set
+{
+  protected:
+    using state_set = atermpp::indexed_set<state, mcrl2::utilities::detail::GlobalThreadSafe>;
+    using value_set = atermpp::indexed_set<data::data_expression, mcrl2::utilities::detail::GlobalThreadSafe>;
+
+    // A node is a pair of indices of its children, each incremented by one, such that the
+    // value 0 never occurs as a node. It marks a position that has not been filled.
+    struct node_hash
+    {
+      std::size_t operator()(std::uint64_t node) const
+      {
+        return utilities::detail::hash_combine(node >> 32, node & 0xffffffff);
+      }
+    };
+
+    using node_set = utilities::indexed_set<std::uint64_t, mcrl2::utilities::detail::GlobalThreadSafe, node_hash>;
+
+    std::size_t m_number_of_threads;
+
+    // The states if tree compression is not enabled.
+    state_set m_states;
+
+    // The number of elements of a state if tree compression is enabled, and 0 otherwise.
+    std::size_t m_state_size = 0;
+
+    // The values of each parameter and the nodes at each inner position of the tree, in preorder.
+    std::vector<std::unique_ptr<value_set>> m_values;
+    std::vector<std::unique_ptr<node_set>> m_nodes;
+
+    // Throws an mcrl2::runtime_error if an index does not fit in 32 bits. The explorer catches exceptions
+    // that are thrown in its threads, and aborts the exploration.
+    static std::uint64_t make_node(std::size_t left, std::size_t right)
+    {
+      if (left >= 0xffffffff || right >= 0xffffffff)
+      {
+        throw mcrl2::runtime_error("Tree compression cannot store more than 4294967294 different subtrees at a position in a state.");
+      }
+      return (static_cast<std::uint64_t>(left + 1) << 32) | static_cast<std::uint64_t>(right + 1);
+    }
+
+    // Inserts the subtree t with the given number of elements, whose inner nodes start at the given
+    // position and whose first element is the given parameter. Returns the index of t in its table.
+    std::pair<std::size_t, bool> insert_subtree(const atermpp::aterm& t,
+                                                std::size_t size,
+                                                std::size_t position,
+                                                std::size_t parameter,
+                                                std::size_t thread_index)
+    {
+      if (size == 1)
+      {
+        return m_values[parameter]->insert(atermpp::down_cast<data::data_expression>(t), thread_index);
+      }
+      std::size_t left_size = (size + 1) / 2;
+      std::size_t left = insert_subtree(t[0], left_size, position + 1, parameter, thread_index).first;
+      std::size_t right = insert_subtree(t[1], size - left_size, position + left_size, parameter + left_size, thread_index).first;
+      return m_nodes[position]->insert(make_node(left, right), thread_index);
+    }
+
+    // Returns the index of the subtree t in its table, or npos if it is not present.
+    std::size_t index_subtree(const atermpp::aterm& t,
+                              std::size_t size,
+                              std::size_t position,
+                              std::size_t parameter,
+                              std::size_t thread_index) const
+    {
+      if (size == 1)
+      {
+        return m_values[parameter]->index(atermpp::down_cast<data::data_expression>(t), thread_index);
+      }
+      std::size_t left_size = (size + 1) / 2;
+      std::size_t left = index_subtree(t[0], left_size, position + 1, parameter, thread_index);
+      if (left == npos)
+      {
+        return npos;
+      }
+      std::size_t right = index_subtree(t[1], size - left_size, position + left_size, parameter + left_size, thread_index);
+      if (right == npos)
+      {
+        return npos;
+      }
+      return m_nodes[position]->index(make_node(left, right), thread_index);
+    }
+
+    // Appends the elements of the subtree with the given index to result.
+    void collect_subtree(std::size_t index,
+                         std::size_t size,
+                         std::size_t position,
+                         std::size_t parameter,
+                         std::vector<data::data_expression>& result) const
+    {
+      if (size == 1)
+      {
+        result.push_back((*m_values[parameter])[index]);
+        return;
+      }
+      std::size_t left_size = (size + 1) / 2;
+      std::uint64_t node = (*m_nodes[position])[index];
+      collect_subtree((node >> 32) - 1, left_size, position + 1, parameter, result);
+      collect_subtree((node & 0xffffffff) - 1, size - left_size, position + left_size, parameter + left_size, result);
+    }
+
+  public:
+    /// \brief Value returned when a state does not exist in the set.
+    static constexpr std::size_t npos = state_set::npos;
+
+    explorer_state_set()
+      : explorer_state_set(1)
+    {}
+
+    /// \brief Constructor. The threads are numbered as in an atermpp::indexed_set.
+    explicit explorer_state_set(std::size_t number_of_threads)
+      : m_number_of_threads(number_of_threads),
+        m_states(number_of_threads)
+    {}
+
+    /// \brief Stores states that consist of the given number of elements using tree compression.
+    /// \details States with less than two elements are always stored as terms. The set is cleared.
+    ///          Must not be called concurrently with other operations.
+    void enable_tree_compression(std::size_t number_of_elements)
+    {
+      m_values.clear();
+      m_nodes.clear();
+      m_state_size = number_of_elements < 2 ? 0 : number_of_elements;
+      for (std::size_t i = 0; i < m_state_size; i++)
+      {
+        m_values.push_back(std::make_unique<value_set>(m_number_of_threads));
+      }
+      for (std::size_t i = 0; i + 1 < m_state_size; i++)
+      {
+        m_nodes.push_back(std::make_unique<node_set>(m_number_of_threads));
+      }
+      m_states.clear();
+    }
+
+    /// \returns True if the states are stored using tree compression.
+    bool tree_compression() const
+    {
+      return m_state_size > 0;
+    }
+
+    /// \brief Allocates the table once for the given number of states, see utilities::indexed_set.
+    /// \details Not available with tree compression, as the number of nodes and values that is needed
+    ///          for a number of states is not known in advance.
+    void set_fixed_capacity(std::size_t capacity, std::size_t thread_index = 0)
+    {
+      assert(!tree_compression());
+      m_states.set_fixed_capacity(capacity, thread_index);
+    }
+
+    /// \brief Inserts the state s. The state must have the number of elements passed to enable_tree_compression.
+    /// \returns The index of s, and a boolean indicating whether s was not present yet.
+    std::pair<std::size_t, bool> insert(const state& s, std::size_t thread_index = 0)
+    {
+      if (!tree_compression())
+      {
+        return m_states.insert(s, thread_index);
+      }
+      assert(s.size() == m_state_size);
+      return insert_subtree(s, m_state_size, 0, 0, thread_index);
+    }
+
+    /// \returns The index of the state s, or npos when it is not present.
+    std::size_t index(const state& s, std::size_t thread_index = 0) const
+    {
+      if (!tree_compression())
+      {
+        return m_states.index(s, thread_index);
+      }
+      assert(s.size() == m_state_size);
+      return index_subtree(s, m_state_size, 0, 0, thread_index);
+    }
+
+    /// \returns The state with the given index. In a parallel context an index
+    ///          that has not been filled yields the default state.
+    state operator[](std::size_t index) const
+    {
+      if (!tree_compression())
+      {
+        return m_states[index];
+      }
+      if ((*m_nodes[0])[index] == 0)
+      {
+        return state();
+      }
+      std::vector<data::data_expression> elements;
+      elements.reserve(m_state_size);
+      collect_subtree(index, m_state_size, 0, 0, elements);
+      state result;
+      make_state(result, elements.begin(), m_state_size);
+      return result;
+    }
+
+    /// \returns The number of states, including indices that are skipped in a parallel context.
+    std::size_t size(std::size_t thread_index = 0) const
+    {
+      if (!tree_compression())
+      {
+        return m_states.size(thread_index);
+      }
+      return m_nodes[0]->size(thread_index);
+    }
+
+    /// \brief Removes all states.
+    void clear(std::size_t thread_index = 0)
+    {
+      m_states.clear(thread_index);
+      for (const std::unique_ptr<value_set>& values: m_values)
+      {
+        values->clear(thread_index);
+      }
+      for (const std::unique_ptr<node_set>& nodes: m_nodes)
+      {
+        nodes->clear(thread_index);
+      }
+    }
+};
+
+} // namespace mcrl2::lps
+
+#endif // MCRL2_LPS_EXPLORER_STATE_SET_H
@@ -12,12 +12,17 @@
 #ifndef MCRL2_LPS_EXPLORER_UTILITIES_H
 #define MCRL2_LPS_EXPLORER_UTILITIES_H
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <sstream>
 #include "mcrl2/atermpp/standard_containers/indexed_set.h"
 #include "mcrl2/atermpp/standard_containers/detail/unordered_map_implementation.h"
 #include "mcrl2/data/rewriter.h"
 #include "mcrl2/lps/detail/instantiate_global_variables.h"
 #include "mcrl2/atermpp/standard_containers/vector.h"
 #include "mcrl2/lps/explorer_projections.h"
+#include "mcrl2/utilities/fixed_size_cache.h"
 
 namespace mcrl2::lps
 {
@@ -162,19 +167,163 @@ struct cache_hash
 
 } // end namespace detail
 
-using summand_cache_map = atermpp::utilities::unordered_map<atermpp::aterm,
+/// \brief Counts the hits and misses of the caches of a summand, which are shared by all threads.
+class explorer_cache_metric
+{
+  protected:
+    std::atomic<std::size_t> m_hits = 0;
+    std::atomic<std::size_t> m_misses = 0;
+
+  public:
+    explorer_cache_metric() = default;
+
+    explorer_cache_metric(const explorer_cache_metric& other)
+      : m_hits(other.m_hits.load()),
+        m_misses(other.m_misses.load())
+    {}
+
+    void hit()
+    {
+      m_hits.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void miss()
+    {
+      m_misses.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::size_t hits() const
+    {
+      return m_hits.load();
+    }
+
+    std::size_t misses() const
+    {
+      return m_misses.load();
+    }
+
+    /// \returns A message in the format of utilities::cache_metric.
+    std::string message() const
+    {
+      const std::size_t total = hits() + misses();
+      const double percentage = total == 0 ? 0.0 : static_cast<double>(hits()) / static_cast<double>(total) * 100;
+      std::ostringstream out;
+      out << hits() << " times found out of " << total << " calls (" << percentage << " %)";
+      return out.str();
+    }
+};
+
+/// \brief A cache for the explorer that can be shared by threads. If a maximum size is given, the
+///        least recently used entry is removed when the cache is full.
+/// \details An unbounded cache is a map that supports concurrent lookups and insertions, as entries are
+///          never removed from it. Accesses to a bounded cache are serialised by a mutex. Values are copied
+///          out of the cache, such that they remain valid when another thread removes their entry.
+template <typename Key, typename T, typename Hash, typename Equality>
+class explorer_cache
+{
+  protected:
+    using map_type = atermpp::utilities::unordered_map<Key, T, Hash, Equality, std::allocator<std::pair<Key, T>>, true>;
+    using bounded_map_type = atermpp::utilities::unordered_map<Key, T, Hash, Equality, std::allocator<std::pair<Key, T>>, false>;
+    using bounded_cache_type = utilities::fixed_size_cache<utilities::lru_policy<bounded_map_type>>;
+
+    // The LRU policy stores the keys as the map does, i.e., as unprotected terms that are kept alive by the
+    // map. Hence an eviction by one thread does not touch the protection set of the thread that inserted the key.
+    static_assert(atermpp::detail::is_markable_aterm<typename bounded_map_type::key_type>::value,
+                  "the keys of a bounded explorer cache must not be protected terms");
+
+    // The entries of an unbounded cache.
+    map_type m_map;
+
+    // The entries of a bounded cache, which may only be accessed while holding m_mutex.
+    std::unique_ptr<bounded_cache_type> m_bounded_cache;
+    std::mutex m_mutex;
+
+  public:
+    /// \brief Constructor. A maximum size of 0 means that the cache is unbounded.
+    explicit explorer_cache(std::size_t maximum_size = 0)
+    {
+      if (maximum_size > 0)
+      {
+        m_bounded_cache = std::make_unique<bounded_cache_type>(maximum_size);
+      }
+    }
+
+    // The mutex cannot be copied or moved, but caches are only copied or moved before exploration starts.
+    explorer_cache(const explorer_cache& other)
+      : m_map(other.m_map),
+        m_bounded_cache(other.m_bounded_cache ? std::make_unique<bounded_cache_type>(*other.m_bounded_cache) : nullptr)
+    {}
+
+    explorer_cache(explorer_cache&& other) noexcept
+      : m_map(std::move(other.m_map)),
+        m_bounded_cache(std::move(other.m_bounded_cache))
+    {}
+
+    /// \brief Searches for key, and assigns the value that belongs to it to result if it is present.
+    template <typename K>
+    bool find(const K& key, T& result, explorer_cache_metric& metric)
+    {
+      if (m_bounded_cache)
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto i = m_bounded_cache->find(key);
+        if (i == m_bounded_cache->end())
+        {
+          metric.miss();
+          return false;
+        }
+        result = static_cast<const T&>(i->second);
+      }
+      else
+      {
+        utilities::shared_guard guard = atermpp::detail::g_thread_term_pool().lock_shared();
+        auto i = m_map.find(key);
+        if (i == m_map.end())
+        {
+          guard.unlock();
+          metric.miss();
+          return false;
+        }
+        result = static_cast<const T&>(i->second);
+      }
+      metric.hit();
+      return true;
+    }
+
+    /// \brief Stores value for key, unless another thread stored a value for it in the meantime.
+    void insert(const Key& key, const T& value)
+    {
+      if (m_bounded_cache)
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_bounded_cache->try_emplace(key, value);
+      }
+      else
+      {
+        m_map.emplace(key, value);
+      }
+    }
+
+    std::size_t size()
+    {
+      if (m_bounded_cache)
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_bounded_cache->size();
+      }
+      return m_map.size();
+    }
+};
+
+using summand_cache_map = explorer_cache<atermpp::aterm,
     atermpp::term_list<data::data_expression_list>,
     detail::cache_hash,
-    detail::cache_equality,
-    std::allocator<std::pair<atermpp::aterm, atermpp::term_list<data::data_expression_list>>>,
-    true>;
+    detail::cache_equality>;
 
-using projection_cache_map = atermpp::utilities::unordered_map<lps::state,
+using projection_cache_map = explorer_cache<lps::state,
     std::vector<projected_transition>,
     projection_cache_hash,
-    projection_cache_equality,
-    std::allocator<std::pair<lps::state, std::vector<projected_transition>>>,
-    true>;
+    projection_cache_equality>;
 
 struct explorer_summand
 {
@@ -190,6 +339,7 @@ struct explorer_summand
   std::vector<data::variable> gamma;
   atermpp::function_symbol f_gamma;
   mutable summand_cache_map local_cache;
+  mutable explorer_cache_metric cache_metric;
 
   // attributes for projections (these are not initialized during construction!)
   std::vector<std::size_t> I_r;  // indices of read parameters
@@ -207,14 +357,16 @@ struct explorer_summand
   }
 
   template <typename ActionSummand>
-  explorer_summand(const ActionSummand& summand, std::size_t summand_index, const data::variable_list& process_parameters, caching cache_strategy_)
+  explorer_summand(const ActionSummand& summand, std::size_t summand_index, const data::variable_list& process_parameters, caching cache_strategy_, std::size_t cache_size = 0)
     : variables(summand.summation_variables()),
       condition(summand.condition()),
       multi_action(summand.multi_action()),
       distribution(summand_distribution(summand)),
       next_state(make_data_expression_vector(summand.next_state(process_parameters))),
       index(summand_index),
-      cache_strategy(cache_strategy_)
+      cache_strategy(cache_strategy_),
+      local_cache(cache_size),
+      projection_cache(cache_size)
   {
     gamma = free_variables(summand.condition(), process_parameters);
     if (cache_strategy_ == caching::global)
@@ -0,0 +1,382 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file lts/detail/liblts_bisim_par.h
+/// \brief Strong and branching bisimulation reduction by signature refinement
+///        using multiple threads, following S. Blom and S. Orzan, "Distributed
+///        branching bisimulation reduction of state spaces", PDMC 2003.
+
+#ifndef MCRL2_LTS_DETAIL_LIBLTS_BISIM_PAR_H
+#define MCRL2_LTS_DETAIL_LIBLTS_BISIM_PAR_H
+
+#include <algorithm>
+#include "mcrl2/lts/detail/liblts_merge.h"
+#include "mcrl2/lts/detail/liblts_scc.h"
+#include "mcrl2/lts/transition_csr.h"
+#include "mcrl2/utilities/configuration.h"
+#include "mcrl2/utilities/hash_utility.h"
+#include "mcrl2/utilities/indexed_set.h"
+#include "mcrl2/utilities/parallel_for.h"
+
+namespace mcrl2::lts::detail
+{
+
+/// \brief Computes strong or branching bisimulation by signature refinement with multiple threads.
+/// \details In every round the signature of each state is computed concurrently. The signature of
+///          a state s consists of its current block and the pairs (a, B) such that s can reach a
+///          state in block B by an action a. In case of branching bisimulation the pair may be
+///          preceded by inert tau steps, i.e., tau steps within the block of s, and an inert tau
+///          step itself is not part of the signature. Signatures are numbered by a concurrent
+///          hash table, and these numbers form the next partition. The partition is stable
+///          when the number of blocks does not change anymore.
+///
+///          For branching bisimulation the LTS must not contain tau loops, see scc_reduce. The
+///          signature of a state then depends on those of its tau successors, and the states are
+///          therefore processed per level, where the level of a state is one more than the
+///          maximal level of its tau successors.
+template <class LTS_TYPE>
+class bisim_partitioner_par
+{
+  protected:
+    // A signature is a sorted sequence of pairs of a label and a block.
+    using signature_t = std::vector<std::pair<std::size_t, std::size_t>>;
+
+    // The key in the hash table is the block of a state followed by its signature, flattened.
+    struct key_hash
+    {
+      std::size_t operator()(const std::vector<std::size_t>& key) const
+      {
+        std::size_t hash = key.size();
+        for (const std::size_t x: key)
+        {
+          hash = utilities::detail::hash_combine(hash, x);
+        }
+        return hash;
+      }
+    };
+
+    using signature_table = utilities::indexed_set<std::vector<std::size_t>, utilities::detail::GlobalThreadSafe, key_hash>;
+
+    const LTS_TYPE& m_lts;
+    const bool m_branching;
+    const std::size_t m_number_of_threads;
+
+    // The threads that are used for all levels and rounds of the refinement.
+    utilities::thread_pool m_thread_pool;
+
+    // The block of each state, and the number of blocks.
+    std::vector<std::size_t> m_block;
+    std::size_t m_number_of_blocks = 0;
+
+    // The states ordered by level, and the position in m_order where each level starts.
+    // For strong bisimulation all states are at level 0.
+    std::vector<std::size_t> m_order;
+    std::vector<std::size_t> m_level_start;
+
+    bool is_tau(const std::size_t label) const
+    {
+      return m_lts.is_tau(m_lts.apply_hidden_label_map(label));
+    }
+
+    // Order the states such that the tau successors of a state occur at lower levels.
+    void compute_levels()
+    {
+      const std::size_t n = m_lts.num_states();
+      std::vector<std::size_t> level(n, 0);
+      std::size_t number_of_levels = n == 0 ? 0 : 1;
+
+      if (m_branching)
+      {
+        // The incoming tau transitions, which are only kept while the levels are computed.
+        const transition_csr incoming(m_lts.get_transitions(), n, m_lts.num_action_labels(), false,
+            [this](std::size_t label) { return is_tau(label); });
+
+        // The number of tau successors of which the level is not known yet.
+        std::vector<std::size_t> unknown(n, 0);
+        for (const transition& t: m_lts.get_transitions())
+        {
+          if (is_tau(t.label()) && t.from() != t.to())
+          {
+            unknown[t.from()]++;
+          }
+        }
+
+        std::vector<std::size_t> todo;
+        for (std::size_t s = 0; s < n; ++s)
+        {
+          if (unknown[s] == 0)
+          {
+            todo.push_back(s);
+          }
+        }
+
+        std::size_t visited = 0;
+        while (!todo.empty())
+        {
+          const std::size_t s = todo.back();
+          todo.pop_back();
+          visited++;
+          number_of_levels = std::max(number_of_levels, level[s] + 1);
+          for (std::size_t i = incoming.lowerbound(s); i < incoming.upperbound(s); ++i)
+          {
+            const std::size_t predecessor = incoming.state(i);
+            if (predecessor != s)
+            {
+              level[predecessor] = std::max(level[predecessor], level[s] + 1);
+              if (--unknown[predecessor] == 0)
+              {
+                todo.push_back(predecessor);
+              }
+            }
+          }
+        }
+
+        if (visited != n)
+        {
+          throw mcrl2::runtime_error("Parallel branching bisimulation reduction requires an LTS without tau loops.");
+        }
+      }
+
+      // Sort the states on their level.
+      m_level_start.assign(number_of_levels + 1, 0);
+      for (std::size_t s = 0; s < n; ++s)
+      {
+        m_level_start[level[s] + 1]++;
+      }
+      for (std::size_t l = 1; l <= number_of_levels; ++l)
+      {
+        m_level_start[l] += m_level_start[l - 1];
+      }
+      std::vector<std::size_t> position(m_level_start.begin(), m_level_start.end() - 1);
+      m_order.resize(n);
+      for (std::size_t s = 0; s < n; ++s)
+      {
+        m_order[position[level[s]]++] = s;
+      }
+    }
+
+    // Compute the signature of state s given the signatures of its tau successors.
+    void compute_signature(const transition_csr& outgoing, const std::size_t s, std::vector<signature_t>& signatures, signature_t& result) const
+    {
+      result.clear();
+      for (std::size_t i = outgoing.lowerbound(s); i < outgoing.upperbound(s); ++i)
+      {
+        const std::size_t label = m_lts.apply_hidden_label_map(outgoing.label(i));
+        const std::size_t target = outgoing.state(i);
+        if (m_branching && m_lts.is_tau(label) && m_block[target] == m_block[s])
+        {
+          if (target != s)
+          {
+            result.insert(result.end(), signatures[target].begin(), signatures[target].end());
+          }
+        }
+        else
+        {
+          result.emplace_back(label, m_block[target]);
+        }
+      }
+      std::sort(result.begin(), result.end());
+      result.erase(std::unique(result.begin(), result.end()), result.end());
+    }
+
+    // Refine the partition until it is stable.
+    void refine()
+    {
+      const std::size_t n = m_lts.num_states();
+      const transition_csr outgoing(m_lts.get_transitions(), n, m_lts.num_action_labels(), true);
+
+      m_block.assign(n, 0);
+      m_number_of_blocks = n == 0 ? 0 : 1;
+
+      // Only for branching bisimulation the signatures of other states are needed.
+      std::vector<signature_t> signatures(m_branching ? n : 0);
+      std::vector<std::size_t> new_block(n);
+
+      std::size_t iterations = 0;
+      while (true)
+      {
+        mCRL2log(log::verbose) << "Iteration " << iterations << " currently has " << m_number_of_blocks << " blocks.\n";
+        signature_table table(m_number_of_threads);
+
+        for (std::size_t l = 0; l + 1 < m_level_start.size(); ++l)
+        {
+          const std::size_t first = m_level_start[l];
+          const std::size_t number_of_states = m_level_start[l + 1] - first;
+          m_thread_pool.parallel_for_ranges(number_of_states,
+            [&](const std::size_t thread_index, const std::size_t begin, const std::size_t end)
+            {
+              // The threads of a parallel indexed set are numbered from 1.
+              const std::size_t table_index = m_number_of_threads == 1 ? 0 : thread_index + 1;
+              signature_t signature;
+              std::vector<std::size_t> key;
+              for (std::size_t i = first + begin; i < first + end; ++i)
+              {
+                const std::size_t s = m_order[i];
+                compute_signature(outgoing, s, signatures, signature);
+
+                key.clear();
+                key.push_back(m_block[s]);
+                for (const std::pair<std::size_t, std::size_t>& p: signature)
+                {
+                  key.push_back(p.first);
+                  key.push_back(p.second);
+                }
+                new_block[s] = table.insert(key, table_index).first;
+
+                if (m_branching)
+                {
+                  signatures[s] = std::move(signature);
+                  signature = signature_t();
+                }
+              }
+            });
+        }
+
+        // With multiple threads the numbers of the table can contain holes. Number the blocks consecutively.
+        std::vector<std::size_t> renumbering(table.size(m_number_of_threads == 1 ? 0 : 1), signature_table::npos);
+        std::size_t number_of_blocks = 0;
+        for (std::size_t s = 0; s < n; ++s)
+        {
+          std::size_t& b = renumbering[new_block[s]];
+          if (b == signature_table::npos)
+          {
+            b = number_of_blocks++;
+          }
+          new_block[s] = b;
+        }
+
+        ++iterations;
+        if (number_of_blocks == m_number_of_blocks)
+        {
+          break;
+        }
+        m_block.swap(new_block);
+        m_number_of_blocks = number_of_blocks;
+      }
+
+      mCRL2log(log::verbose) << "Done after " << iterations << " iterations with " << m_number_of_blocks << " blocks.\n";
+    }
+
+  public:
+    /// \brief Constructor, which computes the bisimulation partition of the given LTS.
+    /// \param l The LTS, which must not contain tau loops in case of branching bisimulation.
+    /// \param branching If true, branching bisimulation is computed, and otherwise strong bisimulation.
+    /// \param number_of_threads The number of threads that are used.
+    bisim_partitioner_par(const LTS_TYPE& l, const bool branching, const std::size_t number_of_threads)
+      : m_lts(l),
+        m_branching(branching),
+        m_number_of_threads(number_of_threads),
+        m_thread_pool(number_of_threads)
+    {
+      assert(number_of_threads > 0);
+      compute_levels();
+      refine();
+    }
+
+    /// \returns The number of equivalence classes.
+    std::size_t num_eq_classes() const
+    {
+      return m_number_of_blocks;
+    }
+
+    /// \returns The equivalence class of state s.
+    std::size_t get_eq_class(const std::size_t s) const
+    {
+      return m_block[s];
+    }
+
+    /// \returns True iff the states s and t are bisimilar.
+    bool in_same_class(const std::size_t s, const std::size_t t) const
+    {
+      return m_block[s] == m_block[t];
+    }
+
+    /// \brief Replaces the LTS by its quotient with respect to the computed partition.
+    /// \details The LTS must be the one that was passed to the constructor. The state labels
+    ///          of each equivalence class are merged.
+    void finalize_minimized_LTS(LTS_TYPE& l) const
+    {
+      assert(&l == &m_lts);
+
+      std::vector<transition> transitions;
+      transitions.reserve(l.num_transitions());
+      for (const transition& t: std::as_const(l).get_transitions())
+      {
+        const std::size_t label = l.apply_hidden_label_map(t.label());
+        if (!m_branching || !l.is_tau(label) || m_block[t.from()] != m_block[t.to()])
+        {
+          transitions.emplace_back(m_block[t.from()], label, m_block[t.to()]);
+        }
+      }
+      std::sort(transitions.begin(), transitions.end());
+      transitions.erase(std::unique(transitions.begin(), transitions.end()), transitions.end());
+      l.get_transitions().swap(transitions);
+
+      if (l.has_state_info())
+      {
+        std::vector<typename LTS_TYPE::state_label_t> new_labels(m_number_of_blocks);
+        for (std::size_t i = l.num_states(); i > 0; )
+        {
+          --i;
+          new_labels[m_block[i]] = new_labels[m_block[i]] + l.state_label(i);
+        }
+        for (std::size_t i = 0; i < m_number_of_blocks; ++i)
+        {
+          l.set_state_label(i, new_labels[i]);
+        }
+      }
+
+      l.set_initial_state(m_block[l.initial_state()]);
+      l.set_num_states(m_number_of_blocks, l.has_state_info());
+    }
+};
+
+/// \brief Reduces the LTS modulo strong or branching bisimulation using multiple threads.
+/// \param l The LTS that is reduced.
+/// \param branching If true branching bisimulation is used, and otherwise strong bisimulation.
+/// \param number_of_threads The number of threads that are used.
+template <class LTS_TYPE>
+void bisimulation_reduce_par(LTS_TYPE& l, const bool branching, const std::size_t number_of_threads)
+{
+  if (branching)
+  {
+    scc_reduce(l);
+  }
+
+  bisim_partitioner_par<LTS_TYPE> bisim_part(l, branching, number_of_threads);
+  bisim_part.finalize_minimized_LTS(l);
+}
+
+/// \brief Checks whether the initial states of two LTSs are strongly or branching bisimilar using multiple threads.
+/// \details The LTSs l1 and l2 are merged into l1, and l2 is cleared.
+/// \param l1 A first transition system.
+/// \param l2 A second transition system.
+/// \param branching If true branching bisimulation is used, and otherwise strong bisimulation.
+/// \param number_of_threads The number of threads that are used.
+/// \retval True iff the initial states of l1 and l2 are bisimilar.
+template <class LTS_TYPE>
+bool destructive_bisimulation_compare_par(LTS_TYPE& l1, LTS_TYPE& l2, const bool branching, const std::size_t number_of_threads)
+{
+  std::size_t init_l2 = l2.initial_state() + l1.num_states();
+  detail::merge(l1, l2);
+  l2.clear();
+
+  if (branching)
+  {
+    scc_partitioner<LTS_TYPE> scc_part(l1);
+    scc_part.replace_transition_system(false);
+    init_l2 = scc_part.get_eq_class(init_l2);
+  }
+
+  bisim_partitioner_par<LTS_TYPE> bisim_part(l1, branching, number_of_threads);
+  return bisim_part.in_same_class(l1.initial_state(), init_l2);
+}
+
+} // namespace mcrl2::lts::detail
+
+#endif // MCRL2_LTS_DETAIL_LIBLTS_BISIM_PAR_H
@@ -13,6 +13,7 @@
 
 #include <unordered_set>
 #include "mcrl2/lts/lts.h"
+#include "mcrl2/lts/transition_csr.h"
 #include "mcrl2/utilities/logger.h"
 
 namespace mcrl2::lts
@@ -20,105 +21,6 @@ namespace mcrl2::lts
 
 namespace detail
 {
-  // An indexed sorted vector below contains the outgoing or incoming tau transitions per state,
-  // grouped per state. The input consists of an automaton with transitions. The incoming/outcoming
-  // tau transitions are grouped by state in the m_states_with_outgoing_or_incoming_tau_transition. 
-  // It is as long as the lts aut has tau transitions. The vector m_indices is as long as the number
-  // of states. For each state it contains the place in the other vector where its tau transitions
-  // start. So, the tau transitions reside at position indices[s] to indices[s+1]. These indices
-  // can be acquired using the functions lowerbound and upperbound. 
-  // This data structure is chosen due to its minimal memory and time footprint. 
-  template <class LTS_TYPE>
-  class indexed_sorted_vector_for_tau_transitions
-  {
-    protected:
-      using state_type = std::size_t;
-      using label_type = std::size_t;
-
-      std::vector <state_type> m_states_with_outgoing_or_incoming_tau_transition;
-      std::vector <size_t> m_indices;
-
-    public:
-
-      indexed_sorted_vector_for_tau_transitions(const LTS_TYPE& aut, bool outgoing)
-       : m_indices(aut.num_states()+1,0)
-      {
-        // First count the number of outgoing transitions per state and put it in indices.
-        for(const transition& t: aut.get_transitions())
-        {
-          if (aut.is_tau(aut.apply_hidden_label_map(t.label())))
-          {
-            m_indices[outgoing?t.from():t.to()]++;
-          }
-        }
-
-        // Calculate the m_indices where the states with outgoing/incoming tau transition must be placed.
-        // Put the starting index for state i at position i-1. When placing the transitions these indices
-        // are decremented properly. 
-        
-        size_t sum=0;
-        for(state_type& i: m_indices)  // The vector is changed. This must be a reference. 
-        {
-          sum=sum+i;
-          i=sum;
-        }
-
-        // Now declare enough space for all transitions and store them in reverse order, while
-        // at the same time decrementing the indices in m_indices. 
-        m_states_with_outgoing_or_incoming_tau_transition.resize(sum);
-        for(const transition& t: aut.get_transitions())
-        {
-          if (aut.is_tau(aut.apply_hidden_label_map(t.label())))
-          {
-            if (outgoing)
-            {
-              assert(t.from()<m_indices.size());
-              assert(m_indices[t.from()]>0);
-              m_indices[t.from()]--;
-              assert(m_indices[t.from()] < m_states_with_outgoing_or_incoming_tau_transition.size());
-              m_states_with_outgoing_or_incoming_tau_transition[m_indices[t.from()]]=t.to();
-            }
-            else
-            {
-              assert(t.to()<m_indices.size());
-              assert(m_indices[t.to()]>0);
-              m_indices[t.to()]--;
-              assert(m_indices[t.to()] < m_states_with_outgoing_or_incoming_tau_transition.size());
-              m_states_with_outgoing_or_incoming_tau_transition[m_indices[t.to()]]=t.from();
-            }
-          }
-        }
-        assert(m_indices.at(aut.num_states())==m_states_with_outgoing_or_incoming_tau_transition.size());
-      }
-
-      // Get the indexed transitions. 
-      const std::vector<state_type>& get_transitions() const
-      {
-        return m_states_with_outgoing_or_incoming_tau_transition;
-      }
-    
-      // Get the lowest index of incoming/outging transitions stored in m_states_with_outgoing_or_incoming_tau_transition.
-      size_t lowerbound(const state_type s) const
-      {
-        assert(s+1<m_indices.size());
-        return m_indices[s];
-      }
-
-      // Get 1 beyond the higest index of incoming/outging transitions stored in m_states_with_outgoing_or_incoming_tau_transition.
-      size_t upperbound(const state_type s) const
-      {
-        assert(s+1<m_indices.size());
-        return m_indices[s+1];
-      }
-
-      // Drastically clear the vectors by resetting its memory usage to minimal. 
-      void clear()   
-      {
-        std::vector <state_type>().swap(m_states_with_outgoing_or_incoming_tau_transition);
-        std::vector <size_t>().swap(m_indices);
-        
-      }
-  };
 
 /// \brief This class contains an scc partitioner removing inert tau loops.
 
@@ -311,7 +213,9 @@ void scc_partitioner<LTS_TYPE>::number_sccs()
   const std::size_t uninitialised=-1;
   const std::size_t in_stack_indicator=-1;
 
-  indexed_sorted_vector_for_tau_transitions<LTS_TYPE> src_tgt(aut,true); // Group the tau transitions ordered per outgoing states. 
+  // The outgoing internal transitions per state. They are only kept while the SCCs are numbered.
+  const transition_csr src_tgt(aut.get_transitions(), aut.num_states(), aut.num_action_labels(), true,
+      [this](std::size_t label) { return aut.is_tau(aut.apply_hidden_label_map(label)); });
 
   std::vector< std::size_t > low(aut.num_states(),uninitialised);
   std::vector < std::size_t > disc(aut.num_states(),uninitialised);
@@ -346,7 +250,7 @@ void scc_partitioner<LTS_TYPE>::number_sccs()
         const size_t upper=src_tgt.upperbound(s);
         for(std::size_t i=transition_index; i<upper; ++i)
         {
-          const state_type v = src_tgt.get_transitions()[i];
+          const state_type v = src_tgt.state(i);
           if (disc[v] == uninitialised)
           {
             work.emplace_back(s, i + 1);
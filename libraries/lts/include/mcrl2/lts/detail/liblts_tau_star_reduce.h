@@ -12,6 +12,7 @@
 #define MCRL2_LTS_DETAIL_LIBLTS_TAU_STAR_REDUCE_H
 
 #include "mcrl2/lts/lts_utilities.h"
+#include "mcrl2/lts/transition_csr.h"
 
 namespace mcrl2::lts::detail
 {
@@ -136,7 +137,7 @@ void remove_redundant_transitions(lts<STATE_LABEL_T, ACTION_LABEL_T, LTS_BASE_CL
   using state_type = typename lts<STATE_LABEL_T, ACTION_LABEL_T, LTS_BASE_CLASS>::states_size_type;
   using label_type = typename lts<STATE_LABEL_T, ACTION_LABEL_T, LTS_BASE_CLASS>::labels_size_type;
 
-  outgoing_transitions_per_state_t outgoing_transitions(l.get_transitions(),l.num_states(),true);
+  const transition_csr outgoing_transitions(l.get_transitions(),l.num_states(),l.num_action_labels(),true);
   l.clear_transitions();
   std::set < state_type > states_reachable_in_one_visible_action;
   std::set < state_type > states_reachable_in_one_hidden_action;
@@ -145,10 +146,9 @@ void remove_redundant_transitions(lts<STATE_LABEL_T, ACTION_LABEL_T, LTS_BASE_CL
   {
     for(size_t j=outgoing_transitions.lowerbound(from); j<outgoing_transitions.upperbound(from); ++j)
     {
-      const outgoing_pair_t& p = outgoing_transitions.get_transitions()[j];
-      const state_type from_=from;         // the start state of a transition under consideration. 
-      const label_type label_=label(p);    // the label
-      const state_type to_=to(p);          // the target state
+      const state_type from_=from;                             // the start state of a transition under consideration. 
+      const label_type label_=outgoing_transitions.label(j);   // the label
+      const state_type to_=outgoing_transitions.state(j);      // the target state
 
       states_reachable_in_one_visible_action.clear();
       states_reachable_in_one_hidden_action.clear();
@@ -156,15 +156,15 @@ void remove_redundant_transitions(lts<STATE_LABEL_T, ACTION_LABEL_T, LTS_BASE_CL
       // For every transition from-label->to we calculate the sets { s | from -a->s } and { s | from -tau-> s }.
       for(size_t j_=outgoing_transitions.lowerbound(from_); j_<outgoing_transitions.upperbound(from_); ++j_)
       {
-        const outgoing_pair_t& j = outgoing_transitions.get_transitions()[j_];
-        if (l.is_tau(l.apply_hidden_label_map(label(j))))
+        const label_type label_j=outgoing_transitions.label(j_);
+        if (l.is_tau(l.apply_hidden_label_map(label_j)))
         {
-          states_reachable_in_one_hidden_action.insert(to(j));
+          states_reachable_in_one_hidden_action.insert(outgoing_transitions.state(j_));
         }
-        else if (label_==label(j))
+        else if (label_==label_j)
         {
           assert(!l.is_tau(l.apply_hidden_label_map(label_)));
-          states_reachable_in_one_visible_action.insert(to(j)); 
+          states_reachable_in_one_visible_action.insert(outgoing_transitions.state(j_)); 
         }
       }
 
@@ -176,13 +176,13 @@ void remove_redundant_transitions(lts<STATE_LABEL_T, ACTION_LABEL_T, LTS_BASE_CL
       {
         // Find a visible step from state middle to state to, unless label is hidden, in which case we search
         // a hidden step. 
-        // for(const outgoing_pair_t& j: outgoing_transitions[middle])
         for(size_t j_=outgoing_transitions.lowerbound(middle); j_<outgoing_transitions.upperbound(middle); ++j_)
         {
-          const outgoing_pair_t& j=outgoing_transitions.get_transitions()[j_];
+          const label_type label_j=outgoing_transitions.label(j_);
+          const state_type to_j=outgoing_transitions.state(j_);
           if (l.is_tau(l.apply_hidden_label_map(label_)))
           { 
-            if (l.is_tau(l.apply_hidden_label_map(label(j))) && to(j)==to_)
+            if (l.is_tau(l.apply_hidden_label_map(label_j)) && to_j==to_)
             {
               assert(!found);
               found=true; break;
@@ -190,7 +190,7 @@ void remove_redundant_transitions(lts<STATE_LABEL_T, ACTION_LABEL_T, LTS_BASE_CL
           }
           else // label is visible.
           {
-            if (label(j)==label_ && to(j)==to_)
+            if (label_j==label_ && to_j==to_)
             {
               assert(!found);
               found=true; break;
@@ -208,11 +208,9 @@ void remove_redundant_transitions(lts<STATE_LABEL_T, ACTION_LABEL_T, LTS_BASE_CL
         for(const state_type& middle: states_reachable_in_one_visible_action)
         {
           // Find a hidden step from state middle to state to.
-          // for(const outgoing_pair_t& j: outgoing_transitions[middle])
           for(size_t j_=outgoing_transitions.lowerbound(middle); j_<outgoing_transitions.upperbound(middle); ++j_)
           {
-            const outgoing_pair_t& j=outgoing_transitions.get_transitions()[j_];
-            if (l.is_tau(l.apply_hidden_label_map(label(j))) && to(j)==to_)
+            if (l.is_tau(l.apply_hidden_label_map(outgoing_transitions.label(j_))) && outgoing_transitions.state(j_)==to_)
             { 
               assert(!found);
               found=true; break;
@@ -24,6 +24,7 @@
 #include "mcrl2/lts/detail/liblts_bisim_gjkw.h"
 #include "mcrl2/lts/detail/liblts_bisim_gj.h"
 #include "mcrl2/lts/detail/liblts_bisim_gj_lazy_BLC.h"
+#include "mcrl2/lts/detail/liblts_bisim_par.h"
 #include "mcrl2/lts/detail/liblts_branching_bisim_minimal_depth.h"
 #include "mcrl2/lts/detail/liblts_weak_bisim.h"
 #include "mcrl2/lts/detail/liblts_add_an_action_loop.h"
@@ -44,9 +45,11 @@ namespace mcrl2::lts
  * \param[in] l A labelled transition system that must be reduced.
  * \param[in] eq The equivalence with respect to which the LTS will be
  *            reduced.
+ * \param[in] number_of_threads The number of threads used by the reductions
+ *            that support multiple threads.
  **/
 template <class LTS_TYPE>
-void reduce(LTS_TYPE& l, lts_equivalence eq);
+void reduce(LTS_TYPE& l, lts_equivalence eq, std::size_t number_of_threads = 1);
 
 /** \brief Checks whether this LTS is equivalent to another LTS.
  * \param[in] l1 The first LTS that will be compared.
@@ -55,6 +58,8 @@ void reduce(LTS_TYPE& l, lts_equivalence eq);
  *            compared.
  * \param[in] generate_counter_examples Whether to generate a counter example
  * \param[in] counter_example_file The file to store the counter example in
+ * \param[in] number_of_threads The number of threads used by the equivalences
+ *            that support multiple threads.
  * \retval true if the LTSs are found to be equivalent.
  * \retval false otherwise.
  * \warning This function alters the internal data structure of
@@ -68,7 +73,8 @@ bool destructive_compare(LTS_TYPE& l1,
                          const lts_equivalence eq,
                          const bool generate_counter_examples = false,
                          const std::string& counter_example_file = std::string(),
-                         const bool structured_output = false)
+                         const bool structured_output = false,
+                         const std::size_t number_of_threads = 1)
 {
   // Merge this LTS and l and store the result in this LTS.
   // In the resulting LTS, the initial state i of l will have the
@@ -108,6 +114,14 @@ bool destructive_compare(LTS_TYPE& l1,
     {
       return detail::destructive_bisimulation_compare_gj_lazy_BLC(l1,l2, false,false,generate_counter_examples,counter_example_file,structured_output);
     }
+    case lts_eq_bisim_par:
+    {
+      if (generate_counter_examples)
+      {
+        mCRL2log(log::warning) << "The parallel bisimulation algorithm does not generate counter examples.\n";
+      }
+      return detail::destructive_bisimulation_compare_par(l1,l2, false,number_of_threads);
+    }
     case lts_eq_branching_bisim_jgkw:
     {
       return detail::destructive_bisimulation_compare_dnj(l1,l2, true,false,generate_counter_examples,counter_example_file,structured_output);
@@ -137,6 +151,14 @@ bool destructive_compare(LTS_TYPE& l1,
     {
       return detail::destructive_bisimulation_compare_gj_lazy_BLC(l1,l2, true,false,generate_counter_examples,counter_example_file,structured_output);
     }
+    case lts_eq_branching_bisim_par:
+    {
+      if (generate_counter_examples)
+      {
+        mCRL2log(log::warning) << "The parallel branching bisimulation algorithm does not generate counter examples.\n";
+      }
+      return detail::destructive_bisimulation_compare_par(l1,l2, true,number_of_threads);
+    }
     case lts_eq_divergence_preserving_branching_bisim_jgkw:
     {
       return detail::destructive_bisimulation_compare_dnj(l1,l2, true,true,generate_counter_examples,counter_example_file,structured_output);
@@ -279,6 +301,8 @@ bool destructive_compare(LTS_TYPE& l1,
  *            compared.
  * \param[in] generate_counter_examples Whether to generate a counter example
  * \param[in] counter_example_file The file to store the counter example in
+ * \param[in] number_of_threads The number of threads used by the equivalences
+ *            that support multiple threads.
  * \retval true if the LTSs are found to be equivalent.
  * \retval false otherwise.
  */
@@ -288,7 +312,8 @@ bool compare(const LTS_TYPE& l1,
   lts_equivalence eq,
   bool generate_counter_examples = false,
   const std::string& counter_example_file = "",
-  bool structured_output = false);
+  bool structured_output = false,
+  std::size_t number_of_threads = 1);
 
 /** \brief Checks whether this LTS is smaller than another LTS according
  * to a preorder.
@@ -647,7 +672,7 @@ void merge(LTS_TYPE& l1, const LTS_TYPE& l2)
 
 
 template <class LTS_TYPE>
-void reduce(LTS_TYPE& l,lts_equivalence eq)
+void reduce(LTS_TYPE& l,lts_equivalence eq, std::size_t number_of_threads)
 {
 
   switch (eq)
@@ -690,6 +715,11 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
       s.run();
       return;
     }
+    case lts_eq_bisim_par:
+    {
+      detail::bisimulation_reduce_par(l,false,number_of_threads);
+      return;
+    }
     case lts_eq_branching_bisim:
     {
       detail::bisimulation_reduce_gj(l,true,false);
@@ -726,6 +756,11 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
       s.run();
       return;
     }
+    case lts_eq_branching_bisim_par:
+    {
+      detail::bisimulation_reduce_par(l,true,number_of_threads);
+      return;
+    }
     case lts_eq_divergence_preserving_branching_bisim:
     {
       detail::bisimulation_reduce_gj(l,true,true);
@@ -879,7 +914,7 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
 }
 
 template <class LTS_TYPE>
-bool compare(const LTS_TYPE& l1, const LTS_TYPE& l2, const lts_equivalence eq, const bool generate_counter_examples, const std::string& counter_example_file, const bool structured_output)
+bool compare(const LTS_TYPE& l1, const LTS_TYPE& l2, const lts_equivalence eq, const bool generate_counter_examples, const std::string& counter_example_file, const bool structured_output, const std::size_t number_of_threads)
 {
   switch (eq)
   {
@@ -888,7 +923,7 @@ bool compare(const LTS_TYPE& l1, const LTS_TYPE& l2, const lts_equivalence eq, c
     default:
       LTS_TYPE l1_copy(l1);
       LTS_TYPE l2_copy(l2);
-      return destructive_compare(l1_copy, l2_copy, eq ,generate_counter_examples, counter_example_file, structured_output);
+      return destructive_compare(l1_copy, l2_copy, eq ,generate_counter_examples, counter_example_file, structured_output, number_of_threads);
   }
   return false;
 }
@@ -12,6 +12,8 @@
 #ifndef MCRL2_LTS_BUILDER_H
 #define MCRL2_LTS_BUILDER_H
 
+#include "mcrl2/atermpp/aterm_io_chunked.h"
+#include "mcrl2/atermpp/standard_containers/vector.h"
 #include "mcrl2/lps/explorer.h"
 #include "mcrl2/lts/detail/lts_convert.h"
 #include "mcrl2/lts/lts_io.h"
@@ -27,12 +29,30 @@ lps::state remove_time_stamp(const lps::state& s)
 
 struct lts_builder
 {
-  using indexed_set_for_states_type = atermpp::indexed_set<lps::state, mcrl2::utilities::detail::GlobalThreadSafe>;
+  using indexed_set_for_states_type = lps::explorer_state_set;
   // All LTS classes use integers to represent actions in transitions. A mapping from actions to integers
   // is needed to avoid duplicates.
   utilities::unordered_map_large<lps::multi_action, std::size_t> m_actions;
 
-  lts_builder()
+  // Threads number the actions that they encounter in this set, which does not require locking. The
+  // index of an action in this set is a temporary label, that is replaced by its label in m_actions
+  // when the transitions are moved to the LTS.
+  atermpp::indexed_set<lps::multi_action, mcrl2::utilities::detail::GlobalThreadSafe> m_thread_actions;
+
+  // The labels in m_actions of the temporary labels, or undefined_label if not known yet.
+  static constexpr std::size_t undefined_label = std::numeric_limits<std::size_t>::max();
+  std::vector<std::size_t> m_thread_labels;
+
+  // A buffer of transitions with temporary labels for each thread. Thread indices start at 1 if there
+  // is more than one thread, and the single thread has index 0 otherwise, which adds its transitions
+  // to the LTS directly. A buffer is moved to the LTS when it is full.
+  static constexpr std::size_t transition_buffer_size = 1 << 14;
+  std::vector<std::vector<transition>> m_thread_transitions;
+  std::mutex m_exclusive_lts_access;
+
+  explicit lts_builder(std::size_t number_of_threads = 1)
+    : m_thread_actions(number_of_threads),
+      m_thread_transitions(number_of_threads + 1)
   {
     lps::multi_action tau(process::action_list(), data::undefined_real());
     m_actions.emplace(std::make_pair(tau, m_actions.size()));
@@ -48,9 +68,60 @@ struct lts_builder
     return i->second;
   }
 
-  // Add a transition to the LTS
+  // Moves the transitions in the buffer of the given thread to lts, and replaces their temporary labels.
+  template <typename LTS>
+  void move_thread_transitions(LTS& lts, std::size_t thread_index)
+  {
+    std::vector<transition>& transitions = m_thread_transitions[thread_index];
+    std::lock_guard<std::mutex> guard(m_exclusive_lts_access);
+    for (const transition& t: transitions)
+    {
+      if (t.label() >= m_thread_labels.size())
+      {
+        m_thread_labels.resize(t.label() + 1, undefined_label);
+      }
+      std::size_t& label = m_thread_labels[t.label()];
+      if (label == undefined_label)
+      {
+        label = add_action(m_thread_actions[t.label()]);
+      }
+      lts.add_transition(transition(t.from(), label, t.to()));
+    }
+    transitions.clear();
+  }
+
+  // Adds the transition to lts, via the buffer of the given thread if there is more than one thread.
+  template <typename LTS>
+  void add_thread_transition(LTS& lts, std::size_t from, const lps::multi_action& a, std::size_t to, std::size_t thread_index)
+  {
+    assert(thread_index < m_thread_transitions.size());
+    if (thread_index == 0)
+    {
+      lts.add_transition(transition(from, add_action(a), to));
+      return;
+    }
+    std::vector<transition>& transitions = m_thread_transitions[thread_index];
+    transitions.emplace_back(from, m_thread_actions.insert(a, thread_index).first, to);
+    if (transitions.size() >= transition_buffer_size)
+    {
+      move_thread_transitions(lts, thread_index);
+    }
+  }
+
+  // Moves the transitions that are left in the buffers of all threads to lts.
+  template <typename LTS>
+  void add_thread_transitions(LTS& lts)
+  {
+    for (std::size_t i = 0; i < m_thread_transitions.size(); i++)
+    {
+      move_thread_transitions(lts, i);
+      std::vector<transition>().swap(m_thread_transitions[i]);
+    }
+  }
+
+  // Add a transition to the LTS. Threads can add transitions concurrently.
   virtual void
-  add_transition(std::size_t from, const lps::multi_action& a, std::size_t to, std::size_t number_of_threads = 0)
+  add_transition(std::size_t from, const lps::multi_action& a, std::size_t to, std::size_t number_of_threads = 0, std::size_t thread_index = 0)
     = 0;
 
   // Add actions and states to the LTS
@@ -65,7 +136,7 @@ struct lts_builder
 class lts_none_builder: public lts_builder
 {
   public:
-    void add_transition(std::size_t /* from */, const lps::multi_action& /* a */, std::size_t /* to */, const std::size_t /* number_of_threads */) override
+    void add_transition(std::size_t /* from */, const lps::multi_action& /* a */, std::size_t /* to */, const std::size_t /* number_of_threads */, const std::size_t /* thread_index */) override
     {}
 
     void finalize(const indexed_set_for_states_type& /* state_map */, bool /* timed */) override
@@ -79,10 +150,11 @@ class lts_aut_builder: public lts_builder
 {
   protected:
     lts_aut_t m_lts;
-    std::mutex m_exclusive_transition_access;
 
   public:
-    lts_aut_builder() = default;
+    explicit lts_aut_builder(std::size_t number_of_threads = 1)
+      : lts_builder(number_of_threads)
+    {}
 
     const lts_aut_t& lts() const
     {
@@ -94,20 +166,16 @@ class lts_aut_builder: public lts_builder
       return m_lts;
     }
 
-    void add_transition(std::size_t from, const lps::multi_action& a, std::size_t to, const std::size_t number_of_threads) override
+    void add_transition(std::size_t from, const lps::multi_action& a, std::size_t to, const std::size_t /* number_of_threads */, const std::size_t thread_index) override
     {
-      std::unique_lock<std::mutex> guard(m_exclusive_transition_access, std::defer_lock);
-      if (mcrl2::utilities::detail::GlobalThreadSafe && number_of_threads > 1)
-      {
-        guard.lock();
-      }
-      std::size_t label = add_action(a);
-      m_lts.add_transition(transition(from, label, to));
+      add_thread_transition(m_lts, from, a, to, thread_index);
     }
 
     // Add actions and states to the LTS
     void finalize(const indexed_set_for_states_type& state_map, bool /* timed */) override
     {
+      add_thread_transitions(m_lts);
+
       // add actions
       m_lts.set_num_action_labels(m_actions.size());
       for (const auto& p: m_actions)
@@ -129,16 +197,30 @@ class lts_aut_builder: public lts_builder
     }
 };
 
-// Write transitions immediately to disk, and add the AUT header later.
+// Write transitions to disk while exploring, and add the AUT header later. Each thread formats its
+// transitions in its own buffer, which is written to disk when it is full.
 class lts_aut_disk_builder: public lts_builder
 {
   protected:
+    static constexpr std::size_t buffer_size = 1 << 16;
+
     std::ofstream out;
-    std::size_t m_transition_count = 0;
-    std::mutex m_exclusive_transition_access;
+    std::vector<std::string> m_buffers;
+    std::vector<std::size_t> m_transition_counts;
+    std::mutex m_exclusive_file_access;
+
+    void write_buffer(std::string& buffer)
+    {
+      std::lock_guard<std::mutex> guard(m_exclusive_file_access);
+      out << buffer;
+      buffer.clear();
+    }
 
   public:
-    explicit lts_aut_disk_builder(const std::string& filename)
+    explicit lts_aut_disk_builder(const std::string& filename, std::size_t number_of_threads = 1)
+      : lts_builder(number_of_threads),
+        m_buffers(number_of_threads + 1),
+        m_transition_counts(number_of_threads + 1, 0)
     {
       mCRL2log(log::verbose) << "writing state space in AUT format to '" << filename << "'." << std::endl;
       out.open(filename.c_str());
@@ -149,20 +231,27 @@ class lts_aut_disk_builder: public lts_builder
       out << "des                                                \n"; // write a dummy header that will be overwritten
     }
 
-    void add_transition(std::size_t from, const lps::multi_action& a, std::size_t to, const std::size_t number_of_threads) override
+    void add_transition(std::size_t from, const lps::multi_action& a, std::size_t to, const std::size_t /* number_of_threads */, const std::size_t thread_index) override
     {
-      std::unique_lock<std::mutex> guard(m_exclusive_transition_access, std::defer_lock);
-      if (mcrl2::utilities::detail::GlobalThreadSafe && number_of_threads > 1)
+      assert(thread_index < m_buffers.size());
+      std::string& buffer = m_buffers[thread_index];
+      m_transition_counts[thread_index]++;
+      buffer += "(" + std::to_string(from) + ",\"" + lps::pp(a) + "\"," + std::to_string(to) + ")\n";
+      if (buffer.size() >= buffer_size)
       {
-        guard.lock();
+        write_buffer(buffer);
       }
-      m_transition_count++;
-      out << "(" << from << ",\"" << lps::pp(a) << "\"," << to << ")\n";
     }
 
     // Add actions and states to the LTS
     void finalize(const indexed_set_for_states_type& state_map, bool /* timed */) override
     {
+      std::size_t transition_count = 0;
+      for (std::size_t i = 0; i < m_buffers.size(); i++)
+      {
+        write_buffer(m_buffers[i]);
+        transition_count += m_transition_counts[i];
+      }
       assert(!out.fail());
       out.flush();
       out.seekp(0);
@@ -170,7 +259,7 @@ class lts_aut_disk_builder: public lts_builder
       {
         throw mcrl2::runtime_error("seeking is not supported by the output stream");
       }
-      out << "des (0," << m_transition_count << "," << state_map.size() << ")";
+      out << "des (0," << transition_count << "," << state_map.size() << ")";
       out.close();
     }
 
@@ -183,36 +272,33 @@ class lts_lts_builder: public lts_builder
   protected:
     lts_lts_t m_lts;
     bool m_discard_state_labels = false;
-    std::mutex m_exclusive_transition_access;
 
   public:
     lts_lts_builder(
       const data::data_specification& dataspec,
       const process::action_label_list& action_labels,
       const data::variable_list& process_parameters,
-      bool discard_state_labels = false
+      bool discard_state_labels = false,
+      std::size_t number_of_threads = 1
     )
-     : m_discard_state_labels(discard_state_labels)
+     : lts_builder(number_of_threads),
+       m_discard_state_labels(discard_state_labels)
     {
       m_lts.set_data(dataspec);
       m_lts.set_process_parameters(process_parameters);
       m_lts.set_action_label_declarations(action_labels);
     }
 
-    void add_transition(std::size_t from, const lps::multi_action& a, std::size_t to, const std::size_t number_of_threads) override
+    void add_transition(std::size_t from, const lps::multi_action& a, std::size_t to, const std::size_t /* number_of_threads */, const std::size_t thread_index) override
     {
-      std::unique_lock<std::mutex> guard(m_exclusive_transition_access, std::defer_lock);
-      if (mcrl2::utilities::detail::GlobalThreadSafe && number_of_threads > 1)
-      {
-        guard.lock();
-      }
-      std::size_t label = add_action(a);
-      m_lts.add_transition(transition(from, label, to));
+      add_thread_transition(m_lts, from, a, to, thread_index);
     }
 
     // Add actions and states to the LTS
     void finalize(const indexed_set_for_states_type& state_map, bool timed) override
     {
+      add_thread_transitions(m_lts);
+
       // add actions
       m_lts.set_num_action_labels(m_actions.size());
       for (const auto& p: m_actions)
@@ -249,13 +335,55 @@ class lts_lts_builder: public lts_builder
     }
 };
 
+// Write transitions to disk while exploring. Each thread collects its transitions in its own buffer,
+// which is written to the stream when it is full. A file is written in the chunked format, where each
+// written buffer forms a chunk, such that it can be loaded in parallel.
 class lts_lts_disk_builder: public lts_builder
 {
   protected:
+    static constexpr std::size_t buffer_size = 1 << 12;
+
     std::fstream fstream;
-    std::unique_ptr<atermpp::binary_aterm_ostream> stream;
+    std::unique_ptr<atermpp::aterm_ostream> stream;
+    atermpp::chunked_aterm_ostream* m_chunked_stream = nullptr; // Equal to stream when writing to a file.
     bool m_discard_state_labels = false;
-    std::mutex m_exclusive_transition_access;
+    std::mutex m_exclusive_stream_access;
+
+    // The source and target of the buffered transitions of each thread, and separately their actions
+    // such that these are protected against garbage collection.
+    std::vector<std::vector<std::pair<std::size_t, std::size_t>>> m_buffers;
+    std::vector<atermpp::vector<lps::multi_action>> m_buffer_actions;
+
+    void write_buffer(std::size_t thread_index)
+    {
+      std::vector<std::pair<std::size_t, std::size_t>>& buffer = m_buffers[thread_index];
+      atermpp::vector<lps::multi_action>& actions = m_buffer_actions[thread_index];
+      std::lock_guard<std::mutex> guard(m_exclusive_stream_access);
+      for (std::size_t i = 0; i < buffer.size(); i++)
+      {
+        write_transition(*stream, buffer[i].first, actions[i], buffer[i].second);
+      }
+      buffer.clear();
+      actions.clear();
+      flush_chunk();
+    }
+
+    void flush_chunk()
+    {
+      if (m_chunked_stream != nullptr)
+      {
+        m_chunked_stream->flush_chunk();
+      }
+    }
+
+    // Write the transitions that are still buffered by any of the threads.
+    void flush_transitions()
+    {
+      for (std::size_t i = 0; i < m_buffers.size(); i++)
+      {
+        write_buffer(i);
+      }
+    }
 
   public:
     lts_lts_disk_builder(
@@ -263,9 +391,13 @@ class lts_lts_disk_builder: public lts_builder
       const data::data_specification& dataspec,
       const process::action_label_list& action_labels,
       const data::variable_list& process_parameters,
-      bool discard_state_labels = false
+      bool discard_state_labels = false,
+      std::size_t number_of_threads = 1
     )
-     : m_discard_state_labels(discard_state_labels)
+     : lts_builder(number_of_threads),
+       m_discard_state_labels(discard_state_labels),
+       m_buffers(number_of_threads + 1),
+       m_buffer_actions(number_of_threads + 1)
     {
       bool to_stdout = filename.empty() || filename == "-";
       if (!to_stdout)
@@ -278,24 +410,38 @@ class lts_lts_disk_builder: public lts_builder
 
         mCRL2log(log::verbose) << "writing state space in LTS format to '" << filename << "'." << std::endl;
       }
-      stream = std::make_unique<atermpp::binary_aterm_ostream>(to_stdout ? std::cout : fstream);
+      if (to_stdout)
+      {
+        stream = std::make_unique<atermpp::binary_aterm_ostream>(std::cout);
+      }
+      else
+      {
+        // Chunks are only finished explicitly, such that transitions are never divided over two chunks.
+        auto chunked_stream = std::make_unique<atermpp::chunked_aterm_ostream>(fstream, std::numeric_limits<std::size_t>::max());
+        m_chunked_stream = chunked_stream.get();
+        stream = std::move(chunked_stream);
+      }
 
       mcrl2::lts::write_lts_header(*stream, dataspec, process_parameters, action_labels);
+      flush_chunk();
     }
 
-    void add_transition(std::size_t from, const lps::multi_action& a, std::size_t to, const std::size_t number_of_threads) override
+    void add_transition(std::size_t from, const lps::multi_action& a, std::size_t to, const std::size_t /* number_of_threads */, const std::size_t thread_index) override
     {
-      std::unique_lock<std::mutex> guard(m_exclusive_transition_access, std::defer_lock);
-      if (mcrl2::utilities::detail::GlobalThreadSafe && number_of_threads > 1)
+      assert(thread_index < m_buffers.size());
+      m_buffers[thread_index].emplace_back(from, to);
+      m_buffer_actions[thread_index].push_back(a);
+      if (m_buffers[thread_index].size() >= buffer_size)
       {
-        guard.lock();
+        write_buffer(thread_index);
       }
-      write_transition(*stream, from, a, to);
     }
 
     // Add actions and states to the LTS
     void finalize(const indexed_set_for_states_type& state_map, bool timed) override
     {
+      flush_transitions();
+
       if (!m_discard_state_labels)
       {
         // Write the state labels in the order of their indices.
@@ -312,6 +458,11 @@ class lts_lts_disk_builder: public lts_builder
               write_state_label(*stream, state_label_lts(state_map[i]));
             }
           }
+
+          if ((i + 1) % buffer_size == 0)
+          {
+            flush_chunk();
+          }
         }
       }
 
@@ -326,8 +477,8 @@ class lts_dot_builder: public lts_lts_builder
 {
   public:
     using super = lts_lts_builder;
-    lts_dot_builder(const data::data_specification& dataspec, const process::action_label_list& action_labels, const data::variable_list& process_parameters)
-      : super(dataspec, action_labels, process_parameters)
+    lts_dot_builder(const data::data_specification& dataspec, const process::action_label_list& action_labels, const data::variable_list& process_parameters, std::size_t number_of_threads = 1)
+      : super(dataspec, action_labels, process_parameters, false, number_of_threads)
     { }
 
     void save(const std::string& filename) override
@@ -342,8 +493,8 @@ class lts_fsm_builder: public lts_lts_builder
 {
   public:
     using super = lts_lts_builder;
-    lts_fsm_builder(const data::data_specification& dataspec, const process::action_label_list& action_labels, const data::variable_list& process_parameters)
-      : super(dataspec, action_labels, process_parameters)
+    lts_fsm_builder(const data::data_specification& dataspec, const process::action_label_list& action_labels, const data::variable_list& process_parameters, std::size_t number_of_threads = 1)
+      : super(dataspec, action_labels, process_parameters, false, number_of_threads)
     { }
 
     void save(const std::string& filename) override
@@ -363,24 +514,24 @@ std::unique_ptr<lts_builder> create_lts_builder(const lps::specification& lpsspe
     {
       if (options.save_at_end)
       {
-        return std::make_unique<lts_aut_builder>();
+        return std::make_unique<lts_aut_builder>(options.number_of_threads);
       }
       else
       {
-        return std::make_unique<lts_aut_disk_builder>(output_filename);
+        return std::make_unique<lts_aut_disk_builder>(output_filename, options.number_of_threads);
       }
     }
-    case lts_dot: return std::make_unique<lts_dot_builder>(lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters());
-    case lts_fsm: return std::make_unique<lts_fsm_builder>(lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters());
+    case lts_dot: return std::make_unique<lts_dot_builder>(lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters(), options.number_of_threads);
+    case lts_fsm: return std::make_unique<lts_fsm_builder>(lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters(), options.number_of_threads);
     case lts_lts:
     {
       if (options.save_at_end)
       {
-        return std::make_unique<lts_lts_builder>(lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters(), options.discard_lts_state_labels);
+        return std::make_unique<lts_lts_builder>(lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters(), options.discard_lts_state_labels, options.number_of_threads);
       }
       else
       {
-        return std::make_unique<lts_lts_disk_builder>(output_filename, lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters(), options.discard_lts_state_labels);
+        return std::make_unique<lts_lts_disk_builder>(output_filename, lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters(), options.discard_lts_state_labels, options.number_of_threads);
       }
     }
     default: return std::make_unique<lts_none_builder>();
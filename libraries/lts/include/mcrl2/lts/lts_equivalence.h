@@ -36,6 +36,7 @@ enum lts_equivalence
   lts_eq_bisim_gj,         /**< Strong bisimulation equivalence using an O(m log n) algorithm [Groote/Jansen 2025] */
   lts_eq_bisim_gj_lazy_BLC,      /**< Strong bisimulation equivalence using an O(m log n) algorithm [Groote/Jansen 2025] with lazy BLC set construction (experimental) */
   lts_eq_bisim_sigref,     /**< Strong bisimulation equivalence using the signature refinement algorithm [Blom/Orzan 2003] */
+  lts_eq_bisim_par,        /**< Strong bisimulation equivalence using the signature refinement algorithm with multiple threads [Blom/Orzan 2003] */
   lts_eq_branching_bisim,        /**< Default branching bisimulation equivalence [Groote/Jansen 2025] */
   lts_eq_branching_bisim_jgkw,   /**< Branching bisimulation equivalence using the O(m log n) algorithm [Jansen/Groote/Keiren/Wijs 2019] */
   lts_eq_branching_bisim_gv,     /**< Branching bisimulation equivalence using the O(mn) algorithm [Groote/Vaandrager 1990] */
@@ -43,6 +44,7 @@ enum lts_equivalence
   lts_eq_branching_bisim_gj,     /**< Branching bisimulation equivalence using the O(m log n) algorithm [Groote/Jansen 2025] */
   lts_eq_branching_bisim_gj_lazy_BLC, /**< Branching bisimulation equivalence using the O(m log n) algorithm [Groote/Jansen 2025] with lazy BLC set construction (experimental) */
   lts_eq_branching_bisim_sigref, /**< Branching bisimulation equivalence using the signature refinement algorithm [Blom/Orzan 2003] */
+  lts_eq_branching_bisim_par,    /**< Branching bisimulation equivalence using the signature refinement algorithm with multiple threads [Blom/Orzan 2003] */
   lts_eq_divergence_preserving_branching_bisim,      /**< Default divergence-preserving branching bisimulation equivalence [Groote/Jansen 2025] */
   lts_eq_divergence_preserving_branching_bisim_jgkw, /**< Divergence-preserving branching bisimulation equivalence using the O(m log n) algorithm [Jansen/Groote/Keiren/Wijs 2019] */
   lts_eq_divergence_preserving_branching_bisim_gv,    /**< Divergence-preserving branching bisimulation equivalence using the O(mn) algorithm [Groote/Vaandrager 1990] */
@@ -71,12 +73,16 @@ enum lts_equivalence
  *          [Groote/Vaandrager 1990];
  * \li "bisim-sig" for strong bisimilarity using the signature refinement
  *          algorithm [Blom/Orzan 2003];
+ * \li "bisim-par" for strong bisimilarity using the signature refinement
+ *          algorithm with multiple threads [Blom/Orzan 2003];
  * \li "branching-bisim" for branching bisimilarity using the O(m log n)
  *          algorithm [Groote/Jansen/Keiren/Wijs 2017];
  * \li "branching-bisim-gv" for branching bisimilarity using the O(mn)
  *          algorithm [Groote/Vaandrager 1990];
  * \li "branching-bisim-sig" for branching bisimilarity using the signature
  *          refinement algorithm [Blom/Orzan 2003];
+ * \li "branching-bisim-par" for branching bisimilarity using the signature
+ *          refinement algorithm with multiple threads [Blom/Orzan 2003];
  * \li "dpbranching-bisim" for divergence-preserving branching bisimilarity
  *          using the O(m log n) algorithm [Groote/Jansen/Keiren/Wijs 2017];
  * \li "dpbranching-bisim-gv" for divergence-preserving branching bisimilarity
@@ -129,6 +135,10 @@ lts_equivalence parse_equivalence(std::string const& s)
   {
     return lts_eq_bisim_sigref;
   }
+  else if (s == "bisim-par")
+  {
+    return lts_eq_bisim_par;
+  }
   else if (s == "branching-bisim")
   {
     return lts_eq_branching_bisim;
@@ -157,6 +167,10 @@ lts_equivalence parse_equivalence(std::string const& s)
   {
     return lts_eq_branching_bisim_sigref;
   }
+  else if (s == "branching-bisim-par")
+  {
+    return lts_eq_branching_bisim_par;
+  }
   else if (s == "dpbranching-bisim")
   {
     return lts_eq_divergence_preserving_branching_bisim;
@@ -273,6 +287,8 @@ inline std::string print_equivalence(const lts_equivalence eq)
       return "bisim-gj-lazy-BLC";
     case lts_eq_bisim_sigref:
       return "bisim-sig";
+    case lts_eq_bisim_par:
+      return "bisim-par";
     case lts_eq_branching_bisim:
       return "branching-bisim";
     case lts_eq_branching_bisim_jgkw:
@@ -287,6 +303,8 @@ inline std::string print_equivalence(const lts_equivalence eq)
       return "branching-bisim-gj-lazy-BLC";
     case lts_eq_branching_bisim_sigref:
       return "branching-bisim-sig";
+    case lts_eq_branching_bisim_par:
+      return "branching-bisim-par";
     case lts_eq_divergence_preserving_branching_bisim:
       return "dpbranching-bisim";
     case lts_eq_divergence_preserving_branching_bisim_jgkw:
@@ -358,6 +376,8 @@ inline std::string description(const lts_equivalence eq)
       return "strong bisimilarity using an O(m log n) algorithm [Groote/Jansen 2025] with lazy BLC set construction (experimental)";
     case lts_eq_bisim_sigref:
       return "strong bisimilarity using the signature refinement algorithm [Blom/Orzan 2003]";
+    case lts_eq_bisim_par:
+      return "strong bisimilarity using the signature refinement algorithm with multiple threads [Blom/Orzan 2003]";
     case lts_eq_branching_bisim:
       return "default branching bisimilarity (using the O(m log n) algorithm [Groote/Jansen 2025])";
     case lts_eq_branching_bisim_jgkw:
@@ -372,6 +392,8 @@ inline std::string description(const lts_equivalence eq)
       return "branching bisimilarity using an O(m log n) algorithm [Groote/Jansen 2025] with lazy BLC set construction (experimental)";
     case lts_eq_branching_bisim_sigref:
       return "branching bisimilarity using the signature refinement algorithm [Blom/Orzan 2003]";
+    case lts_eq_branching_bisim_par:
+      return "branching bisimilarity using the signature refinement algorithm with multiple threads [Blom/Orzan 2003]";
     case lts_eq_divergence_preserving_branching_bisim:
       return "default divergence-preserving branching bisimilarity (using the O(m log n) algorithm [Groote/Jansen 2025])";
     case lts_eq_divergence_preserving_branching_bisim_jgkw:
@@ -375,8 +375,9 @@ class lts_lts_t : public lts< state_label_lts, action_label_lts, detail::lts_lts
     /** \brief Load the labelled transition system from file.
      *  \details If the filename is empty, the result is read from stdout.
      *  \param[in] filename Name of the file to which this lts is written.
+     *  \param[in] number_of_threads The number of threads that decode a file in the chunked format in parallel.
      */
-    void load(const std::string& filename);
+    void load(const std::string& filename, std::size_t number_of_threads = 1);
 
     /** \brief Save the labelled transition system to file.
      *  \details If the filename is empty, the result is read from stdin.
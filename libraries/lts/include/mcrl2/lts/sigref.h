@@ -14,13 +14,71 @@
 #ifndef MCRL2_LTS_SIGREF_H
 #define MCRL2_LTS_SIGREF_H
 
+#include <algorithm>
+#include <limits>
 #include "mcrl2/lts/lts_utilities.h"
+#include "mcrl2/lts/transition_csr.h"
+#include "mcrl2/utilities/hash_utility.h"
 
 namespace mcrl2::lts
 {
 
-/** \brief A signature is a pair of an action label and a block */
-using signature_t = std::set<std::pair<std::size_t, std::size_t>>;
+/** \brief An element of a signature is a pair of an action label and a block */
+using signature_element = std::pair<std::size_t, std::size_t>;
+
+/** \brief A signature is a sorted sequence of distinct pairs of an action label and a block.
+  * \details A signature refers to the signatures that are stored by a signature object, and it
+  *          remains valid until the signatures are computed again.
+  */
+class signature_t
+{
+protected:
+  const signature_element* m_begin = nullptr;
+  const signature_element* m_end = nullptr;
+
+public:
+  signature_t() = default;
+
+  signature_t(const signature_element* begin, const signature_element* end)
+    : m_begin(begin), m_end(end)
+  {}
+
+  const signature_element* begin() const
+  {
+    return m_begin;
+  }
+
+  const signature_element* end() const
+  {
+    return m_end;
+  }
+
+  std::size_t size() const
+  {
+    return static_cast<std::size_t>(m_end - m_begin);
+  }
+
+  /** \brief Indicates whether the pair \a e occurs in this signature */
+  bool contains(const signature_element& e) const
+  {
+    return std::binary_search(m_begin, m_end, e);
+  }
+
+  bool operator==(const signature_t& other) const
+  {
+    return std::equal(m_begin, m_end, other.m_begin, other.m_end);
+  }
+
+  std::size_t hash() const
+  {
+    std::size_t result = size();
+    for (const signature_element& e: *this)
+    {
+      result = utilities::detail::hash_combine(result, utilities::detail::hash_combine(e.first, e.second));
+    }
+    return result;
+  }
+};
 
 /** \brief Base class for signature computation */
 template < class LTS_T >
@@ -30,14 +88,144 @@ protected:
   /** \brief The labelled transition system for which the signature is computed */
   const LTS_T& m_lts;
 
-  /** \brief Signature stored per state */
-  std::vector<signature_t> m_sig;
+  /** \brief The signatures of all states. The signature of state s consists of the
+             elements m_elements[m_offsets[s]] up to m_elements[m_offsets[s+1]]. */
+  std::vector<std::size_t> m_offsets;
+  std::vector<signature_element> m_elements;
+
+  /** \brief Workspace that is reused when the signatures are computed again */
+  std::vector<std::size_t> m_direct;
+  std::vector<std::size_t> m_sorted;
+  std::vector<std::size_t> m_count;
+  std::vector<std::size_t> m_visited;
+  std::vector<std::size_t> m_stack;
+  std::vector<std::pair<std::size_t, signature_element>> m_entries;
+
+  /** \brief The incoming tau transitions of all states, only constructed when inert predecessors are needed */
+  transition_csr m_incoming_tau;
+
+  /** \brief Stably sorts the transition indices in \a from on key(index) < \a range, and stores them in \a to */
+  template <typename Key>
+  void counting_sort(const std::vector<std::size_t>& from, std::vector<std::size_t>& to, const std::size_t range, Key key)
+  {
+    m_count.assign(range + 1, 0);
+    for (const std::size_t i: from)
+    {
+      m_count[key(i) + 1]++;
+    }
+    for (std::size_t k = 1; k <= range; ++k)
+    {
+      m_count[k] += m_count[k - 1];
+    }
+    to.resize(from.size());
+    for (const std::size_t i: from)
+    {
+      to[m_count[key(i)]++] = i;
+    }
+  }
+
+  /** \brief Computes the signatures of all states.
+    * \param[in] partition The current partition
+    * \param[in] direct Indicates whether a transition contributes the pair of its label and target block to the signature of its source.
+    * \param[in] inert_predecessors If true, a pair is also added to the signatures of all states that can reach a state with this
+    *            pair by a tau transition within their own block, as in the insert function described in S. Blom, S. Orzan,
+    *            "Distributed Branching Bisimulation Reduction of State Spaces", Proc. PDMC 2003.
+    *
+    * The transitions that contribute directly are sorted on their pair with two counting sorts. Processing the pairs
+    * in this order yields the signatures sorted, and a pair is added to a state at most once as the states that
+    * already received the current pair are marked.
+    */
+  template <typename Direct>
+  void compute_signatures(const std::vector<std::size_t>& partition, Direct direct, const bool inert_predecessors)
+  {
+    const std::vector<transition>& transitions = m_lts.get_transitions();
+    const std::size_t num_states = m_lts.num_states();
+
+    m_direct.clear();
+    for (std::size_t i = 0; i < transitions.size(); ++i)
+    {
+      if (direct(transitions[i]))
+      {
+        m_direct.push_back(i);
+      }
+    }
+    counting_sort(m_direct, m_sorted, num_states, [&](std::size_t i) { return partition[transitions[i].to()]; });
+    counting_sort(m_sorted, m_direct, m_lts.num_action_labels(), [&](std::size_t i) { return m_lts.apply_hidden_label_map(transitions[i].label()); });
+
+    if (inert_predecessors && m_incoming_tau.num_states() != num_states)
+    {
+      m_incoming_tau = transition_csr(transitions, num_states, m_lts.num_action_labels(), false,
+          [&](std::size_t label) { return m_lts.is_tau(m_lts.apply_hidden_label_map(label)); });
+    }
+
+    m_entries.clear();
+    m_visited.assign(num_states, std::numeric_limits<std::size_t>::max());
+    std::size_t group = 0;
+    for (std::size_t first = 0; first < m_direct.size(); ++group)
+    {
+      const transition& t = transitions[m_direct[first]];
+      const signature_element element(m_lts.apply_hidden_label_map(t.label()), partition[t.to()]);
+
+      std::size_t last = first;
+      for (; last < m_direct.size(); ++last)
+      {
+        const transition& u = transitions[m_direct[last]];
+        if (m_lts.apply_hidden_label_map(u.label()) != element.first || partition[u.to()] != element.second)
+        {
+          break;
+        }
+        if (m_visited[u.from()] != group)
+        {
+          m_visited[u.from()] = group;
+          m_entries.emplace_back(u.from(), element);
+          if (inert_predecessors)
+          {
+            m_stack.push_back(u.from());
+          }
+        }
+      }
+      first = last;
+
+      while (!m_stack.empty())
+      {
+        const std::size_t s = m_stack.back();
+        m_stack.pop_back();
+        for (std::size_t i = m_incoming_tau.lowerbound(s); i < m_incoming_tau.upperbound(s); ++i)
+        {
+          const std::size_t p = m_incoming_tau.state(i);
+          if (partition[p] == partition[s] && m_visited[p] != group)
+          {
+            m_visited[p] = group;
+            m_entries.emplace_back(p, element);
+            m_stack.push_back(p);
+          }
+        }
+      }
+    }
+
+    // Group the pairs per state, preserving their order.
+    m_offsets.assign(num_states + 1, 0);
+    for (const std::pair<std::size_t, signature_element>& e: m_entries)
+    {
+      m_offsets[e.first + 1]++;
+    }
+    for (std::size_t s = 1; s <= num_states; ++s)
+    {
+      m_offsets[s] += m_offsets[s - 1];
+    }
+    m_elements.resize(m_entries.size());
+    m_count.assign(m_offsets.begin(), m_offsets.end());
+    for (const std::pair<std::size_t, signature_element>& e: m_entries)
+    {
+      m_elements[m_count[e.first]++] = e.second;
+    }
+  }
 
 public:
   /** \brief Constructor
     */
   signature(const LTS_T& lts_)
-    : m_lts(lts_), m_sig(m_lts.num_states(), signature_t())
+    : m_lts(lts_), m_offsets(m_lts.num_states() + 1, 0)
   {}
   virtual ~signature() = default;
 
@@ -48,13 +236,13 @@ public:
 
   /** \brief Compute the transitions for the quotient according to \a partition.
     * \param[in] partition The partition that is used to compute the quotient
-    * \param[out] transitions A set to which the transitions of the quotient are written
+    * \param[out] transitions A vector to which the transitions of the quotient are written. It can contain duplicates.
     */
-  virtual void quotient_transitions(std::set<transition>& transitions, const std::vector<std::size_t>& partition)
+  virtual void quotient_transitions(std::vector<transition>& transitions, const std::vector<std::size_t>& partition)
   {
     for(std::vector<transition>::const_iterator i = m_lts.get_transitions().begin(); i != m_lts.get_transitions().end(); ++i)
     {
-      transitions.insert(transition(partition[i->from()], i->label(), partition[i->to()]));
+      transitions.emplace_back(partition[i->from()], i->label(), partition[i->to()]);
     }
   }
 
@@ -62,9 +250,9 @@ public:
     * \param[in] i The state for which to return the signature.
     * \pre i < m_lts.num_states().
     */
-  virtual const signature_t& get_signature(std::size_t i) const
+  signature_t get_signature(std::size_t i) const
   {
-    return m_sig[i];
+    return signature_t(m_elements.data() + m_offsets[i], m_elements.data() + m_offsets[i + 1]);
   }
 };
 
@@ -74,7 +262,7 @@ class signature_bisim: public signature<LTS_T>
 {
 protected:
   using signature<LTS_T>::m_lts;
-  using signature<LTS_T>::m_sig;
+  using signature<LTS_T>::compute_signatures;
 
 public:
   virtual ~signature_bisim() = default;
@@ -88,12 +276,7 @@ public:
   /** \overload */
   void compute_signature(const std::vector<std::size_t>& partition) override
   {
-    // compute signatures
-    m_sig = std::vector<signature_t>(m_lts.num_states(), signature_t());
-    for(std::vector<transition>::const_iterator i = m_lts.get_transitions().begin(); i != m_lts.get_transitions().end(); ++i)
-    {
-      m_sig[i->from()].insert(std::make_pair(m_lts.apply_hidden_label_map(i->label()), partition[i->to()]));
-    }
+    compute_signatures(partition, [](const transition&) { return true; }, false);
   }
 
 };
@@ -104,48 +287,19 @@ class signature_branching_bisim: public signature<LTS_T>
 {
 protected:
   using signature<LTS_T>::m_lts;
-  using signature<LTS_T>::m_sig;
+  using signature<LTS_T>::compute_signatures;
 
-  /** \brief Store the incoming transitions per state */
-  outgoing_transitions_per_state_t m_prev_transitions;
-
-  /** \brief Insert function
-    * \param[in] partition The current partition
-    * \param[in] t source state
-    * \param[in] label_ transition label
-    * \param[in] block target block
-    *
-    * Insert function as described in S. Blom, S. Orzan,
-    * "Distributed Branching Bisimulation Reduction of State Spaces",
-    * Proc. PDMC 2003.
-    *
-    * Inserts the pair (label_, block) in the signature of t, as well as
-    * the signatures of all tau-predecessors of t within the same block.
-    */
-  void insert(const std::vector<std::size_t>& partition, const std::size_t t, const std::size_t label_, const std::size_t block)
+  /** \brief Indicates whether t is a tau transition within a block of \a partition */
+  bool is_inert(const std::vector<std::size_t>& partition, const transition& t) const
   {
-    if(m_sig[t].insert(std::make_pair(label_, block)).second)
-    {
-      // std::pair<outgoing_transitions_per_state_t::const_iterator, outgoing_transitions_per_state_t::const_iterator> pred_range
-      //    = m_prev_transitions.equal_range(t);
-
-      for (std::size_t i=m_prev_transitions.lowerbound(t); i<m_prev_transitions.upperbound(t); ++i)
-      {
-        const outgoing_pair_t& p = m_prev_transitions.get_transitions()[i];
-        if(m_lts.is_tau(m_lts.apply_hidden_label_map(label(p))) && partition[t] == partition[to(p)])
-        {
-          insert(partition, to(p), label_, block);
-        }
-      }
-    }
+    return m_lts.is_tau(m_lts.apply_hidden_label_map(t.label())) && partition[t.from()] == partition[t.to()];
   }
 
 public:
   virtual ~signature_branching_bisim() = default;
   /** \brief Constructor  */
   signature_branching_bisim(const LTS_T& lts_)
-    : signature<LTS_T>(lts_),
-      m_prev_transitions(lts_.get_transitions(),lts_.num_states(),false)  // transitions stored backward. 
+    : signature<LTS_T>(lts_)
   {
     mCRL2log(log::verbose) << "initialising signature computation for branching bisimulation" << std::endl;
   }
@@ -153,25 +307,17 @@ public:
   /** \overload */
   void compute_signature(const std::vector<std::size_t>& partition) override
   {
-    // compute signatures
-    m_sig = std::vector<signature_t>(m_lts.num_states(), signature_t());
-    for(std::vector<transition>::const_iterator i = m_lts.get_transitions().begin(); i != m_lts.get_transitions().end(); ++i)
-    {
-      if (!(m_lts.is_tau(m_lts.apply_hidden_label_map(i->label())) && (partition[i->from()] == partition[i->to()])))
-      {
-        insert(partition, i->from(), m_lts.apply_hidden_label_map(i->label()), partition[i->to()]);
-      }
-    }
+    compute_signatures(partition, [&](const transition& t) { return !is_inert(partition, t); }, true);
   }
 
   /** \overload */
-  void quotient_transitions(std::set<transition>& transitions, const std::vector<std::size_t>& partition) override
+  void quotient_transitions(std::vector<transition>& transitions, const std::vector<std::size_t>& partition) override
   {
     for(std::vector<transition>::const_iterator i = m_lts.get_transitions().begin(); i != m_lts.get_transitions().end(); ++i)
     {
-      if(partition[i->from()] != partition[i->to()] || !m_lts.is_tau(m_lts.apply_hidden_label_map(i->label())))
+      if(!is_inert(partition, *i))
       {
-        transitions.insert(transition(partition[i->from()], m_lts.apply_hidden_label_map(i->label()), partition[i->to()]));
+        transitions.emplace_back(partition[i->from()], m_lts.apply_hidden_label_map(i->label()), partition[i->to()]);
       }
     }
   }
@@ -183,8 +329,8 @@ class signature_divergence_preserving_branching_bisim: public signature_branchin
 {
 protected:
   using signature_branching_bisim<LTS_T>::m_lts;
-  using signature_branching_bisim<LTS_T>::m_sig;
-  using signature_branching_bisim<LTS_T>::insert;
+  using signature_branching_bisim<LTS_T>::compute_signatures;
+  using signature_branching_bisim<LTS_T>::is_inert;
 
   /** \brief Record for each vertex whether it is in a tau-scc */
   std::vector<bool> m_divergent;
@@ -309,27 +455,18 @@ public:
     */
   void compute_signature(const std::vector<std::size_t>& partition) override
   {
-    // compute signatures
-    m_sig = std::vector<signature_t>(m_lts.num_states(), signature_t());
-    for(std::vector<transition>::const_iterator i = m_lts.get_transitions().begin(); i != m_lts.get_transitions().end(); ++i)
-    {
-      if(!(partition[i->from()] == partition[i->to()] && m_lts.is_tau(m_lts.apply_hidden_label_map(i->label())))
-         || m_divergent[i->to()])
-      {
-        insert(partition, i->from(), m_lts.apply_hidden_label_map(i->label()), partition[i->to()]);
-      }
-    }
+    compute_signatures(partition, [&](const transition& t) { return !is_inert(partition, t) || m_divergent[t.to()]; }, true);
   }
 
   /** \overload */
-  void quotient_transitions(std::set<transition>& transitions, const std::vector<std::size_t>& partition) override
+  void quotient_transitions(std::vector<transition>& transitions, const std::vector<std::size_t>& partition) override
   {
     for(std::vector<transition>::const_iterator i = m_lts.get_transitions().begin(); i != m_lts.get_transitions().end(); ++i)
     {
-      if(!(partition[i->from()] == partition[i->to()] && m_lts.is_tau(m_lts.apply_hidden_label_map(i->label())))
-         || m_sig[i->from()].find(std::make_pair(m_lts.apply_hidden_label_map(i->label()), partition[i->to()])) != m_sig[i->from()].end())
+      if(!is_inert(partition, *i)
+         || this->get_signature(i->from()).contains(signature_element(m_lts.apply_hidden_label_map(i->label()), partition[i->to()])))
       {
-        transitions.insert(transition(partition[i->from()], m_lts.apply_hidden_label_map(i->label()), partition[i->to()]));
+        transitions.emplace_back(partition[i->from()], m_lts.apply_hidden_label_map(i->label()), partition[i->to()]);
       }
     }
   }
@@ -363,8 +500,13 @@ protected:
              current equivalence */
   Signature m_signature;
 
+  /** \brief Open addressing hash table that maps signatures to blocks. An entry
+             is either empty, or a block of which m_representative contains a state. */
+  std::vector<std::size_t> m_table;
+  std::vector<std::size_t> m_representative;
+
   /** \brief Print a signature (for debugging purposes) */
-  std::string print_sig(const signature_t& sig)
+  std::string print_sig(const signature_t& sig) const
   {
     std::stringstream os;
     os << "{ ";
@@ -383,7 +525,14 @@ protected:
     std::size_t count_prev = m_count;
     std::size_t iterations = 0;
 
-    sort_transitions(m_lts.get_transitions(), m_lts.hidden_label_set(), mcrl2::lts::lbl_tgt_src);
+    // The table has at least twice as many entries as there are states, and its size is a power of two.
+    constexpr std::size_t empty = std::numeric_limits<std::size_t>::max();
+    std::size_t table_bits = 4;
+    while ((std::size_t(1) << table_bits) < 2 * m_lts.num_states())
+    {
+      ++table_bits;
+    }
+    const std::size_t mask = (std::size_t(1) << table_bits) - 1;
 
     do
     {
@@ -394,22 +543,28 @@ protected:
 
       count_prev = m_count;
 
-      // Map signatures to block numbers
-      std::map<signature_t, std::size_t> hashtable;
+      // Map signatures to block numbers, and states to blocks. The signatures have
+      // already been computed, so the partition can be overwritten directly.
+      m_table.assign(mask + 1, empty);
+      m_representative.clear();
       m_count = 0;
       for(std::size_t i = 0; i < m_lts.num_states(); ++i)
       {
-        if(hashtable.find(m_signature.get_signature(i)) == hashtable.end())
+        const signature_t sig = m_signature.get_signature(i);
+        // Fibonacci hashing spreads the hash over the bits that are used as position.
+        std::size_t position = (sig.hash() * 0x9e3779b97f4a7c15ULL) >> (std::numeric_limits<std::size_t>::digits - table_bits);
+        while (m_table[position] != empty && !(m_signature.get_signature(m_representative[m_table[position]]) == sig))
         {
-          mCRL2log(log::debug) << "Adding block for signature " << print_sig(m_signature.get_signature(i)) << std::endl;
-          hashtable[m_signature.get_signature(i)] = m_count++;
+          position = (position + 1) & mask;
         }
-      }
 
-      // Map states to block numbers
-      for(std::size_t i = 0; i < m_lts.num_states(); ++i)
-      {
-        m_partition[i] = hashtable[m_signature.get_signature(i)];
+        if (m_table[position] == empty)
+        {
+          mCRL2log(log::debug) << "Adding block for signature " << print_sig(sig) << std::endl;
+          m_table[position] = m_count++;
+          m_representative.push_back(i);
+        }
+        m_partition[i] = m_table[position];
       }
 
       ++iterations;
@@ -429,15 +584,14 @@ protected:
 
     // Compute quotient transitions
     // implemented in the signature class because it differs per equivalence.
-    std::set<transition> transitions;
+    std::vector<transition> transitions;
     m_signature.quotient_transitions(transitions, m_partition);
+    std::sort(transitions.begin(), transitions.end());
+    transitions.erase(std::unique(transitions.begin(), transitions.end()), transitions.end());
 
     // Set quotient transitions
     m_lts.clear_transitions();
-    for (const auto& i: transitions)
-    {
-      m_lts.add_transition(i);
-    }
+    m_lts.get_transitions().swap(transitions);
   }
 
 public:
@@ -743,7 +743,7 @@ struct state_space_generator
           }
           else
           {
-            builder.add_transition(s0_index, a, s1_index, number_of_threads);
+            builder.add_transition(s0_index, a, s1_index, number_of_threads, thread_index);
           }
           assert(thread_index<has_outgoing_transitions.size());
           has_outgoing_transitions[thread_index].m_bool = true;
@@ -801,6 +801,7 @@ struct state_space_generator
         }
       );
       m_progress_monitor.finish_exploration(explorer.state_map().size(), options.number_of_threads);
+      explorer.print_cache_statistics();
       builder.finalize(explorer.state_map(), Timed);
     }
     catch (const data::enumerator_error& e)
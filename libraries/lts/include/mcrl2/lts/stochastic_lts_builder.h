@@ -18,7 +18,7 @@ namespace mcrl2::lts {
 
 struct stochastic_lts_builder
 {
-  using indexed_set_for_states_type = atermpp::indexed_set<lps::state, mcrl2::utilities::detail::GlobalThreadSafe>;
+  using indexed_set_for_states_type = lps::explorer_state_set;
   // All LTS classes use integers to represent actions in transitions. A mapping from actions to integers
   // is needed to avoid duplicates.
   utilities::unordered_map_large<lps::multi_action, std::size_t> m_actions;
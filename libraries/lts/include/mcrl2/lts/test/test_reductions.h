@@ -131,6 +131,12 @@ static bool reduce_lts_in_various_ways(const std::string& test_description,
     return false;
   }
   l=l_in;
+  reduce(l,lts::lts_eq_bisim_par);
+  if (!test_lts(test_description + " (bisimulation signature with one thread)",l, expected.labels_bisimulation,expected.states_bisimulation, expected.transitions_bisimulation)) return false;
+  l=l_in;
+  reduce(l,lts::lts_eq_bisim_par,4);
+  if (!test_lts(test_description + " (bisimulation signature with four threads)",l, expected.labels_bisimulation,expected.states_bisimulation, expected.transitions_bisimulation)) return false;
+  l=l_in;
   reduce(l,lts::lts_eq_branching_bisim_jgkw);
   if (!test_lts(test_description + " (branching bisimulation [Jansen/Groote/Keiren/Wijs 2019])",l, expected.labels_branching_bisimulation,expected.states_branching_bisimulation, expected.transitions_branching_bisimulation)) return false;
   l=l_in;
@@ -170,6 +176,12 @@ static bool reduce_lts_in_various_ways(const std::string& test_description,
     return false;
   }
   l=l_in;
+  reduce(l,lts::lts_eq_branching_bisim_par);
+  if (!test_lts(test_description + " (branching bisimulation signature with one thread)",l, expected.labels_branching_bisimulation,expected.states_branching_bisimulation, expected.transitions_branching_bisimulation)) return false;
+  l=l_in;
+  reduce(l,lts::lts_eq_branching_bisim_par,4);
+  if (!test_lts(test_description + " (branching bisimulation signature with four threads)",l, expected.labels_branching_bisimulation,expected.states_branching_bisimulation, expected.transitions_branching_bisimulation)) return false;
+  l=l_in;
   reduce(l,lts::lts_eq_divergence_preserving_branching_bisim_jgkw);
   if (!test_lts(test_description + " (divergence-preserving branching bisimulation [Jansen/Groote/Keiren/Wijs 2019])",l,
                                       expected.labels_divergence_preserving_branching_bisimulation,
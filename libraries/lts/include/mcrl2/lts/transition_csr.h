@@ -0,0 +1,270 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+/** \file
+ *
+ * \brief The transitions of an lts in compressed sparse row format.
+ */
+
+#ifndef MCRL2_LTS_TRANSITION_CSR_H
+#define MCRL2_LTS_TRANSITION_CSR_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "mcrl2/lts/transition.h"
+
+namespace mcrl2::lts
+{
+
+namespace detail
+{
+
+/// \brief A vector of indices that are stored with 32 bits if all of them fit, and with 64 bits otherwise.
+class compact_index_vector
+{
+  protected:
+    std::vector<std::uint32_t> m_narrow;
+    std::vector<std::uint64_t> m_wide;
+    bool m_is_narrow = true;
+
+  public:
+    compact_index_vector() = default;
+
+    /// \brief Constructor of a vector of the given size with indices up to and including max_value.
+    compact_index_vector(std::size_t size, std::size_t max_value)
+      : m_is_narrow(max_value <= std::numeric_limits<std::uint32_t>::max())
+    {
+      if (m_is_narrow)
+      {
+        m_narrow.resize(size, 0);
+      }
+      else
+      {
+        m_wide.resize(size, 0);
+      }
+    }
+
+    std::size_t operator[](std::size_t i) const
+    {
+      return m_is_narrow ? m_narrow[i] : m_wide[i];
+    }
+
+    void set(std::size_t i, std::size_t value)
+    {
+      if (m_is_narrow)
+      {
+        assert(value <= std::numeric_limits<std::uint32_t>::max());
+        m_narrow[i] = static_cast<std::uint32_t>(value);
+      }
+      else
+      {
+        m_wide[i] = value;
+      }
+    }
+
+    std::size_t size() const
+    {
+      return m_is_narrow ? m_narrow.size() : m_wide.size();
+    }
+
+    /// \returns True if the indices are stored with 32 bits.
+    bool is_narrow() const
+    {
+      return m_is_narrow;
+    }
+
+    /// \brief Releases all memory.
+    void clear()
+    {
+      std::vector<std::uint32_t>().swap(m_narrow);
+      std::vector<std::uint64_t>().swap(m_wide);
+      m_is_narrow = true;
+    }
+};
+
+} // namespace detail
+
+/// \brief The outgoing or incoming transitions of the states of an lts in compressed sparse row format.
+/// \details The transitions of state s are found at positions lowerbound(s) up to upperbound(s). For
+///          each such position i, label(i) is the label of the transition and state(i) its target for
+///          outgoing transitions and its source for incoming transitions. The transitions of a state are
+///          sorted on label and then on state, and the tau transitions therefore come first. Indices
+///          are stored with 32 bits where the number of states, labels and transitions allow it.
+///
+///          This is an index that is built from the transitions of an lts, and that takes memory in
+///          addition to them, as the lts keeps its transitions as a vector of triples. It is meant for
+///          algorithms that traverse the transitions per state, and that can release it when they are
+///          done. The signature based reductions, the computation of tau strongly connected components
+///          and the tau star closure use it. The partition refinement of bisim_gj uses its own data
+///          structures, and weak bisimulation only uses it through the tau star closure.
+class transition_csr
+{
+  protected:
+    detail::compact_index_vector m_offsets;
+    detail::compact_index_vector m_labels;
+    detail::compact_index_vector m_states;
+    bool m_outgoing = true;
+
+  public:
+    transition_csr() = default;
+
+    /// \brief Constructor.
+    /// \param transitions The transitions to be stored.
+    /// \param num_states The number of states, which must be larger than any state in the transitions.
+    /// \param num_labels The number of labels, which must be larger than any label in the transitions.
+    /// \param outgoing If true the transitions are grouped per source, and otherwise per target.
+    transition_csr(const std::vector<transition>& transitions, std::size_t num_states, std::size_t num_labels, bool outgoing = true)
+      : transition_csr(transitions, num_states, num_labels, outgoing, [](std::size_t) { return true; })
+    {}
+
+    /// \brief Constructor that only stores the transitions with a label for which include_label holds.
+    template <typename LabelPredicate>
+    transition_csr(const std::vector<transition>& transitions,
+                   std::size_t num_states,
+                   std::size_t num_labels,
+                   bool outgoing,
+                   LabelPredicate include_label)
+      : m_outgoing(outgoing)
+    {
+      std::size_t num_transitions = 0;
+      for (const transition& t: transitions)
+      {
+        assert(t.from() < num_states && t.to() < num_states && t.label() < num_labels);
+        if (include_label(t.label()))
+        {
+          ++num_transitions;
+        }
+      }
+
+      m_offsets = detail::compact_index_vector(num_states + 1, num_transitions);
+      m_labels = detail::compact_index_vector(num_transitions, num_labels);
+      m_states = detail::compact_index_vector(num_transitions, num_states);
+
+      // Count the transitions per state and place the end of the transitions of state s at position s.
+      std::vector<std::size_t> count(num_states + 1, 0);
+      for (const transition& t: transitions)
+      {
+        if (include_label(t.label()))
+        {
+          count[outgoing ? t.from() : t.to()]++;
+        }
+      }
+
+      std::size_t sum = 0;
+      for (std::size_t& c: count)
+      {
+        sum += c;
+        c = sum;
+      }
+
+      // Store the transitions in reverse order, decrementing the positions until they mark the start of each state.
+      for (const transition& t: transitions)
+      {
+        if (!include_label(t.label()))
+        {
+          continue;
+        }
+        std::size_t& position = count[outgoing ? t.from() : t.to()];
+        --position;
+        m_labels.set(position, t.label());
+        m_states.set(position, outgoing ? t.to() : t.from());
+      }
+
+      for (std::size_t s = 0; s <= num_states; ++s)
+      {
+        m_offsets.set(s, count[s]);
+      }
+      count = std::vector<std::size_t>();
+
+      // Sort the transitions of each state on label and state.
+      std::vector<std::pair<std::size_t, std::size_t>> row;
+      for (std::size_t s = 0; s < num_states; ++s)
+      {
+        row.clear();
+        for (std::size_t i = lowerbound(s); i < upperbound(s); ++i)
+        {
+          row.emplace_back(m_labels[i], m_states[i]);
+        }
+        std::sort(row.begin(), row.end());
+
+        std::size_t i = lowerbound(s);
+        for (const std::pair<std::size_t, std::size_t>& p: row)
+        {
+          m_labels.set(i, p.first);
+          m_states.set(i, p.second);
+          ++i;
+        }
+      }
+    }
+
+    /// \returns The number of states.
+    std::size_t num_states() const
+    {
+      return m_offsets.size() == 0 ? 0 : m_offsets.size() - 1;
+    }
+
+    /// \returns The number of transitions.
+    std::size_t num_transitions() const
+    {
+      return m_labels.size();
+    }
+
+    /// \returns True if the transitions are grouped per source, and false if they are grouped per target.
+    bool outgoing() const
+    {
+      return m_outgoing;
+    }
+
+    /// \returns True if all indices are stored with 32 bits.
+    bool is_narrow() const
+    {
+      return m_offsets.is_narrow() && m_labels.is_narrow() && m_states.is_narrow();
+    }
+
+    /// \returns The position of the first transition of state s.
+    std::size_t lowerbound(std::size_t s) const
+    {
+      assert(s < num_states());
+      return m_offsets[s];
+    }
+
+    /// \returns The position one beyond the last transition of state s.
+    std::size_t upperbound(std::size_t s) const
+    {
+      assert(s < num_states());
+      return m_offsets[s + 1];
+    }
+
+    /// \returns The label of the transition at position i.
+    std::size_t label(std::size_t i) const
+    {
+      return m_labels[i];
+    }
+
+    /// \returns The target of the outgoing, or the source of the incoming, transition at position i.
+    std::size_t state(std::size_t i) const
+    {
+      return m_states[i];
+    }
+
+    /// \brief Releases all memory.
+    void clear()
+    {
+      m_offsets.clear();
+      m_labels.clear();
+      m_states.clear();
+    }
+};
+
+} // namespace mcrl2::lts
+
+#endif // MCRL2_LTS_TRANSITION_CSR_H
@@ -9,13 +9,18 @@
 /// \file liblts_lts.cpp
 
 #include <algorithm>
+#include <chrono>
+#include <exception>
 #include <fstream>
 #include <optional>
 
+#include "mcrl2/atermpp/aterm_io_chunked.h"
 #include "mcrl2/atermpp/standard_containers/indexed_set.h"
+#include "mcrl2/atermpp/standard_containers/vector.h"
 
 #include "mcrl2/lts/lts_lts.h"
 #include "mcrl2/lts/lts_io.h"
+#include "mcrl2/utilities/parallel_for.h"
 
 
 namespace mcrl2::lts
@@ -296,8 +301,245 @@ static void read_lts(atermpp::aterm_istream& stream, LTS& lts)
   }
 }
 
+/// \brief The number of transitions, resp. state labels, that are written to a single chunk of a chunked stream.
+static constexpr std::size_t transitions_per_chunk = 1 << 16;
+static constexpr std::size_t state_labels_per_chunk = 1 << 14;
+
+/// \brief Yields the terms of a decoded chunk. The default constructed term indicates the end of the chunk.
+class chunk_istream final : public atermpp::aterm_istream
+{
+  public:
+    chunk_istream(const std::vector<aterm>& terms)
+      : m_terms(terms)
+    {}
+
+    void get(aterm& t) override
+    {
+      t = m_position < m_terms.size() ? m_terms[m_position++] : aterm();
+    }
+
+    /// \returns The number of terms that have not been read yet.
+    std::size_t remaining() const
+    {
+      return m_terms.size() - m_position;
+    }
+
+  private:
+    const std::vector<aterm>& m_terms;
+    std::size_t m_position = 0;
+};
+
+/// \brief The contents of a chunk of an LTS stream.
+/// \details The containers of terms are protected by the thread that created them, and can be filled by another thread.
+struct lts_chunk
+{
+  std::vector<transition> transitions; // The labels of these transitions are indices in actions.
+  atermpp::vector<lps::multi_action> actions;
+  atermpp::vector<aterm> state_labels;
+  std::optional<std::size_t> initial_state;
+  std::size_t number_of_states = 1;
+  bool aligned = true; // False when a transition or initial state is divided over two chunks.
+};
+
+// Decodes the given chunk of the input stream into result.
+static void decode_lts_chunk(atermpp::chunked_aterm_istream& input, std::size_t index, lts_chunk& result)
+{
+  std::vector<aterm> terms;
+  atermpp::chunked_aterm_istream::decode_chunk(input.read_chunk_data(index), terms, data::detail::add_index_impl);
+  chunk_istream stream(terms);
+
+  mcrl2::utilities::indexed_set<action_label_lts> actions;
+  aterm term;
+  aterm_int from;
+  action_label_lts action;
+  aterm_int to;
+
+  for (stream.get(term); term.defined(); stream.get(term))
+  {
+    if (term == transition_mark())
+    {
+      // A transition consists of the source, the actions and time of the label, and the target.
+      if (stream.remaining() < 4)
+      {
+        result.aligned = false;
+        return;
+      }
+
+      stream >> from;
+      stream >> action;
+      stream >> to;
+
+      result.transitions.emplace_back(from.value(), actions.insert(action).first, to.value());
+      result.number_of_states = std::max({result.number_of_states, from.value() + 1, to.value() + 1});
+    }
+    else if (term == probabilistic_transition_mark())
+    {
+      throw mcrl2::runtime_error("Attempting to read a probabilistic LTS as a regular LTS.");
+    }
+    else if (term.type_is_list())
+    {
+      result.state_labels.push_back(term);
+    }
+    else if (term == initial_state_mark())
+    {
+      if (stream.remaining() < 2)
+      {
+        result.aligned = false;
+        return;
+      }
+
+      // The initial state is stored as a probabilistic state consisting of a single state.
+      stream >> from;
+      if (from.value() != 1)
+      {
+        throw mcrl2::runtime_error("The initial state of the non probabilistic input lts is probabilistic.");
+      }
+      stream >> to;
+      result.initial_state = to.value();
+    }
+    else
+    {
+      // The chunk starts in the middle of a transition, or the stream is invalid, which is then reported when it is read sequentially.
+      result.aligned = false;
+      return;
+    }
+  }
+
+  for (const action_label_lts& a: actions)
+  {
+    result.actions.push_back(a);
+  }
+}
+
+/// \brief Reads an LTS from a chunked stream, where the chunks are decoded in parallel.
+/// \details The header must be in the first chunk, and no transition may be divided over two chunks, which
+///          holds for the streams written by write_to_lts and the lts_lts_disk_builder. Otherwise, the
+///          stream is read sequentially. The state labels are added after all transitions have been read.
+static void read_lts_parallel(atermpp::chunked_aterm_istream& input, lts_lts_t& lts, std::size_t number_of_threads)
+{
+  const std::vector<atermpp::chunk_information>& index = input.index();
+  if (index.empty())
+  {
+    throw mcrl2::runtime_error("Stream does not contain a labelled transition system (LTS).");
+  }
+
+  // Read the header of the lts from the first chunk.
+  std::vector<aterm> header_terms;
+  atermpp::chunked_aterm_istream::decode_chunk(input.read_chunk_data(0), header_terms, data::detail::add_index_impl);
+  chunk_istream header(header_terms);
+
+  atermpp::aterm marker;
+  header >> marker;
+  if (marker != labelled_transition_system_mark())
+  {
+    throw mcrl2::runtime_error("Stream does not contain a labelled transition system (LTS).");
+  }
+
+  data::data_specification spec;
+  data::variable_list parameters;
+  process::action_label_list action_labels;
+
+  header >> spec;
+  header >> parameters;
+  header >> action_labels;
+
+  if (header.remaining() > 0)
+  {
+    read_lts(input, lts);
+    return;
+  }
+
+  // The containers of terms in the chunks are created by this thread, and filled by the workers.
+  std::vector<lts_chunk> chunks(index.size() - 1);
+  number_of_threads = std::max<std::size_t>(1, std::min(number_of_threads, chunks.size()));
+  mcrl2::utilities::parallel_for_ranges(chunks.size(), number_of_threads,
+    [&](std::size_t, std::size_t begin, std::size_t end)
+    {
+      for (std::size_t i = begin; i < end; ++i)
+      {
+        decode_lts_chunk(input, i + 1, chunks[i]);
+      }
+    }, 1);
+
+  if (std::any_of(chunks.begin(), chunks.end(), [](const lts_chunk& chunk) { return !chunk.aligned; }))
+  {
+    read_lts(input, lts);
+    return;
+  }
+
+  lts.set_data(spec);
+  lts.set_process_parameters(parameters);
+  lts.set_action_label_declarations(action_labels);
+
+  // Number the actions in the order of their first occurrence, and determine where the transitions of each chunk start.
+  mcrl2::utilities::indexed_set<action_label_lts> multi_actions;
+  multi_actions.insert(action_label_lts::tau_action()); // This action list represents 'tau'.
+
+  std::vector<std::vector<std::size_t>> action_indices(chunks.size());
+  std::vector<std::size_t> offsets(chunks.size() + 1, 0);
+  std::optional<std::size_t> initial_state;
+  std::size_t number_of_states = 1;
+
+  for (std::size_t i = 0; i < chunks.size(); ++i)
+  {
+    for (const lps::multi_action& action: chunks[i].actions)
+    {
+      const auto [index, inserted] = multi_actions.insert(action_label_lts(action));
+      if (inserted)
+      {
+        [[maybe_unused]]
+        std::size_t actual_index = lts.add_action(action_label_lts(action));
+        assert(actual_index == index);
+      }
+      action_indices[i].push_back(index);
+    }
+
+    offsets[i + 1] = offsets[i] + chunks[i].transitions.size();
+    number_of_states = std::max(number_of_states, chunks[i].number_of_states);
+    if (chunks[i].initial_state)
+    {
+      initial_state = chunks[i].initial_state;
+    }
+  }
+
+  // Copy the transitions into the presized storage of the lts.
+  std::vector<transition>& transitions = lts.get_transitions();
+  std::size_t start = transitions.size();
+  transitions.resize(start + offsets.back());
+  mcrl2::utilities::parallel_for_ranges(chunks.size(), number_of_threads,
+    [&](std::size_t, std::size_t begin, std::size_t end)
+    {
+      for (std::size_t i = begin; i < end; ++i)
+      {
+        std::size_t position = start + offsets[i];
+        for (const transition& t: chunks[i].transitions)
+        {
+          transitions[position++] = transition(t.from(), action_indices[i][t.label()], t.to());
+        }
+        chunks[i].transitions = std::vector<transition>();
+      }
+    }, 1);
+
+  for (const lts_chunk& chunk: chunks)
+  {
+    for (const aterm& label: chunk.state_labels)
+    {
+      lts.add_state(reinterpret_cast<const state_label_lts&>(label));
+    }
+  }
+
+  if (!initial_state)
+  {
+    throw mcrl2::runtime_error("Missing initial state in labelled transition system (LTS) stream.");
+  }
+
+  // If the lts has no state labels, we need to add empty states labels.
+  lts.set_num_states(number_of_states, lts.has_state_info());
+  lts.set_initial_state(initial_state.value());
+}
+
 template <class LTS_TRANSITION_SYSTEM>     
-static void read_from_lts(LTS_TRANSITION_SYSTEM& lts, const std::string& filename)
+static void read_from_lts(LTS_TRANSITION_SYSTEM& lts, const std::string& filename, std::size_t number_of_threads = 1)
 {
   static_assert(std::is_same_v<LTS_TRANSITION_SYSTEM, probabilistic_lts_lts_t>
                     || std::is_same_v<LTS_TRANSITION_SYSTEM, lts_lts_t>,
@@ -320,10 +562,42 @@ static void read_from_lts(LTS_TRANSITION_SYSTEM& lts, const std::string& filenam
     }
   }
 
+  auto start = std::chrono::steady_clock::now();
   try
   {
-    atermpp::binary_aterm_istream stream(filename.empty() ? std::cin : fstream);
-    stream >> lts;
+    if (!filename.empty() && atermpp::chunked_aterm_istream::is_chunked(fstream))
+    {
+      atermpp::chunked_aterm_istream stream(fstream);
+      if constexpr (std::is_same_v<LTS_TRANSITION_SYSTEM, lts_lts_t>)
+      {
+        read_lts_parallel(stream, lts, number_of_threads);
+      }
+      else
+      {
+        stream >> lts;
+      }
+    }
+    else if (filename.empty())
+    {
+      // Standard input cannot be repositioned, so its first bytes are read in advance to determine the format.
+      // The index at the end of a chunked stream cannot be read either, so its chunks are read sequentially.
+      atermpp::peeked_istream input(std::cin, atermpp::chunked_aterm_istream::identification_size);
+      if (atermpp::chunked_aterm_istream::is_chunked(input.peeked()))
+      {
+        atermpp::chunked_aterm_istream stream(input);
+        stream >> lts;
+      }
+      else
+      {
+        atermpp::binary_aterm_istream stream(input);
+        stream >> lts;
+      }
+    }
+    else
+    {
+      atermpp::binary_aterm_istream stream(fstream);
+      stream >> lts;
+    }
   }
   catch (const std::exception& ex)
   {
@@ -337,6 +611,16 @@ static void read_from_lts(LTS_TRANSITION_SYSTEM& lts, const std::string& filenam
       throw mcrl2::runtime_error("Fail to correctly read an lts from the file " + filename + ".");
     }
   }
+
+  if (!filename.empty())
+  {
+    fstream.clear();
+    fstream.seekg(0, std::ios_base::end);
+    double megabytes = static_cast<double>(fstream.tellg()) / (1024 * 1024);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    mCRL2log(log::verbose) << "Read " << megabytes << " MB in " << seconds << " seconds ("
+                           << (seconds > 0 ? megabytes / seconds : 0.0) << " MB/s).\n";
+  }
 }
 
 void write_initial_state(atermpp::aterm_ostream& stream, const probabilistic_lts_lts_t& lts)
@@ -351,8 +635,21 @@ void write_initial_state(atermpp::aterm_ostream& stream, const lts_lts_t& lts)
   stream << probabilistic_lts_lts_t::probabilistic_state_t(lts.initial_state());
 }
 
-template <class LTS>
-static void write_lts(atermpp::aterm_ostream& stream, const LTS& lts)
+// Finishes the current chunk after the given number of records when writing to a chunked stream.
+template <class Stream>
+static void end_of_record(Stream& stream, std::size_t records, std::size_t records_per_chunk)
+{
+  if constexpr (std::is_same_v<Stream, atermpp::chunked_aterm_ostream>)
+  {
+    if (records % records_per_chunk == 0)
+    {
+      stream.flush_chunk();
+    }
+  }
+}
+
+template <class LTS, class Stream>
+static void write_lts(Stream& stream, const LTS& lts)
 {
   static_assert(std::is_same_v<LTS, probabilistic_lts_lts_t> || std::is_same_v<LTS, lts_lts_t>,
       "Function write_lts can only be applied to a (probabilistic) lts. ");
@@ -362,7 +659,9 @@ static void write_lts(atermpp::aterm_ostream& stream, const LTS& lts)
    lts.data(),
    lts.process_parameters(),
    lts.action_label_declarations());
+  end_of_record(stream, 0, 1);
 
+  std::size_t count = 0;
   for (const transition& trans : lts.get_transitions())
   {
     lts_lts_t::action_label_t label = lts.action_label(lts.apply_hidden_label_map(trans.label()));
@@ -375,7 +674,9 @@ static void write_lts(atermpp::aterm_ostream& stream, const LTS& lts)
     {
       write_transition(stream, trans.from(), label, trans.to());
     }
+    end_of_record(stream, ++count, transitions_per_chunk);
   }
+  end_of_record(stream, 0, 1);
 
   if (lts.has_state_info())
   {
@@ -383,6 +684,7 @@ static void write_lts(atermpp::aterm_ostream& stream, const LTS& lts)
     {
       // Write state labels as such, we assume that all list terms without headers are state labels.
       stream << lts.state_label(i);
+      end_of_record(stream, i + 1, state_labels_per_chunk);
     }
   }
 
@@ -410,8 +712,18 @@ static void write_to_lts(const LTS_TRANSITION_SYSTEM& lts, const std::string& fi
 
   try
   {
-    atermpp::binary_aterm_ostream stream(to_stdout ? std::cout : fstream);
-    stream << lts;
+    if (to_stdout)
+    {
+      // Standard output is written sequentially, as the chunks of a stream that cannot be repositioned can only be read sequentially.
+      atermpp::binary_aterm_ostream stream(std::cout);
+      stream << lts;
+    }
+    else
+    {
+      // Chunks are only finished at the end of a transition or state label, such that they can be decoded in parallel.
+      atermpp::chunked_aterm_ostream stream(fstream, std::numeric_limits<std::size_t>::max());
+      write_lts(stream, lts);
+    }
   }
   catch (const std::exception& ex)
   {
@@ -517,10 +829,10 @@ void probabilistic_lts_lts_t::load(const std::string& filename)
   detail::read_from_lts(*this, filename);
 }
 
-void lts_lts_t::load(const std::string& filename)
+void lts_lts_t::load(const std::string& filename, std::size_t number_of_threads)
 {
   mCRL2log(log::verbose) << "Starting to load an lts from the file " << filename << ".\n";
-  detail::read_from_lts(*this, filename);
+  detail::read_from_lts(*this, filename, number_of_threads);
 }
 
 } // namespace mcrl2::lts
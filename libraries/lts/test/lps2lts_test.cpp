@@ -47,21 +47,28 @@ std::string file_extension(lts::lts_type output_format)
   }
 }
 
+// The options used by default in these tests. The LTS is kept in memory and saved at the end.
+static lps::explorer_options default_test_options()
+{
+  lps::explorer_options options;
+  options.save_at_end = true;
+  return options;
+}
+
 void run_generatelts(
   const lps::stochastic_specification& stochastic_lpsspec,
   data::rewrite_strategy rstrategy,
   lps::exploration_strategy estrategy,
   lts::lts_type output_format,
   const std::string& outputfile,
-  const std::string& priority_action
+  const std::string& priority_action,
+  lps::explorer_options options
 )
 {
-  lps::explorer_options options;
   options.trace_prefix = "lps2lts_test";
   options.confluence_action = priority_action;
   options.rewrite_strategy = rstrategy;
   options.search_strategy = estrategy;
-  options.save_at_end = true;
 
   bool is_timed = stochastic_lpsspec.process().has_time();
 
@@ -80,7 +87,7 @@ void run_generatelts(
   else
   {
     lps::specification lpsspec = lps::remove_stochastic_operators(stochastic_lpsspec);
-    auto builder = create_lts_builder(lpsspec, options, output_format);
+    auto builder = create_lts_builder(lpsspec, options, output_format, outputfile);
     if (is_timed)
     {
       generate_state_space<false, true>(lpsspec, *builder, outputfile, options);
@@ -101,7 +108,8 @@ void check_lts(
   std::size_t expected_states,
   std::size_t expected_transitions,
   std::size_t expected_labels,
-  const std::string& priority_action = ""
+  const std::string& priority_action = "",
+  const lps::explorer_options& options = default_test_options()
 )
 {
   std::cerr << "Translating LPS to LTS with exploration strategy " << estrategy << ", rewrite strategy " << rstrategy << "." << std::endl;
@@ -109,7 +117,7 @@ void check_lts(
   LTSType result;
   lts::lts_type output_format = result.type();
   std::string outputfile = static_cast<std::string>(boost::unit_test::framework::current_test_case().p_name) + ".generatelts" + file_extension(output_format);
-  run_generatelts(stochastic_lpsspec, rstrategy, estrategy, output_format, outputfile, priority_action);
+  run_generatelts(stochastic_lpsspec, rstrategy, estrategy, output_format, outputfile, priority_action, options);
   result.load(outputfile);
 
   BOOST_CHECK_EQUAL(result.num_states(), expected_states);
@@ -123,7 +131,8 @@ static void check_lps2lts_specification(const std::string& specification,
                                         const std::size_t expected_states,
                                         const std::size_t expected_transitions,
                                         const std::size_t expected_labels,
-                                        const std::string& priority_action = "")
+                                        const std::string& priority_action = "",
+                                        const lps::explorer_options& options = default_test_options())
 {
   std::cerr << "CHECK STATE SPACE GENERATION FOR:\n" << specification << "\n";
   lps::stochastic_specification lpsspec;
@@ -136,15 +145,15 @@ static void check_lps2lts_specification(const std::string& specification,
     {
       if (contains_probabilities)
       {
-        check_lts<lts::probabilistic_lts_aut_t>("PROBABILISTIC AUT", lpsspec, rstrategy, estrategy, expected_states, expected_transitions, expected_labels, priority_action);
-        check_lts<lts::probabilistic_lts_lts_t>("PROBABILISTIC LTS", lpsspec, rstrategy, estrategy, expected_states, expected_transitions, expected_labels, priority_action);
-        check_lts<lts::probabilistic_lts_fsm_t>("PROBABILISTIC FSM", lpsspec, rstrategy, estrategy, expected_states, expected_transitions, expected_labels, priority_action);
+        check_lts<lts::probabilistic_lts_aut_t>("PROBABILISTIC AUT", lpsspec, rstrategy, estrategy, expected_states, expected_transitions, expected_labels, priority_action, options);
+        check_lts<lts::probabilistic_lts_lts_t>("PROBABILISTIC LTS", lpsspec, rstrategy, estrategy, expected_states, expected_transitions, expected_labels, priority_action, options);
+        check_lts<lts::probabilistic_lts_fsm_t>("PROBABILISTIC FSM", lpsspec, rstrategy, estrategy, expected_states, expected_transitions, expected_labels, priority_action, options);
       }
       else
       {
-        check_lts<lts::lts_aut_t>("AUT", lpsspec, rstrategy, estrategy, expected_states, expected_transitions, expected_labels, priority_action);
-        check_lts<lts::lts_lts_t>("LTS", lpsspec, rstrategy, estrategy, expected_states, expected_transitions, expected_labels, priority_action);
-        check_lts<lts::lts_fsm_t>("FSM", lpsspec, rstrategy, estrategy, expected_states, expected_transitions, expected_labels, priority_action);
+        check_lts<lts::lts_aut_t>("AUT", lpsspec, rstrategy, estrategy, expected_states, expected_transitions, expected_labels, priority_action, options);
+        check_lts<lts::lts_lts_t>("LTS", lpsspec, rstrategy, estrategy, expected_states, expected_transitions, expected_labels, priority_action, options);
+        check_lts<lts::lts_fsm_t>("FSM", lpsspec, rstrategy, estrategy, expected_states, expected_transitions, expected_labels, priority_action, options);
       }
     }
   }
@@ -220,6 +229,46 @@ BOOST_AUTO_TEST_CASE(test_abp)
   );
   check_lps2lts_specification(abp, 74, 92, 20);
   check_lps2lts_specification(abp, 74, 92, 20, "tau");
+
+  lps::explorer_options options = default_test_options();
+  options.number_of_threads = 4;
+  check_lps2lts_specification(abp, 74, 92, 20, "", options); // Threads steal states from each other.
+  options.tree_compression = true;
+  check_lps2lts_specification(abp, 74, 92, 20, "", options);
+  options.number_of_threads = 1;
+  check_lps2lts_specification(abp, 74, 92, 20, "", options);
+
+  // Threads write their transitions to the .aut and .lts files while exploring.
+  lps::explorer_options disk_options;
+  disk_options.number_of_threads = 4;
+  check_lps2lts_specification(abp, 74, 92, 20, "", disk_options);
+
+  // Caches that can only hold a few entries evict most of them.
+  lps::explorer_options cache_options = default_test_options();
+  cache_options.cached = true;
+  cache_options.cache_size = 2;
+  check_lps2lts_specification(abp, 74, 92, 20, "", cache_options);
+  cache_options.global_cache = true;
+  cache_options.number_of_threads = 4;
+  check_lps2lts_specification(abp, 74, 92, 20, "", cache_options);
+  cache_options.cache_size = 0; // Unbounded caches are accessed without a lock.
+  check_lps2lts_specification(abp, 74, 92, 20, "", cache_options);
+
+  // If the set of discovered states is full, the exploration of all threads is aborted with an error.
+  lps::stochastic_specification abpspec;
+  parse_lps(abp, abpspec);
+  lps::explorer_options capacity_options = default_test_options();
+  capacity_options.state_capacity = 10;
+  for (std::size_t number_of_threads: { 1, 4 })
+  {
+    capacity_options.number_of_threads = number_of_threads;
+    BOOST_CHECK_THROW(run_generatelts(abpspec, data::jitty, lps::es_breadth, lts::lts_aut, "test_abp_capacity.aut", "", capacity_options), mcrl2::runtime_error);
+  }
+
+  // A state capacity cannot be combined with tree compression, even if it is large enough.
+  capacity_options.state_capacity = 100;
+  capacity_options.tree_compression = true;
+  BOOST_CHECK_THROW(run_generatelts(abpspec, data::jitty, lps::es_breadth, lts::lts_aut, "test_abp_capacity.aut", "", capacity_options), mcrl2::runtime_error);
 }
 
 BOOST_AUTO_TEST_CASE(test_confluence)
@@ -288,6 +337,36 @@ BOOST_AUTO_TEST_CASE(test_timed) // For bug #756
     "init P(1);\n"
   );
   check_lps2lts_specification(spec, 3, 2, 3);
+  lps::explorer_options options = default_test_options();
+  options.tree_compression = true;
+  check_lps2lts_specification(spec, 3, 2, 3, "", options); // The time stamp is compressed as an extra parameter.
+}
+
+// The time stamp is an extra element of the states. Here the states have several parameters, and the
+// action b leads back to states that have been discovered before. The labels are tau, a@1, a@2 and b.
+BOOST_AUTO_TEST_CASE(test_timed_parameters)
+{
+  std::string spec(
+    "act  a,b;\n"
+    "\n"
+    "proc P(x: Pos, y: Bool) =\n"
+    "       (x < 3) ->\n"
+    "         a @ x .\n"
+    "         P(x = x + 1)\n"
+    "     + b .\n"
+    "         P(y = !y)\n"
+    "     + delta;\n"
+    "\n"
+    "init P(1, true);\n"
+  );
+  check_lps2lts_specification(spec, 6, 10, 4);
+  lps::explorer_options options = default_test_options();
+  options.number_of_threads = 4;
+  check_lps2lts_specification(spec, 6, 10, 4, "", options);
+  options.tree_compression = true;
+  check_lps2lts_specification(spec, 6, 10, 4, "", options);
+  options.number_of_threads = 1;
+  check_lps2lts_specification(spec, 6, 10, 4, "", options);
 }
 
 BOOST_AUTO_TEST_CASE(test_struct)
@@ -12,7 +12,10 @@
 #define BOOST_TEST_MODULE lts_test
 #include <boost/test/included/unit_test.hpp>
 
+#include "mcrl2/atermpp/aterm_io_chunked.h"
+#include "mcrl2/lts/lts_io.h"
 #include "mcrl2/lts/test/test_reductions.h"
+#include "mcrl2/lts/transition_csr.h"
 
 using namespace mcrl2;
 
@@ -843,3 +846,198 @@ BOOST_AUTO_TEST_CASE(hide_actions5)
 }
 
 
+
+// An lts with enough transitions to be saved in several chunks, which are decoded in parallel when it is loaded.
+BOOST_AUTO_TEST_CASE(save_and_load_chunked_lts)
+{
+  process::action_label a("a", data::sort_expression_list());
+  process::action_label b("b", data::sort_expression_list());
+
+  lts::lts_lts_t l;
+  l.set_action_label_declarations(process::action_label_list({a, b}));
+  l.add_action(lts::action_label_lts(lps::multi_action(process::action_list({process::action(a, data::data_expression_list())}))));
+  l.add_action(lts::action_label_lts(lps::multi_action(process::action_list({process::action(b, data::data_expression_list())}))));
+
+  const std::size_t number_of_states = 100000;
+  l.set_num_states(number_of_states, false);
+  for (std::size_t i = 0; i < 2 * number_of_states; ++i)
+  {
+    l.add_transition(lts::transition(i % number_of_states, i % 3, (i * 7 + 1) % number_of_states));
+  }
+  l.set_initial_state(5);
+
+  const std::string filename = "save_and_load_chunked_lts.lts";
+  l.save(filename);
+
+  lts::lts_lts_t loaded;
+  loaded.load(filename);
+  std::remove(filename.c_str());
+
+  BOOST_CHECK_EQUAL(loaded.num_states(), l.num_states());
+  BOOST_CHECK_EQUAL(loaded.initial_state(), l.initial_state());
+  BOOST_CHECK_EQUAL(loaded.num_action_labels(), l.num_action_labels());
+  BOOST_CHECK(loaded.get_transitions() == l.get_transitions());
+  for (std::size_t i = 0; i < l.num_action_labels(); ++i)
+  {
+    BOOST_CHECK_EQUAL(loaded.action_label(i), l.action_label(i));
+  }
+}
+
+// Forwards the terms to a chunked stream, and finishes a chunk whenever the number of terms written after the
+// header modulo the given period equals the offset.
+class splitting_aterm_ostream : public atermpp::aterm_ostream
+{
+public:
+  splitting_aterm_ostream(atermpp::chunked_aterm_ostream& stream, std::size_t period, std::size_t offset)
+    : m_stream(stream), m_period(period), m_offset(offset)
+  {}
+
+  void put(const atermpp::aterm& term) override
+  {
+    m_stream.set_transformer(*m_transformer);
+    m_stream.put(term);
+    if (m_split && ++m_count % m_period == m_offset)
+    {
+      m_stream.flush_chunk();
+    }
+  }
+
+  void start_splitting()
+  {
+    m_stream.flush_chunk();
+    m_split = true;
+  }
+
+private:
+  atermpp::chunked_aterm_ostream& m_stream;
+  std::size_t m_period;
+  std::size_t m_offset;
+  std::size_t m_count = 0;
+  bool m_split = false;
+};
+
+BOOST_AUTO_TEST_CASE(load_lts_split_within_transitions)
+{
+  process::action_label a("a", data::sort_expression_list());
+  const lps::multi_action action(process::action_list({process::action(a, data::data_expression_list())}));
+
+  // A transition is written as a mark, the source, the actions, the time and the target.
+  const std::size_t terms_per_transition = 5;
+  const std::size_t number_of_transitions = 100;
+  for (std::size_t offset = 0; offset < terms_per_transition; ++offset)
+  {
+    const std::string filename = "load_lts_split_within_transitions.lts";
+    {
+      std::ofstream fstream(filename, std::ofstream::out | std::ofstream::binary);
+      atermpp::chunked_aterm_ostream chunked(fstream, std::numeric_limits<std::size_t>::max());
+      splitting_aterm_ostream stream(chunked, terms_per_transition, offset);
+
+      lts::write_lts_header(stream, data::data_specification(), data::variable_list(), process::action_label_list({a}));
+      stream.start_splitting();
+      for (std::size_t i = 0; i < number_of_transitions; ++i)
+      {
+        lts::write_transition(stream, i, action, i + 1);
+      }
+      lts::write_initial_state(stream, 0);
+    }
+
+    lts::lts_lts_t loaded;
+    loaded.load(filename);
+    std::remove(filename.c_str());
+
+    BOOST_CHECK_EQUAL(loaded.num_states(), number_of_transitions + 1);
+    BOOST_CHECK_EQUAL(loaded.initial_state(), 0u);
+    BOOST_REQUIRE_EQUAL(loaded.num_transitions(), number_of_transitions);
+    for (std::size_t i = 0; i < number_of_transitions; ++i)
+    {
+      const lts::transition& t = loaded.get_transitions()[i];
+      BOOST_CHECK_EQUAL(t.from(), i);
+      BOOST_CHECK_EQUAL(t.to(), i + 1);
+      BOOST_CHECK_EQUAL(loaded.action_label(t.label()), lts::action_label_lts(action));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(transitions_in_csr_format)
+{
+  lts::lts_aut_t l;
+  l.add_action(lts::action_label_string("a"));
+  l.add_action(lts::action_label_string("b"));
+  l.set_num_states(4, false);
+  l.add_transition(lts::transition(0, 2, 3));
+  l.add_transition(lts::transition(0, 0, 2));
+  l.add_transition(lts::transition(2, 1, 0));
+  l.add_transition(lts::transition(0, 2, 1));
+  l.add_transition(lts::transition(3, 0, 0));
+
+  const lts::transition_csr outgoing(l.get_transitions(), l.num_states(), l.num_action_labels(), true);
+  BOOST_CHECK(outgoing.is_narrow());
+  BOOST_CHECK_EQUAL(outgoing.num_states(), 4u);
+  BOOST_CHECK_EQUAL(outgoing.num_transitions(), 5u);
+
+  // The transitions of a state are sorted on label and target, such that the tau transition comes first.
+  BOOST_CHECK_EQUAL(outgoing.upperbound(0) - outgoing.lowerbound(0), 3u);
+  std::size_t i = outgoing.lowerbound(0);
+  BOOST_CHECK(outgoing.label(i) == 0 && outgoing.state(i) == 2);
+  BOOST_CHECK(outgoing.label(i + 1) == 2 && outgoing.state(i + 1) == 1);
+  BOOST_CHECK(outgoing.label(i + 2) == 2 && outgoing.state(i + 2) == 3);
+  BOOST_CHECK_EQUAL(outgoing.lowerbound(1), outgoing.upperbound(1));
+
+  const lts::transition_csr incoming(l.get_transitions(), l.num_states(), l.num_action_labels(), false);
+  BOOST_CHECK(!incoming.outgoing());
+  BOOST_CHECK_EQUAL(incoming.upperbound(0) - incoming.lowerbound(0), 2u);
+  i = incoming.lowerbound(0);
+  BOOST_CHECK(incoming.label(i) == 0 && incoming.state(i) == 3);
+  BOOST_CHECK(incoming.label(i + 1) == 1 && incoming.state(i + 1) == 2);
+
+  // A csr that is built after adding a transition contains it.
+  l.add_transition(lts::transition(1, 1, 1));
+  BOOST_CHECK_EQUAL(lts::transition_csr(l.get_transitions(), l.num_states(), l.num_action_labels()).num_transitions(), 6u);
+  const lts::transition_csr incoming_after(l.get_transitions(), l.num_states(), l.num_action_labels(), false);
+  BOOST_CHECK_EQUAL(incoming_after.upperbound(1) - incoming_after.lowerbound(1), 2u);
+
+  // Only the tau transitions.
+  const lts::transition_csr tau(l.get_transitions(), l.num_states(), l.num_action_labels(), true,
+                                [&l](std::size_t label) { return l.is_tau(label); });
+  BOOST_CHECK_EQUAL(tau.num_transitions(), 2u);
+  BOOST_CHECK_EQUAL(tau.upperbound(0) - tau.lowerbound(0), 1u);
+  BOOST_CHECK_EQUAL(tau.state(tau.lowerbound(3)), 0u);
+  BOOST_CHECK_EQUAL(tau.lowerbound(2), tau.upperbound(2));
+}
+
+// A pseudo random lts that is large enough to let several threads compute signatures concurrently.
+static lts::lts_aut_t random_lts(const std::size_t number_of_states)
+{
+  lts::lts_aut_t l;
+  l.add_action(lts::action_label_string("a"));
+  l.add_action(lts::action_label_string("b"));
+  l.set_num_states(number_of_states, false);
+  std::size_t seed = 12345;
+  for (std::size_t i = 0; i < 3 * number_of_states; ++i)
+  {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    const std::size_t from = (seed >> 33) % number_of_states;
+    // Only a few targets, such that the lts contains many bisimilar states.
+    l.add_transition(lts::transition(from, (seed >> 20) % 3, (from * 7 + (seed >> 10) % 3) % number_of_states));
+  }
+  return l;
+}
+
+BOOST_AUTO_TEST_CASE(parallel_bisimulation_reduction)
+{
+  const lts::lts_aut_t l = random_lts(20000);
+  for (const bool branching: {false, true})
+  {
+    lts::lts_aut_t expected = l;
+    reduce(expected, branching ? lts::lts_eq_branching_bisim : lts::lts_eq_bisim);
+
+    for (const std::size_t number_of_threads: {1, 4})
+    {
+      lts::lts_aut_t reduced = l;
+      reduce(reduced, branching ? lts::lts_eq_branching_bisim_par : lts::lts_eq_bisim_par, number_of_threads);
+      BOOST_CHECK_EQUAL(reduced.num_states(), expected.num_states());
+      BOOST_CHECK_EQUAL(reduced.num_transitions(), expected.num_transitions());
+      BOOST_CHECK(compare(l, reduced, branching ? lts::lts_eq_branching_bisim_par : lts::lts_eq_bisim_par, false, "", false, number_of_threads));
+    }
+  }
+}
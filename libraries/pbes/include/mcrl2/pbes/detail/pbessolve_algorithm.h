@@ -47,6 +47,9 @@ bool run_solve(const pbes_system::pbes& pbesspec,
   std::string evidence_file,
   mcrl2::utilities::execution_timer& timer)
 {  
+  // The formulas of the vertices are only needed to construct evidence.
+  G.freeze(!lpsfile.empty() || !ltsfile.empty());
+
   bool result;
   if (!lpsfile.empty())
   {
@@ -57,7 +60,7 @@ bool run_solve(const pbes_system::pbes& pbesspec,
     lps::specification evidence;
     timer.start("solving");
     std::tie(result, evidence) = solve_structure_graph_with_counter_example(
-        G, lpsspec, pbesspec, equation_index);
+        G, lpsspec, pbesspec, equation_index, options.number_of_threads, options.scc_decomposition, options.solver);
     timer.finish("solving");
 
     std::cout << (result ? "true" : "false") << std::endl;
@@ -77,7 +80,7 @@ bool run_solve(const pbes_system::pbes& pbesspec,
 
     lts::lts_lts_t evidence;
     timer.start("solving");
-    result = solve_structure_graph_with_counter_example(G, ltsspec);
+    result = solve_structure_graph_with_counter_example(G, ltsspec, options.number_of_threads, options.scc_decomposition, options.solver);
     timer.finish("solving");
     std::cout << (result ? "true" : "false") << std::endl;
     if (evidence_file.empty())
@@ -92,7 +95,7 @@ bool run_solve(const pbes_system::pbes& pbesspec,
   else
   {
     timer.start("solving");
-    result = solve_structure_graph(G, options.check_strategy);
+    result = solve_structure_graph(G, options.check_strategy, options.number_of_threads, options.scc_decomposition, options.solver);
     timer.finish("solving");
     std::cout << (result ? "true" : "false") << std::endl;
   }
@@ -135,6 +138,16 @@ class pbessolve_tool
           "be an LTS.",
           'f');
       desc.add_option("prune-todo-list", "Prune the todo list periodically.");
+      desc.add_option("scc-decomposition",
+          "Solve the strongly connected components of the parity game bottom-up. Components that do not "
+          "depend on each other are solved in parallel if more than one thread is used.");
+      desc.add_option("solver",
+          utilities::make_enum_argument<structure_graph_solver>("NAME")
+              .add_value(structure_graph_solver::zielonka, true)
+              .add_value(structure_graph_solver::priority_promotion)
+              .add_value(structure_graph_solver::tangle_learning)
+              .add_value(structure_graph_solver::fixpoint_iteration),
+          "Solve the parity game using algorithm NAME:");
       desc.add_hidden_option("naive-counter-example-instantiation",
           "run the naive instantiation algorithm for pbes with counter example information");
       desc.add_hidden_option("no-remove-unused-rewrite-rules", "do not remove unused rewrite rules. ", 'u');
@@ -200,6 +213,8 @@ class pbessolve_tool
     options.prune_and_solve_frequently = parser.has_option("frequent");
     options.aggressive = parser.has_option("aggressive");
     options.prune_todo_list = parser.has_option("prune-todo-list");
+    options.scc_decomposition = parser.has_option("scc-decomposition");
+    options.solver = parser.option_argument_as<structure_graph_solver>("solver");
     options.exploration_strategy =
         parser.option_argument_as<mcrl2::pbes_system::search_strategy>(
             "search-strategy");
@@ -220,6 +235,12 @@ class pbessolve_tool
       }
     }
 
+    if (!computes_strategies(options.solver) && (parser.has_option("file") || options.check_strategy))
+    {
+      throw mcrl2::runtime_error("Solver " + print_structure_graph_solver(options.solver) + " does not compute strategies, "
+                                 "so it cannot be used with --file or --check-strategy");
+    }
+
     if (parser.has_option("evidence-file"))
     {
       if (!parser.has_option("file"))
@@ -360,18 +381,32 @@ class pbessolve_tool
           << std::endl;
     }
 
+    // Without strategies the evidence cannot be extracted from the first pass, so it is not used.
+    if (has_counter_example && !options.naive_counter_example_instantiation && !computes_strategies(options.solver))
+    {
+      mCRL2log(log::verbose) << "The solver " << options.solver << " does not compute strategies; the counter example "
+                             << "information is instantiated in a single pass." << std::endl;
+    }
+
     // When the original has counter example information we remove it and store the provided pbes.
-    if (!has_counter_example || options.naive_counter_example_instantiation)
+    if (!has_counter_example || options.naive_counter_example_instantiation || !computes_strategies(options.solver))
     {      
       mCRL2log(log::verbose) << "Generating parity game..." << std::endl;
       structure_graph G;
-      PbesInstAlgorithm instantiate(options, pbesspec, G);
+      pbes_equation_index equation_index;
+      {
+        // The instantiation refers to the formulas of all vertices. It is destroyed before solving, such
+        // that these formulas are released when the graph is frozen.
+        PbesInstAlgorithm instantiate(options, pbesspec, G);
 
-      timer().start("instantiation");
-      instantiate.run();
-      timer().finish("instantiation");
+        timer().start("instantiation");
+        instantiate.run();
+        timer().finish("instantiation");
+
+        equation_index = instantiate.equation_index();
+      }
 
-      detail::run_solve(pbesspec, sigma, G, instantiate.equation_index(), options, input_filename(), lpsfile, ltsfile, evidence_file, timer());
+      detail::run_solve(pbesspec, sigma, G, equation_index, options, input_filename(), lpsfile, ltsfile, evidence_file, timer());
     }
     else
     {
@@ -382,18 +417,27 @@ class pbessolve_tool
 
       mCRL2log(log::verbose) << "Generating parity game..." << std::endl;
       structure_graph initial_G;
-      PbesInstAlgorithm first_instantiate(options, pbesspec_without_counterexample, initial_G);
+      std::optional<data::rewriter> datar;
+      {
+        PbesInstAlgorithm first_instantiate(options, pbesspec_without_counterexample, initial_G);
+
+        timer().start("first-instantiation");
+        first_instantiate.run();
+        timer().finish("first-instantiation");
 
-      timer().start("first-instantiation");
-      first_instantiate.run();
-      timer().finish("first-instantiation");
+        // The rewriter is reused by the second instantiation, the remainder of the instantiation is released.
+        datar = first_instantiate.data_rewriter();
+      }
 
       mCRL2log(log::verbose) << "Number of vertices in the structure graph: "
-                             << initial_G.all_vertices().size() << std::endl;      
+                             << initial_G.extent() << std::endl;      
+
+      // The formulas are kept, since they are needed for the second instantiation.
+      initial_G.freeze();
 
       // Solve the initial pbes and obtain the strategies in G.
       timer().start("first-solving");
-      auto [result, mapping] = solve_structure_graph_winning_mapping(initial_G, true);
+      auto [result, mapping] = solve_structure_graph_winning_mapping(initial_G, true, options.number_of_threads, options.scc_decomposition, options.solver);
       timer().finish("first-solving");
       mCRL2log(log::log_level_t::verbose) << (result ? "true" : "false") << std::endl;
 
@@ -414,17 +458,22 @@ class pbessolve_tool
       mCRL2log(log::trace) << pbesspec << std::endl;
 
       structure_graph G;
-      PbesInstAlgorithmCE second_instantiate(options, pbesspec, initial_G, !result, mapping, G, first_instantiate.data_rewriter(), R);
-      
-      // Perform the second instantiation given the proof graph.      
-      timer().start("second-instantiation");
-      second_instantiate.run();
-      timer().finish("second-instantiation");
+      pbes_equation_index equation_index;
+      {
+        PbesInstAlgorithmCE second_instantiate(options, pbesspec, initial_G, !result, mapping, G, datar, R);
+
+        // Perform the second instantiation given the proof graph.
+        timer().start("second-instantiation");
+        second_instantiate.run();
+        timer().finish("second-instantiation");
+
+        equation_index = second_instantiate.equation_index();
+      }
 
       mCRL2log(log::verbose) << "Number of vertices in the structure graph: "
-                             << G.all_vertices().size() << std::endl;
+                             << G.extent() << std::endl;
       
-      bool final_result = detail::run_solve(pbesspec, sigma, G, second_instantiate.equation_index(), options, input_filename(), lpsfile, ltsfile, evidence_file, timer());
+      bool final_result = detail::run_solve(pbesspec, sigma, G, equation_index, options, input_filename(), lpsfile, ltsfile, evidence_file, timer());
       if(result != final_result) {
         throw mcrl2::runtime_error("The result of the second instantiation does not match the first instantiation. This is a bug in the tool!");
       }
@@ -519,6 +568,7 @@ bool pbessolve(const pbes& p)
   structure_graph G;
   pbesinst_structure_graph_algorithm algorithm(options, pbesspec, G);
   algorithm.run();
+  G.freeze(false);
   return solve_structure_graph(G);
 }
 
@@ -0,0 +1,216 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/pbes/detail/pbessolve_regions.h
+/// \brief Priorities and regions of structure graphs, which are shared by the parity game solvers.
+
+#ifndef MCRL2_PBES_DETAIL_PBESSOLVE_REGIONS_H
+#define MCRL2_PBES_DETAIL_PBESSOLVE_REGIONS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "mcrl2/pbes/pbessolve_attractors.h"
+
+namespace mcrl2::pbes_system::detail {
+
+/// \brief The ranks of the vertices of a structure graph that are not excluded, numbered in order of importance.
+/// \details Priority 0 corresponds to the smallest rank, which is the most important one. The parity of a
+///          priority is the parity of its rank, and it is the player that wins a play in which it is the most
+///          important priority that occurs infinitely often. An undefined rank is the least important rank.
+class structure_graph_priorities
+{
+  protected:
+    std::vector<std::size_t> m_priority;                         // the priority of each vertex
+    std::vector<std::size_t> m_parity;                           // the parity of each priority
+    std::vector<std::vector<structure_graph::index_type>> m_vertices; // the vertices with each priority
+
+  public:
+    explicit structure_graph_priorities(const structure_graph& G)
+      : m_priority(G.extent(), 0)
+    {
+      const std::size_t N = G.extent();
+      std::vector<std::size_t> ranks;
+      for (structure_graph::index_type u = 0; u < N; u++)
+      {
+        if (G.contains(u))
+        {
+          ranks.push_back(G.rank(u));
+        }
+      }
+      std::sort(ranks.begin(), ranks.end());
+      ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
+
+      m_vertices.resize(ranks.size());
+      for (std::size_t rank: ranks)
+      {
+        m_parity.push_back(rank % 2);
+      }
+      for (structure_graph::index_type u = 0; u < N; u++)
+      {
+        if (G.contains(u))
+        {
+          const std::size_t p = std::lower_bound(ranks.begin(), ranks.end(), G.rank(u)) - ranks.begin();
+          m_priority[u] = p;
+          m_vertices[p].push_back(u);
+        }
+      }
+    }
+
+    /// \brief The number of priorities.
+    std::size_t size() const
+    {
+      return m_parity.size();
+    }
+
+    std::size_t priority(structure_graph::index_type u) const
+    {
+      return m_priority[u];
+    }
+
+    std::size_t parity(std::size_t p) const
+    {
+      return m_parity[p];
+    }
+
+    const std::vector<structure_graph::index_type>& vertices(std::size_t p) const
+    {
+      return m_vertices[p];
+    }
+
+    /// \brief Removes the vertices that are excluded from G from the vertices of each priority.
+    /// \details A solver calls this when it has removed a dominion, such that a traversal of the vertices of
+    ///          the priorities only visits the vertices that are still in the game.
+    void remove_excluded(const structure_graph& G)
+    {
+      for (std::vector<structure_graph::index_type>& vertices: m_vertices)
+      {
+        vertices.erase(std::remove_if(vertices.begin(), vertices.end(),
+                                      [&](structure_graph::index_type u) { return !G.contains(u); }),
+                       vertices.end());
+      }
+    }
+};
+
+/// \brief Computes attractors in the subgames that consist of the vertices with a region of at least some priority.
+/// \details The region of a vertex is a priority, where regions with a smaller priority are more important.
+///          The attractor of player alpha to region p is computed in the subgame of the vertices u of G with
+///          region[u] >= p. The vertices that are added to the attractor get region p. Strategies of player alpha
+///          are set in G for the vertices that are added.
+class region_attractor
+{
+  protected:
+    std::vector<std::uint32_t> m_counter;             // the number of successors that are not yet in the attractor plus one, or zero
+    std::vector<structure_graph::index_type> m_touched; // the vertices with a nonzero counter
+
+  public:
+    explicit region_attractor(std::size_t N)
+      : m_counter(N, 0)
+    {}
+
+    /// \brief Extends R, which contains the vertices with region p, to the attractor of R for player alpha.
+    /// \param on_insert Is called as on_insert(u, R) for every vertex u of the attractor, including the
+    ///        initial ones, before its predecessors are examined. It may add vertices to R, after setting
+    ///        their region to p.
+    template <typename OnInsert>
+    void run(const structure_graph& G,
+             std::vector<std::size_t>& region,
+             std::size_t p,
+             std::size_t alpha,
+             std::vector<structure_graph::index_type>& R,
+             OnInsert on_insert)
+    {
+      for (std::size_t i = 0; i < R.size(); i++)
+      {
+        const structure_graph::index_type v = R[i];
+        on_insert(v, R);
+        for (structure_graph::index_type u: G.predecessors(v))
+        {
+          if (region[u] <= p)
+          {
+            continue; // u is outside the subgame, or it is already in the attractor
+          }
+          if (G.decoration(u) == alpha)
+          {
+            G.set_strategy(u, v);
+            region[u] = p;
+            R.push_back(u);
+            continue;
+          }
+          if (m_counter[u] == 0)
+          {
+            std::uint32_t count = 1;
+            for (structure_graph::index_type w: G.successors(u))
+            {
+              if (region[w] >= p)
+              {
+                count++;
+              }
+            }
+            m_counter[u] = count;
+            m_touched.push_back(u);
+          }
+          if (--m_counter[u] == 1)
+          {
+            region[u] = p;
+            R.push_back(u);
+          }
+        }
+      }
+
+      for (structure_graph::index_type u: m_touched)
+      {
+        m_counter[u] = 0;
+      }
+      m_touched.clear();
+    }
+
+    void run(const structure_graph& G,
+             std::vector<std::size_t>& region,
+             std::size_t p,
+             std::size_t alpha,
+             std::vector<structure_graph::index_type>& R)
+    {
+      run(G, region, p, alpha, R, [](structure_graph::index_type, std::vector<structure_graph::index_type>&) {});
+    }
+};
+
+/// \brief Removes the vertices of G without successors, which are won by the player that does not own them,
+///        together with their attractors. The removed vertices are added to W0 and W1.
+/// \details The vertices of G that are not removed form a game without dead ends, since the complement of an
+///          attractor has no dead ends if G has none.
+inline
+void remove_dead_ends(structure_graph& G, vertex_set& W0, vertex_set& W1, parallel_attractor_workspace& workspace)
+{
+  const std::size_t N = G.extent();
+  std::vector<structure_graph::index_type> dead_ends[2]; // NOLINT(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+  for (structure_graph::index_type u = 0; u < N; u++)
+  {
+    if (G.contains(u) && G.successors(u).empty())
+    {
+      const std::size_t owner = G.decoration(u) == structure_graph::d_conjunction ? 1 : 0;
+      dead_ends[1 - owner].push_back(u);
+    }
+  }
+  for (std::size_t alpha = 0; alpha < 2; alpha++)
+  {
+    if (dead_ends[alpha].empty())
+    {
+      continue;
+    }
+    vertex_set A = attr_default(G, vertex_set(N, dead_ends[alpha].begin(), dead_ends[alpha].end()), alpha, workspace);
+    G.exclude() |= A.include();
+    vertex_set& W = alpha == 0 ? W0 : W1;
+    W = set_union(W, A);
+  }
+}
+
+} // namespace mcrl2::pbes_system::detail
+
+#endif // MCRL2_PBES_DETAIL_PBESSOLVE_REGIONS_H
@@ -126,14 +126,33 @@ vertex_set attr_min_rank_generic(const StructureGraph& G, vertex_set A, std::siz
   return A;
 }
 
+// Computes attr_min_rank_generic(G, A, alpha, U, j, compare) with the threads of the workspace.
+template <typename StructureGraph, typename Compare>
+vertex_set attr_min_rank_generic(const StructureGraph& G, vertex_set A, std::size_t alpha, const vertex_set& U, std::size_t j, Compare compare, parallel_attractor_workspace& workspace)
+{
+  if (workspace.number_of_threads() == 1)
+  {
+    return attr_min_rank_generic(G, std::move(A), alpha, U, j, compare);
+  }
+
+  // Unranked vertices are only considered if they are not a predecessor of the initial set A.
+  auto is_candidate = [&](structure_graph::index_type u, bool initial)
+  {
+    return U.contains(u) && (compare(G.rank(u), j) || (!initial && G.rank(u) == data::undefined_index() && G.decoration(u) <= 1));
+  };
+  return attr_parallel_generic(G, std::move(A), alpha, global_strategy<StructureGraph>(G), workspace, is_candidate);
+}
+
 // calculation_steps is used to count how many steps are required to calculate a fatal_attractor.
+// The attractors are computed with the threads of the workspace.
 template <typename Compare>
 void fatal_attractors_generic(const simple_structure_graph& G,
                               std::array<vertex_set, 2>& S,
                               std::array<strategy_vector, 2>& tau,
                               std::size_t& calculation_steps,
                               std::size_t equation_count,
-                              Compare compare
+                              Compare compare,
+                              parallel_attractor_workspace& workspace
                              )
 {
   mCRL2log(log::debug) << "\n  === fatal attractors (equation " << equation_count << ") ===\n" << G << std::endl;
@@ -155,8 +174,8 @@ void fatal_attractors_generic(const simple_structure_graph& G,
   // compute U_j_map, such that U_j_map[j] = U_j
   std::map<std::size_t, vertex_set> U_j_map = compute_U_j_map(G, V);
 
-  S[0] = attr_default_with_tau(G, S[0], 0, tau);
-  S[1] = attr_default_with_tau(G, S[1], 1, tau);
+  S[0] = attr_default_with_tau(G, S[0], 0, tau, workspace);
+  S[1] = attr_default_with_tau(G, S[1], 1, tau, workspace);
 
   for (auto& p: U_j_map)
   {
@@ -168,16 +187,16 @@ void fatal_attractors_generic(const simple_structure_graph& G,
     U_j = set_minus(U_j, S[1 - alpha]);
     mCRL2log(log::debug) << "  U_" << std::to_string(j) << " = " << U_j << std::endl;
     vertex_set U = set_union(U_j, S[alpha]);
-    vertex_set X = detail::attr_min_rank_generic(G, U, alpha, V, j, compare);
-    vertex_set Y = set_minus(V, attr_default(G, set_minus(V, X), 1 - alpha));
+    vertex_set X = detail::attr_min_rank_generic(G, U, alpha, V, j, compare, workspace);
+    vertex_set Y = set_minus(V, attr_default(G, set_minus(V, X), 1 - alpha, workspace));
 
     while (X != Y)
     {
       calculation_steps++;
       mCRL2log(log::debug) << "  X = " << X << std::endl;
       mCRL2log(log::debug) << "  Y = " << Y << std::endl;
-      X = detail::attr_min_rank_generic(G, set_intersection(U, Y), alpha, V, j, compare);
-      Y = set_minus(Y, attr_default(G, set_minus(Y, X), 1 - alpha));
+      X = detail::attr_min_rank_generic(G, set_intersection(U, Y), alpha, V, j, compare, workspace);
+      Y = set_minus(Y, attr_default(G, set_minus(Y, X), 1 - alpha, workspace));
     }
     mCRL2log(log::debug) << "  X (final) = " << X << std::endl;
 
@@ -198,7 +217,7 @@ void fatal_attractors_generic(const simple_structure_graph& G,
         }
         else
         {
-          auto tau_v = G.find_vertex(v).strategy;
+          auto tau_v = G.strategy(v);
           local_strategy(tau, alpha).set_strategy(v, tau_v);
         }
       }
@@ -213,7 +232,7 @@ void fatal_attractors_generic(const simple_structure_graph& G,
       mCRL2log(log::debug) << "  insert vertex " << x << " in S" << alpha << std::endl;
     }
 
-    S[alpha] = attr_default_with_tau(G, S[alpha], alpha, tau);
+    S[alpha] = attr_default_with_tau(G, S[alpha], alpha, tau, workspace);
   }
   mCRL2log(log::debug) << "\n  === result of fatal attractors (equation " << equation_count << ") ===" << std::endl;
   mCRL2log(log::debug) << "  S0 = " << S[0] << std::endl;
@@ -228,10 +247,11 @@ void fatal_attractors(const simple_structure_graph& G,
                       std::array<vertex_set, 2>& S,
                       std::array<strategy_vector, 2>& tau,
                       std::size_t& calculation_steps,
-                      std::size_t equation_count
+                      std::size_t equation_count,
+                      parallel_attractor_workspace& workspace
                      )
 {
-  fatal_attractors_generic(G, S, tau, calculation_steps, equation_count, std::greater_equal<>());
+  fatal_attractors_generic(G, S, tau, calculation_steps, equation_count, std::greater_equal<>(), workspace);
 }
 
 // calculation_steps returns how many steps were needed to find the loops. 
@@ -240,10 +260,11 @@ void find_loops2(const simple_structure_graph& G,
                  std::array<vertex_set, 2>& S,
                  std::array<strategy_vector, 2>& tau,
                  std::size_t& calculation_steps,
-                 std::size_t equation_count
+                 std::size_t equation_count,
+                 parallel_attractor_workspace& workspace
 )
 {
-  fatal_attractors_generic(G, S, tau, calculation_steps, equation_count, std::equal_to<>());
+  fatal_attractors_generic(G, S, tau, calculation_steps, equation_count, std::equal_to<>(), workspace);
 }
 
 // Computes an attractor set, by extending A. Only predecessors in U are considered with a rank of at least j.
@@ -294,7 +315,8 @@ inline
 void fatal_attractors_original(const simple_structure_graph& G,
                                std::array<vertex_set, 2>& S,
                                std::array<strategy_vector, 2>& tau,
-                               std::size_t equation_count
+                               std::size_t equation_count,
+                               parallel_attractor_workspace& workspace
 )
 {
   mCRL2log(log::debug) << "\n  === fatal attractors original (equation " << equation_count << ") ===\n" << G << std::endl;
@@ -315,8 +337,8 @@ void fatal_attractors_original(const simple_structure_graph& G,
   // compute U_j_map, such that U_j_map[j] = U_j
   std::map<std::size_t, vertex_set> U_j_map = compute_U_j_map(G, V);
 
-  S[0] = attr_default_with_tau(G, S[0], 0, tau);
-  S[1] = attr_default_with_tau(G, S[1], 1, tau);
+  S[0] = attr_default_with_tau(G, S[0], 0, tau, workspace);
+  S[1] = attr_default_with_tau(G, S[1], 1, tau, workspace);
 
   for (auto& p: U_j_map)
   {
@@ -356,7 +378,7 @@ void fatal_attractors_original(const simple_structure_graph& G,
             }
             else
             {
-              auto tau_v = G.find_vertex(v).strategy;
+              auto tau_v = G.strategy(v);
               local_strategy(tau, alpha).set_strategy(v, tau_v);
             }
           }
@@ -370,7 +392,7 @@ void fatal_attractors_original(const simple_structure_graph& G,
           mCRL2log(log::debug) << "  insert vertex " << y << " in S" << alpha << std::endl;
         }
 
-        S[alpha] = attr_default_with_tau(G, S[alpha], alpha, tau);
+        S[alpha] = attr_default_with_tau(G, S[alpha], alpha, tau, workspace);
         break;
       }
       else
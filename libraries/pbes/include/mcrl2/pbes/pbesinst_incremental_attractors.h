@@ -0,0 +1,189 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/pbes/pbesinst_incremental_attractors.h
+/// \brief Maintains the attractors of partial solutions while a structure graph is generated.
+
+#ifndef MCRL2_PBES_PBESINST_INCREMENTAL_ATTRACTORS_H
+#define MCRL2_PBES_PBESINST_INCREMENTAL_ATTRACTORS_H
+
+#include <array>
+#include <cstdint>
+#include <deque>
+
+#include "mcrl2/pbes/pbessolve_vertex_set.h"
+
+namespace mcrl2::pbes_system::detail {
+
+/// \brief Extends the sets S[0] and S[1] of vertices that are won by player 0 and 1 to their attractors, while
+///        the structure graph grows.
+/// \details Instead of recomputing the attractors for the whole graph, only the predecessors of vertices that
+///          are added to S[alpha], and the vertices that get new successors, are examined. For every vertex u
+///          that is not owned by alpha a counter is kept with the number of successors of u that have not yet
+///          been propagated, such that u is added to S[alpha] once all its successors are in S[alpha].
+class incremental_attractors
+{
+  protected:
+    using index_type = structure_graph::index_type;
+
+    // m_counter[alpha][u] is one more than the number of successors of u that have not been propagated for alpha,
+    // or zero if it has not been initialised.
+    std::array<std::vector<std::uint32_t>, 2> m_counter;
+
+    // The vertices of S[alpha] of which the predecessors have been examined.
+    std::array<std::vector<bool>, 2> m_propagated;
+
+    // The vertices of S[alpha] of which the predecessors must be examined.
+    std::array<std::deque<index_type>, 2> m_todo;
+
+    // The vertices that have got new successors since the last update.
+    std::vector<index_type> m_changed;
+
+    void resize(std::size_t n)
+    {
+      for (std::size_t alpha = 0; alpha < 2; alpha++)
+      {
+        if (m_counter[alpha].size() < n)
+        {
+          m_counter[alpha].resize(n, 0);
+          m_propagated[alpha].resize(n, false);
+        }
+      }
+    }
+
+    template <typename StructureGraph>
+    std::uint32_t& counter(const StructureGraph& G, std::size_t alpha, index_type u)
+    {
+      std::uint32_t& result = m_counter[alpha][u];
+      if (result == 0)
+      {
+        result = 1;
+        for (index_type w: G.successors(u))
+        {
+          if (!m_propagated[alpha][w])
+          {
+            result++;
+          }
+        }
+      }
+      return result;
+    }
+
+    // Adds u to S[alpha], where v is a successor of u in S[alpha].
+    template <typename StructureGraph>
+    void insert(const StructureGraph& G,
+                std::array<vertex_set, 2>& S,
+                std::array<strategy_vector, 2>& tau,
+                std::size_t alpha,
+                index_type u,
+                index_type v)
+    {
+      S[alpha].insert(u);
+      tau[alpha][u] = v;
+      G.set_strategy(u, v);
+      m_todo[alpha].push_back(u);
+    }
+
+  public:
+    /// \brief Indicates that u has been added to S[alpha].
+    void inserted(std::size_t alpha, index_type u)
+    {
+      m_todo[alpha].push_back(u);
+    }
+
+    /// \brief Indicates that u has got new successors.
+    void changed(index_type u)
+    {
+      m_changed.push_back(u);
+    }
+
+    /// \brief Indicates that S[0] and S[1] may have been extended by another algorithm.
+    void synchronise(const std::array<vertex_set, 2>& S)
+    {
+      for (std::size_t alpha = 0; alpha < 2; alpha++)
+      {
+        for (index_type u: S[alpha].vertices())
+        {
+          if (u >= m_propagated[alpha].size() || !m_propagated[alpha][u])
+          {
+            m_todo[alpha].push_back(u);
+          }
+        }
+      }
+    }
+
+    /// \brief Extends S[0] and S[1] to their attractors in G, and sets the strategies of the added vertices.
+    /// \returns The number of vertices that have been added.
+    template <typename StructureGraph>
+    std::size_t update(const StructureGraph& G, std::array<vertex_set, 2>& S, std::array<strategy_vector, 2>& tau)
+    {
+      resize(G.extent());
+      const std::size_t size = S[0].size() + S[1].size();
+
+      // The changed vertices are compared with the successors that have already been propagated. The other
+      // successors will examine them when they are propagated.
+      for (index_type u: m_changed)
+      {
+        for (std::size_t alpha = 0; alpha < 2; alpha++)
+        {
+          m_counter[alpha][u] = 0;
+          if (S[0].contains(u) || S[1].contains(u) || G.successors(u).empty())
+          {
+            continue;
+          }
+          if (G.decoration(u) == alpha)
+          {
+            for (index_type w: G.successors(u))
+            {
+              if (m_propagated[alpha][w])
+              {
+                insert(G, S, tau, alpha, u, w);
+                break;
+              }
+            }
+          }
+          else if (counter(G, alpha, u) == 1)
+          {
+            insert(G, S, tau, alpha, u, G.successors(u).front());
+          }
+        }
+      }
+      m_changed.clear();
+
+      for (std::size_t alpha = 0; alpha < 2; alpha++)
+      {
+        std::deque<index_type>& todo = m_todo[alpha];
+        while (!todo.empty())
+        {
+          const index_type v = todo.front();
+          todo.pop_front();
+          if (m_propagated[alpha][v])
+          {
+            continue;
+          }
+          for (index_type u: G.predecessors(v))
+          {
+            if (S[0].contains(u) || S[1].contains(u))
+            {
+              continue;
+            }
+            if (G.decoration(u) == alpha || --counter(G, alpha, u) == 1)
+            {
+              insert(G, S, tau, alpha, u, v);
+            }
+          }
+          m_propagated[alpha][v] = true;
+        }
+      }
+      return S[0].size() + S[1].size() - size;
+    }
+};
+
+} // namespace mcrl2::pbes_system::detail
+
+#endif // MCRL2_PBES_PBESINST_INCREMENTAL_ATTRACTORS_H
@@ -111,7 +111,7 @@ struct rewrite_star_substitution
         todo.erase(todo.begin());
         done.insert(u);
 
-        if (mapping.count(G.find_vertex(u).formula()) != 0)
+        if (mapping.count(G.formula(u)) != 0)
         {
           // If this vertex is won by player even and is decorated with `true`,
           // then it stems from an equation (\nu X = true), which originally was (\nu X = X) before the default simplification (analogous for player odd).
@@ -120,7 +120,7 @@ struct rewrite_star_substitution
               || (alpha && utilities::is_odd(G.rank(u)) && G.decoration(u) == structure_graph::d_false)))
           {
             // We act as if the self-dependency is still there.
-            Ys.insert(G.find_vertex(u).formula());
+            Ys.insert(G.formula(u));
           }
           // This vertex is won by alpha
           if (G.strategy(u) != undefined_vertex()
@@ -137,10 +137,10 @@ struct rewrite_star_substitution
                 todo.insert(v);
               }
             }
-            else if (mapping.count(G.find_vertex(v).formula()) != 0)
+            else if (mapping.count(G.formula(v)) != 0)
             {
               // Insert the outgoing edge, but do not add it to the todo set to stop exploring this vertex.
-              Ys.insert(G.find_vertex(v).formula());
+              Ys.insert(G.formula(v));
             }
           }
           else
@@ -156,10 +156,10 @@ struct rewrite_star_substitution
                   todo.insert(v);
                 }
               }
-              else if (mapping.count(G.find_vertex(v).formula()) != 0)
+              else if (mapping.count(G.formula(v)) != 0)
               {
                 // Insert the outgoing edge, but do not add it to the todo set to stop exploring this vertex.
-                Ys.insert(G.find_vertex(v).formula());
+                Ys.insert(G.formula(v));
               }
             }
           }
@@ -177,10 +177,10 @@ struct rewrite_star_substitution
                 todo.insert(v);
               }
             }
-            else if (mapping.count(G.find_vertex(v).formula()) != 0)
+            else if (mapping.count(G.formula(v)) != 0)
             {
               // Insert the outgoing edge, but do not add it to the todo set to stop exploring this vertex.
-              Ys.insert(G.find_vertex(v).formula());
+              Ys.insert(G.formula(v));
             }
           }
         }
@@ -29,7 +29,8 @@ void partial_solve(structure_graph& G,
                    std::array<vertex_set, 2>& S,
                    std::array<strategy_vector, 2>& tau,
                    std::size_t equation_count,
-                   const detail::structure_graph_builder& graph_builder
+                   const detail::structure_graph_builder& graph_builder,
+                   parallel_attractor_workspace& workspace
                   )
 {
   mCRL2log(log::debug) << "\n  === partial solve (equation " << equation_count << ") ===\n" << G << std::endl;
@@ -43,9 +44,9 @@ void partial_solve(structure_graph& G,
   S[1].truncate(N);
 
   mCRL2log(log::debug) << "  computing S0 = attr_default_with_tau(G, S0, 0, tau0)" << std::endl;
-  S[0] = attr_default_with_tau(G, S[0], 0, tau);
+  S[0] = attr_default_with_tau(G, S[0], 0, tau, workspace);
   mCRL2log(log::debug) << "  computing S1 = attr_default_with_tau(G, S1, 1, tau1)" << std::endl;
-  S[1] = attr_default_with_tau(G, S[1], 1, tau);
+  S[1] = attr_default_with_tau(G, S[1], 1, tau, workspace);
 
   // Si_todo := Si U todo
   std::array<vertex_set, 2> S_todo = S;
@@ -59,10 +60,10 @@ void partial_solve(structure_graph& G,
 
   bool check_strategy = false;
   bool use_toms_optimization = false;
-  solve_structure_graph_algorithm algorithm(check_strategy, use_toms_optimization);
+  solve_structure_graph_algorithm algorithm(check_strategy, use_toms_optimization, workspace);
 
   vertex_set W[2] = { vertex_set(N), vertex_set(N) }; // NOLINT(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
-  std::tie(W[0], W[1]) = algorithm.solve_recursive(G, set_union(S[1], attr_default_no_strategy(G, S_todo[0], 0)));
+  std::tie(W[0], W[1]) = algorithm.solve_recursive(G, set_union(S[1], attr_default_no_strategy(G, S_todo[0], 0, workspace)));
   for (structure_graph::index_type v: W[1].vertices())
   {
     if (S[1].contains(v))
@@ -75,7 +76,7 @@ void partial_solve(structure_graph& G,
       local_strategy(tau, 1).set_strategy(v, tau_v);
     }
   }
-  std::tie(W[0], W[1]) = algorithm.solve_recursive(G, set_union(S[0], attr_default_no_strategy(G, S_todo[1], 1)));
+  std::tie(W[0], W[1]) = algorithm.solve_recursive(G, set_union(S[0], attr_default_no_strategy(G, S_todo[1], 1, workspace)));
   for (structure_graph::index_type v: W[0].vertices())
   {
     if (S[0].contains(v))
@@ -17,6 +17,7 @@
 #include "mcrl2/atermpp/standard_containers/vector.h"
 #include "mcrl2/pbes/pbesinst_fatal_attractors.h"
 #include "mcrl2/pbes/pbesinst_find_loops.h"
+#include "mcrl2/pbes/pbesinst_incremental_attractors.h"
 #include "mcrl2/pbes/pbesinst_partial_solve.h"
 #include "mcrl2/pbes/pbesinst_structure_graph.h"
 #include "mcrl2/pbes/pbessolve_options.h"
@@ -28,27 +29,6 @@ namespace mcrl2::pbes_system {
 
 namespace detail {
 
-class computation_guard
-{
-  protected:
-     std::size_t m_count = 64;
-
-  public:
-    explicit computation_guard(std::size_t initial_count = 64)
-      : m_count(initial_count)
-    {}
-
-    bool operator()(std::size_t count)
-    {
-      bool result = count >= m_count;
-      while (m_count <= count)
-      {
-        m_count *= 2;
-      }
-      return result;
-    }
-};
-
 class periodic_guard
 {
   protected:
@@ -88,12 +68,17 @@ class pbesinst_structure_graph_algorithm2: public pbesinst_structure_graph_algor
   protected:
     std::array<vertex_set, 2> S;
     std::array<strategy_vector, 2> tau;
-    std::array<detail::computation_guard, 2> S_guard;
+
+    // extends S[0] and S[1] to their attractors after every equation, if the optimization asks for attractors
+    detail::incremental_attractors m_incremental_attractors;
 
     atermpp::vector<pbes_expression> b; // to store the result of the Rplus computation
     detail::periodic_guard on_the_fly_solve_trigger;
     detail::periodic_guard reset_guard;
 
+    // used by the attractor computations of the partial solvers, with the threads of the instantiation
+    parallel_attractor_workspace m_attractor_workspace;
+
     template<typename T>
     pbes_expression expr(const T& x) const
     {
@@ -385,6 +370,27 @@ class pbesinst_structure_graph_algorithm2: public pbesinst_structure_graph_algor
       return Rplus_traverser::stack_element(f.top());  // Protection is added explicitly. 
     }
 
+    // Returns true if S[0] and S[1] are extended to their attractors after every equation.
+    bool maintains_attractors() const
+    {
+      return m_options.optimization >= partial_solve_strategy::propagate_solved_equations_using_attractor;
+    }
+
+    // Extends S[0] and S[1] to their attractors, which only examines the part of the graph that has changed.
+    void update_attractors()
+    {
+      simple_structure_graph G(m_graph_builder.vertices());
+      m_incremental_attractors.update(G, S, tau);
+    }
+
+    // Updates the attractors after S[0] and S[1] have been extended by one of the partial solvers.
+    void synchronise_attractors()
+    {
+      m_incremental_attractors.synchronise(S);
+      update_attractors();
+      assert(strategies_are_set_in_solved_nodes());
+    }
+
     bool solution_found(const propositional_variable_instantiation& init) const override
     {
       const structure_graph::index_type u = m_graph_builder.find_vertex(init);
@@ -569,7 +575,7 @@ class pbesinst_structure_graph_algorithm2: public pbesinst_structure_graph_algor
       std::optional<data::rewriter> rewriter = std::nullopt
     )
       : pbesinst_structure_graph_algorithm(options, p, G, rewriter),
-        b(options.number_of_threads+1), on_the_fly_solve_trigger(2)
+        b(options.number_of_threads+1), on_the_fly_solve_trigger(2), m_attractor_workspace(options.number_of_threads)
     {}
 
     // Optimization 2 is implemented by overriding the function rewrite_psi.
@@ -602,6 +608,7 @@ class pbesinst_structure_graph_algorithm2: public pbesinst_structure_graph_algor
                             const pbes_expression& psi, std::size_t k
                            ) override
     {
+      const std::size_t extent = m_graph_builder.extent();
       super::on_report_equation(thread_index, X, psi, k);
 
       // The structure graph has just been extended, so S[0] and S[1] need to be resized.
@@ -617,6 +624,20 @@ class pbesinst_structure_graph_algorithm2: public pbesinst_structure_graph_algor
       {
         S[1].insert(u);
       }
+
+      if (maintains_attractors())
+      {
+        // The vertex of X and the vertices that have been created for psi have got new successors.
+        m_incremental_attractors.changed(u);
+        for (structure_graph::index_type v = extent; v < m_graph_builder.extent(); v++)
+        {
+          m_incremental_attractors.changed(v);
+        }
+        if (S[0].contains(u) || S[1].contains(u))
+        {
+          m_incremental_attractors.inserted(S[0].contains(u) ? 0 : 1, u);
+        }
+      }
     }
 
     void report_found_solutions(stopwatch& timer)
@@ -630,30 +651,23 @@ class pbesinst_structure_graph_algorithm2: public pbesinst_structure_graph_algor
       using utilities::detail::contains;
       stopwatch timer;
 
-      if (m_options.optimization == partial_solve_strategy::propagate_solved_equations_using_attractor)
+      // The attractors are updated after every equation, such that the initial vertex is found to be solved
+      // as soon as possible. The partial solvers below are applied periodically, as they examine the whole graph.
+      if (maintains_attractors())
       {
-        if (S_guard[0](S[0].size()))
-        {
-          simple_structure_graph G(m_graph_builder.vertices());
-          S[0] = attr_default_with_tau(G, S[0], 0, tau);
-        }
-        if (S_guard[1](S[1].size()))
-        {
-          simple_structure_graph G(m_graph_builder.vertices());
-          S[1] = attr_default_with_tau(G, S[1], 1, tau);
-        }
-        assert(strategies_are_set_in_solved_nodes());
+        update_attractors();
       }
-      else if (m_options.optimization == partial_solve_strategy::detect_winning_loops_using_fatal_attractor && 
+
+      if (m_options.optimization == partial_solve_strategy::detect_winning_loops_using_fatal_attractor && 
                (m_options.aggressive || on_the_fly_solve_trigger.is_expired()))
       {
         mCRL2log(log::verbose) << "Start partial solving.\n"; 
 
         std::size_t calculation_steps=0;  // Count how many calculation steps it takes to find loops, and retry this after on_discovered_elements have been called that many times. 
         simple_structure_graph G(m_graph_builder.vertices());
-        detail::find_loops2(G, S, tau, calculation_steps, m_iteration_count); // modifies S[0] and S[1]
+        detail::find_loops2(G, S, tau, calculation_steps, m_iteration_count, m_attractor_workspace); // modifies S[0] and S[1]
         on_the_fly_solve_trigger.set_expiration_steps(m_options.prune_and_solve_frequently?calculation_steps/1000:calculation_steps/10);
-        assert(strategies_are_set_in_solved_nodes());
+        synchronise_attractors();
         report_found_solutions(timer);
         prune_todo_list_conditional(init, todo, calculation_steps);
       }
@@ -668,20 +682,21 @@ class pbesinst_structure_graph_algorithm2: public pbesinst_structure_graph_algor
         simple_structure_graph G(m_graph_builder.vertices());
         if (m_options.optimization == partial_solve_strategy::solve_subgames_using_fatal_attractor_local)
         {
-          detail::fatal_attractors(G, S, tau, calculation_steps, m_iteration_count); // modifies S[0] and S[1]
+          detail::fatal_attractors(G, S, tau, calculation_steps, m_iteration_count, m_attractor_workspace); // modifies S[0] and S[1]
           assert(strategies_are_set_in_solved_nodes());
         }
         else if (m_options.optimization == partial_solve_strategy::solve_subgames_using_fatal_attractor_original)
         {
-          detail::fatal_attractors_original(G, S, tau, m_iteration_count); // modifies S[0] and S[1]
+          detail::fatal_attractors_original(G, S, tau, m_iteration_count, m_attractor_workspace); // modifies S[0] and S[1]
           assert(strategies_are_set_in_solved_nodes());
         }
         else if (m_options.optimization == partial_solve_strategy::solve_subgames_using_solver)
         {
           m_graph_builder.finalize();
-          detail::partial_solve(m_graph_builder.m_graph, todo, S, tau, m_iteration_count, m_graph_builder); // modifies S[0] and S[1]
+          detail::partial_solve(m_graph_builder.m_graph, todo, S, tau, m_iteration_count, m_graph_builder, m_attractor_workspace); // modifies S[0] and S[1]
           assert(strategies_are_set_in_solved_nodes());
         }
+        synchronise_attractors();
         on_the_fly_solve_trigger.set_expiration_steps(m_options.prune_and_solve_frequently?calculation_steps/1000:calculation_steps/10);
         report_found_solutions(timer);
         prune_todo_list_conditional(init, todo, calculation_steps);
@@ -696,7 +711,7 @@ class pbesinst_structure_graph_algorithm2: public pbesinst_structure_graph_algor
         simple_structure_graph G(m_graph_builder.vertices());
         detail::find_loops(G, discovered, todo, S, tau, m_iteration_count, m_graph_builder); // modifies S[0] and S[1]
         on_the_fly_solve_trigger.set_expiration_steps(m_options.prune_and_solve_frequently?calculation_steps/1000:calculation_steps/10);
-        assert(strategies_are_set_in_solved_nodes());
+        synchronise_attractors();
         on_the_fly_solve_trigger.set_expiration_steps(m_options.prune_and_solve_frequently?calculation_steps/1000:calculation_steps/10);
         prune_todo_list_conditional(init, todo, calculation_steps);
       }
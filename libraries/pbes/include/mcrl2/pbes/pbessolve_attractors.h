@@ -12,7 +12,10 @@
 #ifndef MCRL2_PBES_PBESSOLVE_ATTRACTORS_H
 #define MCRL2_PBES_PBESSOLVE_ATTRACTORS_H
 
+#include <atomic>
+#include <cstdint>
 #include "mcrl2/pbes/pbessolve_vertex_set.h"
+#include "mcrl2/utilities/parallel_for.h"
 
 namespace mcrl2::pbes_system {
 
@@ -40,7 +43,7 @@ struct global_strategy
       mCRL2log(log::debug) << "Error: undefined strategy for node " << u << std::endl;
     }
     mCRL2log(log::debug) << "  set tau[" << u << "] = " << v << std::endl;
-    G.find_vertex(u).strategy = v;
+    G.set_strategy(u, v);
   }
 };
 
@@ -102,7 +105,7 @@ template <typename StructureGraph>
 deque_vertex_set exclusive_predecessors(const StructureGraph& G, const vertex_set& A)
 {
   // put all predecessors of elements in A in todo
-  deque_vertex_set todo(G.all_vertices().size());
+  deque_vertex_set todo(G.extent());
   for (auto u: A.vertices())
   {
     for (auto v: G.predecessors(u))
@@ -182,6 +185,227 @@ vertex_set attr_default_with_tau(const StructureGraph& G, vertex_set A, std::siz
   return attr_default_generic(G, A, alpha, global_local_strategy<StructureGraph>(G, tau, alpha));
 }
 
+
+// Memory and threads that are shared by the parallel attractor computations with the same number of threads.
+// In between two computations all counters and bits are zero, such that a computation only needs
+// to reset the entries that it has used.
+class parallel_attractor_workspace
+{
+  protected:
+    using index_type = structure_graph::index_type;
+
+    // The threads that compute the attractors. They are also used for other parallel loops of the solver.
+    utilities::thread_pool m_thread_pool;
+
+    // m_counters[u] is one more than the number of successors of u that are not yet in the attractor, or zero
+    // if it has not been initialised.
+    std::vector<std::atomic<std::uint32_t>> m_counters;
+
+    // The vertices that are added to the attractor in the current round.
+    std::vector<std::atomic<std::uint64_t>> m_claimed;
+
+    // Per thread the vertices of which the counter has been initialised.
+    std::vector<std::vector<index_type>> m_touched;
+
+    // Per thread the vertices (u, v) that are added in the current round, where v is the strategy of u.
+    std::vector<std::vector<std::pair<index_type, index_type>>> m_next;
+
+  public:
+    // Frontiers with fewer vertices are handled by a single thread.
+    static constexpr std::size_t minimal_parallel_frontier = 4096;
+
+    explicit parallel_attractor_workspace(std::size_t number_of_threads)
+      : m_thread_pool(number_of_threads),
+        m_touched(number_of_threads),
+        m_next(number_of_threads)
+    {
+      assert(number_of_threads > 0);
+    }
+
+    std::size_t number_of_threads() const
+    {
+      return m_thread_pool.number_of_threads();
+    }
+
+    utilities::thread_pool& thread_pool()
+    {
+      return m_thread_pool;
+    }
+
+    // Makes sure that graphs with n vertices can be handled
+    void resize(std::size_t n)
+    {
+      if (m_counters.size() < n)
+      {
+        m_counters = std::vector<std::atomic<std::uint32_t>>(n);
+        m_claimed = std::vector<std::atomic<std::uint64_t>>((n + 63) / 64);
+      }
+    }
+
+    // Decrements the number of successors of u that are not in the attractor, and returns true if it becomes zero.
+    template <typename StructureGraph>
+    bool decrement(const StructureGraph& G, index_type u, std::size_t thread_index)
+    {
+      std::atomic<std::uint32_t>& counter = m_counters[u];
+      if (counter.load(std::memory_order_relaxed) == 0)
+      {
+        std::uint32_t successor_count = 0;
+        for (auto v: G.successors(u))
+        {
+          static_cast<void>(v);
+          successor_count++;
+        }
+        std::uint32_t expected = 0;
+        if (counter.compare_exchange_strong(expected, successor_count + 1, std::memory_order_relaxed))
+        {
+          m_touched[thread_index].push_back(u);
+        }
+      }
+      return counter.fetch_sub(1, std::memory_order_relaxed) == 2;
+    }
+
+    // Adds u to the attractor with strategy v, unless it was already added in the current round.
+    void claim(index_type u, index_type v, std::size_t thread_index)
+    {
+      const std::uint64_t bit = std::uint64_t(1) << (u % 64);
+      if ((m_claimed[u / 64].fetch_or(bit, std::memory_order_relaxed) & bit) == 0)
+      {
+        m_next[thread_index].emplace_back(u, v);
+      }
+    }
+
+    // Calls f(u, v) for the vertices u that were added in the current round, with strategy v.
+    template <typename Function>
+    void finish_round(Function f)
+    {
+      for (auto& next: m_next)
+      {
+        for (const auto& [u, v]: next)
+        {
+          m_claimed[u / 64].store(0, std::memory_order_relaxed);
+          f(u, v);
+        }
+        next.clear();
+      }
+    }
+
+    void reset_counters()
+    {
+      for (auto& touched: m_touched)
+      {
+        for (index_type u: touched)
+        {
+          m_counters[u].store(0, std::memory_order_relaxed);
+        }
+        touched.clear();
+      }
+    }
+};
+
+// Computes an attractor set, by extending A, using the threads of the workspace.
+// alpha = 0: disjunctive
+// alpha = 1: conjunctive
+// The attractor is computed frontier by frontier. A predecessor u of a vertex in the frontier is attracted if
+// it has decoration alpha, or if the counter of its successors that are not yet in the attractor becomes zero.
+// It is only added if is_candidate(u, initial) holds, where initial is true for the first frontier, i.e. A.
+// The vertices of a frontier are handled concurrently, and the strategy of an attracted vertex is a vertex in the
+// frontier. Since the frontiers are handled in order, the result is the same as the one of attr_default_generic.
+// StructureGraph is either structure_graph or simple_structure_graph
+// Strategy is either no_strategy, global_strategy, local_strategy or global_local_strategy
+template <typename StructureGraph, typename Strategy, typename Candidate>
+vertex_set attr_parallel_generic(const StructureGraph& G,
+                                 vertex_set A,
+                                 std::size_t alpha,
+                                 Strategy tau,
+                                 parallel_attractor_workspace& workspace,
+                                 Candidate is_candidate
+                                )
+{
+  using index_type = structure_graph::index_type;
+  workspace.resize(G.extent());
+
+  std::vector<index_type> frontier = A.vertices();
+  bool initial = true;
+  while (!frontier.empty())
+  {
+    auto attract = [&](std::size_t thread_index, std::size_t begin, std::size_t end)
+    {
+      for (std::size_t i = begin; i < end; i++)
+      {
+        const index_type v = frontier[i];
+        for (auto u: G.predecessors(v))
+        {
+          // A is not changed until the end of the round.
+          if (A.contains(u))
+          {
+            continue;
+          }
+          if ((G.decoration(u) == alpha || workspace.decrement(G, u, thread_index)) && is_candidate(u, initial))
+          {
+            workspace.claim(u, v, thread_index);
+          }
+        }
+      }
+    };
+    if (frontier.size() < parallel_attractor_workspace::minimal_parallel_frontier)
+    {
+      attract(0, 0, frontier.size());
+    }
+    else
+    {
+      workspace.thread_pool().parallel_for_ranges(frontier.size(), attract);
+    }
+
+    frontier.clear();
+    workspace.finish_round([&](index_type u, index_type v)
+      {
+        tau.set_strategy(u, v);
+        A.insert(u);
+        frontier.push_back(u);
+      });
+    initial = false;
+  }
+
+  workspace.reset_counters();
+  return A;
+}
+
+// Computes attr_default(G, A, alpha) with the threads of the workspace.
+template <typename StructureGraph>
+vertex_set attr_default(const StructureGraph& G, vertex_set A, std::size_t alpha, parallel_attractor_workspace& workspace)
+{
+  if (workspace.number_of_threads() == 1)
+  {
+    return attr_default(G, std::move(A), alpha);
+  }
+  return attr_parallel_generic(G, std::move(A), alpha, global_strategy<StructureGraph>(G), workspace,
+                               [](structure_graph::index_type, bool) { return true; });
+}
+
+// Computes attr_default_no_strategy(G, A, alpha) with the threads of the workspace.
+template <typename StructureGraph>
+vertex_set attr_default_no_strategy(const StructureGraph& G, vertex_set A, std::size_t alpha, parallel_attractor_workspace& workspace)
+{
+  if (workspace.number_of_threads() == 1)
+  {
+    return attr_default_no_strategy(G, std::move(A), alpha);
+  }
+  return attr_parallel_generic(G, std::move(A), alpha, no_strategy(), workspace,
+                               [](structure_graph::index_type, bool) { return true; });
+}
+
+// Computes attr_default_with_tau(G, A, alpha, tau) with the threads of the workspace.
+template <typename StructureGraph>
+vertex_set attr_default_with_tau(const StructureGraph& G, vertex_set A, std::size_t alpha, std::array<strategy_vector, 2>& tau, parallel_attractor_workspace& workspace)
+{
+  if (workspace.number_of_threads() == 1)
+  {
+    return attr_default_with_tau(G, std::move(A), alpha, tau);
+  }
+  return attr_parallel_generic(G, std::move(A), alpha, global_local_strategy<StructureGraph>(G, tau, alpha), workspace,
+                               [](structure_graph::index_type, bool) { return true; });
+}
+
 } // namespace mcrl2::pbes_system
 
 
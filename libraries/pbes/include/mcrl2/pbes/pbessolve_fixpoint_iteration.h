@@ -0,0 +1,114 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/pbes/pbessolve_fixpoint_iteration.h
+/// \brief Solves a structure graph using distraction fixpoint iteration.
+
+#ifndef MCRL2_PBES_PBESSOLVE_FIXPOINT_ITERATION_H
+#define MCRL2_PBES_PBESSOLVE_FIXPOINT_ITERATION_H
+
+#include "mcrl2/pbes/detail/pbessolve_regions.h"
+#include "mcrl2/pbes/pbessolve_vertex_set.h"
+
+namespace mcrl2::pbes_system {
+
+/// \brief Solves a structure graph using the distraction fixpoint iteration algorithm of Van Dijk and Rubbens.
+/// \details Every vertex is tentatively won by the parity of its priority, unless it is a distraction, in which
+///          case it is won by the other player. A vertex is a distraction if its owner cannot win it in one step
+///          given the current values of its successors. Distractions are computed from the least important priority
+///          upwards, and whenever a new distraction is found, the distractions of the less important priorities
+///          are reset. At the fixpoint the values are the winners of the vertices. No strategies are computed.
+class fixpoint_iteration_solver
+{
+  protected:
+    using index_type = structure_graph::index_type;
+
+    const structure_graph& G;
+    detail::structure_graph_priorities m_priorities;
+    std::vector<bool> m_distraction;
+
+    // The player that currently wins vertex u.
+    std::size_t value(index_type u) const
+    {
+      return m_priorities.parity(m_priorities.priority(u)) ^ (m_distraction[u] ? 1 : 0);
+    }
+
+    // The player that wins vertex u in one step, according to the current values of its successors.
+    std::size_t onestep(index_type u) const
+    {
+      const std::size_t owner = G.decoration(u) == structure_graph::d_conjunction ? 1 : 0;
+      for (index_type v: G.successors(u))
+      {
+        if (value(v) == owner)
+        {
+          return owner;
+        }
+      }
+      return 1 - owner;
+    }
+
+  public:
+    explicit fixpoint_iteration_solver(const structure_graph& G_)
+      : G(G_),
+        m_priorities(G_),
+        m_distraction(G_.extent(), false)
+    {}
+
+    // pre: G does not contain nodes with decoration true or false.
+    std::pair<vertex_set, vertex_set> solve()
+    {
+      std::size_t iterations = 0;
+      std::size_t p = m_priorities.size();
+      while (p > 0)
+      {
+        p--;
+        iterations++;
+        const std::size_t alpha = m_priorities.parity(p);
+        std::vector<index_type> distractions;
+        for (index_type u: m_priorities.vertices(p))
+        {
+          if (!m_distraction[u] && onestep(u) != alpha)
+          {
+            distractions.push_back(u);
+          }
+        }
+        if (distractions.empty())
+        {
+          continue;
+        }
+        for (index_type u: distractions)
+        {
+          m_distraction[u] = true;
+        }
+        for (std::size_t q = p + 1; q < m_priorities.size(); q++)
+        {
+          for (index_type u: m_priorities.vertices(q))
+          {
+            m_distraction[u] = false;
+          }
+        }
+        p = m_priorities.size();
+      }
+      mCRL2log(log::verbose) << "distraction fixpoint iteration took " << iterations << " iterations" << std::endl;
+
+      const std::size_t N = G.extent();
+      vertex_set W[2] = { vertex_set(N), vertex_set(N) }; // NOLINT(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+      for (index_type u = 0; u < N; u++)
+      {
+        if (G.contains(u))
+        {
+          W[value(u)].insert(u);
+        }
+      }
+      return { W[0], W[1] };
+    }
+};
+
+} // namespace mcrl2::pbes_system
+
+#endif // MCRL2_PBES_PBESSOLVE_FIXPOINT_ITERATION_H
@@ -16,6 +16,7 @@
 #include "mcrl2/core/detail/print_utility.h"
 #include "mcrl2/data/rewrite_strategy.h"
 #include "mcrl2/pbes/search_strategy.h"
+#include "mcrl2/pbes/structure_graph_solver.h"
 
 namespace mcrl2::pbes_system {
 
@@ -76,6 +77,12 @@ struct pbessolve_options
   // for doing a consistency check on the computed strategy
   bool check_strategy = false;
 
+  // if true, solve the strongly connected components of the structure graph bottom-up
+  bool scc_decomposition = false;
+
+  // the algorithm that is used to solve the structure graph
+  structure_graph_solver solver = structure_graph_solver::zielonka;
+
   std::size_t number_of_threads = 1;
 };
 
@@ -90,6 +97,8 @@ std::ostream& operator<<(std::ostream& out, const pbessolve_options& options)
   out << "optimization = " << static_cast<int>(options.optimization) << std::endl;
   out << "frequent = " << std::boolalpha << options.prune_and_solve_frequently << std::endl;
   out << "check-strategy = " << std::boolalpha << options.check_strategy << std::endl;
+  out << "scc-decomposition = " << std::boolalpha << options.scc_decomposition << std::endl;
+  out << "solver = " << options.solver << std::endl;
   out << "threads = " << options.number_of_threads << std::endl;
   return out;
 }
@@ -0,0 +1,243 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/pbes/pbessolve_priority_promotion.h
+/// \brief Solves a structure graph using priority promotion.
+
+#ifndef MCRL2_PBES_PBESSOLVE_PRIORITY_PROMOTION_H
+#define MCRL2_PBES_PBESSOLVE_PRIORITY_PROMOTION_H
+
+#include "mcrl2/pbes/detail/pbessolve_regions.h"
+#include "mcrl2/pbes/pbessolve_attractors.h"
+
+namespace mcrl2::pbes_system {
+
+/// \brief Solves a structure graph using the priority promotion algorithm of Benerecetti, Dell'Erba and Mogavero.
+/// \details A dominion is searched for by computing regions from the most important priority downwards. The region
+///          of priority p is the attractor of the vertices with region p in the subgame of the vertices with a
+///          less important region. If the opponent cannot leave a region within this subgame, the region is
+///          promoted to the least important region to which the opponent can escape, and the less important
+///          regions are reset. A region from which the opponent cannot escape at all is a dominion, which is
+///          removed from the game together with its attractor.
+class priority_promotion_solver
+{
+  protected:
+    using index_type = structure_graph::index_type;
+
+    structure_graph& G;
+    parallel_attractor_workspace& m_attractor_workspace;
+    detail::structure_graph_priorities m_priorities;
+    detail::region_attractor m_attractor;
+
+    // The region of each vertex, which is only meaningful for vertices that are not excluded.
+    std::vector<std::size_t> m_region;
+
+    // The vertices that were added to each region, apart from the vertices of that priority. It may contain
+    // vertices that are no longer in the region.
+    std::vector<std::vector<index_type>> m_members;
+
+    // Returns the vertices with region p.
+    std::vector<index_type> region_vertices(std::size_t p) const
+    {
+      std::vector<index_type> result;
+      for (index_type u: m_priorities.vertices(p))
+      {
+        if (G.contains(u) && m_region[u] == p)
+        {
+          result.push_back(u);
+        }
+      }
+      for (index_type u: m_members[p])
+      {
+        if (G.contains(u) && m_region[u] == p)
+        {
+          result.push_back(u);
+        }
+      }
+      return result;
+    }
+
+    // Resets the vertices with a region that is less important than q to their own priority.
+    void reset_regions(std::size_t q)
+    {
+      for (std::size_t p = q + 1; p < m_priorities.size(); p++)
+      {
+        for (index_type u: m_members[p])
+        {
+          if (m_region[u] > q)
+          {
+            m_region[u] = m_priorities.priority(u);
+          }
+        }
+        m_members[p].clear();
+        for (index_type u: m_priorities.vertices(p))
+        {
+          if (m_region[u] > q)
+          {
+            m_region[u] = p;
+          }
+        }
+      }
+    }
+
+    // Resets the vertices that are still in the game to their own priority.
+    void reset_all_regions()
+    {
+      for (std::size_t p = 0; p < m_priorities.size(); p++)
+      {
+        m_members[p].clear();
+        for (index_type u: m_priorities.vertices(p))
+        {
+          m_region[u] = p;
+        }
+      }
+    }
+
+    // Returns the first priority from p onwards with a nonempty region, or m_priorities.size() if it does not exist.
+    std::size_t first_region(std::size_t p) const
+    {
+      for (; p < m_priorities.size(); p++)
+      {
+        for (index_type u: m_priorities.vertices(p))
+        {
+          if (G.contains(u) && m_region[u] == p)
+          {
+            return p;
+          }
+        }
+        for (index_type u: m_members[p])
+        {
+          if (G.contains(u) && m_region[u] == p)
+          {
+            return p;
+          }
+        }
+      }
+      return p;
+    }
+
+    // Returns a dominion and the player that wins it. The regions are reset beforehand.
+    std::pair<std::vector<index_type>, std::size_t> find_dominion()
+    {
+      reset_all_regions();
+      std::size_t p = first_region(0);
+      while (true)
+      {
+        const std::size_t alpha = m_priorities.parity(p);
+        std::vector<index_type> R = region_vertices(p);
+        const std::size_t initial_size = R.size();
+        m_attractor.run(G, m_region, p, alpha, R);
+        for (std::size_t i = initial_size; i < R.size(); i++)
+        {
+          m_members[p].push_back(R[i]);
+        }
+
+        // Check whether the opponent can leave the region within the subgame, and collect the regions to which
+        // the opponent can escape. The vertices of alpha get a strategy that stays in the region. The value
+        // escape == p means that there is no escape.
+        bool closed = true;
+        std::size_t escape = p;
+        for (index_type u: R)
+        {
+          if (G.decoration(u) == alpha)
+          {
+            const index_type v = G.strategy(u);
+            if (v == undefined_vertex() || !G.contains(v) || m_region[v] != p)
+            {
+              const auto& successors = G.successors(u);
+              auto i = std::find_if(successors.begin(), successors.end(), [&](index_type w) { return m_region[w] == p; });
+              if (i == successors.end())
+              {
+                closed = false;
+                break;
+              }
+              G.set_strategy(u, *i);
+            }
+            continue;
+          }
+          for (index_type v: G.successors(u))
+          {
+            if (m_region[v] > p)
+            {
+              closed = false;
+              break;
+            }
+            if (m_region[v] < p && (escape == p || m_region[v] > escape))
+            {
+              escape = m_region[v];
+            }
+          }
+          if (!closed)
+          {
+            break;
+          }
+        }
+
+        if (!closed)
+        {
+          p = first_region(p + 1);
+          if (p == m_priorities.size())
+          {
+            throw mcrl2::runtime_error("Priority promotion failed to find a dominion.");
+          }
+        }
+        else if (escape == p)
+        {
+          return { R, alpha };
+        }
+        else
+        {
+          mCRL2log(log::trace) << "promote region " << p << " to " << escape << std::endl;
+          for (index_type u: R)
+          {
+            m_region[u] = escape;
+            m_members[escape].push_back(u);
+          }
+          reset_regions(escape);
+          p = escape;
+        }
+      }
+    }
+
+  public:
+    priority_promotion_solver(structure_graph& G_, parallel_attractor_workspace& workspace)
+      : G(G_),
+        m_attractor_workspace(workspace),
+        m_priorities(G_),
+        m_attractor(G_.extent()),
+        m_region(G_.extent(), 0),
+        m_members(m_priorities.size())
+    {}
+
+    // pre: G does not contain nodes with decoration true or false.
+    std::pair<vertex_set, vertex_set> solve()
+    {
+      const std::size_t N = G.extent();
+      vertex_set W[2] = { vertex_set(N), vertex_set(N) }; // NOLINT(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+
+      // The solved vertices are excluded from G, which is restored at the end.
+      boost::dynamic_bitset<> original_exclude = G.exclude();
+      detail::remove_dead_ends(G, W[0], W[1], m_attractor_workspace);
+      m_priorities.remove_excluded(G);
+      while (!G.is_empty())
+      {
+        auto [D, alpha] = find_dominion();
+        mCRL2log(log::debug) << "found a dominion of " << D.size() << " vertices for player " << alpha << std::endl;
+        vertex_set A = attr_default(G, vertex_set(N, D.begin(), D.end()), alpha, m_attractor_workspace);
+        G.exclude() |= A.include();
+        W[alpha] = set_union(W[alpha], A);
+        m_priorities.remove_excluded(G);
+      }
+      G.exclude() = original_exclude;
+      return { W[0], W[1] };
+    }
+};
+
+} // namespace mcrl2::pbes_system
+
+#endif // MCRL2_PBES_PBESSOLVE_PRIORITY_PROMOTION_H
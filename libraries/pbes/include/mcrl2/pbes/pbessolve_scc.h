@@ -0,0 +1,130 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/pbes/pbessolve_scc.h
+/// \brief Computes the strongly connected components of a structure graph.
+
+#ifndef MCRL2_PBES_PBESSOLVE_SCC_H
+#define MCRL2_PBES_PBESSOLVE_SCC_H
+
+#include <algorithm>
+#include <vector>
+
+#include "mcrl2/pbes/structure_graph.h"
+
+namespace mcrl2::pbes_system {
+
+/// \brief Computes the strongly connected components of the vertices u < N with contains(u), using an iterative
+///        version of Tarjan's algorithm.
+/// \details The successors of u are given by the range successors(u) of pointers to indices, of which the
+///          indices v for which contains(v) does not hold are ignored. Afterwards component[u] is the component
+///          of vertex u, or undefined_vertex() if contains(u) does not hold. The components are numbered in reverse
+///          topological order, i.e. if there is an edge from a vertex in component c to a vertex in a different
+///          component d, then d < c.
+/// \returns The number of components.
+template <typename IndexType, typename Contains, typename Successors>
+std::size_t strongly_connected_components(std::size_t N, Contains contains, Successors successors, std::vector<IndexType>& component)
+{
+  using index_type = IndexType;
+
+  struct frame
+  {
+    index_type u;
+    const index_type* next; // the next successor of u that is visited
+    const index_type* last;
+  };
+
+  component.assign(N, undefined_vertex());
+  std::vector<index_type> number(N, undefined_vertex());
+  std::vector<index_type> lowlink(N);
+  std::vector<index_type> stack; // the vertices of which the component is not yet known
+  std::vector<frame> frames;     // the call stack of the recursive algorithm
+  index_type count = 0;
+  std::size_t components = 0;
+
+  auto visit = [&](index_type u)
+  {
+    number[u] = count;
+    lowlink[u] = count;
+    count++;
+    stack.push_back(u);
+    auto range = successors(u);
+    frames.push_back({u, range.begin(), range.end()});
+  };
+
+  for (index_type root = 0; root < N; root++)
+  {
+    if (!contains(root) || number[root] != undefined_vertex())
+    {
+      continue;
+    }
+
+    visit(root);
+    while (!frames.empty())
+    {
+      frame& f = frames.back();
+      const index_type u = f.u;
+      if (f.next != f.last)
+      {
+        const index_type v = *f.next++;
+        if (!contains(v))
+        {
+          continue;
+        }
+        if (number[v] == undefined_vertex())
+        {
+          visit(v);
+        }
+        else if (component[v] == undefined_vertex())
+        {
+          // v is on the stack
+          lowlink[u] = std::min(lowlink[u], number[v]);
+        }
+        continue;
+      }
+
+      frames.pop_back();
+      if (!frames.empty())
+      {
+        const index_type parent = frames.back().u;
+        lowlink[parent] = std::min(lowlink[parent], lowlink[u]);
+      }
+      if (lowlink[u] == number[u])
+      {
+        index_type v;
+        do
+        {
+          v = stack.back();
+          stack.pop_back();
+          component[v] = static_cast<index_type>(components);
+        }
+        while (v != u);
+        components++;
+      }
+    }
+  }
+  return components;
+}
+
+/// \brief Computes the strongly connected components of the vertices of G that are not excluded.
+/// \details Afterwards component[u] is the component of vertex u, or undefined_vertex() if u is excluded.
+///          The components are numbered in reverse topological order.
+/// \returns The number of components.
+template <typename StructureGraph>
+std::size_t strongly_connected_components(const StructureGraph& G, std::vector<typename StructureGraph::index_type>& component)
+{
+  using index_type = typename StructureGraph::index_type;
+  return strongly_connected_components<index_type>(G.extent(),
+                                                   [&](index_type u) { return G.contains(u); },
+                                                   [&](index_type u) { return G.all_successors(u); },
+                                                   component);
+}
+
+} // namespace mcrl2::pbes_system
+
+#endif // MCRL2_PBES_PBESSOLVE_SCC_H
@@ -0,0 +1,364 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/pbes/pbessolve_tangle_learning.h
+/// \brief Solves a structure graph using tangle learning.
+
+#ifndef MCRL2_PBES_PBESSOLVE_TANGLE_LEARNING_H
+#define MCRL2_PBES_PBESSOLVE_TANGLE_LEARNING_H
+
+#include <limits>
+#include <set>
+
+#include "mcrl2/pbes/detail/pbessolve_regions.h"
+#include "mcrl2/pbes/pbessolve_attractors.h"
+#include "mcrl2/pbes/pbessolve_scc.h"
+
+namespace mcrl2::pbes_system {
+
+/// \brief Solves a structure graph using the tangle learning algorithm of Van Dijk.
+/// \details The game is repeatedly decomposed into regions, from the most important priority downwards. The region
+///          of priority p is the attractor of the remaining vertices with priority p, where the attractor also
+///          attracts the tangles of which all escapes lead to the region. A tangle is a strongly connected set of
+///          vertices in which one player has a strategy to win all plays that stay in it. The bottom strongly
+///          connected components of the regions, restricted to the strategy of the player of the region, are new
+///          tangles. A tangle from which the opponent cannot escape is a dominion, which is removed from the game
+///          together with its attractor.
+class tangle_learning_solver
+{
+  protected:
+    using index_type = structure_graph::index_type;
+
+    struct tangle
+    {
+      std::vector<index_type> vertices;                         // the vertices of the tangle, sorted
+      std::size_t alpha;                                        // the player that wins the tangle
+      std::vector<std::pair<index_type, index_type>> strategy;  // the strategy of alpha in the tangle
+      std::vector<index_type> escapes;                          // the successors of the opponent outside the tangle
+      bool alive = true;
+    };
+
+    structure_graph& G;
+    parallel_attractor_workspace& m_attractor_workspace;
+    detail::structure_graph_priorities m_priorities;
+    detail::region_attractor m_attractor;
+
+    // The region of each vertex, which is only meaningful for vertices that are not excluded.
+    std::vector<std::size_t> m_region;
+
+    std::vector<tangle> m_tangles;
+    std::set<std::vector<index_type>> m_tangle_vertices;  // the vertices of all tangles that were learned
+    std::vector<std::vector<std::size_t>> m_escape_tangles;  // the tangles of which a vertex is an escape
+
+    // The number of escapes of each tangle that are not yet in the region that is computed, or zero.
+    std::vector<std::size_t> m_counter;
+
+    // Used for the local numbering of the vertices of a region.
+    std::vector<index_type> m_position;
+
+    static constexpr std::size_t unassigned = std::numeric_limits<std::size_t>::max();
+
+    bool in_subgame(index_type u, std::size_t p) const
+    {
+      return G.contains(u) && m_region[u] >= p;
+    }
+
+    // Initializes the counters of the tangles of player alpha that are contained in the subgame of priority p.
+    void initialize_counters(std::size_t p, std::size_t alpha)
+    {
+      for (std::size_t t = 0; t < m_tangles.size(); t++)
+      {
+        const tangle& T = m_tangles[t];
+        m_counter[t] = 0;
+        if (!T.alive || T.alpha != alpha)
+        {
+          continue;
+        }
+        if (std::all_of(T.vertices.begin(), T.vertices.end(), [&](index_type u) { return in_subgame(u, p); }))
+        {
+          m_counter[t] = std::count_if(T.escapes.begin(), T.escapes.end(), [&](index_type u) { return in_subgame(u, p); });
+        }
+      }
+    }
+
+    // Adds a tangle if it was not found before. Returns true if it is new.
+    bool add_tangle(tangle T)
+    {
+      if (!m_tangle_vertices.insert(T.vertices).second)
+      {
+        return false;
+      }
+      for (index_type u: T.escapes)
+      {
+        m_escape_tangles[u].push_back(m_tangles.size());
+      }
+      m_tangles.push_back(std::move(T));
+      m_counter.push_back(0);
+      return true;
+    }
+
+    // Computes the region of priority p, and stores the vertices of its bottom strongly connected components in
+    // dominions if the opponent cannot escape from it, and as new tangles otherwise.
+    // Returns true if a new tangle was learned.
+    bool compute_region(std::size_t p, std::vector<std::pair<std::vector<index_type>, std::size_t>>& dominions)
+    {
+      const std::size_t alpha = m_priorities.parity(p);
+      std::vector<index_type> R;
+      for (index_type u: m_priorities.vertices(p))
+      {
+        if (G.contains(u) && m_region[u] == unassigned)
+        {
+          m_region[u] = p;
+          R.push_back(u);
+        }
+      }
+      if (R.empty())
+      {
+        return false;
+      }
+      const std::size_t Z_size = R.size();
+
+      initialize_counters(p, alpha);
+      m_attractor.run(G, m_region, p, alpha, R, [&](index_type v, std::vector<index_type>& R_)
+        {
+          for (std::size_t t: m_escape_tangles[v])
+          {
+            if (m_counter[t] == 0 || --m_counter[t] != 0)
+            {
+              continue;
+            }
+            const tangle& T = m_tangles[t];
+            for (index_type u: T.vertices)
+            {
+              if (m_region[u] != p)
+              {
+                m_region[u] = p;
+                R_.push_back(u);
+              }
+            }
+            for (const auto& [u, w]: T.strategy)
+            {
+              G.set_strategy(u, w);
+            }
+          }
+        });
+
+      // Give the vertices of alpha with priority p a strategy that stays in the region, if possible.
+      for (std::size_t i = 0; i < Z_size; i++)
+      {
+        const index_type u = R[i];
+        if (G.decoration(u) != alpha)
+        {
+          continue;
+        }
+        const index_type v = G.strategy(u);
+        if (v == undefined_vertex() || !G.contains(v) || m_region[v] != p)
+        {
+          G.set_strategy(u, undefined_vertex());
+          for (index_type w: G.successors(u))
+          {
+            if (m_region[w] == p)
+            {
+              G.set_strategy(u, w);
+              break;
+            }
+          }
+        }
+      }
+
+      // Compute the strongly connected components of the region restricted to the strategy of alpha. The
+      // vertex sink = R.size() represents the vertices of the subgame outside the region.
+      const index_type sink = R.size();
+      for (std::size_t i = 0; i < R.size(); i++)
+      {
+        m_position[R[i]] = i;
+      }
+      std::vector<index_type> offsets = { 0 };
+      std::vector<index_type> successors;
+      for (index_type u: R)
+      {
+        if (G.decoration(u) == alpha)
+        {
+          const index_type v = G.strategy(u);
+          if (v != undefined_vertex())
+          {
+            successors.push_back(m_position[v]);
+          }
+        }
+        else
+        {
+          for (index_type v: G.successors(u))
+          {
+            if (m_region[v] == p)
+            {
+              successors.push_back(m_position[v]);
+            }
+            else if (m_region[v] > p)
+            {
+              successors.push_back(sink);
+            }
+          }
+        }
+        offsets.push_back(successors.size());
+      }
+      offsets.push_back(successors.size());
+
+      std::vector<index_type> component;
+      const std::size_t component_count = strongly_connected_components<index_type>(R.size() + 1,
+        [](index_type) { return true; },
+        [&](index_type i) { return structure_graph::index_range(successors.data() + offsets[i], successors.data() + offsets[i + 1]); },
+        component);
+
+      // A component is a bottom component if it has no edges to other components, and it is nontrivial if it has
+      // an edge to itself.
+      std::vector<bool> bottom(component_count, true);
+      std::vector<bool> nontrivial(component_count, false);
+      for (index_type i = 0; i < sink; i++)
+      {
+        for (index_type k = offsets[i]; k < offsets[i + 1]; k++)
+        {
+          if (component[successors[k]] != component[i])
+          {
+            bottom[component[i]] = false;
+          }
+          else
+          {
+            nontrivial[component[i]] = true;
+          }
+        }
+      }
+      std::vector<std::vector<index_type>> vertices(component_count);
+      for (index_type i = 0; i < sink; i++)
+      {
+        if (bottom[component[i]] && nontrivial[component[i]])
+        {
+          vertices[component[i]].push_back(R[i]);
+        }
+      }
+
+      bool found = false;
+      for (std::vector<index_type>& S: vertices)
+      {
+        if (S.empty())
+        {
+          continue;
+        }
+        std::sort(S.begin(), S.end());
+        tangle T;
+        T.alpha = alpha;
+        for (index_type u: S)
+        {
+          if (G.decoration(u) == alpha)
+          {
+            T.strategy.emplace_back(u, G.strategy(u));
+            continue;
+          }
+          for (index_type v: G.successors(u))
+          {
+            if (!std::binary_search(S.begin(), S.end(), v))
+            {
+              T.escapes.push_back(v);
+            }
+          }
+        }
+        std::sort(T.escapes.begin(), T.escapes.end());
+        T.escapes.erase(std::unique(T.escapes.begin(), T.escapes.end()), T.escapes.end());
+        if (T.escapes.empty())
+        {
+          dominions.emplace_back(std::move(S), alpha);
+        }
+        else
+        {
+          T.vertices = std::move(S);
+          found = add_tangle(std::move(T)) || found;
+        }
+      }
+      return found;
+    }
+
+    // Returns the dominions of a decomposition of the game into regions. Throws an exception if neither a dominion
+    // nor a new tangle is found.
+    std::vector<std::pair<std::vector<index_type>, std::size_t>> search()
+    {
+      for (std::size_t p = 0; p < m_priorities.size(); p++)
+      {
+        for (index_type u: m_priorities.vertices(p))
+        {
+          m_region[u] = unassigned;
+        }
+      }
+
+      bool found = false;
+      std::vector<std::pair<std::vector<index_type>, std::size_t>> dominions;
+      for (std::size_t p = 0; p < m_priorities.size(); p++)
+      {
+        found = compute_region(p, dominions) || found;
+      }
+      if (!found && dominions.empty())
+      {
+        throw mcrl2::runtime_error("Tangle learning failed to find a new tangle.");
+      }
+      return dominions;
+    }
+
+  public:
+    tangle_learning_solver(structure_graph& G_, parallel_attractor_workspace& workspace)
+      : G(G_),
+        m_attractor_workspace(workspace),
+        m_priorities(G_),
+        m_attractor(G_.extent()),
+        m_region(G_.extent(), unassigned),
+        m_escape_tangles(G_.extent()),
+        m_position(G_.extent(), undefined_vertex())
+    {}
+
+    // pre: G does not contain nodes with decoration true or false.
+    std::pair<vertex_set, vertex_set> solve()
+    {
+      const std::size_t N = G.extent();
+      vertex_set W[2] = { vertex_set(N), vertex_set(N) }; // NOLINT(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+
+      // The solved vertices are excluded from G, which is restored at the end.
+      boost::dynamic_bitset<> original_exclude = G.exclude();
+      detail::remove_dead_ends(G, W[0], W[1], m_attractor_workspace);
+      m_priorities.remove_excluded(G);
+      while (!G.is_empty())
+      {
+        for (const auto& [D, alpha]: search())
+        {
+          // A dominion may overlap with the attractor of a dominion that was found in the same search.
+          if (!std::all_of(D.begin(), D.end(), [&](index_type u) { return G.contains(u); }))
+          {
+            continue;
+          }
+          mCRL2log(log::debug) << "found a dominion of " << D.size() << " vertices for player " << alpha << std::endl;
+          vertex_set A = attr_default(G, vertex_set(N, D.begin(), D.end()), alpha, m_attractor_workspace);
+          G.exclude() |= A.include();
+          W[alpha] = set_union(W[alpha], A);
+        }
+
+        m_priorities.remove_excluded(G);
+
+        // Tangles that contain solved vertices are discarded.
+        for (tangle& T: m_tangles)
+        {
+          if (T.alive && !std::all_of(T.vertices.begin(), T.vertices.end(), [&](index_type u) { return G.contains(u); }))
+          {
+            T.alive = false;
+          }
+        }
+      }
+      mCRL2log(log::verbose) << "learned " << m_tangles.size() << " tangles" << std::endl;
+      G.exclude() = original_exclude;
+      return { W[0], W[1] };
+    }
+};
+
+} // namespace mcrl2::pbes_system
+
+#endif // MCRL2_PBES_PBESSOLVE_TANGLE_LEARNING_H
@@ -360,7 +360,7 @@ void log_vertex_set(const StructureGraph& G, const vertex_set& V, const std::str
   mCRL2log(log::debug) << "--- " << name << " ---" << std::endl;
   for (auto v: V.vertices())
   {
-    mCRL2log(log::debug) << "  " << v << " " << G.find_vertex(v) << std::endl;
+    mCRL2log(log::debug) << "  " << v << " " << print_vertex(G, v) << std::endl;
   }
 }
 
@@ -490,7 +490,7 @@ std::set<structure_graph::index_type> extract_minimal_structure_graph(StructureG
   }
   mCRL2log(log::debug) << "Extracted minimal structure graph " << core::detail::print_set(done) << std::endl;
   for (const auto& index : done) {
-    mCRL2log(log::debug) << std::setw(4) << index << " " << G.find_vertex(index) << std::endl;
+    mCRL2log(log::debug) << std::setw(4) << index << " " << print_vertex(G, index) << std::endl;
   }
 
   return done;
@@ -552,7 +552,7 @@ std::set<structure_graph::index_type> extract_minimal_structure_graph(
   }
   mCRL2log(log::debug) << "\nExtracted minimal structure graph " << core::detail::print_set(done) << std::endl;
   for (const auto& index : done) {
-    mCRL2log(log::debug) << std::setw(4) << index << " " << G.find_vertex(index) << std::endl;
+    mCRL2log(log::debug) << std::setw(4) << index << " " << print_vertex(G, index) << std::endl;
   }
 
   return done;
@@ -75,6 +75,21 @@ class simple_structure_graph
       return find_vertex(u).strategy;
     }
 
+    void set_strategy(index_type u, index_type v) const
+    {
+      find_vertex(u).strategy = v;
+    }
+
+    bool has_formulas() const
+    {
+      return true;
+    }
+
+    const pbes_expression& formula(index_type u) const
+    {
+      return find_vertex(u).formula();
+    }
+
     const vertex& find_vertex(index_type u)
     {
       return m_vertices[u];
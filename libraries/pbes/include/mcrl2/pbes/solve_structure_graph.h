@@ -12,11 +12,17 @@
 #ifndef MCRL2_PBES_SOLVE_STRUCTURE_GRAPH_H
 #define MCRL2_PBES_SOLVE_STRUCTURE_GRAPH_H
 
+#include <memory>
 #include "mcrl2/atermpp/standard_containers/vector.h"
 #include "mcrl2/data/join.h"
 #include "mcrl2/lts/lts_algorithm.h"
 #include "mcrl2/pbes/pbes_equation_index.h"
 #include "mcrl2/pbes/pbessolve_attractors.h"
+#include "mcrl2/pbes/pbessolve_fixpoint_iteration.h"
+#include "mcrl2/pbes/pbessolve_priority_promotion.h"
+#include "mcrl2/pbes/pbessolve_scc.h"
+#include "mcrl2/pbes/pbessolve_tangle_learning.h"
+#include "mcrl2/pbes/structure_graph_solver.h"
 #include "mcrl2/pbes/detail/pbes_remove_counterexample_info.h"
 
 namespace mcrl2::pbes_system {
@@ -27,7 +33,7 @@ std::tuple<std::size_t, std::size_t, vertex_set> get_minmax_rank(const structure
   std::size_t min_rank = (std::numeric_limits<std::size_t>::max)();
   std::size_t max_rank = 0;
   std::vector<structure_graph::index_type> M; // vertices with minimal rank
-  std::size_t N = G.all_vertices().size();
+  std::size_t N = G.extent();
 
   for (std::size_t vi = 0; vi < N; vi++)
   {
@@ -35,19 +41,19 @@ std::tuple<std::size_t, std::size_t, vertex_set> get_minmax_rank(const structure
     {
       continue;
     }
-    const auto& v = G.find_vertex(vi);
-    if (v.rank <= min_rank)
+    const std::size_t rank = G.rank(vi);
+    if (rank <= min_rank)
     {
-      if (v.rank < min_rank)
+      if (rank < min_rank)
       {
         M.clear();
-        min_rank = v.rank;
+        min_rank = rank;
       }
       M.push_back(vi);
     }
-    if (v.rank > max_rank)
+    if (rank > max_rank)
     {
-      max_rank = v.rank;
+      max_rank = rank;
     }
   }
   return std::make_tuple(min_rank, max_rank, vertex_set(N, M.begin(), M.end()));
@@ -61,6 +67,19 @@ class solve_structure_graph_algorithm
 
     bool use_toms_optimization = false;
 
+    // if true, the strongly connected components of the graph are solved bottom-up, see solve_scc_decomposition
+    bool use_scc_decomposition = false;
+
+    // the algorithm that is used to solve the game, or its strongly connected components
+    structure_graph_solver solver = structure_graph_solver::zielonka;
+
+    // the workspace that is created by this algorithm, if no workspace is passed to the constructor
+    std::unique_ptr<parallel_attractor_workspace> m_own_attractor_workspace;
+
+    // used by the attractor computations, which use multiple threads if it has more than one thread. Its
+    // threads are also used to solve strongly connected components in parallel.
+    parallel_attractor_workspace& m_attractor_workspace;
+
     // find a successor of u
     static structure_graph::index_type succ(const structure_graph& G, structure_graph::index_type u)
     {
@@ -124,8 +143,7 @@ class solve_structure_graph_algorithm
       // set strategy
       for (structure_graph::index_type ui: U.vertices())
       {
-        const auto& u = G.find_vertex(ui);
-        if (u.decoration == alpha)
+        if (G.decoration(ui) == alpha)
         {
           // auto v = succ(G, ui); // N.B. this may lead to a wrong strategy!
           auto v = succ(G, ui, U);
@@ -139,14 +157,14 @@ class solve_structure_graph_algorithm
       vertex_set W[2]   = { vertex_set(N), vertex_set(N) }; // NOLINT(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
       vertex_set W_1[2]; // NOLINT(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
 
-      vertex_set A = attr_default(G, U, alpha);
+      vertex_set A = attr_default(G, U, alpha, m_attractor_workspace);
       std::tie(W_1[0], W_1[1]) = solve_recursive(G, A);
 
       if (use_toms_optimization)
       {
         // More efficient than Zielonka, because some recursive calls are skipped.
         // As a consequence, the computed strategy may be wrong.
-        vertex_set B = attr_default(G, W_1[1 - alpha], 1 - alpha);
+        vertex_set B = attr_default(G, W_1[1 - alpha], 1 - alpha, m_attractor_workspace);
         if (W_1[1 - alpha].size() == B.size())
         {
           W[alpha] = set_union(A, W_1[alpha]);
@@ -168,7 +186,7 @@ class solve_structure_graph_algorithm
          }
          else
          {
-           vertex_set B = attr_default(G, W_1[1 - alpha], 1 - alpha);
+           vertex_set B = attr_default(G, W_1[1 - alpha], 1 - alpha, m_attractor_workspace);
            std::tie(W[0], W[1]) = solve_recursive(G, B);
            W[1 - alpha] = set_union(W[1 - alpha], B);
          }
@@ -198,12 +216,11 @@ class solve_structure_graph_algorithm
         {
           continue;
         }
-        const auto& v = G.find_vertex(vi);
-        if (v.decoration == structure_graph::d_false)
+        if (G.decoration(vi) == structure_graph::d_false)
         {
           Vconj.insert(vi);
         }
-        else if (v.decoration == structure_graph::d_true)
+        else if (G.decoration(vi) == structure_graph::d_true)
         {
           Vdisj.insert(vi);
         }
@@ -212,28 +229,307 @@ class solve_structure_graph_algorithm
       // extend Vconj and Vdisj
       if (!Vconj.is_empty())
       {
-        Vconj = attr_default(G, Vconj, 1);
+        Vconj = attr_default(G, Vconj, 1, m_attractor_workspace);
       }
       if (!Vdisj.is_empty())
       {
-        Vdisj = attr_default(G, Vdisj, 0);
+        Vdisj = attr_default(G, Vdisj, 0, m_attractor_workspace);
       }
 
       // default case
       if (Vconj.is_empty() && Vdisj.is_empty())
       {
-        return solve_recursive(G);
+        return solve_game(G);
       }
       else
       {
         vertex_set Wconj(N);
         vertex_set Wdisj(N);
         vertex_set Vunion = set_union(Vconj, Vdisj);
-        std::tie(Wdisj, Wconj) = solve_recursive(G, Vunion);
+        auto exclude = G.exclude() | Vunion.include();
+        std::swap(G.exclude(), exclude);
+        std::tie(Wdisj, Wconj) = solve_game(G);
+        std::swap(G.exclude(), exclude);
         return std::make_pair(set_union(Wdisj, Vdisj), set_union(Wconj, Vconj));
       }
     }
 
+    // pre: G does not contain nodes with decoration true or false.
+    std::pair<vertex_set, vertex_set> solve_game(structure_graph& G)
+    {
+      return use_scc_decomposition ? solve_scc_decomposition(G) : solve_subgame(G);
+    }
+
+    // Solves G with the selected solver.
+    //
+    // pre: G does not contain nodes with decoration true or false.
+    std::pair<vertex_set, vertex_set> solve_subgame(structure_graph& G)
+    {
+      switch (solver)
+      {
+        case structure_graph_solver::priority_promotion:
+          return priority_promotion_solver(G, m_attractor_workspace).solve();
+        case structure_graph_solver::tangle_learning:
+          return tangle_learning_solver(G, m_attractor_workspace).solve();
+        case structure_graph_solver::fixpoint_iteration:
+          return fixpoint_iteration_solver(G).solve();
+        case structure_graph_solver::zielonka:
+          break;
+      }
+      return solve_recursive(G);
+    }
+
+    // The solution of a strongly connected component that is solved separately. The vertices are the
+    // vertices of G, and strategy contains the pairs (u, v) for which the strategy of u is v.
+    struct component_solution
+    {
+      std::vector<structure_graph::index_type> W[2]; // NOLINT(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+      std::vector<std::pair<structure_graph::index_type, structure_graph::index_type>> strategy;
+    };
+
+    // Solves the subgraph of G induced by the vertices U with the selected solver, by solving a copy of it.
+    static component_solution solve_component(solve_structure_graph_algorithm& algorithm,
+                                              structure_graph& H,
+                                              const std::vector<structure_graph::index_type>& U)
+    {
+      component_solution result;
+      auto W = algorithm.solve_subgame(H);
+      for (structure_graph::index_type i = 0; i < U.size(); i++)
+      {
+        result.W[W.first.contains(i) ? 0 : 1].push_back(U[i]);
+        const structure_graph::index_type j = H.strategy(i);
+        if (j != undefined_vertex())
+        {
+          result.strategy.emplace_back(U[i], U[j]);
+        }
+      }
+      return result;
+    }
+
+    // Solves the subgraph of G induced by the vertices U with the selected solver, by excluding the other vertices
+    // of G. This avoids a copy of a large component, but the solution takes time linear in the size of G.
+    static component_solution solve_component_in_place(solve_structure_graph_algorithm& algorithm,
+                                                       structure_graph& G,
+                                                       const std::vector<structure_graph::index_type>& U)
+    {
+      component_solution result;
+      boost::dynamic_bitset<> exclude(G.extent());
+      exclude.set();
+      for (structure_graph::index_type u: U)
+      {
+        exclude.reset(u);
+      }
+      std::swap(G.exclude(), exclude);
+      auto W = algorithm.solve_subgame(G);
+      std::swap(G.exclude(), exclude);
+      result.W[0].assign(W.first.vertices().begin(), W.first.vertices().end());
+      result.W[1].assign(W.second.vertices().begin(), W.second.vertices().end());
+      return result;
+    }
+
+    // Solves G by solving its strongly connected components bottom-up. A component is solved when all
+    // components that it can reach have been solved, which means that it is closed in the graph of the
+    // vertices that are not yet solved. Its winning sets are then winning in G, and they are extended with
+    // attractors in the remaining graph. The components at the same level of the component graph do not depend
+    // on each other, and they are solved concurrently if multiple threads are available.
+    //
+    // The attractors are computed incrementally: for every vertex the number of its successors that are not yet
+    // solved is maintained, so the work for a level is linear in the number of vertices that it solves and the
+    // edges to them.
+    //
+    // pre: G does not contain nodes with decoration true or false.
+    std::pair<vertex_set, vertex_set> solve_scc_decomposition(structure_graph& G)
+    {
+      using index_type = structure_graph::index_type;
+
+      const std::size_t N = G.extent();
+      vertex_set W[2] = { vertex_set(N), vertex_set(N) }; // NOLINT(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+
+      std::vector<index_type> component;
+      const std::size_t number_of_components = strongly_connected_components(G, component);
+      mCRL2log(log::verbose) << "The parity game has " << number_of_components << " strongly connected components" << std::endl;
+
+      // Sort the vertices on their component, such that the vertices of component c are
+      // vertices[first[c]], ..., vertices[first[c + 1] - 1].
+      std::vector<std::size_t> first(number_of_components + 1, 0);
+      for (std::size_t u = 0; u < N; u++)
+      {
+        if (G.contains(u))
+        {
+          first[component[u] + 1]++;
+        }
+      }
+      std::partial_sum(first.begin(), first.end(), first.begin());
+      std::vector<index_type> vertices(first.back());
+      {
+        std::vector<std::size_t> next(first.begin(), first.end() - 1);
+        for (std::size_t u = 0; u < N; u++)
+        {
+          if (G.contains(u))
+          {
+            vertices[next[component[u]]++] = u;
+          }
+        }
+      }
+
+      // The level of a component is the length of the longest path from it to a bottom component in the
+      // component graph. Since the components are numbered in reverse topological order, the levels of the
+      // components that a component can reach are known before its own level is computed.
+      std::vector<std::vector<std::size_t>> levels;
+      {
+        std::vector<std::size_t> level(number_of_components, 0);
+        for (std::size_t c = 0; c < number_of_components; c++)
+        {
+          for (std::size_t k = first[c]; k < first[c + 1]; k++)
+          {
+            for (index_type v: G.successors(vertices[k]))
+            {
+              if (component[v] != c)
+              {
+                level[c] = std::max(level[c], level[component[v]] + 1);
+              }
+            }
+          }
+          if (level[c] >= levels.size())
+          {
+            levels.resize(level[c] + 1);
+          }
+          levels[level[c]].push_back(c);
+        }
+      }
+
+      const std::size_t number_of_threads = m_attractor_workspace.number_of_threads();
+      std::deque<solve_structure_graph_algorithm> algorithms; // one for each thread
+      for (std::size_t i = 0; i < number_of_threads; i++)
+      {
+        algorithms.emplace_back(false, use_toms_optimization, 1, false, solver);
+      }
+
+      // The solved vertices are excluded from G, which is restored at the end.
+      boost::dynamic_bitset<> original_exclude = G.exclude();
+      std::vector<index_type> position(N);
+
+      // The number of successors of each vertex that are not yet solved.
+      std::vector<index_type> unsolved_successors(N, 0);
+      for (std::size_t u = 0; u < N; u++)
+      {
+        if (G.contains(u))
+        {
+          const auto successors = G.successors(u);
+          unsolved_successors[u] = std::distance(successors.begin(), successors.end());
+        }
+      }
+      std::vector<index_type> todo;
+      for (const std::vector<std::size_t>& components: levels)
+      {
+        // The vertices of the components that have not been solved by attractors.
+        std::vector<std::vector<index_type>> U;
+        for (std::size_t c: components)
+        {
+          std::vector<index_type> Uc;
+          for (std::size_t k = first[c]; k < first[c + 1]; k++)
+          {
+            if (G.contains(vertices[k]))
+            {
+              position[vertices[k]] = Uc.size();
+              Uc.push_back(vertices[k]);
+            }
+          }
+          if (!Uc.empty())
+          {
+            U.push_back(std::move(Uc));
+          }
+        }
+        if (U.empty())
+        {
+          continue;
+        }
+
+        // A component that contains more than half of the vertices is solved in place. The copies of the other
+        // components are made beforehand, since the threads cannot create structure graphs.
+        std::vector<structure_graph> H(U.size());
+        for (std::size_t i = 0; i < U.size(); i++)
+        {
+          if (2 * U[i].size() <= N)
+          {
+            H[i] = G.induced_subgraph(U[i], position);
+          }
+        }
+
+        std::vector<component_solution> solutions(U.size());
+        auto solve = [&](solve_structure_graph_algorithm& algorithm, std::size_t i)
+        {
+          solutions[i] = 2 * U[i].size() <= N ? solve_component(algorithm, H[i], U[i]) : solve_component_in_place(algorithm, G, U[i]);
+        };
+        if (U.size() == 1)
+        {
+          solve(*this, 0);
+        }
+        else
+        {
+          m_attractor_workspace.thread_pool().parallel_for_ranges(U.size(),
+            [&](std::size_t thread_index, std::size_t begin, std::size_t end)
+            {
+              for (std::size_t i = begin; i < end; i++)
+              {
+                solve(algorithms[thread_index], i);
+              }
+            }, 1);
+        }
+        H.clear();
+
+        for (const component_solution& solution: solutions)
+        {
+          for (const auto& [u, v]: solution.strategy)
+          {
+            global_strategy<structure_graph>(G).set_strategy(u, v);
+          }
+        }
+
+        // The winning sets are closed in the remaining graph, so they remain winning when the
+        // attractor of the other player's winning set is removed. A vertex is excluded as soon as it is
+        // added to an attractor, so the predecessors of a solved vertex are the vertices that are not yet solved.
+        for (std::size_t alpha = 0; alpha < 2; alpha++)
+        {
+          todo.clear();
+          for (const component_solution& solution: solutions)
+          {
+            for (index_type u: solution.W[alpha])
+            {
+              W[alpha].insert(u);
+              G.exclude()[u] = true;
+              todo.push_back(u);
+            }
+          }
+
+          // N.B. Use a breadth first search, to minimize counter examples
+          for (std::size_t k = 0; k < todo.size(); k++)
+          {
+            const index_type v = todo[k];
+            for (index_type u: G.predecessors(v))
+            {
+              assert(unsolved_successors[u] > 0);
+              unsolved_successors[u]--;
+              if (G.decoration(u) == alpha || unsolved_successors[u] == 0)
+              {
+                global_strategy<structure_graph>(G).set_strategy(u, v);
+                W[alpha].insert(u);
+                G.exclude()[u] = true;
+                todo.push_back(u);
+              }
+            }
+          }
+        }
+      }
+      G.exclude() = original_exclude;
+
+      mCRL2log(log::debug) << "\n  --- solution for solve_scc_decomposition ---\n" << G;
+      mCRL2log(log::debug) << "   W0 = " << W[0] << std::endl;
+      mCRL2log(log::debug) << "   W1 = " << W[1] << std::endl;
+      assert(W[0].size() + W[1].size() + G.exclude().count() == N);
+      return { W[0], W[1] };
+    }
+
     static void insert_edge(structure_graph::vertex_vector& V, structure_graph::index_type ui, structure_graph::index_type vi)
     {
       using utilities::detail::contains;
@@ -254,15 +550,13 @@ class solve_structure_graph_algorithm
       log_vertex_set(G, Wconj, "Wconj");
       log_vertex_set(G, Wdisj, "Wdisj");
 
-      using vertex = structure_graph::vertex;
       structure_graph::index_type init = G.initial_vertex();
 
       // V contains the vertices of G, but not the edges
-      structure_graph::vertex_vector V = G.all_vertices();
-      for (vertex& v: V)
+      structure_graph::vertex_vector V;
+      for (std::size_t u = 0; u < G.extent(); u++)
       {
-        v.successors.clear();
-        v.predecessors.clear();
+        V.emplace_back(G.has_formulas() ? G.formula(u) : pbes_expression(), G.decoration(u), G.rank(u));
       }
 
       std::set<structure_graph::index_type> todo = { init };
@@ -324,9 +618,31 @@ class solve_structure_graph_algorithm
     }
 
   public:
-    explicit solve_structure_graph_algorithm(bool check_strategy_ = false, bool use_toms_optimization_ = false)
+    explicit solve_structure_graph_algorithm(bool check_strategy_ = false,
+                                             bool use_toms_optimization_ = false,
+                                             std::size_t number_of_threads = 1,
+                                             bool use_scc_decomposition_ = false,
+                                             structure_graph_solver solver_ = structure_graph_solver::zielonka)
+      : check_strategy(check_strategy_),
+        use_toms_optimization(use_toms_optimization_),
+        use_scc_decomposition(use_scc_decomposition_),
+        solver(solver_),
+        m_own_attractor_workspace(std::make_unique<parallel_attractor_workspace>(number_of_threads)),
+        m_attractor_workspace(*m_own_attractor_workspace)
+    {
+      if (check_strategy && !computes_strategies(solver))
+      {
+        throw mcrl2::runtime_error("The solver " + print_structure_graph_solver(solver) + " does not compute strategies, so they cannot be checked.");
+      }
+    }
+
+    /// \brief Constructor that uses the threads of the given workspace, which must outlive the algorithm.
+    solve_structure_graph_algorithm(bool check_strategy_,
+                                    bool use_toms_optimization_,
+                                    parallel_attractor_workspace& workspace)
       : check_strategy(check_strategy_),
-        use_toms_optimization(use_toms_optimization_)
+        use_toms_optimization(use_toms_optimization_),
+        m_attractor_workspace(workspace)
     {}
 
     /// Returns the winning player (alpha)
@@ -397,12 +713,12 @@ class lps_solve_structure_graph_algorithm: public solve_structure_graph_algorith
 
         for (structure_graph::index_type vi: V)
         {
-          const auto& v = G.find_vertex(vi);
-          if (is_propositional_variable_instantiation(v.formula()))
+          const pbes_expression& formula = G.formula(vi);
+          if (is_propositional_variable_instantiation(formula))
           {
             // The variable Z below should be a reference, but this leads to crashes with the GCC compiler (March 2022).
             // JFG: I think this is a GCC problem, which may resolve itself in due time. 
-            const auto Z = atermpp::down_cast<propositional_variable_instantiation>(v.formula());
+            const auto Z = atermpp::down_cast<propositional_variable_instantiation>(formula);
             std::string Zname = Z.name();
             std::smatch match;
             if (std::regex_match(Zname, match, re))
@@ -471,7 +787,16 @@ class lps_solve_structure_graph_algorithm: public solve_structure_graph_algorith
     }
 
   public:
-    lps_solve_structure_graph_algorithm() = default;
+    explicit lps_solve_structure_graph_algorithm(std::size_t number_of_threads = 1,
+                                                 bool use_scc_decomposition = false,
+                                                 structure_graph_solver solver = structure_graph_solver::zielonka)
+      : solve_structure_graph_algorithm(false, false, number_of_threads, use_scc_decomposition, solver)
+    {
+      if (!computes_strategies(solver))
+      {
+        throw mcrl2::runtime_error("The solver " + print_structure_graph_solver(solver) + " does not compute strategies, so it cannot be used to construct counter examples.");
+      }
+    }
 
     /// \brief Solve a pbes for some equation, while constructing a counter example or wittness based on the accompanying linear process.
     /// \param G       A structure graph.
@@ -538,10 +863,10 @@ class lts_solve_structure_graph_algorithm: public solve_structure_graph_algorith
         std::set<std::size_t> transition_indices;
         for (structure_graph::index_type vi: V)
         {
-          const auto& v = G.find_vertex(vi);
-          if (is_propositional_variable_instantiation(v.formula()))
+          const pbes_expression& formula = G.formula(vi);
+          if (is_propositional_variable_instantiation(formula))
           {
-            const propositional_variable_instantiation& Z = atermpp::down_cast<propositional_variable_instantiation>(v.formula());
+            const propositional_variable_instantiation& Z = atermpp::down_cast<propositional_variable_instantiation>(formula);
             std::string Zname = Z.name();
             std::smatch match;
             if (std::regex_match(Zname, match, re))
@@ -560,7 +885,16 @@ class lts_solve_structure_graph_algorithm: public solve_structure_graph_algorith
     }
 
   public:
-    lts_solve_structure_graph_algorithm() = default;
+    explicit lts_solve_structure_graph_algorithm(std::size_t number_of_threads = 1,
+                                                 bool use_scc_decomposition = false,
+                                                 structure_graph_solver solver = structure_graph_solver::zielonka)
+      : solve_structure_graph_algorithm(false, false, number_of_threads, use_scc_decomposition, solver)
+    {
+      if (!computes_strategies(solver))
+      {
+        throw mcrl2::runtime_error("The solver " + print_structure_graph_solver(solver) + " does not compute strategies, so it cannot be used to construct counter examples.");
+      }
+    }
 
     /// \brief Solve a boolean equation system while generating a counter example.
     /// \param G       A structure graph.
@@ -582,19 +916,19 @@ class lts_solve_structure_graph_algorithm: public solve_structure_graph_algorith
 };
 
 inline
-bool solve_structure_graph(structure_graph& G, bool check_strategy = false)
+bool solve_structure_graph(structure_graph& G, bool check_strategy = false, std::size_t number_of_threads = 1, bool use_scc_decomposition = false, structure_graph_solver solver = structure_graph_solver::zielonka)
 {
   bool use_toms_optimization = !check_strategy;
-  solve_structure_graph_algorithm algorithm(check_strategy, use_toms_optimization);
+  solve_structure_graph_algorithm algorithm(check_strategy, use_toms_optimization, number_of_threads, use_scc_decomposition, solver);
   return algorithm.solve(G);
 }
 
 /// Returns a mapping from PBES variable instantations to vertices in the structure graph for vertices won by player alpha.
 inline
-std::pair<bool, std::unordered_map<pbes_expression, structure_graph::index_type>> solve_structure_graph_winning_mapping(structure_graph& G, bool check_strategy = false)
+std::pair<bool, std::unordered_map<pbes_expression, structure_graph::index_type>> solve_structure_graph_winning_mapping(structure_graph& G, bool check_strategy = false, std::size_t number_of_threads = 1, bool use_scc_decomposition = false, structure_graph_solver solver = structure_graph_solver::zielonka)
 {
   bool use_toms_optimization = !check_strategy;
-  solve_structure_graph_algorithm algorithm(check_strategy, use_toms_optimization);
+  solve_structure_graph_algorithm algorithm(check_strategy, use_toms_optimization, number_of_threads, use_scc_decomposition, solver);
   auto W = algorithm.solve_partitions(G);
 
   bool is_disjunctive;
@@ -610,30 +944,33 @@ std::pair<bool, std::unordered_map<pbes_expression, structure_graph::index_type>
   // Make a mapping from the formula to the index it belongs to.
   std::unordered_map<pbes_expression, structure_graph::index_type> mapping;
   for (structure_graph::index_type index : W.first.vertices()) {
-    mapping.insert(std::make_pair(G.find_vertex(index).formula(), index));
+    mapping.insert(std::make_pair(G.formula(index), index));
   }
 
   for (structure_graph::index_type index : W.second.vertices()) {
-    mapping.insert(std::make_pair(G.find_vertex(index).formula(), index));
+    mapping.insert(std::make_pair(G.formula(index), index));
   }
 
   return { is_disjunctive, mapping };
 }
 
 inline
-std::pair<bool, lps::specification> solve_structure_graph_with_counter_example(structure_graph& G, const lps::specification& lpsspec, const pbes& p, const pbes_equation_index& p_index)
+std::pair<bool, lps::specification> solve_structure_graph_with_counter_example(structure_graph& G, const lps::specification& lpsspec, const pbes& p, const pbes_equation_index& p_index, std::size_t number_of_threads = 1, bool use_scc_decomposition = false, structure_graph_solver solver = structure_graph_solver::zielonka)
 {
-  lps_solve_structure_graph_algorithm algorithm;
+  lps_solve_structure_graph_algorithm algorithm(number_of_threads, use_scc_decomposition, solver);
   return algorithm.solve_with_counter_example(G, lpsspec, p, p_index);
 }
 
 /// \brief Solve this pbes_system using a structure graph generating a counter example.
 /// \param G       The structure graph.
 /// \param ltsspec The original LTS that was used to create the PBES.
+/// \param number_of_threads The number of threads that is used to compute attractors and to solve components.
+/// \param use_scc_decomposition If true, the strongly connected components of G are solved bottom-up.
+/// \param solver The algorithm that is used to solve G, which must compute strategies.
 inline
-bool solve_structure_graph_with_counter_example(structure_graph& G, lts::lts_lts_t& ltsspec)
+bool solve_structure_graph_with_counter_example(structure_graph& G, lts::lts_lts_t& ltsspec, std::size_t number_of_threads = 1, bool use_scc_decomposition = false, structure_graph_solver solver = structure_graph_solver::zielonka)
 {
-  lts_solve_structure_graph_algorithm algorithm;
+  lts_solve_structure_graph_algorithm algorithm(number_of_threads, use_scc_decomposition, solver);
   return algorithm.solve_with_counter_example(G, ltsspec);
 }
 
@@ -12,9 +12,13 @@
 #ifndef MCRL2_PBES_STRUCTURE_GRAPH_H
 #define MCRL2_PBES_STRUCTURE_GRAPH_H
 
+#include <cstdint>
 #include <iomanip>
+#include <numeric>
+#include <sstream>
 #include <boost/dynamic_bitset.hpp>
 #include <boost/range/adaptor/filtered.hpp>
+#include <boost/range/iterator_range.hpp>
 
 #include "mcrl2/atermpp/standard_containers/vector.h"
 #include "mcrl2/core/detail/print_utility.h"
@@ -37,6 +41,12 @@ unsigned int undefined_vertex()
 
 // A structure graph with a facility to exclude a subset of the vertices.
 // It has the same interface as simple_structure_graph.
+//
+// Once the graph is complete it can be frozen, see freeze(). A frozen graph stores the edges in contiguous
+// arrays in compressed sparse row format, and the decorations, ranks and strategies in separate arrays, which
+// takes much less memory than a vector of vertices. The vertices, and optionally the formulas, are released.
+// The functions that take a vertex index work on both representations, but find_vertex, vertices and
+// all_vertices can only be used on a graph that is not frozen.
 class structure_graph
 {
   friend struct detail::structure_graph_builder;
@@ -109,11 +119,34 @@ class structure_graph
 
     using vertex_vector = atermpp::vector<vertex, std::allocator<atermpp::detail::reference_aterm<vertex>>, mcrl2::utilities::detail::GlobalThreadSafe>;
 
+    // A contiguous range of predecessors or successors
+    using index_range = boost::iterator_range<const index_type*>;
+
   protected:
     vertex_vector m_vertices;
     index_type m_initial_vertex = 0;
     boost::dynamic_bitset<> m_exclude;
 
+    // The frozen representation. The successors of vertex u are m_successors[m_successor_offsets[u]], ...,
+    // m_successors[m_successor_offsets[u + 1] - 1], and similarly for the predecessors.
+    bool m_frozen = false;
+    std::vector<std::uint8_t> m_decorations;
+    std::vector<std::uint32_t> m_ranks;
+    std::vector<std::size_t> m_successor_offsets;
+    std::vector<index_type> m_successors;
+    std::vector<std::size_t> m_predecessor_offsets;
+    std::vector<index_type> m_predecessors;
+    mutable std::vector<index_type> m_strategies;
+    atermpp::vector<pbes_expression> m_formulas;
+
+    // The value of an undefined rank in m_ranks
+    static constexpr std::uint32_t undefined_rank = std::numeric_limits<std::uint32_t>::max();
+
+    static index_range make_index_range(const std::vector<index_type>& v)
+    {
+      return index_range(v.data(), v.data() + v.size());
+    }
+
     struct integers_not_contained_in
     {
       const boost::dynamic_bitset<>& subset;
@@ -161,32 +194,45 @@ class structure_graph
 
     std::size_t extent() const
     {
-      return m_vertices.size();
+      return m_frozen ? m_decorations.size() : m_vertices.size();
     }
 
     decoration_type decoration(index_type u) const
     {
-      return find_vertex(u).decoration;
+      return m_frozen ? static_cast<decoration_type>(m_decorations[u]) : find_vertex(u).decoration;
     }
 
     std::size_t rank(index_type u) const
     {
+      if (m_frozen)
+      {
+        return m_ranks[u] == undefined_rank ? data::undefined_index() : m_ranks[u];
+      }
       return find_vertex(u).rank;
     }
 
     const vertex_vector& all_vertices() const
     {
+      assert(!m_frozen);
       return m_vertices;
     }
 
-    const std::vector<index_type>& all_predecessors(index_type u) const
+    index_range all_predecessors(index_type u) const
     {
-      return find_vertex(u).predecessors;
+      if (m_frozen)
+      {
+        return index_range(m_predecessors.data() + m_predecessor_offsets[u], m_predecessors.data() + m_predecessor_offsets[u + 1]);
+      }
+      return make_index_range(find_vertex(u).predecessors);
     }
 
-    const std::vector<index_type>& all_successors(index_type u) const
+    index_range all_successors(index_type u) const
     {
-      return find_vertex(u).successors;
+      if (m_frozen)
+      {
+        return index_range(m_successors.data() + m_successor_offsets[u], m_successors.data() + m_successor_offsets[u + 1]);
+      }
+      return make_index_range(find_vertex(u).successors);
     }
 
     boost::filtered_range<vertices_not_contained_in, const vertex_vector> vertices() const
@@ -194,28 +240,56 @@ class structure_graph
       return all_vertices() | boost::adaptors::filtered(vertices_not_contained_in(m_vertices, m_exclude));
     }
 
-    boost::filtered_range<integers_not_contained_in, const std::vector<index_type>> predecessors(index_type u) const
+    boost::filtered_range<integers_not_contained_in, const index_range> predecessors(index_type u) const
     {
       return all_predecessors(u) | boost::adaptors::filtered(integers_not_contained_in(m_exclude));
     }
 
-    boost::filtered_range<integers_not_contained_in, const std::vector<index_type>> successors(index_type u) const
+    boost::filtered_range<integers_not_contained_in, const index_range> successors(index_type u) const
     {
       return all_successors(u) | boost::adaptors::filtered(integers_not_contained_in(m_exclude));
     }
 
     index_type strategy(index_type u) const
     {
-      return find_vertex(u).strategy;
+      return m_frozen ? m_strategies[u] : find_vertex(u).strategy;
+    }
+
+    // The strategy is not considered to be part of the structure of the graph, hence this function is const.
+    void set_strategy(index_type u, index_type v) const
+    {
+      if (m_frozen)
+      {
+        m_strategies[u] = v;
+      }
+      else
+      {
+        find_vertex(u).strategy = v;
+      }
+    }
+
+    // Returns true if the formulas of the vertices are available, which is not the case if they are
+    // released when the graph was frozen.
+    bool has_formulas() const
+    {
+      return !m_frozen || m_formulas.size() == m_decorations.size();
+    }
+
+    const pbes_expression& formula(index_type u) const
+    {
+      assert(has_formulas());
+      return m_frozen ? static_cast<const pbes_expression&>(m_formulas[u]) : find_vertex(u).formula();
     }
 
     vertex& find_vertex(index_type u)
     {
+      assert(!m_frozen);
       return m_vertices[u];
     }
 
     const vertex& find_vertex(index_type u) const
     {
+      assert(!m_frozen);
       return m_vertices[u];
     }
 
@@ -243,8 +317,138 @@ class structure_graph
     // Returns true if all vertices have a rank and a decoration
     bool is_defined() const
     {
+      if (m_frozen)
+      {
+        for (std::size_t u = 0; u < extent(); u++)
+        {
+          if ((m_decorations[u] == d_none && m_ranks[u] == undefined_rank)
+              || (m_successor_offsets[u] == m_successor_offsets[u + 1] && m_decorations[u] != d_true && m_decorations[u] != d_false))
+          {
+            return false;
+          }
+        }
+        return true;
+      }
       return std::all_of(m_vertices.begin(), m_vertices.end(), [](const vertex& u) { return u.is_defined(); });
     }
+
+    bool is_frozen() const
+    {
+      return m_frozen;
+    }
+
+    /// \brief Converts the graph into the frozen representation, and releases the vertices.
+    /// \details The graph must be complete, since vertices and edges can no longer be added.
+    /// \param keep_formulas If false, the formulas of the vertices are released too. They are
+    ///        only needed to construct counter examples.
+    void freeze(bool keep_formulas = true)
+    {
+      if (m_frozen)
+      {
+        return;
+      }
+
+      const std::size_t N = m_vertices.size();
+      std::size_t successor_count = 0;
+      std::size_t predecessor_count = 0;
+      for (const vertex& v: m_vertices)
+      {
+        successor_count += v.successors.size();
+        predecessor_count += v.predecessors.size();
+      }
+
+      m_decorations.reserve(N);
+      m_ranks.reserve(N);
+      m_strategies.reserve(N);
+      m_successor_offsets.reserve(N + 1);
+      m_predecessor_offsets.reserve(N + 1);
+      m_successors.reserve(successor_count);
+      m_predecessors.reserve(predecessor_count);
+      if (keep_formulas)
+      {
+        m_formulas.reserve(N);
+      }
+
+      m_successor_offsets.push_back(0);
+      m_predecessor_offsets.push_back(0);
+      for (vertex& v: m_vertices)
+      {
+        assert(v.rank == data::undefined_index() || v.rank < undefined_rank);
+        m_decorations.push_back(static_cast<std::uint8_t>(v.decoration));
+        m_ranks.push_back(v.rank == data::undefined_index() ? undefined_rank : static_cast<std::uint32_t>(v.rank));
+        m_strategies.push_back(v.strategy);
+        m_successors.insert(m_successors.end(), v.successors.begin(), v.successors.end());
+        m_predecessors.insert(m_predecessors.end(), v.predecessors.begin(), v.predecessors.end());
+        m_successor_offsets.push_back(m_successors.size());
+        m_predecessor_offsets.push_back(m_predecessors.size());
+        if (keep_formulas)
+        {
+          m_formulas.push_back(v.formula());
+        }
+
+        // Release the edges immediately, to limit the peak memory usage.
+        std::vector<index_type>().swap(v.successors);
+        std::vector<index_type>().swap(v.predecessors);
+      }
+
+      m_vertices.clear();
+      m_vertices.shrink_to_fit();
+      m_frozen = true;
+    }
+
+    /// \brief Returns the subgraph induced by the vertices in U, in the frozen representation and without formulas.
+    /// \details Vertex U[i] corresponds to vertex i of the result, which has initial vertex 0. The entries
+    ///          position[U[i]] must be equal to i, and the other entries of position may have any value.
+    ///          The strategies of the result are undefined.
+    structure_graph induced_subgraph(const std::vector<index_type>& U, const std::vector<index_type>& position) const
+    {
+      auto local_index = [&](index_type v)
+      {
+        const index_type i = position[v];
+        return i < U.size() && U[i] == v ? i : undefined_vertex();
+      };
+
+      structure_graph result;
+      const std::size_t N = U.size();
+      result.m_decorations.reserve(N);
+      result.m_ranks.reserve(N);
+      result.m_strategies.assign(N, undefined_vertex());
+      result.m_successor_offsets.reserve(N + 1);
+      result.m_successor_offsets.push_back(0);
+      std::vector<std::size_t> predecessor_count(N + 1, 0);
+      for (index_type u: U)
+      {
+        const std::size_t r = rank(u);
+        result.m_decorations.push_back(static_cast<std::uint8_t>(decoration(u)));
+        result.m_ranks.push_back(r == data::undefined_index() ? undefined_rank : static_cast<std::uint32_t>(r));
+        for (index_type v: all_successors(u))
+        {
+          const index_type j = local_index(v);
+          if (j != undefined_vertex())
+          {
+            result.m_successors.push_back(j);
+            predecessor_count[j + 1]++;
+          }
+        }
+        result.m_successor_offsets.push_back(result.m_successors.size());
+      }
+
+      std::partial_sum(predecessor_count.begin(), predecessor_count.end(), predecessor_count.begin());
+      result.m_predecessor_offsets = predecessor_count;
+      result.m_predecessors.resize(result.m_successors.size());
+      for (index_type i = 0; i < N; i++)
+      {
+        for (std::size_t k = result.m_successor_offsets[i]; k < result.m_successor_offsets[i + 1]; k++)
+        {
+          result.m_predecessors[predecessor_count[result.m_successors[k]]++] = i;
+        }
+      }
+
+      result.m_initial_vertex = 0;
+      result.m_exclude = boost::dynamic_bitset<>(N);
+      result.m_frozen = true;
+      return result;
+    }
 };
 
 template <typename StructureGraph>
@@ -296,24 +500,37 @@ std::ostream& operator<<(std::ostream& out, const structure_graph::vertex& u)
   return out;
 }
 
+template <typename StructureGraph>
+std::string print_vertex(const StructureGraph& G, typename StructureGraph::index_type u)
+{
+  std::ostringstream out;
+  out << "vertex(formula = ";
+  if (G.has_formulas())
+  {
+    out << G.formula(u);
+  }
+  else
+  {
+    out << "released";
+  }
+  out << ", decoration = " << G.decoration(u)
+      << ", rank = " << (G.rank(u) == data::undefined_index() ? std::string("undefined") : std::to_string(G.rank(u)))
+      << ", predecessors = " << core::detail::print_list(structure_graph_predecessors(G, u))
+      << ", successors = " << core::detail::print_list(structure_graph_successors(G, u))
+      << ", strategy = " << (G.strategy(u) == undefined_vertex() ? std::string("undefined") : std::to_string(G.strategy(u)))
+      << ")";
+  return out.str();
+}
+
 template <typename StructureGraph>
 std::ostream& print_structure_graph(std::ostream& out, const StructureGraph& G)
 {
-  auto N = G.all_vertices().size();
+  auto N = G.extent();
   for (std::size_t i = 0; i < N; i++)
   {
     if (G.contains(i))
     {
-      const structure_graph::vertex& u = G.find_vertex(i);
-      out << std::setw(4) << i << " "
-          << "vertex(formula = " << u.formula()
-          << ", decoration = " << u.decoration
-          << ", rank = " << (u.rank == data::undefined_index() ? std::string("undefined") : std::to_string(u.rank))
-          << ", predecessors = " << core::detail::print_list(structure_graph_predecessors(G, i))
-          << ", successors = " << core::detail::print_list(structure_graph_successors(G, i))
-          << ", strategy = " << (u.strategy == undefined_vertex() ? std::string("undefined") : std::to_string(u.strategy))
-          << ")"
-          << std::endl;
+      out << std::setw(4) << i << " " << print_vertex(G, i) << std::endl;
     }
   }
   if (G.is_empty())
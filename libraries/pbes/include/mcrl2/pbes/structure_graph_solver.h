@@ -0,0 +1,112 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/pbes/structure_graph_solver.h
+/// \brief The algorithms that can be used to solve a structure graph.
+
+#ifndef MCRL2_PBES_STRUCTURE_GRAPH_SOLVER_H
+#define MCRL2_PBES_STRUCTURE_GRAPH_SOLVER_H
+
+#include "mcrl2/utilities/exception.h"
+#include <string>
+
+namespace mcrl2::pbes_system
+{
+
+/// \brief An enumerated type for the algorithms that solve a structure graph
+enum class structure_graph_solver
+{
+  zielonka,
+  priority_promotion,
+  tangle_learning,
+  fixpoint_iteration
+};
+
+/// \brief Parses a structure graph solver
+inline structure_graph_solver parse_structure_graph_solver(const std::string& s)
+{
+  if (s == "zielonka")
+  {
+    return structure_graph_solver::zielonka;
+  }
+  if (s == "priority-promotion")
+  {
+    return structure_graph_solver::priority_promotion;
+  }
+  if (s == "tangle-learning")
+  {
+    return structure_graph_solver::tangle_learning;
+  }
+  if (s == "fixpoint-iteration")
+  {
+    return structure_graph_solver::fixpoint_iteration;
+  }
+  throw mcrl2::runtime_error("unknown structure graph solver " + s);
+}
+
+/// \brief Prints a structure graph solver
+inline std::string print_structure_graph_solver(const structure_graph_solver s)
+{
+  switch (s)
+  {
+    case structure_graph_solver::zielonka: return "zielonka";
+    case structure_graph_solver::priority_promotion: return "priority-promotion";
+    case structure_graph_solver::tangle_learning: return "tangle-learning";
+    case structure_graph_solver::fixpoint_iteration: return "fixpoint-iteration";
+  }
+  throw mcrl2::runtime_error("unknown structure graph solver");
+}
+
+/// \brief Returns true if the solver computes winning strategies, which are needed for counter examples.
+inline bool computes_strategies(const structure_graph_solver s)
+{
+  return s != structure_graph_solver::fixpoint_iteration;
+}
+
+inline
+std::istream& operator>>(std::istream& is, structure_graph_solver& s)
+{
+  try
+  {
+    std::string text;
+    is >> text;
+    s = parse_structure_graph_solver(text);
+  }
+  catch (mcrl2::runtime_error&)
+  {
+    is.setstate(std::ios_base::failbit);
+  }
+  return is;
+}
+
+inline
+std::ostream& operator<<(std::ostream& os, const structure_graph_solver s)
+{
+  os << print_structure_graph_solver(s);
+  return os;
+}
+
+/// \brief Returns a description of a structure graph solver
+inline std::string description(const structure_graph_solver s)
+{
+  switch (s)
+  {
+    case structure_graph_solver::zielonka: return "the recursive algorithm of Zielonka";
+    case structure_graph_solver::priority_promotion: return "priority promotion, which searches for dominions by "
+        "promoting regions of vertices with the same priority";
+    case structure_graph_solver::tangle_learning: return "tangle learning, which searches for dominions by "
+        "learning tangles from the regions of vertices with the same priority";
+    case structure_graph_solver::fixpoint_iteration: return "distraction fixpoint iteration, which does not compute "
+        "strategies and can therefore not be used for counter examples";
+  }
+  throw mcrl2::runtime_error("unknown structure graph solver");
+}
+
+} // namespace mcrl2::pbes_system
+
+#endif // MCRL2_PBES_STRUCTURE_GRAPH_SOLVER_H
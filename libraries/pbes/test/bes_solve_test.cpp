@@ -12,13 +12,40 @@
 #define BOOST_TEST_MODULE solve_test
 
 #include <boost/test/included/unit_test.hpp>
+#include <random>
 #include "mcrl2/pbes/pbes_gauss_elimination.h"
 #include "mcrl2/pbes/parse.h"
+#include "mcrl2/pbes/pbesinst_incremental_attractors.h"
+#include "mcrl2/pbes/pbesinst_structure_graph.h"
+#include "mcrl2/pbes/simple_structure_graph.h"
 #include "mcrl2/pbes/small_progress_measures.h"
+#include "mcrl2/pbes/solve_structure_graph.h"
+#include "mcrl2/pbes/structure_graph_builder.h"
 
 using namespace mcrl2;
 using namespace mcrl2::pbes_system;
 
+// Solves b using a structure graph, that is frozen before solving if freeze is true
+bool solve_using_structure_graph(const pbes& b,
+                                 bool freeze,
+                                 bool scc_decomposition = false,
+                                 structure_graph_solver solver = structure_graph_solver::zielonka)
+{
+  pbessolve_options options;
+  structure_graph G;
+  pbesinst_structure_graph_algorithm algorithm(options, b, G);
+  algorithm.run();
+  if (freeze)
+  {
+    std::size_t n = G.extent();
+    G.freeze(false);
+    BOOST_CHECK(G.is_frozen());
+    BOOST_CHECK_EQUAL(G.extent(), n);
+    BOOST_CHECK(G.is_defined());
+  }
+  return solve_structure_graph(G, computes_strategies(solver), 1, scc_decomposition, solver);
+}
+
 void run_all_algorithms(std::string const& b, bool expected_outcome)
 {
   pbes b1;
@@ -30,6 +57,12 @@ void run_all_algorithms(std::string const& b, bool expected_outcome)
 
   BOOST_CHECK_EQUAL(small_progress_measures(b1), expected_outcome);
   BOOST_CHECK_EQUAL(gauss_elimination(b1), expected_outcome);
+  BOOST_CHECK_EQUAL(solve_using_structure_graph(b1, false), expected_outcome);
+  BOOST_CHECK_EQUAL(solve_using_structure_graph(b1, true), expected_outcome);
+  BOOST_CHECK_EQUAL(solve_using_structure_graph(b1, true, true), expected_outcome);
+  BOOST_CHECK_EQUAL(solve_using_structure_graph(b1, true, false, structure_graph_solver::priority_promotion), expected_outcome);
+  BOOST_CHECK_EQUAL(solve_using_structure_graph(b1, true, false, structure_graph_solver::tangle_learning), expected_outcome);
+  BOOST_CHECK_EQUAL(solve_using_structure_graph(b1, true, false, structure_graph_solver::fixpoint_iteration), expected_outcome);
 }
 
 BOOST_AUTO_TEST_CASE(test_simple_nu_mu)
@@ -63,3 +96,233 @@ BOOST_AUTO_TEST_CASE(test_simple)
   );
   run_all_algorithms(b, false);
 }
+
+// Creates a random structure graph with n vertices that have between one and three successors.
+void make_random_structure_graph(structure_graph& G, std::size_t n, std::size_t number_of_ranks, unsigned int seed)
+{
+  std::mt19937 generator(seed);
+  std::uniform_int_distribution<std::size_t> rank(0, number_of_ranks - 1);
+  std::uniform_int_distribution<structure_graph::index_type> vertex(0, n - 1);
+  std::uniform_int_distribution<std::size_t> successors(1, 3);
+  detail::manual_structure_graph_builder builder(G);
+  for (std::size_t i = 0; i < n; i++)
+  {
+    builder.insert_vertex(generator() % 2 == 0, rank(generator));
+  }
+  for (structure_graph::index_type u = 0; u < n; u++)
+  {
+    for (std::size_t k = successors(generator); k > 0; k--)
+    {
+      builder.insert_edge(u, vertex(generator));
+    }
+  }
+  builder.finalize();
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_attractors)
+{
+  const std::size_t n = 100000;
+  structure_graph G;
+  make_random_structure_graph(G, n, 4, 12345);
+  G.freeze(false);
+
+  // The attractor sets computed with one and with multiple threads must be equal.
+  std::size_t alpha = 0;
+  parallel_attractor_workspace workspace(4);
+  for (structure_graph::index_type first = 0; first < 10; first++)
+  {
+    vertex_set A(n);
+    for (structure_graph::index_type u = first; u < n; u += 97)
+    {
+      A.insert(u);
+    }
+    BOOST_CHECK(attr_default_no_strategy(G, A, alpha) == attr_default(G, A, alpha, workspace));
+    alpha = 1 - alpha;
+  }
+
+  // The solutions computed with one and with multiple threads must be equal.
+  structure_graph H;
+  make_random_structure_graph(H, n, 4, 12345);
+  solve_structure_graph_algorithm sequential_algorithm(false, true);
+  solve_structure_graph_algorithm parallel_algorithm(false, true, 4);
+  BOOST_CHECK(sequential_algorithm.solve_partitions(G) == parallel_algorithm.solve_partitions(H));
+}
+
+// Creates a random structure graph with n vertices that have between one and three successors. The vertices are
+// divided into clusters of cluster_size consecutive vertices. Most successors of a vertex are in its own cluster,
+// and the others in a preceding cluster, such that the graph has many strongly connected components.
+void make_clustered_random_structure_graph(structure_graph& G, std::size_t n, std::size_t cluster_size, std::size_t number_of_ranks, unsigned int seed)
+{
+  std::mt19937 generator(seed);
+  std::uniform_int_distribution<std::size_t> rank(0, number_of_ranks - 1);
+  std::uniform_int_distribution<std::size_t> successors(1, 3);
+  detail::manual_structure_graph_builder builder(G);
+  for (std::size_t i = 0; i < n; i++)
+  {
+    builder.insert_vertex(generator() % 2 == 0, rank(generator));
+  }
+  for (structure_graph::index_type u = 0; u < n; u++)
+  {
+    const std::size_t first = u - u % cluster_size;
+    const std::size_t last = std::min(first + cluster_size, n);
+    for (std::size_t k = successors(generator); k > 0; k--)
+    {
+      if (first > 0 && generator() % 4 == 0)
+      {
+        builder.insert_edge(u, generator() % first);
+      }
+      else
+      {
+        builder.insert_edge(u, first + generator() % (last - first));
+      }
+    }
+  }
+  builder.finalize();
+}
+
+BOOST_AUTO_TEST_CASE(test_scc_decomposition)
+{
+  const std::size_t n = 20000;
+  for (unsigned int seed = 1; seed <= 3; seed++)
+  {
+    structure_graph G;
+    make_clustered_random_structure_graph(G, n, 20, 5, seed);
+    G.freeze(false);
+
+    // The winning sets are computed with Zielonka's algorithm, and with the decomposition using one and
+    // multiple threads. The strategies computed using the decomposition are checked.
+    solve_structure_graph_algorithm zielonka(false, false);
+    solve_structure_graph_algorithm sequential_algorithm(true, false, 1, true);
+    solve_structure_graph_algorithm parallel_algorithm(true, false, 4, true);
+    auto W = zielonka.solve_partitions(G);
+    BOOST_CHECK(sequential_algorithm.solve_partitions(G) == W);
+    BOOST_CHECK(parallel_algorithm.solve_partitions(G) == W);
+  }
+
+  // The largest component of a random graph contains most vertices, and it is solved in place.
+  structure_graph G;
+  make_random_structure_graph(G, 1000, 4, 12345);
+  G.freeze(false);
+  solve_structure_graph_algorithm zielonka(false, true);
+  solve_structure_graph_algorithm scc_algorithm(false, true, 4, true);
+  BOOST_CHECK(zielonka.solve_partitions(G) == scc_algorithm.solve_partitions(G));
+}
+
+// A chain of components, each consisting of one vertex with a self loop, in which the ranks alternate. Every
+// component is at its own level, so the decomposition must not take time linear in the graph per level.
+BOOST_AUTO_TEST_CASE(test_scc_decomposition_chain)
+{
+  const std::size_t n = 40000;
+  structure_graph G;
+  detail::manual_structure_graph_builder builder(G);
+  for (std::size_t i = 0; i < n; i++)
+  {
+    builder.insert_vertex(i % 3 == 0, i % 2);
+  }
+  for (structure_graph::index_type u = 0; u < n; u++)
+  {
+    builder.insert_edge(u, u);
+    if (u > 0)
+    {
+      builder.insert_edge(u, u - 1);
+    }
+  }
+  builder.finalize();
+  G.freeze(false);
+
+  solve_structure_graph_algorithm zielonka(false, false);
+  solve_structure_graph_algorithm scc_algorithm(true, false, 1, true);
+  BOOST_CHECK(zielonka.solve_partitions(G) == scc_algorithm.solve_partitions(G));
+}
+
+BOOST_AUTO_TEST_CASE(test_structure_graph_solvers)
+{
+  const structure_graph_solver solvers[] = { structure_graph_solver::priority_promotion, // NOLINT(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+                                             structure_graph_solver::tangle_learning,
+                                             structure_graph_solver::fixpoint_iteration };
+
+  // The winning sets of all solvers must be equal to the ones computed with Zielonka's algorithm. The strategies
+  // are checked for the solvers that compute them.
+  for (unsigned int seed = 1; seed <= 40; seed++)
+  {
+    structure_graph G;
+    if (seed % 2 == 0)
+    {
+      make_random_structure_graph(G, 200, 2 + seed % 7, seed);
+    }
+    else
+    {
+      make_clustered_random_structure_graph(G, 500, 10, 2 + seed % 7, seed);
+    }
+    G.freeze(false);
+    solve_structure_graph_algorithm zielonka(false, false);
+    auto W = zielonka.solve_partitions(G);
+    for (structure_graph_solver solver: solvers)
+    {
+      solve_structure_graph_algorithm algorithm(computes_strategies(solver), false, 1, false, solver);
+      BOOST_CHECK_MESSAGE(algorithm.solve_partitions(G) == W, "solver " << solver << " with seed " << seed);
+      solve_structure_graph_algorithm scc_algorithm(false, false, 2, true, solver);
+      BOOST_CHECK_MESSAGE(scc_algorithm.solve_partitions(G) == W, "solver " << solver << " with seed " << seed << " on components");
+    }
+  }
+
+  BOOST_CHECK_THROW(solve_structure_graph_algorithm(true, false, 1, false, structure_graph_solver::fixpoint_iteration), mcrl2::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_incremental_attractors)
+{
+  const std::size_t n = 5000;
+  for (std::size_t alpha = 0; alpha < 2; alpha++)
+  {
+    std::mt19937 generator(static_cast<unsigned int>(alpha + 1));
+    structure_graph::vertex_vector V;
+    for (std::size_t i = 0; i < n; i++)
+    {
+      V.emplace_back(pbes_expression(), generator() % 2 == 0 ? structure_graph::d_disjunction : structure_graph::d_conjunction, 0);
+    }
+    simple_structure_graph G(V);
+
+    // The successors of the vertices are added in batches, and the attractor of a few vertices is maintained.
+    std::array<vertex_set, 2> S = { vertex_set(n), vertex_set(n) };
+    std::array<strategy_vector, 2> tau;
+    vertex_set A(n);
+    detail::incremental_attractors attractors;
+    for (structure_graph::index_type u = 0; u < n; u++)
+    {
+      for (std::size_t k = 1 + generator() % 3; k > 0; k--)
+      {
+        const structure_graph::index_type v = generator() % n;
+        structure_graph::vertex& u_ = V[u];
+        structure_graph::vertex& v_ = V[v];
+        if (!utilities::detail::contains(u_.successors, v))
+        {
+          u_.successors.push_back(v);
+          v_.predecessors.push_back(u);
+        }
+      }
+      attractors.changed(u);
+      if (generator() % 100 == 0 && !S[alpha].contains(u))
+      {
+        S[alpha].insert(u);
+        A.insert(u);
+        attractors.inserted(alpha, u);
+      }
+      if (u % 50 == 0)
+      {
+        attractors.update(G, S, tau);
+      }
+    }
+    attractors.update(G, S, tau);
+
+    BOOST_CHECK(S[alpha] == attr_default_no_strategy(G, A, alpha));
+    BOOST_CHECK(S[1 - alpha].is_empty());
+    for (structure_graph::index_type u: S[alpha].vertices())
+    {
+      if (!A.contains(u) && G.decoration(u) == alpha)
+      {
+        BOOST_CHECK(S[alpha].contains(tau[alpha][u]));
+        BOOST_CHECK(utilities::detail::contains(G.successors(u), tau[alpha][u]));
+      }
+    }
+  }
+}
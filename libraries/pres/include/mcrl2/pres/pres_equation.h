@@ -120,7 +120,7 @@ class pres_equation
       swap(m_formula, other.m_formula);
     }
 
-    void mark(std::stack<std::reference_wrapper<atermpp::detail::_aterm>>& todo) const
+    void mark(atermpp::term_mark_stack& todo) const
     {
       mark_term(m_symbol, todo);
     }
@@ -12,6 +12,7 @@
 #ifndef MCRL2_UTILITIES_BLOCK_ALLOCATOR_H_
 #define MCRL2_UTILITIES_BLOCK_ALLOCATOR_H_
 
+#include "mcrl2/utilities/block_memory.h"
 #include "mcrl2/utilities/noncopyable.h"
 #include "mcrl2/utilities/thread_local.h"
 
@@ -56,6 +57,21 @@ struct Block
   Block<T, N>* next = nullptr;
 };
 
+/// Allocates a block from the memory determined by the block_memory_mode.
+template <typename T, std::size_t N>
+Block<T, N>* new_block()
+{
+  static_assert(alignof(Block<T, N>) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+  return new (allocate_block_memory(sizeof(Block<T, N>))) Block<T, N>;
+}
+
+template <typename T, std::size_t N>
+void delete_block(Block<T, N>* block) noexcept
+{
+  block->~Block();
+  deallocate_block_memory(block, sizeof(Block<T, N>));
+}
+
 /// The shared block list and free chunks. Protected by the allocator mutex.
 template <typename T, std::size_t N>
 struct BlockList
@@ -73,7 +89,7 @@ struct BlockList
     while (block != nullptr)
     {
       Block<T, N>* next = block->next;
-      delete block;
+      delete_block(block);
       block = next;
     }
   }
@@ -105,7 +121,8 @@ struct no_op_mutex
 /// Stores blocks of ElementsPerBlock entries, minimising per-allocation overhead.
 /// Maintains per-thread state so allocation and deallocation are contention-free
 /// on the common path; the shared mutex is only taken when a new block must be
-/// allocated or during consolidate().
+/// allocated or during consolidate(). The memory of the blocks is obtained as
+/// determined by set_block_memory_mode().
 ///
 /// consolidate() must not be called concurrently with any allocations or
 /// deallocations.
@@ -241,7 +258,7 @@ private:
   T* allocate_new_block(LocalState& state)
   {
     std::lock_guard<MutexType> lock(m_mutex);
-    Block* block = new Block;
+    Block* block = detail::new_block<T, N>();
     block->next = m_block_list.head;
     m_block_list.head = block;
 
@@ -325,7 +342,7 @@ private:
       if (all_free)
       {
         *prev = block->next;
-        delete block;
+        detail::delete_block(block);
         ++removed;
       }
       else
@@ -0,0 +1,67 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file block_memory.h
+/// \brief The memory from which the blocks of the block_allocator are obtained.
+
+#ifndef MCRL2_UTILITIES_BLOCK_MEMORY_H_
+#define MCRL2_UTILITIES_BLOCK_MEMORY_H_
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+namespace mcrl2::utilities
+{
+
+/// \brief Determines how the memory for blocks is obtained.
+enum class block_memory_mode
+{
+  standard,       ///< Every block is allocated with operator new.
+  transparent,    ///< Blocks are carved from large regions that are backed by transparent huge pages.
+  explicit_pages  ///< Blocks are carved from large regions that are backed by explicitly reserved huge pages.
+};
+
+/// \brief Parses the mode from one of the strings "standard", "transparent" or "explicit".
+/// \throws mcrl2::runtime_error when the string is not a valid mode.
+block_memory_mode parse_block_memory_mode(const std::string& text);
+
+std::string print_block_memory_mode(block_memory_mode mode);
+
+std::istream& operator>>(std::istream& is, block_memory_mode& mode);
+
+std::ostream& operator<<(std::ostream& os, block_memory_mode mode);
+
+/// \brief Sets the mode for the blocks that are allocated from now on.
+/// \details Blocks that were already allocated keep their memory. The huge page modes are only supported on
+///          Linux; on other platforms a warning is printed and the standard mode is used instead. When no
+///          explicit huge pages are available the transparent mode is used instead.
+void set_block_memory_mode(block_memory_mode mode);
+
+block_memory_mode get_block_memory_mode();
+
+/// \brief Returns memory for a block of the given size.
+/// \details In the standard mode the block is allocated with operator new, without additional memory. In the huge
+///          page modes every thread carves its blocks from its own regions. As a page is placed on the NUMA node of
+///          the thread that touches it first, the blocks of a thread are local to that thread. The memory is aligned
+///          to at least __STDCPP_DEFAULT_NEW_ALIGNMENT__.
+void* allocate_block_memory(std::size_t size);
+
+/// \brief Frees memory obtained from allocate_block_memory(size).
+/// \details Every thread keeps a few of the blocks that it freed for its next allocations, as long as they do not
+///          belong to the regions of other threads. A huge page of a region is returned to the operating system as
+///          soon as all blocks in it have been freed. A region is unmapped as soon as all its blocks have been freed,
+///          unless it is the region from which a thread is currently allocating.
+void deallocate_block_memory(void* pointer, std::size_t size);
+
+/// \returns The number of bytes that are currently reserved for regions.
+std::size_t block_memory_reserved();
+
+} // namespace mcrl2::utilities
+
+#endif // MCRL2_UTILITIES_BLOCK_MEMORY_H_
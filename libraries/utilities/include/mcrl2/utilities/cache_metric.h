@@ -27,6 +27,12 @@ public:
   /// \brief Should be called when searching the cache was a miss.
   void miss() { ++m_miss_count; }
 
+  /// \returns The number of hits.
+  std::size_t hits() const { return m_hit_count; }
+
+  /// \returns The number of misses.
+  std::size_t misses() const { return m_miss_count; }
+
   /// \brief Resets the cache counters.
   void reset()
   {
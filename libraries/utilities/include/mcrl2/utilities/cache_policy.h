@@ -11,6 +11,8 @@
 #define MCRL2_UTILITIES_CACHE_POLICY_H
 
 #include <forward_list>
+#include <list>
+#include <unordered_map>
 
 #include <cassert>
 
@@ -121,6 +123,80 @@ private:
   typename std::forward_list<key_type>::iterator m_last_element_it;
 };
 
+/// \brief Removes the key that has not been found or inserted for the longest time.
+/// \details The keys are stored as the key_type of the map. For the term containers of the atermpp
+///          library this is an unprotected term, which remains valid as long as it is in the map.
+template<typename Map>
+class lru_policy final : public replacement_policy<Map>
+{
+public:
+  using key_type = typename Map::key_type;
+
+  lru_policy() = default;
+
+  lru_policy(const lru_policy& other)
+    : m_queue(other.m_queue)
+  {
+    update_positions();
+  }
+
+  lru_policy& operator=(const lru_policy& other)
+  {
+    m_queue = other.m_queue;
+    update_positions();
+    return *this;
+  }
+
+  // Moving a std::list keeps its iterators valid.
+  lru_policy(lru_policy&& other) noexcept = default;
+  lru_policy& operator=(lru_policy&& other) noexcept = default;
+
+  void clear() override
+  {
+    m_queue.clear();
+    m_positions.clear();
+  }
+
+  typename Map::iterator replacement_candidate(Map& map) override
+  {
+    assert(!m_queue.empty());
+    // The least recently used key is at the back of the queue.
+    auto it = map.find(m_queue.back());
+    m_positions.erase(m_queue.back());
+    m_queue.pop_back();
+    assert(it != map.end());
+    return it;
+  }
+
+  void inserted(const key_type& key) override
+  {
+    m_queue.push_front(key);
+    m_positions[key] = m_queue.begin();
+  }
+
+  void touch(const key_type& key) override
+  {
+    auto it = m_positions.find(key);
+    if (it != m_positions.end())
+    {
+      m_queue.splice(m_queue.begin(), m_queue, it->second);
+    }
+  }
+
+private:
+  void update_positions()
+  {
+    m_positions.clear();
+    for (auto it = m_queue.begin(); it != m_queue.end(); ++it)
+    {
+      m_positions[*it] = it;
+    }
+  }
+
+  std::list<key_type> m_queue; ///< The keys ordered from the most to the least recently used one.
+  std::unordered_map<key_type, typename std::list<key_type>::iterator> m_positions;
+};
+
 } // namespace mcrl2::utilities
 
 #endif // MCRL2_UTILITIES_CACHE_POLICY_H
@@ -175,7 +175,7 @@ inline INDEXED_SET::indexed_set(
 INDEXED_SET_TEMPLATE
 inline typename INDEXED_SET::size_type INDEXED_SET::index(const key_type& key, const std::size_t thread_index) const
 {
-  shared_guard guard(m_shared_mutexes[thread_index]);
+  shared_guard guard = lock_shared(thread_index);
   assert(m_hashtable.size() > 0);
 
   std::size_t start = ((m_hasher(key) * detail::PRIME_NUMBER) >> 2) % m_hashtable.size();
@@ -248,16 +248,37 @@ inline void INDEXED_SET::clear(const std::size_t thread_index)
   m_hashtable.assign(m_hashtable.size(), detail::EMPTY);
 
   m_keys.clear();
+  if (m_fixed_capacity > 0)
+  {
+    m_keys.resize(m_fixed_capacity);
+  }
+  m_next_index.store(0);
+}
+
+INDEXED_SET_TEMPLATE
+inline void INDEXED_SET::set_fixed_capacity(const std::size_t capacity, const std::size_t thread_index)
+{
+  lock_guard guard(m_shared_mutexes[thread_index]);
+  m_fixed_capacity = capacity;
+  m_keys.clear();
+  m_keys.resize(capacity);
   m_next_index.store(0);
+
+  std::size_t hashtable_size = detail::minimal_hashtable_size;
+  while (detail::max_load_factor * hashtable_size < capacity)
+  {
+    hashtable_size = 2 * hashtable_size;
+  }
+  m_hashtable.assign(hashtable_size, detail::EMPTY);
 }
 
 
 INDEXED_SET_TEMPLATE
 inline std::pair<typename INDEXED_SET::size_type, bool> INDEXED_SET::insert(const Key& key, const std::size_t thread_index)
 {
-  shared_guard guard(m_shared_mutexes[thread_index]);
-  assert(m_next_index <= m_keys.size());
-  if (m_next_index + m_shared_mutexes.size() >= m_keys.size())
+  shared_guard guard = lock_shared(thread_index);
+  assert(m_fixed_capacity > 0 || m_next_index <= m_keys.size());
+  if (m_fixed_capacity == 0 && m_next_index + m_shared_mutexes.size() >= m_keys.size())
   {
     guard.unlock();
     reserve_indices(thread_index);
@@ -273,6 +294,16 @@ inline std::pair<typename INDEXED_SET::size_type, bool> INDEXED_SET::insert(cons
   }
 
   const std::size_t new_index = m_next_index.fetch_add(1);
+  if (m_fixed_capacity > 0 && new_index >= m_fixed_capacity)
+  {
+    // The set is full. The reserved position is released again, such that threads that wait for it to be
+    // filled continue. This is safe, as no other key is ever placed beyond a reserved position. The index
+    // is given back as well. As every thread that obtains an index beyond the capacity does so, m_next_index
+    // never drops below the capacity.
+    m_next_index.fetch_sub(1);
+    reinterpret_cast<std::atomic<std::size_t>*>(&m_hashtable[new_position])->store(detail::EMPTY);
+    throw mcrl2::runtime_error("The indexed set cannot contain more than " + std::to_string(m_fixed_capacity) + " elements.");
+  }
   assert(new_index < m_keys.size());
   m_keys[new_index] = key; 
 
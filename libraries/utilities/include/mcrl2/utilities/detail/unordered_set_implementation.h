@@ -131,6 +131,36 @@ auto MCRL2_UNORDERED_SET_CLASS::erase(typename MCRL2_UNORDERED_SET_CLASS::const_
   return result_it;
 }
 
+MCRL2_UNORDERED_SET_TEMPLATES
+template<typename Predicate>
+std::size_t MCRL2_UNORDERED_SET_CLASS::erase_if(size_type first, size_type last, Predicate predicate)
+{
+  assert(first <= last && last <= m_buckets.size());
+  size_type erased = 0;
+
+  for (size_type i = first; i < last; ++i)
+  {
+    bucket_type& bucket = m_buckets[i];
+    for (auto before_it = bucket.before_begin(), it = bucket.begin(); it != bucket.end(); )
+    {
+      if (predicate(*it))
+      {
+        it = bucket.erase_after(m_allocator, before_it);
+        ++erased;
+      }
+      else
+      {
+        before_it = it;
+        ++it;
+      }
+    }
+  }
+
+  // Only a single update of the number of elements, which is atomic when ThreadSafe is set.
+  m_number_of_elements -= erased;
+  return erased;
+}
+
 MCRL2_UNORDERED_SET_TEMPLATES
 template<typename ...Args>
 std::size_t MCRL2_UNORDERED_SET_CLASS::count(const Args&... args) const
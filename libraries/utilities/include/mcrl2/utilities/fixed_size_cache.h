@@ -28,20 +28,14 @@ public:
   using iterator = typename Policy::map_type::iterator;
   using const_iterator = typename Policy::map_type::const_iterator;
 
+  /// \brief Constructor of a cache that contains at most max_size elements, where zero means unbounded.
   explicit fixed_size_cache(std::size_t max_size = 1024)
-    : m_map(max_size)
-  {
-    if (max_size == 0)
-    {
-      m_maximum_size = std::numeric_limits<std::size_t>::max();
-    }
-    else
-    {
-      // The reason for this is that the internal mapping might only support powers of two and as such
-      // we might as well use the additional capacity.
-      m_maximum_size = m_map.capacity();
-    }
-  }
+    : m_map(max_size),
+      m_maximum_size(max_size == 0 ? std::numeric_limits<std::size_t>::max() : max_size)
+  {}
+
+  iterator begin() { return m_map.begin(); }
+  iterator end() { return m_map.end(); }
 
   const_iterator begin() const { return m_map.begin(); }
   const_iterator end() const { return m_map.end(); }
@@ -50,9 +44,42 @@ public:
 
   std::size_t count(const key_type& key) const { return m_map.count(key); }
 
-  iterator find(const key_type& key)
+  /// \returns The number of elements in the cache.
+  std::size_t size() const { return m_map.size(); }
+
+  /// \brief Searches for the given key, which can be any type that the hash and equality of the map accept.
+  /// \details A key that is found is reported to the policy as recently used.
+  template<typename K>
+  iterator find(const K& key)
+  {
+    auto result = m_map.find(key);
+    if (result != m_map.end())
+    {
+      m_policy.touch(result->first);
+    }
+    return result;
+  }
+
+  /// \brief Stores the value constructed from args for the given key, unless the key is already present.
+  ///        If the cache is full the element defined by the policy is removed first.
+  template<typename ...Args>
+  std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args)
   {
-    return m_map.find(key);
+    auto result = m_map.find(key);
+    if (result != m_map.end())
+    {
+      return std::make_pair(result, false);
+    }
+
+    if (m_map.size() >= m_maximum_size)
+    {
+      m_map.erase(m_policy.replacement_candidate(m_map));
+    }
+
+    auto emplace_result = m_map.try_emplace(key, std::forward<Args>(args)...);
+    m_policy.inserted((*emplace_result.first).first);
+    assert(m_map.size() <= m_maximum_size);
+    return emplace_result;
   }
 
   /// \brief Stores the given key-value pair in the cache. Depending on the cache policy and capacity an existing element
@@ -66,8 +93,8 @@ public:
     auto result = find(args...);
     if (result == m_map.end())
     {
-      // If the cache would be full after an inserted.
-      if (m_map.size() + 1 >= m_maximum_size)
+      // If the cache is full.
+      if (m_map.size() >= m_maximum_size)
       {
         // Remove an existing element defined by the policy.
         m_map.erase(m_policy.replacement_candidate(m_map));
@@ -120,8 +147,8 @@ public:
     auto result = find(args...);
     if (result == m_map.end())
     {
-      // If the cache would be full after an inserted.
-      if (m_map.size() + 1 >= m_maximum_size)
+      // If the cache is full.
+      if (m_map.size() >= m_maximum_size)
       {
         // Remove an existing element defined by the policy.
         m_map.erase(m_policy.replacement_candidate(m_map));
@@ -146,6 +173,9 @@ private:
 template<typename Key, typename T>
 using fifo_cache = fixed_size_cache<fifo_policy<mcrl2::utilities::unordered_map<Key, T>>>;
 
+template<typename Key, typename T>
+using lru_cache = fixed_size_cache<lru_policy<mcrl2::utilities::unordered_map<Key, T>>>;
+
 template<typename F, typename Args>
 using fifo_function_cache = function_cache<
   fifo_policy<mcrl2::utilities::unordered_map<Args, decltype(std::declval<F>()(std::declval<Args>()))>>,
@@ -12,6 +12,7 @@
 #include <deque>
 #include <mutex>
 
+#include "mcrl2/utilities/exception.h"
 #include "mcrl2/utilities/unordered_map.h"
 #include "mcrl2/utilities/detail/atomic_wrapper.h"
 #include "mcrl2/utilities/shared_mutex.h"
@@ -41,9 +42,24 @@ private:
   //  large steps, avoiding exclusive access too often.  
   detail::atomic_wrapper<size_t> m_next_index;
 
+  /// \brief If not zero, the key table and the hashtable are allocated once for this number of keys.
+  ///        In that case they are never resized, and no exclusive access is ever required.
+  std::size_t m_fixed_capacity = 0;
+
   Hash m_hasher;
   Equals m_equals;
 
+  /// \brief Obtain a shared lock for the given thread. With a fixed capacity there is no
+  ///        exclusive phase to protect against, and the returned guard does not hold a lock.
+  shared_guard lock_shared(std::size_t thread_index) const
+  {
+    if (m_fixed_capacity == 0)
+    {
+      return shared_guard(m_shared_mutexes[thread_index]);
+    }
+    return shared_guard(m_shared_mutexes[thread_index], std::defer_lock);
+  }
+
   /// \brief Reserve indices that can be used. Doing this 
   ///        infrequently prevents obtaining an exclusive lock for the
   ///        indexed set too often. This operation requires a
@@ -128,7 +144,7 @@ public:
   /// \details Complexity is constant per operation.
   iterator begin(std::size_t thread_index = 0) 
   { 
-    shared_guard guard(m_shared_mutexes[thread_index]);
+    shared_guard guard = lock_shared(thread_index);
     iterator i = m_keys.begin();
     return i;
   }
@@ -136,7 +152,7 @@ public:
   /// \brief End of the forward iterator.
   iterator end(std::size_t thread_index = 0)
   { 
-    shared_guard guard(m_shared_mutexes[thread_index]);
+    shared_guard guard = lock_shared(thread_index);
     iterator i = m_keys.begin()+m_next_index;
     return i;
   }
@@ -145,7 +161,7 @@ public:
   /// \details Complexity is constant per operation.
   const_iterator begin(std::size_t thread_index = 0) const
   {
-    shared_guard guard(m_shared_mutexes[thread_index]);
+    shared_guard guard = lock_shared(thread_index);
     const_iterator i = m_keys.begin();
     return i;
   }
@@ -153,7 +169,7 @@ public:
   /// \brief End of the forward iterator.
   const_iterator end(std::size_t thread_index = 0) const
   {
-    shared_guard guard(m_shared_mutexes[thread_index]);
+    shared_guard guard = lock_shared(thread_index);
     const_iterator i = m_keys.begin()+m_next_index;
     return i;
   }
@@ -161,7 +177,7 @@ public:
   /// \brief const_iterator going through the elements in the set numbered from zero upwards. 
   const_iterator cbegin(std::size_t thread_index = 0) const
   { 
-    shared_guard guard(m_shared_mutexes[thread_index]);
+    shared_guard guard = lock_shared(thread_index);
     const_iterator i = m_keys.begin();
     return i;
   }
@@ -169,7 +185,7 @@ public:
   /// \brief End of the forward const_iterator. 
   const_iterator cend(std::size_t thread_index = 0) const 
   { 
-    shared_guard guard(m_shared_mutexes[thread_index]);
+    shared_guard guard = lock_shared(thread_index);
     const_iterator i = m_keys.cbegin() + m_next_index;
     return i;
   }
@@ -177,7 +193,7 @@ public:
   /// \brief Reverse iterator going through the elements in the set from the largest to the smallest index. 
   reverse_iterator rbegin(std::size_t thread_index = 0) 
   { 
-    shared_guard guard(m_shared_mutexes[thread_index]);
+    shared_guard guard = lock_shared(thread_index);
     reverse_iterator i = m_keys.rend() - m_next_index;
     return i;
   }
@@ -185,7 +201,7 @@ public:
   /// \brief End of the reverse iterator. 
   reverse_iterator rend(std::size_t thread_index = 0)
   { 
-    shared_guard guard(m_shared_mutexes[thread_index]);
+    shared_guard guard = lock_shared(thread_index);
     reverse_iterator i = m_keys.rend();
     return i;
   }
@@ -193,7 +209,7 @@ public:
   /// \brief Reverse const_iterator going through the elements from the highest to the lowest numbered element. 
   const_reverse_iterator crbegin(std::size_t thread_index = 0) const
   { 
-    shared_guard guard(m_shared_mutexes[thread_index]);
+    shared_guard guard = lock_shared(thread_index);
     const_reverse_iterator i=m_keys.crend() - m_next_index;
     return i;
   }
@@ -201,7 +217,7 @@ public:
   /// \brief End of the reverse const_iterator. 
   const_reverse_iterator crend(std::size_t thread_index = 0) const 
   { 
-    shared_guard guard(m_shared_mutexes[thread_index]);
+    shared_guard guard = lock_shared(thread_index);
     const_reverse_iterator i = m_keys.crend();
     return i;
   }
@@ -209,6 +225,21 @@ public:
   /// \brief Clears the indexed set by removing all its elements. It is not guaranteed that the memory is released too. 
   void clear(std::size_t thread_index=0);
 
+  /// \brief Allocates the indexed set for at most capacity elements, after which it never grows.
+  /// \details Afterwards, insert and index never require exclusive access to the indexed set and
+  ///          they do not take the shared mutexes, i.e., the set is lock free. Inserting more
+  ///          than capacity elements results in a mcrl2::runtime_error, after which the set is unchanged and
+  ///          can still be used. This function clears the set
+  ///          and it cannot be called concurrently with other operations on the set. 
+  /// \param capacity The maximal number of elements in the set. Zero means no fixed capacity.
+  void set_fixed_capacity(std::size_t capacity, std::size_t thread_index = 0);
+
+  /// \returns The maximal number of elements of the set, or zero if the set can grow arbitrarily.
+  std::size_t fixed_capacity() const
+  {
+    return m_fixed_capacity;
+  }
+
   /// \brief Insert a key in the indexed set and return its index. 
   /// \details If the element was already in the set, the resulting bool is true, and the existing index is returned.
   ///         Otherwise, the key is inserted in the set, and the next available index is assigned to it. 
@@ -227,8 +258,13 @@ public:
   /// \details threadsafe
   size_type size(std::size_t thread_index = 0) const
   { 
-    shared_guard guard(m_shared_mutexes[thread_index]);
+    shared_guard guard = lock_shared(thread_index);
     size_type result=m_next_index;
+    // A failed insertion into a full set of fixed capacity may temporarily exceed the capacity.
+    if (m_fixed_capacity > 0 && result > m_fixed_capacity)
+    {
+      result = m_fixed_capacity;
+    }
     return result;
   }
 };
@@ -0,0 +1,214 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/utilities/parallel_for.h
+/// \brief Distributes a loop over a range of indices over multiple threads.
+
+#ifndef MCRL2_UTILITIES_PARALLEL_FOR_H
+#define MCRL2_UTILITIES_PARALLEL_FOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mcrl2::utilities
+{
+
+namespace detail
+{
+
+// Returns a function for the thread with the given index that calls f for the ranges that it obtains from next.
+// An exception is stored in exceptions, after which no further ranges are handed out.
+template <typename Function>
+auto range_worker(const std::size_t n,
+                  Function& f,
+                  const std::size_t range_size,
+                  std::atomic<std::size_t>& next,
+                  std::vector<std::exception_ptr>& exceptions)
+{
+  return [&, n, range_size](const std::size_t thread_index)
+  {
+    try
+    {
+      for (std::size_t begin = next.fetch_add(range_size); begin < n; begin = next.fetch_add(range_size))
+      {
+        f(thread_index, begin, std::min(begin + range_size, n));
+      }
+    }
+    catch (...)
+    {
+      exceptions[thread_index] = std::current_exception();
+      next = n;
+    }
+  };
+}
+
+inline
+void rethrow_first_exception(const std::vector<std::exception_ptr>& exceptions)
+{
+  for (const std::exception_ptr& exception: exceptions)
+  {
+    if (exception)
+    {
+      std::rethrow_exception(exception);
+    }
+  }
+}
+
+} // namespace detail
+
+/// \brief Calls f(thread_index, begin, end) for consecutive ranges that together cover [0, n).
+/// \details The ranges, of at most range_size indices, are handed out dynamically to the given number of
+///          threads, which are numbered from 0. An exception thrown by f is rethrown in the calling thread.
+///          The threads are created for this call only; use a thread_pool for loops that are executed often.
+template <typename Function>
+void parallel_for_ranges(const std::size_t n, const std::size_t number_of_threads, Function f, const std::size_t range_size = 1024)
+{
+  if (number_of_threads == 1 || n <= range_size)
+  {
+    f(0, 0, n);
+    return;
+  }
+
+  std::atomic<std::size_t> next = 0;
+  std::vector<std::exception_ptr> exceptions(number_of_threads);
+  auto worker = detail::range_worker(n, f, range_size, next, exceptions);
+
+  std::vector<std::thread> threads;
+  for (std::size_t i = 1; i < number_of_threads; ++i)
+  {
+    threads.emplace_back(worker, i);
+  }
+  worker(0);
+
+  for (std::thread& thread: threads)
+  {
+    thread.join();
+  }
+  detail::rethrow_first_exception(exceptions);
+}
+
+/// \brief A fixed number of threads that execute parallel loops, such that the threads are created once
+///        instead of for every loop.
+/// \details The calling thread takes part in every loop as the thread with index 0, so a pool for n threads
+///          starts n-1 threads. The threads wait on a condition variable in between two loops. A pool must be
+///          used by one thread at a time.
+class thread_pool
+{
+  protected:
+    std::size_t m_number_of_threads;
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_mutex;
+    std::condition_variable m_start;       // Signalled when a loop is started or the pool is destroyed.
+    std::condition_variable m_finished;    // Signalled when the last thread of the pool finished a loop.
+    const std::function<void(std::size_t)>* m_job = nullptr;
+    std::size_t m_generation = 0;          // Incremented for every loop.
+    std::size_t m_running = 0;             // The number of threads of the pool that did not finish the loop.
+    bool m_stop = false;
+
+    void work(const std::size_t thread_index)
+    {
+      std::size_t generation = 0;
+      while (true)
+      {
+        {
+          std::unique_lock lock(m_mutex);
+          m_start.wait(lock, [&]() { return m_stop || m_generation != generation; });
+          if (m_stop)
+          {
+            return;
+          }
+          generation = m_generation;
+        }
+
+        (*m_job)(thread_index);
+
+        std::lock_guard lock(m_mutex);
+        if (--m_running == 0)
+        {
+          m_finished.notify_one();
+        }
+      }
+    }
+
+    // Calls job(thread_index) in every thread and returns when all calls have finished. The job must not throw.
+    void run(const std::function<void(std::size_t)>& job)
+    {
+      {
+        std::lock_guard lock(m_mutex);
+        m_job = &job;
+        m_running = m_threads.size();
+        m_generation++;
+      }
+      m_start.notify_all();
+
+      job(0);
+
+      std::unique_lock lock(m_mutex);
+      m_finished.wait(lock, [&]() { return m_running == 0; });
+      m_job = nullptr;
+    }
+
+  public:
+    explicit thread_pool(const std::size_t number_of_threads)
+      : m_number_of_threads(std::max<std::size_t>(number_of_threads, 1))
+    {
+      for (std::size_t i = 1; i < m_number_of_threads; ++i)
+      {
+        m_threads.emplace_back([this, i]() { work(i); });
+      }
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    ~thread_pool()
+    {
+      {
+        std::lock_guard lock(m_mutex);
+        m_stop = true;
+      }
+      m_start.notify_all();
+      for (std::thread& thread: m_threads)
+      {
+        thread.join();
+      }
+    }
+
+    std::size_t number_of_threads() const
+    {
+      return m_number_of_threads;
+    }
+
+    /// \brief Calls f(thread_index, begin, end) for consecutive ranges that together cover [0, n), using the
+    ///        threads of the pool, see the function parallel_for_ranges.
+    template <typename Function>
+    void parallel_for_ranges(const std::size_t n, Function f, const std::size_t range_size = 1024)
+    {
+      if (m_number_of_threads == 1 || n <= range_size)
+      {
+        f(0, 0, n);
+        return;
+      }
+
+      std::atomic<std::size_t> next = 0;
+      std::vector<std::exception_ptr> exceptions(m_number_of_threads);
+      run(detail::range_worker(n, f, range_size, next, exceptions));
+      detail::rethrow_first_exception(exceptions);
+    }
+};
+
+} // namespace mcrl2::utilities
+
+#endif // MCRL2_UTILITIES_PARALLEL_FOR_H
@@ -221,6 +221,12 @@ public:
     m_reference.tag();
   }
 
+  /// \returns True iff this call applied the tag, see tagged_pointer::try_tag().
+  bool try_tag() const
+  {
+    return m_reference.try_tag();
+  }
+
   void untag() const
   {
     m_reference.untag();
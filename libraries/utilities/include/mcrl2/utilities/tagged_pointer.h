@@ -83,6 +83,33 @@ public:
     m_pointer = mcrl2::utilities::tag(m_pointer);
   }
 
+  /// \brief Apply the tag unless it was already applied.
+  /// \returns True iff this call applied the tag, which is decided atomically when threads are enabled.
+  bool try_tag() const
+  {
+    if constexpr (detail::GlobalThreadSafe)
+    {
+      T* expected = m_pointer.load(std::memory_order_relaxed);
+      while (!mcrl2::utilities::tagged(expected))
+      {
+        if (m_pointer.compare_exchange_weak(expected, mcrl2::utilities::tag(expected), std::memory_order_relaxed))
+        {
+          return true;
+        }
+      }
+      return false;
+    }
+    else
+    {
+      if (tagged())
+      {
+        return false;
+      }
+      tag();
+      return true;
+    }
+  }
+
   /// \brief Remove the tag.
   void untag() const
   {
@@ -119,6 +119,18 @@ class uncompiled_library : public dynamic_library
       m_filename = m_tempfiles.back();
     }
 
+    /// \brief Uses the given library, which has been compiled before, instead of compiling a source file.
+    void use_compiled(const std::string& filename)
+    {
+      m_filename = filename;
+    }
+
+    /// \returns The file name of the compiled library.
+    const std::string& library_filename() const
+    {
+      return m_filename;
+    }
+
     void leave_files()
     {
       m_tempfiles.clear();
@@ -294,6 +294,13 @@ public:
   /// \returns An iterator to the next key.
   iterator erase(const_iterator it);
 
+  /// \brief Erases the elements in the buckets with an index in [first, last) that satisfy the predicate.
+  /// \details Not standard. Disjoint ranges of buckets can be processed concurrently provided that the
+  ///          allocator supports concurrent deallocation and that no other operations take place.
+  /// \returns The number of erased elements.
+  template<typename Predicate>
+  size_type erase_if(size_type first, size_type last, Predicate predicate);
+
   /// \brief Counts the number of occurrences of the given key (1 when it exists and 0 otherwise).
   template<typename ...Args>
   size_type count(const Args&... args) const;
@@ -321,7 +328,7 @@ public:
   size_type max_bucket_count() const noexcept { return m_buckets.max_size(); }
 
   size_type bucket_size(size_type n) const noexcept { return std::distance(m_buckets[n].begin(), m_buckets[n].end()); }
-  size_type bucket(const key_type& key) const noexcept { return std::distance(m_buckets.begin(), find_bucket_index(key)); }
+  size_type bucket(const key_type& key) const noexcept { return find_bucket_index(key); }
 
   float load_factor() const { return static_cast<float>(size()) / bucket_count(); }
   float max_load_factor() const { return m_max_load_factor; }
@@ -0,0 +1,646 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "mcrl2/utilities/block_memory.h"
+#include "mcrl2/utilities/exception.h"
+#include "mcrl2/utilities/logger.h"
+#include "mcrl2/utilities/platform.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#ifdef MCRL2_PLATFORM_LINUX
+  #include <sys/mman.h>
+  #include <unistd.h>
+#endif
+
+using namespace mcrl2::utilities;
+
+namespace
+{
+
+/// \brief The size of a (transparent) huge page, which is 2 MiB on all common Linux platforms.
+constexpr std::size_t huge_page_size = std::size_t(1) << 21;
+
+/// \brief The size of a region, which is reserved as a whole but only backed by memory when it is used.
+constexpr std::size_t region_size = 16 * huge_page_size;
+
+/// \brief Blocks are aligned to cache lines, such that the blocks of different threads share no cache lines.
+constexpr std::size_t block_alignment = 64;
+
+/// \brief The number of freed blocks that a thread keeps for its own allocations without taking the lock.
+constexpr std::size_t thread_free_blocks = 8;
+
+static_assert(block_alignment >= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+
+std::size_t round_up(std::size_t value, std::size_t multiple)
+{
+  return (value + multiple - 1) / multiple * multiple;
+}
+
+/// \brief The size of a block in a region, which is never empty such that the blocks have different addresses.
+std::size_t region_block_size(std::size_t size)
+{
+  return round_up(std::max<std::size_t>(size, 1), block_alignment);
+}
+
+/// \brief Returns the given huge page to the operating system. It reads as zeroes when it is used again.
+void release_huge_page([[maybe_unused]] char* page)
+{
+#ifdef MCRL2_PLATFORM_LINUX
+  madvise(page, huge_page_size, MADV_DONTNEED);
+#endif
+}
+
+struct thread_arena;
+
+/// \brief A region of memory from which the blocks of one thread are carved.
+/// \details The fields begin, size and huge_tlb do not change. The list of regions of the owner and the owner
+///          itself are only changed while holding the global lock, and the other fields while holding the lock
+///          of the region. The global lock is taken first.
+struct region
+{
+  char* begin = nullptr;
+  std::size_t size = 0;
+  std::size_t used = 0;        ///< The blocks are bump allocated from [begin + used, begin + size).
+  std::size_t live_blocks = 0; ///< The number of blocks that have not been freed.
+  bool huge_tlb = false;       ///< The region consists of explicit huge pages, which cannot be released partially.
+  std::atomic<thread_arena*> owner = nullptr;
+  std::mutex mutex;
+
+  /// The freed blocks together with their size, which are reused for blocks of the same size.
+  std::vector<std::pair<std::size_t, char*>> free_blocks;
+
+  /// The number of live blocks that overlap each huge page of the region.
+  std::vector<std::uint32_t> page_blocks;
+
+  char* take_free_block(std::size_t size)
+  {
+    auto it = std::find_if(free_blocks.begin(), free_blocks.end(), [size](const auto& block) { return block.first == size; });
+    if (it == free_blocks.end())
+    {
+      return nullptr;
+    }
+
+    char* result = it->second;
+    *it = free_blocks.back();
+    free_blocks.pop_back();
+    add_block(result, size);
+    return result;
+  }
+
+  /// \brief Counts the block [block, block + size) as live.
+  void add_block(char* block, std::size_t size)
+  {
+    ++live_blocks;
+    for (std::size_t page = first_page(block); page <= last_page(block, size); ++page)
+    {
+      ++page_blocks[page];
+    }
+  }
+
+  /// \brief Counts the block [block, block + size) as freed, and returns the huge pages in which no block is live
+  ///        anymore to the operating system.
+  void remove_block(char* block, std::size_t size)
+  {
+    assert(live_blocks > 0);
+    --live_blocks;
+    for (std::size_t page = first_page(block); page <= last_page(block, size); ++page)
+    {
+      assert(page_blocks[page] > 0);
+      if (--page_blocks[page] == 0 && !huge_tlb)
+      {
+        release_huge_page(begin + page * huge_page_size);
+      }
+    }
+  }
+
+private:
+  std::size_t first_page(const char* block) const
+  {
+    return static_cast<std::size_t>(block - begin) / huge_page_size;
+  }
+
+  std::size_t last_page(const char* block, std::size_t size) const
+  {
+    return static_cast<std::size_t>(block + size - 1 - begin) / huge_page_size;
+  }
+};
+
+/// \brief Maps the huge pages of all regions to their region, such that the region of a block is found without a
+///        header in front of the block and without a lock.
+/// \details The map consists of a root of which the entries point to leaves with the regions of consecutive huge
+///          pages. The leaves are created when needed and never removed. Entries are only changed while holding
+///          the global lock of the block memory. Addresses are assumed to fit in 48 bits, which holds for the memory
+///          that the operating systems give to user processes.
+class region_map
+{
+public:
+  /// \returns The region that contains the given address, or nullptr when it was not allocated in a region.
+  region* find(const void* address) const
+  {
+    const std::uintptr_t page = reinterpret_cast<std::uintptr_t>(address) / huge_page_size;
+    if (page >= root_size * leaf_size)
+    {
+      return nullptr;
+    }
+
+    const leaf* l = m_root[page / leaf_size].load(std::memory_order_acquire);
+    return l == nullptr ? nullptr : (*l)[page % leaf_size].load(std::memory_order_acquire);
+  }
+
+  /// \brief Maps the huge pages in [begin, begin + size) to the given region.
+  void assign(char* begin, std::size_t size, region* r)
+  {
+    const std::uintptr_t first = reinterpret_cast<std::uintptr_t>(begin) / huge_page_size;
+    if (first + size / huge_page_size > root_size * leaf_size)
+    {
+      throw std::bad_alloc();
+    }
+
+    for (std::uintptr_t page = first; page < first + size / huge_page_size; ++page)
+    {
+      std::atomic<leaf*>& entry = m_root[page / leaf_size];
+      leaf* l = entry.load(std::memory_order_relaxed);
+      if (l == nullptr)
+      {
+        l = new leaf();
+        entry.store(l, std::memory_order_release);
+      }
+      (*l)[page % leaf_size].store(r, std::memory_order_release);
+    }
+  }
+
+private:
+  static constexpr std::size_t address_bits = 48;
+  static constexpr std::size_t leaf_size = std::size_t(1) << 15;
+  static constexpr std::size_t root_size = (std::size_t(1) << address_bits) / huge_page_size / leaf_size;
+
+  using leaf = std::array<std::atomic<region*>, leaf_size>;
+
+  std::array<std::atomic<leaf*>, root_size> m_root{};
+};
+
+/// \brief The regions that belong to a single thread.
+struct thread_arena
+{
+  region* current = nullptr;
+  std::vector<region*> regions;
+
+  /// The blocks that this thread freed most recently together with their size, which are only accessed by
+  /// this thread. They are allocated with operator new or from a region of this thread, and count as live
+  /// blocks.
+  std::vector<std::pair<std::size_t, void*>> free_blocks;
+
+  void* take_free_block(std::size_t size)
+  {
+    auto it = std::find_if(free_blocks.begin(), free_blocks.end(), [size](const auto& block) { return block.first == size; });
+    if (it == free_blocks.end())
+    {
+      return nullptr;
+    }
+
+    void* result = it->second;
+    free_blocks.erase(it);
+    return result;
+  }
+};
+
+class block_memory
+{
+public:
+  void set_mode(block_memory_mode mode)
+  {
+#ifndef MCRL2_PLATFORM_LINUX
+    if (mode != block_memory_mode::standard)
+    {
+      mCRL2log(mcrl2::log::warning) << "Huge pages are not supported on this platform, using the standard memory allocation instead.\n";
+      mode = block_memory_mode::standard;
+    }
+#endif
+    m_mode = mode;
+  }
+
+  block_memory_mode mode() const { return m_mode.load(std::memory_order_relaxed); }
+
+  std::size_t reserved()
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_reserved;
+  }
+
+  /// \returns The region of the given block, or nullptr when it was allocated with operator new.
+  region* find_region(const void* block) const
+  {
+    return m_region_map.find(block);
+  }
+
+  void* allocate(thread_arena& arena, block_memory_mode mode, std::size_t size)
+  {
+    size = region_block_size(size);
+    std::lock_guard<std::mutex> guard(m_mutex);
+
+    // Reuse a freed block of the same size of this thread, or of a thread that has terminated.
+    for (region* r : arena.regions)
+    {
+      std::lock_guard<std::mutex> region_guard(r->mutex);
+      if (char* block = r->take_free_block(size))
+      {
+        return block;
+      }
+    }
+
+    for (auto it = m_orphans.begin(); it != m_orphans.end(); ++it)
+    {
+      region* r = *it;
+      std::lock_guard<std::mutex> region_guard(r->mutex);
+      if (char* block = r->take_free_block(size))
+      {
+        r->owner = &arena;
+        arena.regions.push_back(r);
+        m_orphans.erase(it);
+        return block;
+      }
+    }
+
+    region* r = arena.current;
+    std::unique_lock<std::mutex> region_guard;
+    if (r != nullptr)
+    {
+      region_guard = std::unique_lock<std::mutex>(r->mutex);
+    }
+    if (r == nullptr || r->used + size > r->size)
+    {
+      r = create_region(arena, mode, size);
+      arena.current = r;
+      region_guard = std::unique_lock<std::mutex>(r->mutex);
+    }
+
+    char* block = r->begin + r->used;
+    r->used += size;
+    r->add_block(block, size);
+    return block;
+  }
+
+  /// \brief Frees a block that was allocated with operator new or in a region.
+  void deallocate(void* pointer, std::size_t size)
+  {
+    region* r = find_region(pointer);
+    if (r == nullptr)
+    {
+      // This block was allocated in the standard mode.
+      ::operator delete(pointer);
+      return;
+    }
+    deallocate(r, pointer, size);
+  }
+
+  /// \brief Frees a block of the given region.
+  /// \details The huge pages in which no block is live anymore are returned to the operating system, as blocks are
+  ///          mostly freed by the consolidation after garbage collection and are not needed again soon.
+  void deallocate(region* r, void* pointer, std::size_t size)
+  {
+    size = region_block_size(size);
+
+    {
+      std::lock_guard<std::mutex> region_guard(r->mutex);
+      assert(r->live_blocks > 0);
+      if (r->live_blocks > 1)
+      {
+        r->remove_block(static_cast<char*>(pointer), size);
+        r->free_blocks.emplace_back(size, static_cast<char*>(pointer));
+        return;
+      }
+    }
+
+    // This is the last live block of the region, unless another thread has taken a free block in the meantime.
+    // Releasing or resetting the region requires the global lock.
+    std::lock_guard<std::mutex> guard(m_mutex);
+    std::unique_lock<std::mutex> region_guard(r->mutex);
+    r->remove_block(static_cast<char*>(pointer), size);
+    thread_arena* owner = r->owner.load(std::memory_order_relaxed);
+    if (r->live_blocks > 0)
+    {
+      r->free_blocks.emplace_back(size, static_cast<char*>(pointer));
+    }
+    else if (owner != nullptr && owner->current == r)
+    {
+      // Keep the region from which the thread allocates, but start at its beginning again.
+      r->used = 0;
+      r->free_blocks.clear();
+    }
+    else
+    {
+      region_guard.unlock();
+      release_region(r);
+    }
+  }
+
+  /// \brief Releases the empty regions of a terminated thread and makes the others available to other threads.
+  void thread_exit(thread_arena& arena)
+  {
+    std::vector<std::pair<std::size_t, void*>> free_blocks;
+    std::swap(free_blocks, arena.free_blocks);
+    for (const auto& [size, block] : free_blocks)
+    {
+      deallocate(block, size);
+    }
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    arena.current = nullptr;
+
+    std::vector<region*> regions;
+    std::swap(regions, arena.regions);
+    for (region* r : regions)
+    {
+      r->owner = nullptr;
+      std::unique_lock<std::mutex> region_guard(r->mutex);
+      if (r->live_blocks == 0)
+      {
+        region_guard.unlock();
+        release_region(r);
+      }
+      else
+      {
+        m_orphans.push_back(r);
+      }
+    }
+  }
+
+private:
+
+  region* create_region(thread_arena& arena, block_memory_mode mode, std::size_t minimum_size)
+  {
+    const std::size_t size = std::max(region_size, round_up(minimum_size, huge_page_size));
+
+    auto r = std::make_unique<region>();
+    r->begin = static_cast<char*>(map(mode, size, r->huge_tlb));
+    r->size = size;
+    r->owner = &arena;
+    r->page_blocks.resize(size / huge_page_size, 0);
+
+    try
+    {
+      m_region_map.assign(r->begin, size, r.get());
+    }
+    catch (const std::bad_alloc&)
+    {
+      unmap(r->begin, size);
+      throw;
+    }
+
+    region* result = r.get();
+    arena.regions.push_back(result);
+    m_regions.emplace(result->begin, std::move(r));
+    m_reserved += size;
+    return result;
+  }
+
+  void release_region(region* r)
+  {
+    thread_arena* owner = r->owner.load(std::memory_order_relaxed);
+    if (owner != nullptr)
+    {
+      std::vector<region*>& regions = owner->regions;
+      regions.erase(std::find(regions.begin(), regions.end(), r));
+      if (owner->current == r)
+      {
+        owner->current = nullptr;
+      }
+    }
+    else
+    {
+      auto it = std::find(m_orphans.begin(), m_orphans.end(), r);
+      if (it != m_orphans.end())
+      {
+        m_orphans.erase(it);
+      }
+    }
+
+    m_reserved -= r->size;
+    m_region_map.assign(r->begin, r->size, nullptr);
+    unmap(r->begin, r->size);
+    m_regions.erase(r->begin);
+  }
+
+  /// \brief Reserves size bytes, which must be a multiple of the huge page size, aligned to a huge page.
+  /// \param huge_tlb Set to true iff the memory consists of explicit huge pages.
+  void* map([[maybe_unused]] block_memory_mode mode, std::size_t size, bool& huge_tlb)
+  {
+    huge_tlb = false;
+#ifdef MCRL2_PLATFORM_LINUX
+  #ifdef MAP_HUGETLB
+    if (mode == block_memory_mode::explicit_pages)
+    {
+      void* result = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+      if (result != MAP_FAILED)
+      {
+        huge_tlb = true;
+        return result;
+      }
+
+      mCRL2log(mcrl2::log::warning) << "Could not reserve explicit huge pages, using transparent huge pages instead.\n";
+      m_mode = block_memory_mode::transparent;
+    }
+  #endif
+
+    // Reserve an additional huge page such that the region can be aligned to a huge page.
+    const std::size_t reserved_size = size + huge_page_size;
+    void* reserved = mmap(nullptr, reserved_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (reserved == MAP_FAILED)
+    {
+      throw std::bad_alloc();
+    }
+
+    char* begin = static_cast<char*>(reserved);
+    char* result = reinterpret_cast<char*>(round_up(reinterpret_cast<std::uintptr_t>(begin), huge_page_size));
+    if (result != begin)
+    {
+      munmap(begin, result - begin);
+    }
+    munmap(result + size, begin + reserved_size - (result + size));
+
+  #ifdef MADV_HUGEPAGE
+    madvise(result, size, MADV_HUGEPAGE);
+  #endif
+    return result;
+#else
+    return ::operator new(size, std::align_val_t(huge_page_size));
+#endif
+  }
+
+  static void unmap(char* begin, [[maybe_unused]] std::size_t size)
+  {
+#ifdef MCRL2_PLATFORM_LINUX
+    munmap(begin, size);
+#else
+    ::operator delete(begin, std::align_val_t(huge_page_size));
+#endif
+  }
+
+  std::atomic<block_memory_mode> m_mode = block_memory_mode::standard;
+
+  std::mutex m_mutex;
+  std::map<char*, std::unique_ptr<region>> m_regions; ///< All regions indexed by their first address.
+  region_map m_region_map;
+  std::vector<region*> m_orphans;                     ///< The regions of terminated threads.
+  std::size_t m_reserved = 0;
+};
+
+/// \brief The block memory is never destroyed, as blocks can be freed during the destruction of static objects.
+block_memory& g_block_memory()
+{
+  static block_memory* memory = new block_memory();
+  return *memory;
+}
+
+/// \brief The arena of a thread, which is trivially destructible such that it can still be used after the
+///        thread_arena_guard of the thread has been destroyed.
+thread_local thread_arena* t_arena = nullptr;
+
+/// \brief Hands the regions of a thread over when it terminates.
+struct thread_arena_guard
+{
+  ~thread_arena_guard()
+  {
+    if (t_arena != nullptr)
+    {
+      g_block_memory().thread_exit(*t_arena);
+      delete t_arena;
+      t_arena = nullptr;
+    }
+  }
+};
+
+thread_local thread_arena_guard t_arena_guard;
+
+thread_arena& local_arena()
+{
+  if (t_arena == nullptr)
+  {
+    // Constructs the guard of this thread.
+    static_cast<void>(&t_arena_guard);
+    t_arena = new thread_arena();
+  }
+  return *t_arena;
+}
+
+} // namespace
+
+block_memory_mode mcrl2::utilities::parse_block_memory_mode(const std::string& text)
+{
+  if (text == "standard")
+  {
+    return block_memory_mode::standard;
+  }
+  else if (text == "transparent")
+  {
+    return block_memory_mode::transparent;
+  }
+  else if (text == "explicit")
+  {
+    return block_memory_mode::explicit_pages;
+  }
+
+  throw mcrl2::runtime_error("Unknown huge page mode " + text + ", expected standard, transparent or explicit.");
+}
+
+std::string mcrl2::utilities::print_block_memory_mode(block_memory_mode mode)
+{
+  switch (mode)
+  {
+    case block_memory_mode::standard: return "standard";
+    case block_memory_mode::transparent: return "transparent";
+    case block_memory_mode::explicit_pages: return "explicit";
+  }
+  return "unknown";
+}
+
+std::istream& mcrl2::utilities::operator>>(std::istream& is, block_memory_mode& mode)
+{
+  std::string text;
+  is >> text;
+  try
+  {
+    mode = parse_block_memory_mode(text);
+  }
+  catch (const mcrl2::runtime_error&)
+  {
+    is.setstate(std::ios_base::failbit);
+  }
+  return is;
+}
+
+std::ostream& mcrl2::utilities::operator<<(std::ostream& os, block_memory_mode mode)
+{
+  return os << print_block_memory_mode(mode);
+}
+
+void mcrl2::utilities::set_block_memory_mode(block_memory_mode mode)
+{
+  g_block_memory().set_mode(mode);
+}
+
+block_memory_mode mcrl2::utilities::get_block_memory_mode()
+{
+  return g_block_memory().mode();
+}
+
+void* mcrl2::utilities::allocate_block_memory(std::size_t size)
+{
+  thread_arena& arena = local_arena();
+  if (void* block = arena.take_free_block(size))
+  {
+    return block;
+  }
+
+  const block_memory_mode mode = get_block_memory_mode();
+  if (mode == block_memory_mode::standard)
+  {
+    return ::operator new(size);
+  }
+  return g_block_memory().allocate(arena, mode, size);
+}
+
+void mcrl2::utilities::deallocate_block_memory(void* pointer, std::size_t size)
+{
+  // The arena is not created here, as blocks are also freed after the arena of this thread has been removed.
+  // Blocks of the regions of other threads are not kept, as they would prevent that those regions are released.
+  // The owner of a region only becomes equal to, or stops being equal to, the arena of this thread on this thread.
+  region* r = g_block_memory().find_region(pointer);
+  if (t_arena == nullptr || (r != nullptr && r->owner.load(std::memory_order_relaxed) != t_arena))
+  {
+    g_block_memory().deallocate(pointer, size);
+    return;
+  }
+
+  // Keep this block instead of the block that was freed the longest ago.
+  std::vector<std::pair<std::size_t, void*>>& free_blocks = t_arena->free_blocks;
+  if (free_blocks.size() == thread_free_blocks)
+  {
+    const std::pair<std::size_t, void*> oldest = free_blocks.front();
+    free_blocks.erase(free_blocks.begin());
+    g_block_memory().deallocate(oldest.second, oldest.first);
+  }
+  free_blocks.emplace_back(size, pointer);
+}
+
+std::size_t mcrl2::utilities::block_memory_reserved()
+{
+  return g_block_memory().reserved();
+}
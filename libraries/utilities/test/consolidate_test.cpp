@@ -12,6 +12,8 @@
 #define BOOST_AUTO_TEST_MAIN
 #include <boost/test/included/unit_test.hpp>
 
+#include <cstring>
+#include <thread>
 #include <vector>
 
 using namespace mcrl2::utilities;
@@ -89,3 +91,164 @@ BOOST_AUTO_TEST_CASE(test_partial_block_reclaimed)
   // And the allocator is empty again.
   BOOST_CHECK_EQUAL(allocator.consolidate(), 0u);
 }
+
+BOOST_AUTO_TEST_CASE(test_huge_page_blocks)
+{
+  set_block_memory_mode(block_memory_mode::transparent);
+  if (get_block_memory_mode() == block_memory_mode::standard)
+  {
+    // Huge pages are not supported on this platform.
+    return;
+  }
+
+  {
+    block_allocator<int, 16> allocator;
+
+    std::vector<int*> elements;
+    for (std::size_t i = 0; i < 1024; ++i)
+    {
+      elements.push_back(allocator.allocate(1));
+      *elements.back() = static_cast<int>(i);
+    }
+
+    const std::size_t reserved = block_memory_reserved();
+    BOOST_CHECK(reserved > 0);
+
+    for (std::size_t i = 0; i < elements.size(); ++i)
+    {
+      BOOST_CHECK_EQUAL(*elements[i], static_cast<int>(i));
+      allocator.deallocate(elements[i], 1);
+    }
+    BOOST_CHECK_EQUAL(allocator.consolidate(), 1024u/16);
+
+    // The freed blocks are reused, so no additional memory is reserved.
+    for (std::size_t i = 0; i < 1024; ++i)
+    {
+      allocator.allocate(1);
+    }
+    BOOST_CHECK_EQUAL(block_memory_reserved(), reserved);
+  }
+
+  set_block_memory_mode(block_memory_mode::standard);
+}
+
+BOOST_AUTO_TEST_CASE(test_freed_block_memory)
+{
+  set_block_memory_mode(block_memory_mode::transparent);
+  if (get_block_memory_mode() == block_memory_mode::standard)
+  {
+    // Huge pages are not supported on this platform.
+    return;
+  }
+
+  // The blocks span several huge pages, which are returned as soon as their blocks are freed.
+  constexpr std::size_t size = 2 * 2 * 1024 * 1024;
+  std::vector<char*> blocks;
+  for (std::size_t i = 0; i < 16; ++i)
+  {
+    blocks.push_back(static_cast<char*>(allocate_block_memory(size)));
+    std::memset(blocks.back(), 0xff, size);
+  }
+
+  for (char* block : blocks)
+  {
+    deallocate_block_memory(block, size);
+  }
+
+  // This thread keeps the blocks that it freed last, and the pages of the others are returned to the operating
+  // system. These read as zeroes when the blocks are allocated again.
+  std::size_t released = 0;
+  for (char*& block : blocks)
+  {
+    block = static_cast<char*>(allocate_block_memory(size));
+    if (block[size / 2] == 0)
+    {
+      ++released;
+    }
+  }
+  BOOST_CHECK(released > 0);
+  BOOST_CHECK(released < blocks.size());
+
+  for (char* block : blocks)
+  {
+    deallocate_block_memory(block, size);
+  }
+
+  set_block_memory_mode(block_memory_mode::standard);
+}
+
+BOOST_AUTO_TEST_CASE(test_freed_small_block_memory)
+{
+  set_block_memory_mode(block_memory_mode::transparent);
+  if (get_block_memory_mode() == block_memory_mode::standard)
+  {
+    // Huge pages are not supported on this platform.
+    return;
+  }
+
+  // The blocks are much smaller than a huge page, and fill several of them.
+  constexpr std::size_t size = 4096;
+  std::vector<char*> blocks;
+  for (std::size_t i = 0; i < 3 * 512; ++i)
+  {
+    blocks.push_back(static_cast<char*>(allocate_block_memory(size)));
+    std::memset(blocks.back(), 0xff, size);
+  }
+
+  for (char* block : blocks)
+  {
+    deallocate_block_memory(block, size);
+  }
+
+  // The huge pages in which all blocks have been freed are returned to the operating system.
+  std::size_t released = 0;
+  for (char*& block : blocks)
+  {
+    block = static_cast<char*>(allocate_block_memory(size));
+    if (block[0] == 0)
+    {
+      ++released;
+    }
+  }
+  BOOST_CHECK(released >= 512);
+
+  for (char* block : blocks)
+  {
+    deallocate_block_memory(block, size);
+  }
+
+  set_block_memory_mode(block_memory_mode::standard);
+}
+
+BOOST_AUTO_TEST_CASE(test_block_memory_of_other_threads)
+{
+  set_block_memory_mode(block_memory_mode::transparent);
+  if (get_block_memory_mode() == block_memory_mode::standard)
+  {
+    // Huge pages are not supported on this platform.
+    return;
+  }
+
+  const std::size_t reserved = block_memory_reserved();
+
+  // The blocks belong to the regions of a thread that terminates before they are freed.
+  constexpr std::size_t size = 4096;
+  std::vector<void*> blocks;
+  std::thread([&blocks]()
+    {
+      for (std::size_t i = 0; i < 4; ++i)
+      {
+        blocks.push_back(allocate_block_memory(size));
+      }
+    }).join();
+  BOOST_CHECK(block_memory_reserved() > reserved);
+
+  // Another thread does not keep these blocks, so the region is released once they are all freed.
+  for (void* block : blocks)
+  {
+    deallocate_block_memory(block, size);
+  }
+  BOOST_CHECK_EQUAL(block_memory_reserved(), reserved);
+
+  set_block_memory_mode(block_memory_mode::standard);
+}
@@ -38,3 +38,20 @@ BOOST_AUTO_TEST_CASE(test_function_cache)
   }
 
 }
+
+BOOST_AUTO_TEST_CASE(test_lru_cache)
+{
+  lru_cache<int, int> cache(4);
+
+  for (int i = 0; i < 1000; ++i)
+  {
+    cache.try_emplace(i, i*i);
+    // The first key is found every time, so it is never the least recently used one.
+    BOOST_CHECK(cache.find(0) != cache.end());
+  }
+
+  BOOST_CHECK(cache.find(0) != cache.end());
+  BOOST_CHECK(cache.find(999) != cache.end());
+  BOOST_CHECK(cache.find(1) == cache.end());
+  BOOST_CHECK_EQUAL(cache.size(), 4u);
+}
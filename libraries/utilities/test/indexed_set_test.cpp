@@ -76,4 +76,113 @@ BOOST_AUTO_TEST_CASE(test_indexed_set_parallel)
       thread.join();
     }
   }
-}
\ No newline at end of file
+}
+BOOST_AUTO_TEST_CASE(test_indexed_set_fixed_capacity)
+{
+  indexed_set<std::size_t> set;
+  set.set_fixed_capacity(100);
+  BOOST_CHECK(set.fixed_capacity() == 100);
+
+  for (std::size_t i = 0; i < 100; ++i)
+  {
+    BOOST_CHECK(set.insert(i).first == i);
+  }
+  BOOST_CHECK(set.size() == 100);
+  BOOST_CHECK(set.index(42) == 42);
+  BOOST_CHECK(set.insert(42) == std::make_pair(std::size_t(42), false));
+  BOOST_CHECK_THROW(set.insert(100), mcrl2::runtime_error);
+
+  // A failed insertion leaves the set unchanged.
+  BOOST_CHECK_THROW(set.insert(100), mcrl2::runtime_error);
+  BOOST_CHECK(set.size() == 100);
+  BOOST_CHECK(set.index(100) == set.npos);
+  BOOST_CHECK(set.insert(99) == std::make_pair(std::size_t(99), false));
+
+  set.clear();
+  BOOST_CHECK(set.size() == 0);
+  BOOST_CHECK(set.index(42) == set.npos);
+  BOOST_CHECK(set.insert(42).first == 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_indexed_set_fixed_capacity_parallel)
+{
+  if (detail::GlobalThreadSafe)
+  {
+    // Every thread inserts the same elements, such that insertions of equal keys happen concurrently.
+    const std::size_t number_of_threads = 8;
+    const std::size_t number_of_elements = 10000;
+    std::vector<std::thread> threads;
+
+    indexed_set<std::size_t, true> set(number_of_threads);
+    set.set_fixed_capacity(number_of_elements);
+
+    for (std::size_t i = 1; i <= number_of_threads; ++i)
+    {
+      threads.emplace_back([&set](std::size_t index)
+      {
+        for (std::size_t j = 0; j < number_of_elements; ++j)
+        {
+          set.insert(j, index);
+        }
+      }, i);
+    }
+
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+
+    BOOST_CHECK(set.size() == number_of_elements);
+    for (std::size_t j = 0; j < number_of_elements; ++j)
+    {
+      BOOST_CHECK(set[set.index(j)] == j);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_indexed_set_fixed_capacity_parallel_overflow)
+{
+  if (detail::GlobalThreadSafe)
+  {
+    // The threads insert twice as many elements as fit in the set. Insertions that do not fit fail,
+    // and must not block insertions and lookups of the other threads.
+    const std::size_t number_of_threads = 8;
+    const std::size_t number_of_elements = 10000;
+    std::vector<std::thread> threads;
+    std::atomic<std::size_t> failures = 0;
+
+    indexed_set<std::size_t, true> set(number_of_threads);
+    set.set_fixed_capacity(number_of_elements);
+
+    for (std::size_t i = 1; i <= number_of_threads; ++i)
+    {
+      threads.emplace_back([&set, &failures](std::size_t index)
+      {
+        for (std::size_t j = 0; j < 2 * number_of_elements; ++j)
+        {
+          try
+          {
+            set.insert(j, index);
+          }
+          catch (const mcrl2::runtime_error&)
+          {
+            failures++;
+          }
+        }
+      }, i);
+    }
+
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+
+    BOOST_CHECK(failures > 0);
+    BOOST_CHECK(set.size() == number_of_elements);
+    for (std::size_t j = 0; j < number_of_elements; ++j)
+    {
+      BOOST_CHECK(set[j] < 2 * number_of_elements);
+      BOOST_CHECK(set.index(set[j]) == j);
+    }
+  }
+}
@@ -241,6 +241,8 @@ public:
 
   void finalize_combined(size_t /* states */) override
   {
+    flush_transitions();
+
     // Write the initial state.
     lts::write_initial_state(*stream, 0);
   }
@@ -53,7 +53,7 @@ public:
     for (auto& filename : input_filenames())
     {
       lts::lts_lts_t new_lts;
-      new_lts.load(filename);
+      new_lts.load(filename, number_of_threads());
       lts.push_back(new_lts);
     }
 
@@ -0,0 +1,69 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_TEST_MODULE lts_combine_test
+#include <boost/test/included/unit_test.hpp>
+
+#include "../lts_combine.h"
+
+#include <cstdio>
+#include <string>
+
+using namespace mcrl2;
+
+// An lts that consists of a single sequence of the given number of a transitions.
+static lts::lts_lts_t make_sequence(const process::action_label& a, const std::size_t length)
+{
+  lts::lts_lts_t l;
+  l.set_action_label_declarations(process::action_label_list({a}));
+  const std::size_t label = l.add_action(lts::action_label_lts(lps::multi_action(process::action_list({process::action(a, data::data_expression_list())}))));
+  l.set_num_states(length + 1, false);
+  for (std::size_t i = 0; i < length; ++i)
+  {
+    l.add_transition(lts::transition(i, label, i + 1));
+  }
+  l.set_initial_state(0);
+  return l;
+}
+
+// The combined lts is written to disk with more transitions than fit in the buffer of the builder.
+BOOST_AUTO_TEST_CASE(combine_to_disk_writes_all_transitions)
+{
+  const process::action_label a("a", data::sort_expression_list());
+  const process::action_label b("b", data::sort_expression_list());
+  const std::size_t length = 99;
+  const std::vector<lts::lts_lts_t> ltss{make_sequence(a, length), make_sequence(b, length)};
+
+  const process::communication_expression_list comm_set;
+  const core::identifier_string_list block_set;
+  const core::identifier_string_list hide_set;
+  const process::action_name_multiset_list allow_set = parse_multi_action_name_set("{a, b}");
+  const lps::detail::allow_list_cache allow_cache = lps::detail::make_allow_list_cache(allow_set);
+
+  process::action_name_set used_actions{a.name(), b.name()};
+  const process::action_name_multiset_list inner_allow_set = calculate_inner_allow_set(comm_set, used_actions, allow_set);
+  std::unordered_set<core::identifier_string> inner_allowed_action_names;
+  for (const process::action_name_multiset& allow: inner_allow_set)
+  {
+    inner_allowed_action_names.insert(allow.names().begin(), allow.names().end());
+  }
+
+  const std::string filename = "combine_to_disk_writes_all_transitions.lts";
+  const combine_lts_static_context input{ltss, comm_set, block_set, hide_set, allow_cache, inner_allow_set,
+                                         inner_allowed_action_names, filename, false, 1};
+  combine_lts(input);
+
+  lts::lts_lts_t result;
+  result.load(filename);
+  std::remove(filename.c_str());
+
+  // Every state (i, j) of the product has an a transition if i < length, and a b transition if j < length.
+  BOOST_CHECK_EQUAL(result.num_transitions(), 2 * length * (length + 1));
+  BOOST_CHECK_EQUAL(result.num_states(), (length + 1) * (length + 1));
+  BOOST_CHECK_EQUAL(result.initial_state(), 0u);
+}
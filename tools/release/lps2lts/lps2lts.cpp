@@ -64,6 +64,9 @@ class lps2lts_tool: public parallel_tool<rewriter_tool<input_output_tool>>
       desc.add_option("no-probability-checking", "do not check if probabilities in stochastic specifications have sensible values");
       desc.add_hidden_option("dfs-recursive", "use recursive depth first search for divergence detection");
       desc.add_option("cached", "use enumeration caching techniques to speed up state space generation. ");
+      desc.add_option("cache-size", utilities::make_mandatory_argument("NUM"),
+                 "store at most NUM entries in each enumeration cache. When a cache is full, the entry that was "
+                 "used least recently is removed. Only applies in combination with --cached or --project. ");
       desc.add_option("project", "use read/write projections ");
 #ifdef MCRL2_USE_CONTROL_FLOW
       desc.add_option("control-flow", "use control flow based summand pruning");
@@ -104,6 +107,15 @@ class lps2lts_tool: public parallel_tool<rewriter_tool<input_output_tool>>
                  "There is no guarantee that the traces are fully contained in the partial state space."
                  , 't');
       desc.add_option("max", utilities::make_mandatory_argument("NUM"), "explore at most NUM states", 'l');
+      desc.add_option("state-capacity", utilities::make_mandatory_argument("NUM"),
+                 "allocate the table of discovered states once for at most NUM states. Threads can then "
+                 "insert states without any locking, which improves the scalability of exploration with many "
+                 "threads. State space generation fails if more than NUM states are discovered. "
+                 "This option cannot be combined with --tree-compression. ");
+      desc.add_option("tree-compression",
+                 "store the discovered states using tree compression. Each value of a parameter is stored only once, "
+                 "and states are stored as trees of indices in which common subtrees are shared. This reduces the "
+                 "memory needed per state, in particular for processes with many parameters. ");
       desc.add_option("confluence", utilities::make_optional_argument("NAME", "ctau"),
                  "apply prioritization of transitions with the action label NAME (default 'ctau'). "
                  "To give priority "
@@ -248,6 +260,7 @@ class lps2lts_tool: public parallel_tool<rewriter_tool<input_output_tool>>
       options.suppress_progress_messages            = parser.has_option("suppress");
       options.dfs_recursive                         = parser.has_option("dfs-recursive");
       options.discard_lts_state_labels              = parser.has_option("no-info");
+      options.tree_compression                      = parser.has_option("tree-compression");
       options.search_strategy = parser.option_argument_as<lps::exploration_strategy>("strategy");
       options.number_of_threads = number_of_threads();
       bool to_stdout = output_filename().empty() || output_filename() == "-";
@@ -310,6 +323,27 @@ class lps2lts_tool: public parallel_tool<rewriter_tool<input_output_tool>>
         options.max_states = parser.option_argument_as<std::size_t>("max");
       }
 
+      if (parser.has_option("cache-size"))
+      {
+        options.cache_size = parser.option_argument_as<std::size_t>("cache-size");
+        if (options.cache_size == 0)
+        {
+          parser.error("The argument of option --cache-size must be positive.");
+        }
+      }
+      if (parser.has_option("state-capacity"))
+      {
+        options.state_capacity = parser.option_argument_as<std::size_t>("state-capacity");
+        if (options.state_capacity == 0)
+        {
+          parser.error("The argument of option --state-capacity must be positive.");
+        }
+        if (parser.has_option("tree-compression"))
+        {
+          parser.error("The options --state-capacity and --tree-compression cannot be combined.");
+        }
+      }
+
       if (parser.has_option("tau"))
       {
         if (!parser.has_option("divergence"))
@@ -9,6 +9,7 @@
 /// \file ltscompare.cpp
 
 #include "mcrl2/utilities/input_tool.h"
+#include "mcrl2/utilities/parallel_tool.h"
 
 #include "mcrl2/lts/lts_algorithm.h"
 #include "mcrl2/lts/lts_io.h"
@@ -36,7 +37,7 @@ struct t_tool_options
   bool enable_preprocessing      = true;
 };
 
-using ltscompare_base = input_tool;
+using ltscompare_base = parallel_tool<input_tool>;
 class ltscompare_tool : public ltscompare_base
 {
   private:
@@ -89,8 +90,16 @@ class ltscompare_tool : public ltscompare_base
     {
       LTS_TYPE l1;
       LTS_TYPE l2;
-      l1.load(tool_options.name_for_first);
-      l2.load(tool_options.name_for_second);
+      if constexpr (std::is_same_v<LTS_TYPE, lts_lts_t>)
+      {
+        l1.load(tool_options.name_for_first, number_of_threads());
+        l2.load(tool_options.name_for_second, number_of_threads());
+      }
+      else
+      {
+        l1.load(tool_options.name_for_first);
+        l2.load(tool_options.name_for_second);
+      }
 
       l1.record_hidden_actions(tool_options.tau_actions);
       l2.record_hidden_actions(tool_options.tau_actions);
@@ -101,7 +110,7 @@ class ltscompare_tool : public ltscompare_base
         mCRL2log(verbose) << "comparing LTSs using " <<
                      tool_options.equivalence << "..." << std::endl;
 
-        result = destructive_compare(l1, l2, tool_options.equivalence, tool_options.generate_counter_examples, tool_options.counter_example_file, tool_options.structured_output);
+        result = destructive_compare(l1, l2, tool_options.equivalence, tool_options.generate_counter_examples, tool_options.counter_example_file, tool_options.structured_output, number_of_threads());
 
         mCRL2log(info) << "LTSs are " << ((result) ? "" : "not ")
                        << "equal ("
@@ -223,12 +232,14 @@ class ltscompare_tool : public ltscompare_base
                  .add_hidden_value(lts_eq_bisim_jgkw)
                  .add_hidden_value(lts_eq_bisim_gj)
                  .add_hidden_value(lts_eq_bisim_gj_lazy_BLC)
+                 .add_hidden_value(lts_eq_bisim_par)
                  .add_value(lts_eq_branching_bisim)
                  .add_hidden_value(lts_eq_branching_bisim_gv)
                  .add_hidden_value(lts_eq_branching_bisim_gjkw)
                  .add_hidden_value(lts_eq_branching_bisim_jgkw)
                  .add_hidden_value(lts_eq_branching_bisim_gj)
                  .add_hidden_value(lts_eq_branching_bisim_gj_lazy_BLC)
+                 .add_hidden_value(lts_eq_branching_bisim_par)
                  .add_value(lts_eq_divergence_preserving_branching_bisim)
                  .add_hidden_value(lts_eq_divergence_preserving_branching_bisim_gv)
                  .add_hidden_value(lts_eq_divergence_preserving_branching_bisim_gjkw)
@@ -13,6 +13,7 @@ constexpr auto NAME = "ltsconvert";
 constexpr auto AUTHOR = "Muck van Weerdenburg, Jan Friso Groote";
 
 #include "mcrl2/utilities/input_output_tool.h"
+#include "mcrl2/utilities/parallel_tool.h"
 #include "mcrl2/lts/lts_io.h"
 #include "mcrl2/lts/lts_algorithm.h"
 
@@ -125,14 +126,15 @@ public:
 
 };
 
-class ltsconvert_tool : public input_output_tool
+using ltsconvert_base = parallel_tool<input_output_tool>;
+class ltsconvert_tool : public ltsconvert_base
 {
   private:
     t_tool_options tool_options;
 
   public:
     ltsconvert_tool() :
-      input_output_tool(NAME,AUTHOR,
+      ltsconvert_base(NAME,AUTHOR,
                       "convert and optionally minimise an LTS",
                       "Convert the labelled transition system (LTS) from INFILE to OUTFILE in the\n"
                       "requested format after applying the selected minimisation method (default is\n"
@@ -156,7 +158,14 @@ class ltsconvert_tool : public input_output_tool
       using namespace mcrl2::lts::detail;
 
       LTS_TYPE l;
-      l.load(tool_options.infilename);
+      if constexpr (std::is_same_v<LTS_TYPE, lts_lts_t>)
+      {
+        l.load(tool_options.infilename, number_of_threads());
+      }
+      else
+      {
+        l.load(tool_options.infilename);
+      }
       l.apply_hidden_actions(tool_options.tau_actions);
 
       if (tool_options.check_reach)
@@ -201,7 +210,7 @@ class ltsconvert_tool : public input_output_tool
           mCRL2log(verbose) << "Reducing LTS (modulo " <<  description(tool_options.equivalence) << ")..." << std::endl;
           mCRL2log(verbose) << "Before reduction: " << l.num_states() << " states and " << l.num_transitions() << " transitions." << std::endl;
           timer().start("reduction");
-          reduce(l,tool_options.equivalence);
+          reduce(l,tool_options.equivalence,number_of_threads());
           timer().finish("reduction");
           mCRL2log(verbose) << "After reduction: " << l.num_states() << " states and " << l.num_transitions() << " transitions." << std::endl;
         }
@@ -331,7 +340,7 @@ class ltsconvert_tool : public input_output_tool
   protected:
     void add_options(interface_description& desc) override
     {
-      input_output_tool::add_options(desc);
+      ltsconvert_base::add_options(desc);
 
       desc.add_option("no-reach",
                       "do not perform a reachability check on the input LTS.");
@@ -355,6 +364,7 @@ class ltsconvert_tool : public input_output_tool
                       .add_hidden_value(lts_eq_bisim_gj)
                       .add_hidden_value(lts_eq_bisim_gj_lazy_BLC)
                       .add_hidden_value(lts_eq_bisim_sigref)
+                      .add_hidden_value(lts_eq_bisim_par)
                       .add_value(lts_eq_branching_bisim)
                       .add_hidden_value(lts_eq_branching_bisim_gv)
                       .add_hidden_value(lts_eq_branching_bisim_gjkw)
@@ -362,6 +372,7 @@ class ltsconvert_tool : public input_output_tool
                       .add_hidden_value(lts_eq_branching_bisim_gj)
                       .add_hidden_value(lts_eq_branching_bisim_gj_lazy_BLC)
                       .add_hidden_value(lts_eq_branching_bisim_sigref)
+                      .add_hidden_value(lts_eq_branching_bisim_par)
                       .add_value(lts_eq_divergence_preserving_branching_bisim)
                       .add_hidden_value(lts_eq_divergence_preserving_branching_bisim_gv)
                       .add_hidden_value(lts_eq_divergence_preserving_branching_bisim_gjkw)
@@ -404,7 +415,7 @@ class ltsconvert_tool : public input_output_tool
 
     void parse_options(const command_line_parser& parser) override
     {
-      input_output_tool::parse_options(parser);
+      ltsconvert_base::parse_options(parser);
 
       if (parser.options.count("lps"))
       {
@@ -130,7 +130,7 @@ static const std::string help_text=
   "  a[ssign] VAR=EXPRESSION        evaluate the expression and assign it to the variable.\n"
   "  e[val] EXPRESSION              rewrite EXPRESSION and print result.\n"
   "  v[ar] VARLIST                  declare variables in VARLIST.\n"
-  "  r[ewriter] STRATEGY            use STRATEGY for rewriting (jitty, jittyc, jittyp, jittycp).\n"
+  "  r[ewriter] STRATEGY            use STRATEGY for rewriting (jitty, jittyc, jittyi, jittyp, jittycp).\n"
   "  s[solve] VARLIST. EXPRESSION   give all valuations of the variables in VARLIST that satisfy EXPRESSION.\n"
   "\n"
   "VARLIST is of the form x,y,...: S; ... v,w,...: T.\n";
@@ -740,7 +740,7 @@ void solve(pbes_system::pbes pbesspec,
         second_instantiate.run();
         timer.finish("second-instantiation");
 
-        mCRL2log(log::verbose) << "Number of vertices in the structure graph: " << SG.all_vertices().size()
+        mCRL2log(log::verbose) << "Number of vertices in the structure graph: " << SG.extent()
                                << std::endl;
         [[maybe_unused]]
         bool final_result